@@ -1,6 +1,7 @@
 #include "GameMap.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
 
@@ -12,6 +13,8 @@ constexpr int kBinarySearchIterations = 12;
 constexpr float kContactTolerance = 1e-4f;
 constexpr float kContactBackoff = 1e-3f;
 
+std::atomic<uint64_t> nextTerrainId{1};
+
 bool segmentIntersectsAabb(const Position &start, const Position &end,
                            float minX, float minY, float maxX, float maxY,
                            float &outTEnter) {
@@ -69,13 +72,161 @@ GameMap::GameMap(int width, int height, float tileSize, float minX, float minY)
     : width_(width), height_(height), tileSize_(tileSize), minX_(minX),
       minY_(minY), maxX_(minX + tileSize * width),
       maxY_(minY + tileSize * height),
-      tiles_(static_cast<size_t>(width) * height, TerrainType::Unknown) {}
+      tiles_(static_cast<size_t>(width) * height, TerrainType::Unknown),
+      blocked_(tiles_.size(), 0),
+      walkable_(tiles_.size(),
+                getTerrainProperties(TerrainType::Unknown).walkable ? 1 : 0),
+      clearance_(tiles_.size(), 0.0f), terrainId_(nextTerrainId++) {}
 
 void GameMap::setTile(int x, int y, TerrainType terrain) {
   if (x < 0 || x >= width_ || y < 0 || y >= height_) {
     return;
   }
-  tiles_[toIndex(x, y)] = terrain;
+  const int index = toIndex(x, y);
+  if (tiles_[index] != terrain) {
+    tiles_[index] = terrain;
+    refreshWalkable(index);
+    recordTileChange(index);
+  }
+}
+
+void GameMap::setTileBlocked(int x, int y, bool blocked) {
+  if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+    return;
+  }
+  const int index = toIndex(x, y);
+  const uint8_t value = blocked ? 1 : 0;
+  if (blocked_[index] != value) {
+    blocked_[index] = value;
+    refreshWalkable(index);
+    recordTileChange(index);
+  }
+}
+
+bool GameMap::isTileBlocked(int x, int y) const {
+  if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+    return false;
+  }
+  return blocked_[toIndex(x, y)] != 0;
+}
+
+void GameMap::refreshWalkable(int index) {
+  walkable_[index] =
+      getTerrainProperties(tiles_[index]).walkable && blocked_[index] == 0;
+}
+
+void GameMap::recordTileChange(int index) {
+  // Enough for incremental path repair after local edits; bulk edits such
+  // as loading a map overflow it and force full replans, which they need
+  // anyway.
+  constexpr size_t kMaxChangeLog = 4096;
+  ++terrainEpoch_;
+  if (changeLog_.size() >= kMaxChangeLog) {
+    const size_t dropped = changeLog_.size() / 2;
+    changeLog_.erase(changeLog_.begin(), changeLog_.begin() + dropped);
+    changeLogStartEpoch_ += dropped;
+  }
+  changeLog_.push_back(static_cast<uint32_t>(index));
+}
+
+bool GameMap::getTileChangesSince(uint64_t epoch,
+                                  std::vector<uint32_t> &outTiles) const {
+  if (epoch < changeLogStartEpoch_ || epoch > terrainEpoch_) {
+    return false;
+  }
+  outTiles.insert(outTiles.end(),
+                  changeLog_.begin() + (epoch - changeLogStartEpoch_),
+                  changeLog_.end());
+  return true;
+}
+
+void GameMap::rebuildClearance() {
+  // 各タイルに「最も近い歩行不能タイル」を持たせ、8近傍から2パスで伝播する
+  // （ベクトル伝播による距離変換。誤差はタイル幅に比べて十分小さい）
+  constexpr int kNone = -1;
+  const size_t count = tiles_.size();
+  std::vector<int> nearest(count, kNone);
+  for (size_t i = 0; i < count; ++i) {
+    if (!walkable_[i]) {
+      nearest[i] = static_cast<int>(i);
+    }
+  }
+
+  // タイル中心から歩行不能タイルの最も近い点までの距離（タイル単位の二乗）
+  auto distanceSq = [&](int x, int y, int blockedIndex) {
+    const float ex =
+        std::max(std::abs(x - blockedIndex % width_) - 0.5f, 0.0f);
+    const float ey =
+        std::max(std::abs(y - blockedIndex / width_) - 0.5f, 0.0f);
+    return ex * ex + ey * ey;
+  };
+  auto relax = [&](int x, int y, int dx, int dy) {
+    const int nx = x + dx;
+    const int ny = y + dy;
+    if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) {
+      return;
+    }
+    const int candidate = nearest[toIndex(nx, ny)];
+    int &current = nearest[toIndex(x, y)];
+    if (candidate != kNone &&
+        (current == kNone ||
+         distanceSq(x, y, candidate) < distanceSq(x, y, current))) {
+      current = candidate;
+    }
+  };
+  for (int y = 0; y < height_; ++y) {
+    for (int x = 0; x < width_; ++x) {
+      relax(x, y, -1, 0);
+      relax(x, y, -1, -1);
+      relax(x, y, 0, -1);
+      relax(x, y, 1, -1);
+    }
+    for (int x = width_ - 1; x >= 0; --x) {
+      relax(x, y, 1, 0);
+    }
+  }
+  for (int y = height_ - 1; y >= 0; --y) {
+    for (int x = width_ - 1; x >= 0; --x) {
+      relax(x, y, 1, 0);
+      relax(x, y, 1, 1);
+      relax(x, y, 0, 1);
+      relax(x, y, -1, 1);
+    }
+    for (int x = 0; x < width_; ++x) {
+      relax(x, y, -1, 0);
+    }
+  }
+
+  for (int y = 0; y < height_; ++y) {
+    for (int x = 0; x < width_; ++x) {
+      const int index = toIndex(x, y);
+      if (!walkable_[index]) {
+        clearance_[index] = 0.0f;
+        continue;
+      }
+      // マップの端も壁として扱う
+      float tiles = std::min(std::min(x, width_ - 1 - x),
+                             std::min(y, height_ - 1 - y)) +
+                    0.5f;
+      if (nearest[index] != kNone) {
+        tiles = std::min(tiles, std::sqrt(distanceSq(x, y, nearest[index])));
+      }
+      clearance_[index] = tiles * tileSize_;
+    }
+  }
+  clearanceEpoch_ = terrainEpoch_;
+}
+
+bool GameMap::isTilePassable(int x, int y, float radius) const {
+  if (!isTileWalkable(x, y)) {
+    return false;
+  }
+  if (isClearanceCurrent()) {
+    return clearance_[toIndex(x, y)] >= radius;
+  }
+  const Position center(minX_ + (x + 0.5f) * tileSize_,
+                        minY_ + (y + 0.5f) * tileSize_);
+  return isWalkable(center, radius);
 }
 
 TerrainType GameMap::getTile(int x, int y) const {
@@ -85,6 +236,15 @@ TerrainType GameMap::getTile(int x, int y) const {
   return tiles_[toIndex(x, y)];
 }
 
+bool GameMap::isPointWalkable(const Position &worldPos) const {
+  int tileX = 0;
+  int tileY = 0;
+  if (!positionToTile(worldPos, tileX, tileY)) {
+    return getTerrainProperties(TerrainType::Unknown).walkable;
+  }
+  return walkable_[toIndex(tileX, tileY)] != 0;
+}
+
 TerrainType GameMap::terrainAt(const Position &worldPos) const {
   int tileX = 0;
   int tileY = 0;
@@ -98,6 +258,9 @@ float GameMap::getMovementMultiplier(const Position &worldPos,
                                      float radius) const {
   const float effectiveRadius = std::max(radius, 0.0f);
   if (effectiveRadius <= kEpsilon) {
+    if (!isPointWalkable(worldPos)) {
+      return 0.0f;
+    }
     TerrainType terrain = terrainAt(worldPos);
     return getTerrainProperties(terrain).movementSpeedMultiplier;
   }
@@ -121,10 +284,10 @@ float GameMap::getMovementMultiplier(const Position &worldPos,
       }
 
       touchedAnyTile = true;
-      TerrainProperties props = getTerrainProperties(getTile(tx, ty));
-      if (!props.walkable) {
+      if (!isTileWalkable(tx, ty)) {
         return 0.0f;
       }
+      TerrainProperties props = getTerrainProperties(getTile(tx, ty));
       minMultiplier = std::min(minMultiplier, props.movementSpeedMultiplier);
     }
   }
@@ -144,8 +307,7 @@ float GameMap::getMovementMultiplier(const Position &worldPos,
 bool GameMap::isWalkable(const Position &worldPos, float radius) const {
   const float effectiveRadius = std::max(radius, 0.0f);
   if (effectiveRadius <= kEpsilon) {
-    TerrainType terrain = terrainAt(worldPos);
-    return getTerrainProperties(terrain).walkable;
+    return isPointWalkable(worldPos);
   }
 
   int minTileX = 0;
@@ -172,21 +334,38 @@ bool GameMap::isWalkable(const Position &worldPos, float radius) const {
       }
 
       touchedAnyTile = true;
-      TerrainProperties props = getTerrainProperties(getTile(tx, ty));
-      if (!props.walkable) {
+      if (!isTileWalkable(tx, ty)) {
         return false;
       }
     }
   }
 
   if (!touchedAnyTile) {
-    TerrainType terrain = terrainAt(worldPos);
-    return getTerrainProperties(terrain).walkable;
+    return isPointWalkable(worldPos);
   }
 
   return touchedAnyTile && inBounds;
 }
 
+void GameMap::areWalkable(const Position *positions, size_t count,
+                          float radius, uint8_t *outWalkable) const {
+  const float effectiveRadius = std::max(radius, 0.0f);
+  for (size_t i = 0; i < count; ++i) {
+    // 円が内部の1タイルに収まる場合はそのタイルだけを見る（大半のケース）
+    int minTileX = 0;
+    int maxTileX = 0;
+    int minTileY = 0;
+    int maxTileY = 0;
+    if (computeTileRangeForCircle(positions[i], effectiveRadius, minTileX,
+                                  maxTileX, minTileY, maxTileY) &&
+        minTileX == maxTileX && minTileY == maxTileY) {
+      outWalkable[i] = isTileWalkable(minTileX, minTileY) ? 1 : 0;
+      continue;
+    }
+    outWalkable[i] = isWalkable(positions[i], effectiveRadius) ? 1 : 0;
+  }
+}
+
 Position GameMap::clampInside(const Position &worldPos, float radius) const {
   float minAllowedX = minX_ + radius;
   float maxAllowedX = maxX_ - radius;
@@ -274,8 +453,6 @@ bool GameMap::positionToTile(const Position &worldPos, int &tileX,
   return true;
 }
 
-int GameMap::toIndex(int x, int y) const { return y * width_ + x; }
-
 bool GameMap::computeTileRangeForCircle(const Position &center, float radius,
                                         int &minTileX, int &maxTileX,
                                         int &minTileY, int &maxTileY) const {
@@ -427,7 +604,7 @@ GameMap::clipMovementRaycast(const Position &start, const Position &desired,
   for (int ty = minTileY; ty <= maxTileY; ++ty) {
     for (int tx = minTileX; tx <= maxTileX; ++tx) {
       TerrainProperties props = getTerrainProperties(getTile(tx, ty));
-      if (props.walkable && props.movementSpeedMultiplier > kEpsilon) {
+      if (isTileWalkable(tx, ty) && props.movementSpeedMultiplier > kEpsilon) {
         continue;
       }
 
@@ -1,6 +1,7 @@
 #ifndef SIMULATION_GAME_GAME_MAP_H
 #define SIMULATION_GAME_GAME_MAP_H
 
+#include <cstdint>
 #include <vector>
 
 #include "../value_objects/Position.h"
@@ -28,10 +29,67 @@ public:
   void setTile(int x, int y, TerrainType terrain);
   TerrainType getTile(int x, int y) const;
 
+  // Marks a tile as covered by a static obstacle (props rasterized from
+  // MovementField). A blocked tile is unwalkable whatever its terrain.
+  void setTileBlocked(int x, int y, bool blocked);
+  bool isTileBlocked(int x, int y) const;
+
+  // Terrain walkability and obstacles combined into one per-tile lookup.
+  // Tiles outside the map are not walkable.
+  bool isTileWalkable(int x, int y) const {
+    return x >= 0 && x < width_ && y >= 0 && y < height_ &&
+           walkable_[toIndex(x, y)] != 0;
+  }
+
+  // Clearance layer: distance in world units from a tile's center to the
+  // nearest unwalkable tile or the map edge (0 for unwalkable tiles). A
+  // circle of radius r centered on the tile fits when clearance >= r.
+  // The layer is recomputed by rebuildClearance(); isClearanceCurrent()
+  // tells whether tiles or obstacles have changed since.
+  void rebuildClearance();
+  bool isClearanceCurrent() const { return clearanceEpoch_ == terrainEpoch_; }
+  float getTileClearance(int x, int y) const {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+      return 0.0f;
+    }
+    return clearance_[toIndex(x, y)];
+  }
+
+  // Whether a circle of the given radius can stand on the tile's center.
+  // Uses the clearance layer when it is current and falls back to
+  // isWalkable at the tile center otherwise. Grid searches (move range,
+  // pathfinding) share this so they agree on what a unit fits through.
+  bool isTilePassable(int x, int y, float radius) const;
+
+  // Incremented whenever setTile or setTileBlocked actually changes a tile.
+  // Caches derived from the terrain compare this value to detect edits.
+  uint64_t getTerrainEpoch() const { return terrainEpoch_; }
+  // Distinct for every constructed map (a copy shares its source's value).
+  // Caches that remember a map by address compare this as well, since a new
+  // map built at the same address can reach the same epoch.
+  uint64_t getTerrainId() const { return terrainId_; }
+
+  // Appends the indices (y * width + x) of tiles changed after the given
+  // epoch, oldest first; a tile edited twice appears twice. Only the most
+  // recent edits are journaled: returns false when the journal no longer
+  // reaches back to the epoch, and callers must treat every tile as changed.
+  bool getTileChangesSince(uint64_t epoch,
+                           std::vector<uint32_t> &outTiles) const;
+
+  // Converts a world position to tile coordinates. Returns false outside the
+  // map.
+  bool worldToTile(const Position &worldPos, int &tileX, int &tileY) const {
+    return positionToTile(worldPos, tileX, tileY);
+  }
+
   TerrainType terrainAt(const Position &worldPos) const;
   float getMovementMultiplier(const Position &worldPos,
                               float radius = 0.0f) const;
   bool isWalkable(const Position &worldPos, float radius = 0.0f) const;
+  // Batch form of isWalkable for many circles of the same radius (formation
+  // slots and similar). outWalkable[i] is 1 when positions[i] is walkable.
+  void areWalkable(const Position *positions, size_t count, float radius,
+                   uint8_t *outWalkable) const;
   Position clampInside(const Position &worldPos, float radius = 0.0f) const;
   Position resolveMovementTarget(const Position &start, const Position &desired,
                                  float radius) const;
@@ -47,7 +105,12 @@ public:
 
 private:
   bool positionToTile(const Position &worldPos, int &tileX, int &tileY) const;
-  int toIndex(int x, int y) const;
+  // Point form of the walkable layer (outside the map falls back to Unknown).
+  bool isPointWalkable(const Position &worldPos) const;
+  int toIndex(int x, int y) const { return y * width_ + x; }
+  void refreshWalkable(int index);
+  // Bumps terrainEpoch_ and journals the changed tile.
+  void recordTileChange(int index);
   bool computeTileRangeForCircle(const Position &center, float radius,
                                  int &minTileX, int &maxTileX, int &minTileY,
                                  int &maxTileY) const;
@@ -65,6 +128,15 @@ private:
   float maxX_;
   float maxY_;
   std::vector<TerrainType> tiles_;
+  std::vector<uint8_t> blocked_;  // 1 = covered by a static obstacle
+  std::vector<uint8_t> walkable_; // terrain walkable and not blocked
+  std::vector<float> clearance_;
+  uint64_t terrainId_;
+  uint64_t terrainEpoch_ = 0;
+  // changeLog_[i] is the tile changed at epoch changeLogStartEpoch_ + i + 1
+  std::vector<uint32_t> changeLog_;
+  uint64_t changeLogStartEpoch_ = 0;
+  uint64_t clearanceEpoch_ = UINT64_MAX;
 };
 
 #endif // SIMULATION_GAME_GAME_MAP_H
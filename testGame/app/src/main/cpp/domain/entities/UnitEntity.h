@@ -36,6 +36,22 @@ enum class UnitState {
   DEAD    // 死亡
 };
 
+class UnitEntity;
+
+/**
+ * @brief ユニットの状態遷移を受け取るオブザーバー
+ *
+ * 移動中・戦闘中などのアクティブ集合（ActiveUnitSets）をティックごとの
+ * 全走査なしに保守するために使う。通知は状態が実際に変わったときと、
+ * 生き残る被ダメージのときだけ行われる。
+ */
+class UnitStateObserver {
+public:
+  virtual ~UnitStateObserver() = default;
+  virtual void onUnitStateChanged(UnitEntity &unit, UnitState previous) = 0;
+  virtual void onUnitDamaged(UnitEntity &unit) = 0;
+};
+
 /**
  * @brief ユニットエンティティ
  *
@@ -77,6 +93,17 @@ public:
   int getFaction() const { return faction_; }
   void setFaction(int f) { faction_ = f; }
 
+  /**
+   * @brief 状態遷移の通知先を設定する（nullptr で解除）
+   *
+   * 所有権は呼び出し側が持つ。コピーしたユニットにも引き継がれるので、
+   * 通知先はユニットの同一性を確認すること。
+   */
+  void setStateObserver(UnitStateObserver *observer) {
+    stateObserver_ = observer;
+  }
+  UnitStateObserver *getStateObserver() const { return stateObserver_; }
+
   /**
    * @brief ユニットが生きているかチェック
    */
@@ -193,9 +220,9 @@ public:
      * これにより、COMBAT状態からでも新しい移動を開始できる
      */
     if (position_ != targetPosition_) {
-      state_ = UnitState::MOVING;
+      transitionTo(UnitState::MOVING);
     } else {
-      state_ = UnitState::IDLE;
+      transitionTo(UnitState::IDLE);
     }
 
     return true;
@@ -217,11 +244,26 @@ public:
       // MOVING状態の場合のみIDLEに遷移
       // COMBAT状態の場合は戦闘状態を維持
       if (state_ == UnitState::MOVING) {
-        state_ = UnitState::IDLE;
+        transitionTo(UnitState::IDLE);
       }
     }
   }
 
+  /**
+   * @brief 重なり解消などで外部から押し出す
+   * @param newPosition 押し出し後の位置
+   *
+   * 停止中（目標位置に到達済み）のユニットは目標位置も一緒に動かし、
+   * 元の位置へ歩いて戻らないようにする。状態は変えない。
+   */
+  void pushTo(const Position &newPosition) {
+    const bool atTarget = position_ == targetPosition_;
+    position_ = newPosition;
+    if (atTarget) {
+      targetPosition_ = newPosition;
+    }
+  }
+
   /**
    * @brief 移動を更新（フレーム毎の移動処理）
    * @param deltaTime フレーム間の時間（秒）
@@ -238,7 +280,7 @@ public:
     const float clampedModifier = std::max(0.0f, speedModifier);
     const float effectiveSpeed = stats_.getMoveSpeed() * clampedModifier;
     if (effectiveSpeed <= 0.0f || deltaTime <= 0.0f) {
-      state_ = UnitState::IDLE;
+      transitionTo(UnitState::IDLE);
       return;
     }
 
@@ -247,14 +289,14 @@ public:
 
     if (distance <= kArrivalThreshold) {
       position_ = targetPosition_;
-      state_ = UnitState::IDLE;
+      transitionTo(UnitState::IDLE);
       return;
     }
 
     float dx = targetPosition_.getX() - position_.getX();
     float dy = targetPosition_.getY() - position_.getY();
     if (std::abs(dx) < 1e-6f && std::abs(dy) < 1e-6f) {
-      state_ = UnitState::IDLE;
+      transitionTo(UnitState::IDLE);
       return;
     }
 
@@ -265,11 +307,11 @@ public:
     float moveLen = std::sqrt(moveX * moveX + moveY * moveY);
     if (moveLen >= distance) {
       position_ = targetPosition_;
-      state_ = UnitState::IDLE;
+      transitionTo(UnitState::IDLE);
     } else {
       Position nextPos(position_.getX() + moveX, position_.getY() + moveY);
       position_ = nextPos;
-      state_ = UnitState::MOVING;
+      transitionTo(UnitState::MOVING);
     }
   }
 
@@ -282,10 +324,13 @@ public:
     stats_ = stats_.takeDamage(damage);
 
     if (!stats_.isAlive()) {
-      state_ = UnitState::DEAD;
+      transitionTo(UnitState::DEAD);
       return false;
     }
 
+    if (stateObserver_) {
+      stateObserver_->onUnitDamaged(*this);
+    }
     return true;
   }
 
@@ -304,7 +349,7 @@ public:
    */
   void enterCombat() {
     if (isAlive()) {
-      state_ = UnitState::COMBAT;
+      transitionTo(UnitState::COMBAT);
     }
   }
 
@@ -315,9 +360,9 @@ public:
     if (isAlive() && state_ == UnitState::COMBAT) {
       // 移動中だった場合は移動状態に戻す
       if (position_ != targetPosition_) {
-        state_ = UnitState::MOVING;
+        transitionTo(UnitState::MOVING);
       } else {
-        state_ = UnitState::IDLE;
+        transitionTo(UnitState::IDLE);
       }
     }
   }
@@ -327,7 +372,7 @@ public:
    */
   void setState(UnitState newState) {
     if (isAlive() || newState == UnitState::DEAD) {
-      state_ = newState;
+      transitionTo(newState);
     }
   }
 
@@ -362,7 +407,7 @@ public:
                        stats_.getCollisionRadius());
 
     // 状態をIDLEにリセット
-    state_ = UnitState::IDLE;
+    transitionTo(UnitState::IDLE);
 
     // 移動目標を現在位置にリセット
     targetPosition_ = position_;
@@ -416,6 +461,20 @@ public:
   bool operator!=(const UnitEntity &other) const { return !(*this == other); }
 
 private:
+  /**
+   * @brief 状態を変更し、変わった場合だけオブザーバーに通知する
+   */
+  void transitionTo(UnitState next) {
+    if (state_ == next) {
+      return;
+    }
+    const UnitState previous = state_;
+    state_ = next;
+    if (stateObserver_) {
+      stateObserver_->onUnitStateChanged(*this, previous);
+    }
+  }
+
   int id_;                  // 一意ID
   std::string name_;        // ユニット名
   Position position_;       // 現在位置
@@ -425,6 +484,7 @@ private:
   float lastAttackTime_;    // 最後の攻撃時刻
   int faction_;             // 陣営ID（0: default / neutral）
   float suppressAttackUntil_; // この時刻まで攻撃を抑制（秒）
+  UnitStateObserver *stateObserver_ = nullptr; // 状態遷移の通知先（非所有）
 };
 
 #endif // SIMULATION_GAME_UNIT_ENTITY_H
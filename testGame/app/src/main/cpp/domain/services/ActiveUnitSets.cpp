@@ -0,0 +1,180 @@
+#include "ActiveUnitSets.h"
+
+/*
+ * ActiveUnitSets.cpp
+ *
+ * Membership of the moving / in-combat sets is a pure function of the unit's
+ * state and is recomputed on every notified transition. The awake set is
+ * different: it is joined on any transition or hit, but only left in
+ * updateSleep (or on death), so a unit that has just stopped stays awake for
+ * at least one sleep check.
+ */
+#include <algorithm>
+
+void ActiveUnitSets::IndexSet::reset(size_t capacity) {
+  members.clear();
+  slots.assign(capacity, kAbsent);
+}
+
+void ActiveUnitSets::IndexSet::insert(uint32_t index) {
+  if (index >= slots.size() || slots[index] != kAbsent) {
+    return;
+  }
+  slots[index] = static_cast<uint32_t>(members.size());
+  members.push_back(index);
+}
+
+void ActiveUnitSets::IndexSet::erase(uint32_t index) {
+  if (!contains(index)) {
+    return;
+  }
+  // 末尾の要素を空いた位置へ移して詰める
+  const uint32_t slot = slots[index];
+  const uint32_t last = members.back();
+  members[slot] = last;
+  slots[last] = slot;
+  members.pop_back();
+  slots[index] = kAbsent;
+}
+
+ActiveUnitSets::ActiveUnitSets(float wakeRadius)
+    : configuredWakeRadius_(wakeRadius), wakeRadius_(wakeRadius) {}
+
+ActiveUnitSets::~ActiveUnitSets() { detachAll(); }
+
+void ActiveUnitSets::detachAll() {
+  for (const auto &weak : observed_) {
+    if (auto unit = weak.lock()) {
+      if (unit->getStateObserver() == this) {
+        unit->setStateObserver(nullptr);
+      }
+    }
+  }
+  observed_.clear();
+}
+
+void ActiveUnitSets::track(
+    const std::vector<std::shared_ptr<UnitEntity>> &units) {
+  detachAll();
+  const size_t count = units.size();
+  unitAt_.assign(count, nullptr);
+  indexById_.clear();
+  moving_.reset(count);
+  inCombat_.reset(count);
+  awake_.reset(count);
+
+  float maxReach = 0.0f;
+  for (size_t i = 0; i < count; ++i) {
+    const auto &unit = units[i];
+    if (!unit) {
+      continue;
+    }
+    const uint32_t index = static_cast<uint32_t>(i);
+    unit->setStateObserver(this);
+    observed_.push_back(unit);
+    unitAt_[i] = unit.get();
+    indexById_[unit->getId()] = index;
+    maxReach = std::max(maxReach, unit->getStats().getAttackRange() +
+                                      unit->getStats().getCollisionRadius());
+    refresh(index);
+    if (unit->isAlive()) {
+      awake_.insert(index);
+    }
+  }
+  // 射程内に入った敵に気づかないまま眠っていることがないようにする
+  wakeRadius_ = std::max(configuredWakeRadius_, maxReach);
+  trackedCount_ = count;
+  tracked_ = true;
+}
+
+bool ActiveUnitSets::findIndex(const UnitEntity &unit,
+                               uint32_t &outIndex) const {
+  auto found = indexById_.find(unit.getId());
+  // コピーされたユニットは同じ ID と通知先を持つので、実体で確認する
+  if (found == indexById_.end() || unitAt_[found->second] != &unit) {
+    return false;
+  }
+  outIndex = found->second;
+  return true;
+}
+
+void ActiveUnitSets::refresh(uint32_t index) {
+  const UnitEntity &unit = *unitAt_[index];
+  const bool alive = unit.isAlive();
+  const UnitState state = unit.getState();
+
+  if (alive && state == UnitState::MOVING) {
+    moving_.insert(index);
+  } else {
+    moving_.erase(index);
+  }
+  if (alive && state == UnitState::COMBAT) {
+    inCombat_.insert(index);
+  } else {
+    inCombat_.erase(index);
+  }
+  if (!alive) {
+    awake_.erase(index);
+  }
+}
+
+void ActiveUnitSets::onUnitStateChanged(UnitEntity &unit,
+                                        UnitState /*previous*/) {
+  uint32_t index = 0;
+  if (findIndex(unit, index)) {
+    refresh(index);
+    if (unit.isAlive()) {
+      awake_.insert(index); // 止まった直後も次の判定までは起きている
+    }
+  }
+}
+
+void ActiveUnitSets::onUnitDamaged(UnitEntity &unit) {
+  uint32_t index = 0;
+  if (findIndex(unit, index) && unit.isAlive()) {
+    awake_.insert(index);
+  }
+}
+
+void ActiveUnitSets::updateSleep(const FactionSpatialIndex &index) {
+  if (!tracked_) {
+    return;
+  }
+
+  // 動いているユニットの周囲にいる敵を起こす
+  auto wakeAround = [&](const std::vector<uint32_t> &active) {
+    for (uint32_t i : active) {
+      const UnitEntity &unit = *unitAt_[i];
+      index.forEachEnemyInRadius(
+          unit.getFaction(), unit.getPosition().getX(),
+          unit.getPosition().getY(), wakeRadius_,
+          [&](uint32_t other, float) {
+            if (other < trackedCount_ && unitAt_[other] &&
+                unitAt_[other]->isAlive()) {
+              awake_.insert(other);
+            }
+          });
+    }
+  };
+  wakeAround(moving_.members);
+  wakeAround(inCombat_.members);
+
+  // 待機中で周囲に敵がいなければ眠らせる
+  fallingAsleep_.clear();
+  for (uint32_t i : awake_.members) {
+    const UnitEntity &unit = *unitAt_[i];
+    if (unit.getState() != UnitState::IDLE) {
+      continue;
+    }
+    uint32_t nearest = 0;
+    float distanceSq = 0.0f;
+    if (!index.findNearestEnemy(unit.getFaction(), unit.getPosition().getX(),
+                                unit.getPosition().getY(), wakeRadius_,
+                                nearest, distanceSq)) {
+      fallingAsleep_.push_back(i);
+    }
+  }
+  for (uint32_t i : fallingAsleep_) {
+    awake_.erase(i);
+  }
+}
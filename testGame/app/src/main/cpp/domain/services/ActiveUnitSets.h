@@ -0,0 +1,123 @@
+#ifndef SIMULATION_GAME_ACTIVE_UNIT_SETS_H
+#define SIMULATION_GAME_ACTIVE_UNIT_SETS_H
+
+#include "../entities/UnitEntity.h"
+#include "FactionSpatialIndex.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 移動中・戦闘中・起きているユニットの集合を状態遷移で保守する
+ *
+ * 設計方針：
+ * - 各ユニットの UnitStateObserver として登録し、setTargetPosition /
+ *   enterCombat / exitCombat / takeDamage などの状態遷移のたびに該当する
+ *   ユニットだけの所属を更新する。ティックごとの全ユニット走査は行わない
+ * - 集合の要素は track に渡したユニット配列上のインデックス。追加・削除は
+ *   位置表（slot）による O(1) の入れ替え削除なので、列挙順は不定
+ * - 「起きている」= 移動中・戦闘中・被ダメージ・近くに敵がいるユニット。
+ *   待機中で周囲（wakeRadius）に敵がいなければ updateSleep で眠らせる。
+ *   止まっているユニットに敵が近づくのは敵が動いたときだけなので、起こす
+ *   判定は動いているユニットの周囲を調べれば足りる
+ *
+ * 注意：
+ * - インデックスは track 時点の配列に対するもの。配列の要素が変わったら
+ *   （死亡ユニット除去など）track し直すこと。covers() が false の間は
+ *   消費者は全走査にフォールバックする
+ * - 死亡したユニットは遷移の時点ですべての集合から外れる
+ * - 眠っているユニットを走査しない処理は次のとおり
+ *   - CombatBroadphase::buildPairs（攻撃者として敵を探さない）
+ *   - CombatUseCase::executeAutoCombat（交戦中の攻撃者だけを訪問する）
+ *   - MovementUseCase::updateMovements（移動中・戦闘中だけを訪問し、
+ *     眠っているユニットは近くにいるものだけを障害物として加える）
+ *   - CollisionUseCase::resolveOverlaps（起きているユニットの周りだけ）
+ *   陣営別インデックスの構築（眠っていても攻撃・回避の相手になる）と
+ *   影響マップ（存在そのものが入力）は全員を見る。AI の思考は
+ *   AISchedulerUseCase の思考間隔で間引き、視界は動いたユニットだけを
+ *   更新する
+ */
+class ActiveUnitSets : public UnitStateObserver {
+public:
+  /**
+   * @param wakeRadius 近くに敵がいるとみなす距離（射程 + 衝突半径より
+   *        小さい場合は track 時にそこまで広げる）
+   */
+  explicit ActiveUnitSets(float wakeRadius = 6.0f);
+  ~ActiveUnitSets() override;
+
+  ActiveUnitSets(const ActiveUnitSets &) = delete;
+  ActiveUnitSets &operator=(const ActiveUnitSets &) = delete;
+
+  /**
+   * @brief ユニット配列を登録し直し、各集合を現在の状態から作り直す
+   *
+   * 生存ユニットはすべて起きている状態から始める。以前に登録していた
+   * ユニットの通知は解除する。
+   */
+  void track(const std::vector<std::shared_ptr<UnitEntity>> &units);
+
+  /**
+   * @brief 指定サイズのユニット配列に対して登録済みかどうか
+   */
+  bool covers(size_t unitCount) const {
+    return tracked_ && trackedCount_ == unitCount;
+  }
+
+  const std::vector<uint32_t> &getMoving() const { return moving_.members; }
+  const std::vector<uint32_t> &getInCombat() const {
+    return inCombat_.members;
+  }
+  const std::vector<uint32_t> &getAwake() const { return awake_.members; }
+  bool isAwake(size_t unitIndex) const { return awake_.contains(unitIndex); }
+  float getWakeRadius() const { return wakeRadius_; }
+
+  /**
+   * @brief 動いているユニットの近くの敵を起こし、周囲に敵のいない待機中の
+   *        ユニットを眠らせる
+   * @param index track と同じ配列から構築した陣営別インデックス
+   *
+   * 走査するのは移動中・戦闘中・起きているユニットだけ。
+   */
+  void updateSleep(const FactionSpatialIndex &index);
+
+  void onUnitStateChanged(UnitEntity &unit, UnitState previous) override;
+  void onUnitDamaged(UnitEntity &unit) override;
+
+private:
+  // インデックスの集合（要素の配列 + インデックス -> 配列上の位置）
+  struct IndexSet {
+    static constexpr uint32_t kAbsent = UINT32_MAX;
+    std::vector<uint32_t> members;
+    std::vector<uint32_t> slots;
+
+    void reset(size_t capacity);
+    bool contains(size_t index) const {
+      return index < slots.size() && slots[index] != kAbsent;
+    }
+    void insert(uint32_t index);
+    void erase(uint32_t index);
+  };
+
+  // 通知元のユニットの配列上の位置（登録していないユニットなら false）
+  bool findIndex(const UnitEntity &unit, uint32_t &outIndex) const;
+  // 状態に合わせて移動中・戦闘中の所属を更新する（死亡なら全集合から外す）
+  void refresh(uint32_t index);
+  void detachAll();
+
+  float configuredWakeRadius_;
+  float wakeRadius_;
+  std::vector<std::weak_ptr<UnitEntity>> observed_;
+  std::vector<UnitEntity *> unitAt_;
+  std::unordered_map<int, uint32_t> indexById_;
+  size_t trackedCount_ = 0;
+  bool tracked_ = false;
+
+  IndexSet moving_;
+  IndexSet inCombat_;
+  IndexSet awake_;
+  std::vector<uint32_t> fallingAsleep_; // updateSleep の作業領域
+};
+
+#endif // SIMULATION_GAME_ACTIVE_UNIT_SETS_H
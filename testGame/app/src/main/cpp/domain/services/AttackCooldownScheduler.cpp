@@ -0,0 +1,72 @@
+#include "AttackCooldownScheduler.h"
+
+/*
+ * AttackCooldownScheduler.cpp
+ *
+ * The heap is a plain std::vector managed with std::push_heap / std::pop_heap
+ * so that its storage is reused between ticks. Stale entries (cancelled or
+ * rescheduled units) are left in the heap and skipped when they surface; the
+ * heap is compacted when stale entries clearly dominate.
+ */
+#include <algorithm>
+
+namespace {
+// readyTime が小さいものを先頭に置くための比較（std::*_heap は最大ヒープ）
+struct LaterFirst {
+  template <typename Entry>
+  bool operator()(const Entry &lhs, const Entry &rhs) const {
+    return lhs.readyTime > rhs.readyTime;
+  }
+};
+
+constexpr size_t kCompactionFactor = 4;
+constexpr size_t kCompactionMinSize = 64;
+} // namespace
+
+void AttackCooldownScheduler::schedule(int unitId, float readyTime) {
+  float &current =
+      readyTimes_.try_emplace(unitId, kNotScheduled).first->second;
+  scheduledCount_ += current == kNotScheduled ? 1 : 0;
+  current = readyTime;
+  heap_.push_back({readyTime, unitId});
+  std::push_heap(heap_.begin(), heap_.end(), LaterFirst{});
+
+  // 古い要素が溜まり過ぎた場合は有効な登録だけで作り直す
+  if (heap_.size() > kCompactionMinSize &&
+      heap_.size() > scheduledCount_ * kCompactionFactor) {
+    heap_.clear();
+    for (const auto &entry : readyTimes_) {
+      if (entry.second != kNotScheduled) {
+        heap_.push_back({entry.second, entry.first});
+      }
+    }
+    std::make_heap(heap_.begin(), heap_.end(), LaterFirst{});
+  }
+}
+
+void AttackCooldownScheduler::cancel(int unitId) {
+  auto it = readyTimes_.find(unitId);
+  if (it == readyTimes_.end()) {
+    return;
+  }
+  scheduledCount_ -= it->second != kNotScheduled ? 1 : 0;
+  readyTimes_.erase(it);
+}
+
+void AttackCooldownScheduler::clear() {
+  heap_.clear();
+  readyTimes_.clear();
+  scheduledCount_ = 0;
+}
+
+bool AttackCooldownScheduler::isCoolingDown(int unitId, float now) const {
+  auto it = readyTimes_.find(unitId);
+  return it != readyTimes_.end() && now < it->second;
+}
+
+AttackCooldownScheduler::Entry AttackCooldownScheduler::popTop() {
+  std::pop_heap(heap_.begin(), heap_.end(), LaterFirst{});
+  const Entry top = heap_.back();
+  heap_.pop_back();
+  return top;
+}
@@ -0,0 +1,97 @@
+#ifndef SIMULATION_GAME_ATTACK_COOLDOWN_SCHEDULER_H
+#define SIMULATION_GAME_ATTACK_COOLDOWN_SCHEDULER_H
+
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 攻撃クールダウン中のユニットを「次に攻撃可能になる時刻」で管理する
+ * 最小ヒープ
+ *
+ * 設計方針：
+ * - 攻撃直後に readyTime = now + 1 / attackSpeed を1回だけ計算して登録する。
+ *   以降のティックでは除算も全ユニット走査も不要
+ * - ヒープは遅延削除方式。再登録・取り消しで古くなった要素は pop 時に捨てる
+ * - ユニットは ID で識別する（units_ の並び替えや死亡ユニット除去の影響を
+ *   受けない）
+ * - クールダウンが明けても readyTimes_ の要素は消さずに「未登録」の印を
+ *   付ける。攻撃のたびにハッシュのノードを確保し直さない（消すのは cancel
+ *   だけ）
+ *
+ * 責任：
+ * - クールダウン中かどうかの O(1) 判定
+ * - クールダウンが明けたユニットの列挙
+ */
+class AttackCooldownScheduler {
+public:
+  /**
+   * @brief ユニットのクールダウンを登録（既存の登録は上書き）
+   * @param unitId ユニットID
+   * @param readyTime 次に攻撃可能になる時刻（秒）
+   */
+  void schedule(int unitId, float readyTime);
+
+  /**
+   * @brief ユニットのクールダウン登録を取り消す（死亡・リセット時など）
+   */
+  void cancel(int unitId);
+
+  /**
+   * @brief 全登録を破棄する
+   */
+  void clear();
+
+  /**
+   * @brief 指定ユニットがクールダウン中かどうか
+   * @param unitId ユニットID
+   * @param now 現在時刻（秒）
+   */
+  bool isCoolingDown(int unitId, float now) const;
+
+  /**
+   * @brief now までにクールダウンが明けたユニットを取り出す
+   * @param now 現在時刻（秒）
+   * @param onExpired void(int unitId) を受け取る関数
+   *
+   * 取り出したユニットは登録から外れる（以後 isCoolingDown は false）。
+   */
+  template <typename Callback>
+  void popExpired(float now, Callback &&onExpired) {
+    while (!heap_.empty() && heap_.front().readyTime <= now) {
+      const Entry top = popTop();
+      auto it = readyTimes_.find(top.unitId);
+      // 遅延削除: 取り消し済み・再登録済みの古い要素は捨てる
+      if (it == readyTimes_.end() || it->second != top.readyTime) {
+        continue;
+      }
+      it->second = kNotScheduled;
+      --scheduledCount_;
+      onExpired(top.unitId);
+    }
+  }
+
+  /**
+   * @brief クールダウン中として登録されているユニット数
+   */
+  size_t scheduledCount() const { return scheduledCount_; }
+
+private:
+  struct Entry {
+    float readyTime;
+    int unitId;
+  };
+
+  // readyTimes_ で「登録なし」を表す値（どの now に対しても明けている）
+  static constexpr float kNotScheduled =
+      -std::numeric_limits<float>::infinity();
+
+  Entry popTop();
+
+  std::vector<Entry> heap_;                  // readyTime の最小ヒープ
+  std::unordered_map<int, float> readyTimes_; // unitId -> 時刻（または印）
+  size_t scheduledCount_ = 0;                 // 印の付いていない登録の数
+};
+
+#endif // SIMULATION_GAME_ATTACK_COOLDOWN_SCHEDULER_H
@@ -0,0 +1,147 @@
+#include "BatchCombatResolver.h"
+
+/*
+ * BatchCombatResolver.cpp
+ *
+ * Pipeline (one call per tick):
+ * 1. Gather: copy attack power ranges, start-of-tick HP and the counter-range
+ * flag of every request into flat arrays.
+ * 2. Roll: compute direct and counter damage for all requests in plain loops
+ * over those arrays. Randomness comes from a stateless hash, so the loops have
+ * no loop-carried dependency and can be vectorised by the compiler.
+ * 3. Accumulate: walk requests in order, add damage per unit and record the
+ * hit that first brings a unit's HP to zero (deterministic kill attribution).
+ * 4. Write back: apply the summed damage once per damaged unit.
+ */
+#include <algorithm>
+
+namespace {
+// SplitMix64 の最終混合。状態を持たないので要素ごとに独立に計算できる
+inline uint64_t mix64(uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// 乱数値から calculateDamage と同じ分布のダメージを作る
+inline int rollDamage(uint64_t random, int minAttack, int span) {
+  const int power =
+      minAttack + static_cast<int>((random & 0xFFFFFFFFull) %
+                                   static_cast<uint64_t>(span + 1));
+  const float unit = static_cast<float>(random >> 40) * (1.0f / 16777216.0f);
+  const float multiplier =
+      CombatDomainService::kMinDamageMultiplier +
+      (CombatDomainService::kMaxDamageMultiplier -
+       CombatDomainService::kMinDamageMultiplier) *
+          unit;
+  return std::max(1, static_cast<int>(static_cast<float>(power) * multiplier));
+}
+} // namespace
+
+BatchCombatResolver::BatchCombatResolver(uint64_t seed) : seed_(seed) {}
+
+void BatchCombatResolver::resolve(
+    std::vector<std::shared_ptr<UnitEntity>> &units,
+    const std::vector<AttackRequest> &attacks) {
+  const size_t count = attacks.size();
+  const uint64_t tickKey = mix64(seed_ ^ (++tick_ * 0x9E3779B97F4A7C15ull));
+
+  attackerMin_.resize(count);
+  attackerSpan_.resize(count);
+  targetMin_.resize(count);
+  targetSpan_.resize(count);
+  targetStartHp_.resize(count);
+  counterInRange_.resize(count);
+  rollKeys_.resize(count);
+  damage_.resize(count);
+  counterDamage_.resize(count);
+  killedTarget_.assign(count, 0);
+  killedAttacker_.assign(count, 0);
+  kills_.clear();
+
+  // 1. Gather
+  for (size_t i = 0; i < count; ++i) {
+    const UnitEntity &attacker = *units[attacks[i].attackerIndex];
+    const UnitEntity &target = *units[attacks[i].targetIndex];
+    const UnitStats &a = attacker.getStats();
+    const UnitStats &t = target.getStats();
+    attackerMin_[i] = a.getMinAttackPower();
+    attackerSpan_[i] = a.getMaxAttackPower() - a.getMinAttackPower();
+    targetMin_[i] = t.getMinAttackPower();
+    targetSpan_[i] = t.getMaxAttackPower() - t.getMinAttackPower();
+    targetStartHp_[i] = t.getCurrentHp();
+    // 反撃の射程は UnitEntity::isInAttackRange(const UnitEntity&) と同じ定義
+    counterInRange_[i] = target.isInAttackRange(attacker) ? 1 : 0;
+    rollKeys_[i] = (static_cast<uint64_t>(static_cast<uint32_t>(
+                        attacker.getId()))
+                    << 32) |
+                   static_cast<uint32_t>(target.getId());
+  }
+
+  // 2. Roll（直撃と反撃。配列演算のみ）
+  for (size_t i = 0; i < count; ++i) {
+    const uint64_t key = mix64(tickKey ^ rollKeys_[i]);
+    damage_[i] = rollDamage(key, attackerMin_[i], attackerSpan_[i]);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    const uint64_t key = mix64(tickKey ^ ~rollKeys_[i]);
+    const int counter = rollDamage(key, targetMin_[i], targetSpan_[i]);
+    // 直撃単体で倒れなかった、かつ射程内の対象だけが反撃する
+    const bool counters =
+        counterInRange_[i] != 0 && targetStartHp_[i] - damage_[i] > 0;
+    counterDamage_[i] = counters ? counter : 0;
+  }
+
+  // 3. Accumulate（要求順に合算し、HP が 0 に達した一撃をとどめとする）
+  if (startHp_.size() < units.size()) {
+    startHp_.resize(units.size(), 0);
+    totalDamage_.resize(units.size(), 0);
+    touchedTick_.resize(units.size(), 0);
+  }
+  touchedUnits_.clear();
+  auto touch = [&](uint32_t index) {
+    if (touchedTick_[index] == tick_) {
+      return;
+    }
+    touchedTick_[index] = tick_;
+    touchedUnits_.push_back(index);
+    startHp_[index] = units[index]->getStats().getCurrentHp();
+    totalDamage_[index] = 0;
+  };
+  auto hit = [&](uint32_t victim, int amount) {
+    const bool wasAlive = startHp_[victim] - totalDamage_[victim] > 0;
+    totalDamage_[victim] += amount;
+    return wasAlive && startHp_[victim] - totalDamage_[victim] <= 0;
+  };
+  for (size_t i = 0; i < count; ++i) {
+    const uint32_t a = attacks[i].attackerIndex;
+    const uint32_t t = attacks[i].targetIndex;
+    touch(a);
+    touch(t);
+    if (hit(t, damage_[i])) {
+      killedTarget_[i] = 1;
+      kills_.push_back({t, a, static_cast<uint32_t>(i), false});
+    }
+    if (counterDamage_[i] > 0 && hit(a, counterDamage_[i])) {
+      killedAttacker_[i] = 1;
+      kills_.push_back({a, t, static_cast<uint32_t>(i), true});
+    }
+  }
+
+  // 4. Write back（被弾ユニットごとに1回だけ）
+  for (uint32_t index : touchedUnits_) {
+    if (totalDamage_[index] > 0) {
+      units[index]->takeDamage(totalDamage_[index]);
+    }
+  }
+}
+
+CombatDomainService::CombatResult
+BatchCombatResolver::resultFor(size_t attackIndex) const {
+  if (attackIndex >= damage_.size()) {
+    return CombatDomainService::CombatResult();
+  }
+  return CombatDomainService::CombatResult(damage_[attackIndex],
+                                           killedTarget_[attackIndex] != 0,
+                                           killedAttacker_[attackIndex] != 0);
+}
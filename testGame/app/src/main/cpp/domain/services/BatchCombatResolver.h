@@ -0,0 +1,117 @@
+#ifndef SIMULATION_GAME_BATCH_COMBAT_RESOLVER_H
+#define SIMULATION_GAME_BATCH_COMBAT_RESOLVER_H
+
+#include "../entities/UnitEntity.h"
+#include "CombatDomainService.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 1ティック分の攻撃要求（インデックスはユニット配列上の位置）
+ */
+struct AttackRequest {
+  uint32_t attackerIndex;
+  uint32_t targetIndex;
+};
+
+/**
+ * @brief バッチ解決で発生した撃破イベント
+ */
+struct KillEvent {
+  uint32_t victimIndex; // 倒されたユニット
+  uint32_t killerIndex; // とどめを刺したユニット
+  uint32_t attackIndex; // とどめとなった攻撃要求の位置
+  bool byCounter;       // 反撃によるとどめか
+};
+
+/**
+ * @brief 1ティック分の攻撃をまとめて解決する戦闘リゾルバ
+ *
+ * 設計方針：
+ * - 攻撃要求を SoA 配列（攻撃力・HP・反撃可否）に集め、ダメージ乱数・
+ *   反撃判定を分岐の少ない配列演算で一括計算する（自動ベクトル化しやすい）
+ * - 同時攻撃の扱い：すべての攻撃はティック開始時点の HP を見て判定する。
+ *   反撃は「その攻撃単体で倒されなかった」対象だけが行う。ダメージは
+ *   ユニットごとに合算してから1回だけ書き戻すため、UnitStats の再構築も
+ *   被弾ユニットあたり1回で済む
+ * - 乱数は (シード, ティック, 攻撃者ID, 対象ID) のハッシュから作るため、
+ *   同じ入力なら同じ結果になる（処理順やスレッドに依存しない）
+ * - 撃破は、攻撃要求の並び順で累積ダメージが HP に達した一撃を
+ *   とどめとして記録する
+ *
+ * 注意：
+ * - 攻撃要求の妥当性（射程・陣営・状態・クールダウン）は呼び出し側で検証済み
+ *   であること
+ * - 結果（getDamageDealt 等）は次の resolve 呼び出しまで有効
+ */
+class BatchCombatResolver {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param seed 乱数シード（リプレイやテストで結果を固定したい場合に指定）
+   */
+  explicit BatchCombatResolver(uint64_t seed = 0x9E3779B97F4A7C15ull);
+
+  /**
+   * @brief 攻撃要求をまとめて解決し、ユニットにダメージを反映する
+   * @param units 対象ユニット配列（インデックスの基準）
+   * @param attacks このティックの攻撃要求
+   */
+  void resolve(std::vector<std::shared_ptr<UnitEntity>> &units,
+               const std::vector<AttackRequest> &attacks);
+
+  /**
+   * @brief 攻撃要求ごとの与ダメージ
+   */
+  const std::vector<int> &getDamageDealt() const { return damage_; }
+
+  /**
+   * @brief 攻撃要求ごとの反撃ダメージ（反撃なしは 0）
+   */
+  const std::vector<int> &getCounterDamage() const { return counterDamage_; }
+
+  /**
+   * @brief このティックに発生した撃破（攻撃要求の順）
+   */
+  const std::vector<KillEvent> &getKills() const { return kills_; }
+
+  /**
+   * @brief 攻撃要求1件分の結果を CombatResult 形式で取得（イベント通知用）
+   */
+  CombatDomainService::CombatResult resultFor(size_t attackIndex) const;
+
+  /**
+   * @brief これまでに解決したティック数
+   */
+  uint64_t getTick() const { return tick_; }
+
+private:
+  uint64_t seed_;
+  uint64_t tick_ = 0;
+
+  // 攻撃要求ごとの SoA（gather で埋める）
+  std::vector<int> attackerMin_;
+  std::vector<int> attackerSpan_;
+  std::vector<int> targetMin_;
+  std::vector<int> targetSpan_;
+  std::vector<int> targetStartHp_;
+  std::vector<uint8_t> counterInRange_;
+  std::vector<uint64_t> rollKeys_;
+
+  // 計算結果
+  std::vector<int> damage_;
+  std::vector<int> counterDamage_;
+  std::vector<uint8_t> killedTarget_;   // この攻撃がとどめになったか
+  std::vector<uint8_t> killedAttacker_; // この攻撃の反撃がとどめになったか
+  std::vector<KillEvent> kills_;
+
+  // ユニットごとの累積（ユニット配列サイズ、触れた要素だけ使用）
+  std::vector<int> startHp_;
+  std::vector<int> totalDamage_;
+  std::vector<uint64_t> touchedTick_; // 最後に触れたティック（重複排除用）
+  std::vector<uint32_t> touchedUnits_;
+};
+
+#endif // SIMULATION_GAME_BATCH_COMBAT_RESOLVER_H
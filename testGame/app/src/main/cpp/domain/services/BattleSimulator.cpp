@@ -0,0 +1,115 @@
+#include "BattleSimulator.h"
+
+/*
+ * BattleSimulator.cpp
+ *
+ * Event-driven skirmish model:
+ * - Every combatant attacks once per 1 / attackSpeed seconds, with a random
+ * initial phase so that groups do not fire in lock-step.
+ * - Pending attacks live in a min-heap keyed by time. The earliest event is
+ * popped; events of combatants that died meanwhile are discarded lazily.
+ * - The attacker hits a random living enemy; if the enemy survives it
+ * counter-attacks, mirroring CombatDomainService::executeCombat.
+ * - Dead combatants are swap-removed from their side's alive list in O(1).
+ *
+ * The buffers are kept between runs, so repeated runs allocate nothing once
+ * warmed up.
+ */
+#include "CombatDomainService.h"
+#include <algorithm>
+
+namespace {
+// std::*_heap は最大ヒープなので、時刻の遅いものを「小さい」とみなす
+struct LaterFirst {
+  template <typename Event>
+  bool operator()(const Event &lhs, const Event &rhs) const {
+    return lhs.time > rhs.time;
+  }
+};
+} // namespace
+
+BattleSimulationResult
+BattleSimulator::run(const std::vector<UnitStats> &sideA,
+                     const std::vector<UnitStats> &sideB, std::mt19937 &rng) {
+  std::uniform_real_distribution<float> phase(0.0f, 1.0f);
+
+  combatants_.clear();
+  alive_[0].clear();
+  alive_[1].clear();
+  aliveSlot_.clear();
+  events_.clear();
+  const std::vector<UnitStats> *sides[2] = {&sideA, &sideB};
+  for (int side = 0; side < 2; ++side) {
+    for (const UnitStats &stats : *sides[side]) {
+      if (!stats.isAlive()) {
+        continue;
+      }
+      const uint32_t index = static_cast<uint32_t>(combatants_.size());
+      const float interval = 1.0f / stats.getAttackSpeed();
+      aliveSlot_.push_back(static_cast<uint32_t>(alive_[side].size()));
+      alive_[side].push_back(index);
+      combatants_.push_back({&stats, stats.getCurrentHp(), side, interval});
+      events_.push_back({interval * phase(rng), index});
+    }
+  }
+  std::make_heap(events_.begin(), events_.end(), LaterFirst{});
+
+  auto removeDead = [&](uint32_t index) {
+    auto &list = alive_[combatants_[index].side];
+    const uint32_t slot = aliveSlot_[index];
+    list[slot] = list.back();
+    aliveSlot_[list[slot]] = slot;
+    list.pop_back();
+  };
+
+  float now = 0.0f;
+  while (!alive_[0].empty() && !alive_[1].empty() && !events_.empty()) {
+    // 次に攻撃するユニット（最も早く攻撃可能になる生存者）
+    std::pop_heap(events_.begin(), events_.end(), LaterFirst{});
+    const AttackEvent event = events_.back();
+    events_.pop_back();
+    Combatant &attacker = combatants_[event.combatant];
+    if (attacker.hp <= 0) {
+      continue; // 既に倒れている（遅延削除）
+    }
+    now = event.time;
+    if (now >= kMaxBattleSeconds) {
+      break;
+    }
+
+    const auto &enemies = alive_[1 - attacker.side];
+    std::uniform_int_distribution<size_t> pick(0, enemies.size() - 1);
+    const uint32_t targetIndex = enemies[pick(rng)];
+    Combatant &target = combatants_[targetIndex];
+
+    target.hp -= CombatDomainService::calculateDamage(*attacker.stats,
+                                                      *target.stats, rng);
+    if (target.hp <= 0) {
+      removeDead(targetIndex);
+    } else {
+      // 生き残った対象の反撃
+      attacker.hp -= CombatDomainService::calculateDamage(*target.stats,
+                                                          *attacker.stats, rng);
+      if (attacker.hp <= 0) {
+        removeDead(event.combatant);
+        continue;
+      }
+    }
+
+    events_.push_back({event.time + attacker.attackInterval, event.combatant});
+    std::push_heap(events_.begin(), events_.end(), LaterFirst{});
+  }
+
+  BattleSimulationResult result;
+  result.survivorsA = static_cast<int>(alive_[0].size());
+  result.survivorsB = static_cast<int>(alive_[1].size());
+  result.duration = now;
+  if (result.survivorsA > 0 && result.survivorsB == 0) {
+    result.winner = 0;
+  } else if (result.survivorsB > 0 && result.survivorsA == 0) {
+    result.winner = 1;
+  } else {
+    result.winner = -1;
+  }
+  return result;
+}
@@ -0,0 +1,71 @@
+#ifndef SIMULATION_GAME_BATTLE_SIMULATOR_H
+#define SIMULATION_GAME_BATTLE_SIMULATOR_H
+
+#include "../value_objects/UnitStats.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @brief 1回分の戦闘シミュレーション結果
+ */
+struct BattleSimulationResult {
+  int winner;      // 0 = 陣営A, 1 = 陣営B, -1 = 引き分け（時間切れ）
+  int survivorsA;  // 陣営Aの生存数
+  int survivorsB;  // 陣営Bの生存数
+  float duration;  // 決着までの時間（秒）
+};
+
+/**
+ * @brief 2つのユニット集団の戦闘を1回だけ模擬する
+ *
+ * 設計方針：
+ * - 入力は UnitStats のコピー（値オブジェクト）のみ。UnitEntity や units_
+ *   には一切触れないため、ライブ状態を変更しない
+ * - 攻撃の解決は CombatDomainService::executeCombat と同じ規則
+ *   （攻撃 → 生き残った対象が反撃）。集団同士が交戦済みである前提で
+ *   射程と移動は省略する
+ * - 乱数は呼び出し側のストリームだけを使う。インスタンスごとに作業領域を
+ *   持つので、スレッドごとに1インスタンスを使えば並列に実行できる
+ *
+ * 注意：
+ * - 1インスタンスを複数スレッドから同時に使ってはならない
+ */
+class BattleSimulator {
+public:
+  /**
+   * @brief 決着がつかない場合に打ち切る模擬時間（秒）
+   */
+  static constexpr float kMaxBattleSeconds = 300.0f;
+
+  /**
+   * @brief 戦闘を1回模擬する
+   * @param sideA 陣営Aのユニット
+   * @param sideB 陣営Bのユニット
+   * @param rng このシミュレーション専用の乱数ストリーム
+   * @return 勝敗と生存数
+   */
+  BattleSimulationResult run(const std::vector<UnitStats> &sideA,
+                             const std::vector<UnitStats> &sideB,
+                             std::mt19937 &rng);
+
+private:
+  struct Combatant {
+    const UnitStats *stats;
+    int hp;
+    int side;
+    float attackInterval;
+  };
+
+  struct AttackEvent {
+    float time;
+    uint32_t combatant;
+  };
+
+  std::vector<Combatant> combatants_;
+  std::vector<uint32_t> alive_[2]; // 陣営ごとの生存者（combatants_ の位置）
+  std::vector<uint32_t> aliveSlot_; // combatants_ -> alive_ 内の位置
+  std::vector<AttackEvent> events_; // 次の攻撃時刻の最小ヒープ
+};
+
+#endif // SIMULATION_GAME_BATTLE_SIMULATOR_H
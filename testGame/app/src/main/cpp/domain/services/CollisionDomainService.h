@@ -82,6 +82,9 @@ public:
    * @param excludeUnit 除外ユニット
    * @param movingRadius 移動ユニットの半径（合算して判定）
    * @return 接触が見つかった場合 true を返す
+   *
+   * 全ユニットとの総当たりで、他のユニットは止まっているものとして解く。
+   * ティック単位の移動の判定には SweptCollision（sort-and-sweep）を使う。
    */
   static bool findFirstContactOnPath(
       const Position &start, const Position &end,
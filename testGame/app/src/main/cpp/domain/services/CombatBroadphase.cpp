@@ -0,0 +1,171 @@
+#include "CombatBroadphase.h"
+
+/*
+ * CombatBroadphase.cpp
+ *
+ * Algorithm:
+ * 1. Snapshot position / range / faction of every unit into flat arrays.
+ * 2. Build a FactionSpatialIndex (one SpatialHashGrid per faction, alive units
+ * only) whose cell size equals the largest possible effective range
+ * (max attackRange + max collisionRadius), so each attacker only inspects its
+ * 3x3 neighbourhood in each hostile grid.
+ * 3. For each alive attacker, query the hostile grids with that conservative
+ * radius and keep enemies that satisfy the exact per-pair test
+ * distanceSq <= (attackRange + target.collisionRadius)^2.
+ * 4. Optionally, run the attacker's candidates through one
+ * LineOfSight::visibilityBatch call and drop pairs blocked by terrain. Tile
+ * indices are snapshotted in step 1, so repeated pairs are served from the
+ * LOS cache without walking the grid again.
+ *
+ * Steps 1-2 (rebuildIndex) and 3-4 (buildPairs) can be split so the caller
+ * can put units to sleep with the fresh index first. A sleeping unit has no
+ * enemy within the wake radius, which covers every effective range, so
+ * skipping it as an attacker yields exactly the pairs of a full scan.
+ *
+ * Pairs are emitted attacker by attacker, and each attacker's slice is sorted by
+ * target index so that "first enemy in range" keeps the container-order
+ * semantics the use-cases relied on before.
+ */
+#include "ActiveUnitSets.h"
+#include <algorithm>
+
+void CombatBroadphase::rebuild(
+    const std::vector<std::shared_ptr<UnitEntity>> &units) {
+  rebuildIndex(units);
+  buildPairs(nullptr);
+}
+
+void CombatBroadphase::rebuildIndex(
+    const std::vector<std::shared_ptr<UnitEntity>> &units) {
+  built_ = false;
+  const size_t count = units.size();
+  xs_.resize(count);
+  ys_.resize(count);
+  attackRanges_.resize(count);
+  collisionRadii_.resize(count);
+  factions_.resize(count);
+  alive_.resize(count);
+  tiles_.resize(count);
+
+  float maxAttackRange = 0.0f;
+  float maxCollisionRadius = 0.0f;
+  for (size_t i = 0; i < count; ++i) {
+    const auto &unit = units[i];
+    const bool alive = unit && unit->getStats().getCurrentHp() > 0;
+    alive_[i] = alive ? 1 : 0;
+    if (!unit) {
+      xs_[i] = ys_[i] = 0.0f;
+      attackRanges_[i] = collisionRadii_[i] = 0.0f;
+      factions_[i] = 0;
+      tiles_[i] = LineOfSight::kOutsideMap;
+      continue;
+    }
+    const Position &pos = unit->getPosition();
+    const UnitStats &stats = unit->getStats();
+    xs_[i] = pos.getX();
+    ys_[i] = pos.getY();
+    attackRanges_[i] = stats.getAttackRange();
+    collisionRadii_[i] = stats.getCollisionRadius();
+    factions_[i] = unit->getFaction();
+    tiles_[i] = lineOfSight_ ? lineOfSight_->tileIndexAt(pos)
+                             : LineOfSight::kOutsideMap;
+    if (alive) {
+      maxAttackRange = std::max(maxAttackRange, attackRanges_[i]);
+      maxCollisionRadius = std::max(maxCollisionRadius, collisionRadii_[i]);
+    }
+  }
+
+  const float maxEffectiveRange = maxAttackRange + maxCollisionRadius;
+  factionIndex_.setCellSize(maxEffectiveRange);
+  factionIndex_.build(xs_.data(), ys_.data(), factions_.data(), alive_.data(),
+                      count);
+  maxCollisionRadius_ = maxCollisionRadius;
+  indexedUnitCount_ = count;
+}
+
+void CombatBroadphase::buildPairs(const ActiveUnitSets *activeUnitSets) {
+  const size_t count = indexedUnitCount_;
+  const float maxCollisionRadius = maxCollisionRadius_;
+  const bool awakeOnly = activeUnitSets && activeUnitSets->covers(count);
+  pairs_.clear();
+  engagedAttackers_.clear();
+  attackerOffsets_.resize(count + 1);
+  scannedAttackerCount_ = 0;
+
+  for (size_t a = 0; a < count; ++a) {
+    attackerOffsets_[a] = static_cast<uint32_t>(pairs_.size());
+    if (!alive_[a] || (awakeOnly && !activeUnitSets->isAwake(a))) {
+      continue;
+    }
+    ++scannedAttackerCount_;
+
+    const float attackRange = attackRanges_[a];
+    const int attackerFaction = factions_[a];
+    const size_t sliceBegin = pairs_.size();
+
+    // 自陣営のグリッドは走査しないため、味方・自分自身・死亡ユニットの
+    // 除外判定は不要
+    factionIndex_.forEachEnemyInRadius(
+        attackerFaction, xs_[a], ys_[a], attackRange + maxCollisionRadius,
+        [&](uint32_t t, float distanceSq) {
+          const float effectiveRange = attackRange + collisionRadii_[t];
+          if (distanceSq <= effectiveRange * effectiveRange) {
+            pairs_.push_back({static_cast<uint32_t>(a), t, distanceSq});
+          }
+        });
+
+    if (lineOfSight_) {
+      filterByLineOfSight(sliceBegin);
+    }
+    if (pairs_.size() == sliceBegin) {
+      continue;
+    }
+    std::sort(pairs_.begin() + sliceBegin, pairs_.end(),
+              [](const EngagementPair &lhs, const EngagementPair &rhs) {
+                return lhs.targetIndex < rhs.targetIndex;
+              });
+    engagedAttackers_.push_back(static_cast<uint32_t>(a));
+  }
+  attackerOffsets_[count] = static_cast<uint32_t>(pairs_.size());
+
+  builtUnitCount_ = count;
+  built_ = true;
+}
+
+void CombatBroadphase::filterByLineOfSight(size_t sliceBegin) {
+  const size_t sliceSize = pairs_.size() - sliceBegin;
+  if (sliceSize == 0) {
+    return;
+  }
+  losFromTiles_.resize(sliceSize);
+  losToTiles_.resize(sliceSize);
+  losVisibility_.resize(sliceSize);
+  for (size_t i = 0; i < sliceSize; ++i) {
+    const EngagementPair &pair = pairs_[sliceBegin + i];
+    losFromTiles_[i] = tiles_[pair.attackerIndex];
+    losToTiles_[i] = tiles_[pair.targetIndex];
+  }
+  lineOfSight_->visibilityBatch(losFromTiles_.data(), losToTiles_.data(),
+                                sliceSize, losVisibility_.data());
+
+  size_t kept = sliceBegin;
+  for (size_t i = 0; i < sliceSize; ++i) {
+    if (losVisibility_[i] < LineOfSight::kBlockedThreshold) {
+      continue;
+    }
+    pairs_[kept] = pairs_[sliceBegin + i];
+    pairs_[kept].visibility = losVisibility_[i];
+    ++kept;
+  }
+  pairs_.resize(kept);
+}
+
+CombatBroadphase::PairRange
+CombatBroadphase::pairsForAttacker(size_t attackerIndex) const {
+  if (!built_ || attackerIndex >= builtUnitCount_) {
+    return {nullptr, nullptr};
+  }
+  const EngagementPair *base = pairs_.data();
+  return {base + attackerOffsets_[attackerIndex],
+          base + attackerOffsets_[attackerIndex + 1]};
+}
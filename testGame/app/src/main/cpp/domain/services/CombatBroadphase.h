@@ -0,0 +1,179 @@
+#ifndef SIMULATION_GAME_COMBAT_BROADPHASE_H
+#define SIMULATION_GAME_COMBAT_BROADPHASE_H
+
+#include "../entities/UnitEntity.h"
+#include "FactionSpatialIndex.h"
+#include "LineOfSight.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class ActiveUnitSets;
+
+/**
+ * @brief 射程内にいる (攻撃者, 対象) の組
+ *
+ * インデックスは CombatBroadphase::rebuild に渡したユニット配列上の位置。
+ */
+struct EngagementPair {
+  uint32_t attackerIndex; // 攻撃側ユニットのインデックス
+  uint32_t targetIndex;   // 射程内の敵ユニットのインデックス
+  float distanceSq;       // 中心間距離の二乗（sqrt 不要）
+  float visibility = 1.0f; // 地形による見通し（LineOfSight 未設定時は 1）
+};
+
+/**
+ * @brief 1ティックに1回だけ「射程内の敵」を求める戦闘ブロードフェーズ
+ *
+ * 設計方針：
+ * - これまで Renderer / CombatUseCase / MovementUseCase がそれぞれ O(N²)
+ *   で行っていた射程判定を、空間ハッシュによる 1 パスに集約する（約 N·k）
+ * - 結果は攻撃者インデックス順に並んだペア配列（CSR 形式）として保持し、
+ *   各消費者は pairsForAttacker() で自分の範囲だけを読む
+ * - 射程の定義は UnitEntity::isInAttackRange(const UnitEntity&) と同じ
+ *   （攻撃者の射程 + 対象の衝突半径）。生存している異陣営ユニットのみ対象
+ * - 空間インデックスは陣営別（FactionSpatialIndex）。味方は走査しない
+ * - LineOfSight が設定されていれば、射程内の候補を攻撃者ごとにまとめて
+ *   視線判定し、地形に遮られたペアを除外する
+ * - 眠っているユニット（ActiveUnitSets）は wakeRadius（射程 + 衝突半径
+ *   以上）内に敵がいないので、攻撃者としては探索しない。対象としては
+ *   インデックスに残す
+ *
+ * 注意：
+ * - インデックスは rebuild 時点のユニット配列に対するもの。配列を変更
+ *   （死亡ユニット除去など）した後は、次の rebuild まで参照してはならない
+ * - 位置は rebuild 時点のスナップショット。同ティック内の移動は反映されない
+ */
+class CombatBroadphase {
+public:
+  /**
+   * @brief 攻撃者1体分のペア範囲（連続領域への借用ポインタ）
+   */
+  struct PairRange {
+    const EngagementPair *first;
+    const EngagementPair *last;
+
+    const EngagementPair *begin() const { return first; }
+    const EngagementPair *end() const { return last; }
+    bool empty() const { return first == last; }
+  };
+
+  CombatBroadphase() = default;
+
+  /**
+   * @brief 視線判定を設定する（nullptr で無効化、次回 rebuild から有効）
+   *
+   * 所有権は呼び出し側が持つ。
+   */
+  void setLineOfSight(LineOfSight *lineOfSight) { lineOfSight_ = lineOfSight; }
+
+  /**
+   * @brief ユニット配列からペアリストを再構築する
+   * @param units 対象ユニット配列（インデックスの基準）
+   *
+   * rebuildIndex と buildPairs(nullptr) を続けて呼ぶのと同じ。
+   */
+  void rebuild(const std::vector<std::shared_ptr<UnitEntity>> &units);
+
+  /**
+   * @brief 位置のスナップショットと陣営別インデックスだけを作り直す
+   *
+   * ペアリストは次の buildPairs まで無効（covers() は false）。
+   * ActiveUnitSets::updateSleep をペアの構築より前に行うために使う。
+   */
+  void rebuildIndex(const std::vector<std::shared_ptr<UnitEntity>> &units);
+
+  /**
+   * @brief rebuildIndex で作ったインデックスからペアリストを作る
+   * @param activeUnitSets 眠っている攻撃者を飛ばすためのアクティブ集合
+   *        （nullptr か、配列を覆っていなければ全員を探索する）。
+   *        同じインデックスで updateSleep を済ませておくこと
+   */
+  void buildPairs(const ActiveUnitSets *activeUnitSets = nullptr);
+
+  /**
+   * @brief 直前の buildPairs で敵を探した攻撃者の数（計測用）
+   */
+  size_t getScannedAttackerCount() const { return scannedAttackerCount_; }
+
+  /**
+   * @brief 直前の rebuildIndex での生存ユニットの最大衝突半径
+   */
+  float getMaxCollisionRadius() const { return maxCollisionRadius_; }
+
+  /**
+   * @brief 全ペア（攻撃者インデックス昇順、同一攻撃者内は対象インデックス昇順）
+   */
+  const std::vector<EngagementPair> &getPairs() const { return pairs_; }
+
+  /**
+   * @brief 指定攻撃者のペア範囲を取得する
+   * @param attackerIndex rebuild 時のユニット配列上のインデックス
+   */
+  PairRange pairsForAttacker(size_t attackerIndex) const;
+
+  /**
+   * @brief 射程内に1体以上の敵がいる攻撃者のインデックス（昇順）
+   *
+   * 交戦していないユニットを走査せずに済ませるための索引。
+   */
+  const std::vector<uint32_t> &getEngagedAttackers() const {
+    return engagedAttackers_;
+  }
+
+  /**
+   * @brief 指定サイズのユニット配列に対して構築済みかどうか
+   *
+   * 配列の要素数が変わっていればインデックスが無効なので false を返す。
+   * 消費者はこれが false の場合に従来の全探索へフォールバックする。
+   */
+  bool covers(size_t unitCount) const {
+    return built_ && builtUnitCount_ == unitCount;
+  }
+
+  /**
+   * @brief 構築結果を破棄する（covers() が false を返すようになる）
+   */
+  void invalidate() { built_ = false; }
+
+  /**
+   * @brief rebuild 時に構築した陣営別インデックス
+   *
+   * 最近傍の敵探索など、ペアリスト以外の敵クエリに使う。インデックスの
+   * 有効期間はペアリストと同じ（covers() が true の間のみ）。
+   */
+  const FactionSpatialIndex &getFactionIndex() const { return factionIndex_; }
+
+private:
+  // 攻撃者1体分のペア（pairs_ の sliceBegin 以降）から視線の通らないものを除く
+  void filterByLineOfSight(size_t sliceBegin);
+
+  FactionSpatialIndex factionIndex_;
+  LineOfSight *lineOfSight_ = nullptr;
+
+  // rebuild 時に収集する位置・射程のスナップショット（SoA）
+  std::vector<float> xs_;
+  std::vector<float> ys_;
+  std::vector<float> attackRanges_;
+  std::vector<float> collisionRadii_;
+  std::vector<int> factions_;
+  std::vector<uint8_t> alive_;
+  std::vector<int32_t> tiles_; // LineOfSight 用のタイル番号
+
+  // 視線のバッチ判定用の作業領域
+  std::vector<int32_t> losFromTiles_;
+  std::vector<int32_t> losToTiles_;
+  std::vector<float> losVisibility_;
+
+  std::vector<EngagementPair> pairs_;
+  std::vector<uint32_t> attackerOffsets_; // 攻撃者ごとの開始位置（+1 要素）
+  std::vector<uint32_t> engagedAttackers_; // ペアを1つ以上持つ攻撃者
+
+  float maxCollisionRadius_ = 0.0f;
+  size_t indexedUnitCount_ = 0;
+  size_t scannedAttackerCount_ = 0;
+  size_t builtUnitCount_ = 0;
+  bool built_ = false;
+};
+
+#endif // SIMULATION_GAME_COMBAT_BROADPHASE_H
@@ -22,7 +22,8 @@
 // 静的メンバの初期化
 std::random_device CombatDomainService::rd_;
 std::mt19937 CombatDomainService::gen_(CombatDomainService::rd_());
-std::uniform_real_distribution<float> CombatDomainService::dis_(0.8f, 1.2f);
+std::uniform_real_distribution<float>
+    CombatDomainService::dis_(kMinDamageMultiplier, kMaxDamageMultiplier);
 
 CombatDomainService::CombatResult
 CombatDomainService::executeCombat(UnitEntity &attacker, UnitEntity &target) {
@@ -84,6 +85,19 @@ int CombatDomainService::calculateDamage(const UnitStats &attackerStats,
   return std::max(1, static_cast<int>(baseDamage));
 }
 
+int CombatDomainService::calculateDamage(const UnitStats &attackerStats,
+                                         const UnitStats & /* targetStats */,
+                                         std::mt19937 &rng) {
+  // Same formula as above, but every random draw comes from the caller's
+  // stream so that parallel simulations never share RNG state.
+  std::uniform_int_distribution<int> power(attackerStats.getMinAttackPower(),
+                                           attackerStats.getMaxAttackPower());
+  std::uniform_real_distribution<float> multiplier(kMinDamageMultiplier,
+                                                   kMaxDamageMultiplier);
+  float baseDamage = power(rng) * multiplier(rng);
+  return std::max(1, static_cast<int>(baseDamage));
+}
+
 bool CombatDomainService::isInAttackRange(const UnitEntity &attacker,
                                           const UnitEntity &target) {
 
@@ -19,6 +19,12 @@
  */
 class CombatDomainService {
 public:
+  /**
+   * @brief ダメージ計算で攻撃力に掛ける乱数倍率の範囲
+   */
+  static constexpr float kMinDamageMultiplier = 0.8f;
+  static constexpr float kMaxDamageMultiplier = 1.2f;
+
   /**
    * @brief 攻撃力をmin-max範囲でランダム取得
    */
@@ -55,6 +61,19 @@ public:
   static int calculateDamage(const UnitStats &attackerStats,
                              const UnitStats &targetStats);
 
+  /**
+   * @brief 呼び出し側の乱数ストリームでダメージを計算
+   * @param attackerStats 攻撃側のステータス
+   * @param targetStats 防御側のステータス（将来の防御力実装用）
+   * @param rng 乱数生成器（スレッドごと・シミュレーションごとに独立させる）
+   * @return 与えるダメージ
+   *
+   * 共有の乱数状態に触れないため、複数スレッドから同時に呼び出せる。
+   * 分布は calculateDamage(attackerStats, targetStats) と同じ。
+   */
+  static int calculateDamage(const UnitStats &attackerStats,
+                             const UnitStats &targetStats, std::mt19937 &rng);
+
   /**
    * @brief 攻撃範囲内かどうかを判定
    * @param attacker 攻撃側ユニット
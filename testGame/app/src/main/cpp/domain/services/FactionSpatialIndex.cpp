@@ -0,0 +1,111 @@
+#include "FactionSpatialIndex.h"
+
+/*
+ * FactionSpatialIndex.cpp
+ *
+ * Build strategy:
+ * - Alive points are appended to the partition of their faction (partitions
+ * are created on first sight of a faction id and kept for later builds).
+ * - Each partition then rebuilds its own SpatialHashGrid over its subset,
+ * passing the original array indices so that queries report positions in the
+ * caller's array.
+ * - Partitions of factions that disappeared keep their buffers but are moved
+ * past activePartitions_, so re-appearing factions reuse them.
+ */
+#include <utility>
+
+void FactionSpatialIndex::build(const float *xs, const float *ys,
+                                const int *factions, const uint8_t *alive,
+                                size_t count) {
+  activePartitions_ = 0;
+  for (auto &partition : partitions_) {
+    partition.xs.clear();
+    partition.ys.clear();
+    partition.indices.clear();
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    if (!alive[i]) {
+      continue;
+    }
+    Partition &partition = acquirePartition(factions[i]);
+    partition.xs.push_back(xs[i]);
+    partition.ys.push_back(ys[i]);
+    partition.indices.push_back(static_cast<uint32_t>(i));
+  }
+
+  for (size_t p = 0; p < activePartitions_; ++p) {
+    Partition &partition = partitions_[p];
+    partition.grid.setCellSize(cellSize_);
+    partition.grid.build(partition.xs.data(), partition.ys.data(),
+                         partition.indices.size(), partition.indices.data());
+  }
+}
+
+bool FactionSpatialIndex::findNearestEnemy(int faction, float x, float y,
+                                           float maxRadius, uint32_t &outIndex,
+                                           float &outDistanceSq) const {
+  bool found = false;
+  forEachEnemyInRadius(faction, x, y, maxRadius,
+                       [&](uint32_t index, float distanceSq) {
+                         if (!found || distanceSq < outDistanceSq ||
+                             (distanceSq == outDistanceSq &&
+                              index < outIndex)) {
+                           outIndex = index;
+                           outDistanceSq = distanceSq;
+                           found = true;
+                         }
+                       });
+  return found;
+}
+
+size_t FactionSpatialIndex::countInFaction(int faction) const {
+  const Partition *partition = findPartition(faction);
+  return partition ? partition->indices.size() : 0;
+}
+
+size_t FactionSpatialIndex::countEnemiesOf(int faction) const {
+  size_t total = 0;
+  for (size_t p = 0; p < activePartitions_; ++p) {
+    if (partitions_[p].faction != faction) {
+      total += partitions_[p].indices.size();
+    }
+  }
+  return total;
+}
+
+const FactionSpatialIndex::Partition *
+FactionSpatialIndex::findPartition(int faction) const {
+  for (size_t p = 0; p < activePartitions_; ++p) {
+    if (partitions_[p].faction == faction) {
+      return &partitions_[p];
+    }
+  }
+  return nullptr;
+}
+
+FactionSpatialIndex::Partition &
+FactionSpatialIndex::acquirePartition(int faction) {
+  for (size_t p = 0; p < activePartitions_; ++p) {
+    if (partitions_[p].faction == faction) {
+      return partitions_[p];
+    }
+  }
+  // 非アクティブなパーティションのうち同じ陣営のものがあれば優先して再利用
+  size_t slot = activePartitions_;
+  for (size_t p = activePartitions_; p < partitions_.size(); ++p) {
+    if (partitions_[p].faction == faction) {
+      slot = p;
+      break;
+    }
+  }
+  if (slot == partitions_.size()) {
+    partitions_.emplace_back();
+  }
+  if (slot != activePartitions_) {
+    std::swap(partitions_[slot], partitions_[activePartitions_]);
+  }
+  Partition &partition = partitions_[activePartitions_++];
+  partition.faction = faction;
+  return partition;
+}
@@ -0,0 +1,120 @@
+#ifndef SIMULATION_GAME_FACTION_SPATIAL_INDEX_H
+#define SIMULATION_GAME_FACTION_SPATIAL_INDEX_H
+
+#include "SpatialHashGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 陣営ごとに分割した空間インデックス
+ *
+ * 設計方針：
+ * - 生存ユニットを陣営ごとの SpatialHashGrid に振り分ける。敵探索では
+ *   自陣営以外のグリッドだけを走査するため、味方は候補にすら上がらない
+ *   （一方的な戦闘で候補の大半が味方、というケースで効く）
+ * - 陣営数は固定しない（spawn データの faction 値をそのまま使う）。陣営は
+ *   少数なので、陣営 -> パーティションの対応は線形探索で十分
+ * - パーティションとバッファは build 間で再利用し、定常状態ではヒープ確保を
+ *   行わない
+ *
+ * 注意：
+ * - クエリが返すインデックスは build に渡した配列上の位置
+ * - 死亡ユニット（alive が 0）は build 時点で除外される
+ */
+class FactionSpatialIndex {
+public:
+  /**
+   * @brief 全パーティション共通のセルサイズを設定する（次回 build から有効）
+   */
+  void setCellSize(float cellSize) { cellSize_ = cellSize; }
+  float getCellSize() const { return cellSize_; }
+
+  /**
+   * @brief 点集合を陣営ごとに振り分けてインデックスを再構築する
+   * @param xs X座標配列
+   * @param ys Y座標配列
+   * @param factions 陣営配列
+   * @param alive 生存フラグ配列（0 の要素は登録しない）
+   * @param count 要素数
+   */
+  void build(const float *xs, const float *ys, const int *factions,
+             const uint8_t *alive, size_t count);
+
+  /**
+   * @brief 指定陣営の敵（他陣営すべて）のうち円内にいるものを列挙する
+   * @param faction 探索する側の陣営
+   * @param visitor void(uint32_t index, float distanceSq) を受け取る関数
+   */
+  template <typename Visitor>
+  void forEachEnemyInRadius(int faction, float x, float y, float radius,
+                            Visitor &&visitor) const {
+    for (size_t p = 0; p < activePartitions_; ++p) {
+      const Partition &partition = partitions_[p];
+      if (partition.faction == faction) {
+        continue;
+      }
+      partition.grid.forEachInRadius(x, y, radius, visitor);
+    }
+  }
+
+  /**
+   * @brief 指定陣営のユニットのうち円内にいるものを列挙する
+   * @param faction 対象の陣営
+   * @param visitor void(uint32_t index, float distanceSq) を受け取る関数
+   */
+  template <typename Visitor>
+  void forEachInFactionRadius(int faction, float x, float y, float radius,
+                              Visitor &&visitor) const {
+    const Partition *partition = findPartition(faction);
+    if (partition) {
+      partition->grid.forEachInRadius(x, y, radius, visitor);
+    }
+  }
+
+  /**
+   * @brief 半径内で最も近い敵を探す
+   * @param faction 探索する側の陣営
+   * @param maxRadius 探索半径
+   * @param outIndex 見つかった敵のインデックス
+   * @param outDistanceSq 見つかった敵までの距離の二乗
+   * @return 見つかった場合 true
+   *
+   * 距離が等しい場合はインデックスの小さい方を返す（走査順に依存しない）。
+   */
+  bool findNearestEnemy(int faction, float x, float y, float maxRadius,
+                        uint32_t &outIndex, float &outDistanceSq) const;
+
+  /**
+   * @brief 登録されている陣営の数
+   */
+  size_t factionCount() const { return activePartitions_; }
+
+  /**
+   * @brief 指定陣営に登録されているユニット数
+   */
+  size_t countInFaction(int faction) const;
+
+  /**
+   * @brief 指定陣営から見た敵ユニットの総数
+   */
+  size_t countEnemiesOf(int faction) const;
+
+private:
+  struct Partition {
+    int faction = 0;
+    SpatialHashGrid grid;
+    std::vector<float> xs;
+    std::vector<float> ys;
+    std::vector<uint32_t> indices;
+  };
+
+  const Partition *findPartition(int faction) const;
+  Partition &acquirePartition(int faction);
+
+  float cellSize_ = 1.0f;
+  std::vector<Partition> partitions_; // 先頭 activePartitions_ 個が有効
+  size_t activePartitions_ = 0;
+};
+
+#endif // SIMULATION_GAME_FACTION_SPATIAL_INDEX_H
@@ -0,0 +1,181 @@
+#include "FogOfWarGrid.h"
+
+/*
+ * FogOfWarGrid.cpp
+ *
+ * update():
+ * 1. For every alive unit, compute its tile (positions slightly outside the
+ * map still reveal the tiles inside) and sight radius in tiles.
+ * 2. If the unit's observer entry is unchanged, only refresh its update stamp.
+ * Otherwise subtract the old disc and add the new one.
+ * 3. Observers that were not seen in this update (dead or removed units) are
+ * subtracted and erased.
+ *
+ * stamp() walks the disc row by row as [x0, x1] spans and clips them to the map.
+ * Bits are toggled only on 0 <-> 1 reference count transitions, and only those
+ * rows are flagged dirty.
+ */
+#include <algorithm>
+#include <cmath>
+
+FogOfWarGrid::FogOfWarGrid(const GameMap &gameMap)
+    : width_(gameMap.getWidth()), height_(gameMap.getHeight()),
+      tileSize_(gameMap.getTileSize()), minX_(gameMap.getMinX()),
+      minY_(gameMap.getMinY()), wordsPerRow_((gameMap.getWidth() + 63) / 64) {}
+
+void FogOfWarGrid::update(
+    const std::vector<std::shared_ptr<UnitEntity>> &units) {
+  ++updateCount_;
+
+  for (const auto &unit : units) {
+    if (!unit || !unit->isAlive()) {
+      continue;
+    }
+    const Position &pos = unit->getPosition();
+    const int tileX =
+        static_cast<int>(std::floor((pos.getX() - minX_) / tileSize_));
+    const int tileY =
+        static_cast<int>(std::floor((pos.getY() - minY_) / tileSize_));
+    const float radiusTiles =
+        (unit->getStats().getAttackRange() + sightBonus_) / tileSize_;
+
+    size_t layerIndex = 0;
+    Layer &layer = layerFor(unit->getFaction(), layerIndex);
+
+    auto found = observers_.find(unit->getId());
+    if (found != observers_.end()) {
+      Observer &observer = found->second;
+      observer.seenUpdate = updateCount_;
+      if (observer.layer == layerIndex && observer.tileX == tileX &&
+          observer.tileY == tileY && observer.radiusTiles == radiusTiles) {
+        continue;
+      }
+      stamp(layers_[observer.layer], observer.tileX, observer.tileY,
+            observer.radiusTiles, -1);
+      observer = {layerIndex, tileX, tileY, radiusTiles, updateCount_};
+    } else {
+      observers_.emplace(unit->getId(), Observer{layerIndex, tileX, tileY,
+                                                 radiusTiles, updateCount_});
+    }
+    stamp(layer, tileX, tileY, radiusTiles, +1);
+  }
+
+  // 今回見つからなかったユニット（死亡・除去）の視界を取り除く
+  for (auto it = observers_.begin(); it != observers_.end();) {
+    const Observer &observer = it->second;
+    if (observer.seenUpdate == updateCount_) {
+      ++it;
+      continue;
+    }
+    stamp(layers_[observer.layer], observer.tileX, observer.tileY,
+          observer.radiusTiles, -1);
+    it = observers_.erase(it);
+  }
+}
+
+bool FogOfWarGrid::isVisible(int faction, int tileX, int tileY) const {
+  if (tileX < 0 || tileX >= width_ || tileY < 0 || tileY >= height_) {
+    return false;
+  }
+  const Layer *layer = findLayer(faction);
+  if (!layer) {
+    return false;
+  }
+  const uint64_t word =
+      layer->bits[static_cast<size_t>(tileY) * wordsPerRow_ + (tileX >> 6)];
+  return (word >> (tileX & 63)) & 1u;
+}
+
+bool FogOfWarGrid::isVisibleAt(int faction, const Position &worldPos) const {
+  const float localX = (worldPos.getX() - minX_) / tileSize_;
+  const float localY = (worldPos.getY() - minY_) / tileSize_;
+  if (localX < 0.0f || localY < 0.0f) {
+    return false;
+  }
+  return isVisible(faction, static_cast<int>(localX),
+                   static_cast<int>(localY));
+}
+
+const uint64_t *FogOfWarGrid::getRowBits(int faction, int row) const {
+  const Layer *layer = findLayer(faction);
+  if (!layer || row < 0 || row >= height_) {
+    return nullptr;
+  }
+  return layer->bits.data() + static_cast<size_t>(row) * wordsPerRow_;
+}
+
+void FogOfWarGrid::takeDirtyRows(int faction, std::vector<int> &outRows) {
+  outRows.clear();
+  for (Layer &layer : layers_) {
+    if (layer.faction != faction) {
+      continue;
+    }
+    for (int row = 0; row < height_; ++row) {
+      if (layer.dirtyRows[row]) {
+        layer.dirtyRows[row] = 0;
+        outRows.push_back(row);
+      }
+    }
+    return;
+  }
+}
+
+FogOfWarGrid::Layer &FogOfWarGrid::layerFor(int faction,
+                                            size_t &outLayerIndex) {
+  // 陣営は少数なので線形探索で十分
+  for (size_t i = 0; i < layers_.size(); ++i) {
+    if (layers_[i].faction == faction) {
+      outLayerIndex = i;
+      return layers_[i];
+    }
+  }
+  const size_t tileCount = static_cast<size_t>(width_) * height_;
+  layers_.push_back({faction, std::vector<uint16_t>(tileCount, 0),
+                     std::vector<uint64_t>(wordsPerRow_ * height_, 0),
+                     std::vector<uint8_t>(height_, 0)});
+  outLayerIndex = layers_.size() - 1;
+  return layers_.back();
+}
+
+const FogOfWarGrid::Layer *FogOfWarGrid::findLayer(int faction) const {
+  for (const Layer &layer : layers_) {
+    if (layer.faction == faction) {
+      return &layer;
+    }
+  }
+  return nullptr;
+}
+
+void FogOfWarGrid::stamp(Layer &layer, int centerX, int centerY,
+                         float radiusTiles, int delta) {
+  const int reach = static_cast<int>(radiusTiles);
+  const float radiusSq = radiusTiles * radiusTiles;
+  const int firstRow = std::max(0, centerY - reach);
+  const int lastRow = std::min(height_ - 1, centerY + reach);
+
+  for (int y = firstRow; y <= lastRow; ++y) {
+    const float dy = static_cast<float>(y - centerY);
+    const int halfWidth = static_cast<int>(std::sqrt(radiusSq - dy * dy));
+    const int x0 = std::max(0, centerX - halfWidth);
+    const int x1 = std::min(width_ - 1, centerX + halfWidth);
+    if (x0 > x1) {
+      continue;
+    }
+
+    uint16_t *counts = layer.refCounts.data() + static_cast<size_t>(y) * width_;
+    uint64_t *bits = layer.bits.data() + static_cast<size_t>(y) * wordsPerRow_;
+    bool rowChanged = false;
+    for (int x = x0; x <= x1; ++x) {
+      const uint16_t before = counts[x];
+      counts[x] = static_cast<uint16_t>(before + delta);
+      // 0 <-> 1 の遷移だけがビットを変える
+      if ((before == 0) != (counts[x] == 0)) {
+        bits[x >> 6] ^= uint64_t{1} << (x & 63);
+        rowChanged = true;
+      }
+    }
+    if (rowChanged) {
+      layer.dirtyRows[y] = 1;
+    }
+  }
+}
@@ -0,0 +1,121 @@
+#ifndef SIMULATION_GAME_FOG_OF_WAR_GRID_H
+#define SIMULATION_GAME_FOG_OF_WAR_GRID_H
+
+#include "../entities/GameMap.h"
+#include "../entities/UnitEntity.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 陣営ごとの視界（戦場の霧）を GameMap のタイル単位で管理する
+ *
+ * 設計方針：
+ * - 各ユニットは自タイルを中心とする円（攻撃射程 + 視界ボーナス）を
+ *   見えるようにする
+ * - タイルごとに「そのタイルを見ている自陣営ユニット数」を参照カウントで
+ *   持つ。タイルが変わったユニットだけ、古い円を減算して新しい円を加算する
+ *   （移動していないユニットのコストは0）
+ * - 参照カウントが 0 <-> 1 に変化したタイルだけ、陣営ごとのビットセット
+ *   （1行 = wordsPerRow 個の uint64_t）を更新し、その行を変更済みにする。
+ *   描画側は変更済みの行だけをテクスチャへ転送できる
+ * - 死亡・除去されたユニットは update で見つからなかった時点で減算する
+ *
+ * 注意：
+ * - 陣営のレイヤーは、その陣営のユニットが初めて現れた時点で作られる
+ * - ユニットの同一性は UnitEntity::getId() で判定する
+ */
+class FogOfWarGrid {
+public:
+  /**
+   * @brief 攻撃射程に加える視界の広さ（ワールド単位）の既定値
+   */
+  static constexpr float kDefaultSightBonus = 2.0f;
+
+  explicit FogOfWarGrid(const GameMap &gameMap);
+
+  int getWidth() const { return width_; }
+  int getHeight() const { return height_; }
+
+  /**
+   * @brief 視界の広さ = 攻撃射程 + bonus（次に移動したユニットから反映）
+   */
+  void setSightBonus(float bonus) { sightBonus_ = bonus; }
+  float getSightBonus() const { return sightBonus_; }
+
+  /**
+   * @brief ユニットの位置から視界を更新する
+   * @param units ユニット配列（読み取りのみ）
+   *
+   * タイル・陣営・視界半径のいずれも変わっていないユニットは何もしない。
+   */
+  void update(const std::vector<std::shared_ptr<UnitEntity>> &units);
+
+  /**
+   * @brief 指定陣営からタイルが見えているか
+   */
+  bool isVisible(int faction, int tileX, int tileY) const;
+
+  /**
+   * @brief 指定陣営からワールド座標が見えているか（マップ外は false）
+   */
+  bool isVisibleAt(int faction, const Position &worldPos) const;
+
+  /**
+   * @brief 1行あたりの uint64_t 数
+   */
+  size_t getWordsPerRow() const { return wordsPerRow_; }
+
+  /**
+   * @brief 指定陣営の1行分のビット列（x 番目のビットがタイル x）
+   * @return レイヤーが無い場合は nullptr
+   */
+  const uint64_t *getRowBits(int faction, int row) const;
+
+  /**
+   * @brief 前回の取り出し以降に変化した行を取り出す（昇順）
+   * @param faction 対象の陣営
+   * @param outRows 行番号の出力先（上書きされる）
+   *
+   * 取り出した行は未変更の状態に戻る。
+   */
+  void takeDirtyRows(int faction, std::vector<int> &outRows);
+
+private:
+  struct Layer {
+    int faction;
+    std::vector<uint16_t> refCounts; // タイルを見ているユニット数
+    std::vector<uint64_t> bits;      // refCounts > 0 のビットセット
+    std::vector<uint8_t> dirtyRows;  // 行ごとの変更フラグ
+  };
+
+  struct Observer {
+    size_t layer;       // layers_ 上の位置
+    int tileX;
+    int tileY;
+    float radiusTiles;  // 視界半径（タイル単位）
+    uint64_t seenUpdate; // 最後に見つかった update の番号
+  };
+
+  Layer &layerFor(int faction, size_t &outLayerIndex);
+  const Layer *findLayer(int faction) const;
+  // 円内のタイルの参照カウントを delta（+1 / -1）だけ変える
+  void stamp(Layer &layer, int centerX, int centerY, float radiusTiles,
+             int delta);
+
+  int width_;
+  int height_;
+  float tileSize_;
+  float minX_;
+  float minY_;
+  size_t wordsPerRow_;
+  float sightBonus_ = kDefaultSightBonus;
+
+  std::vector<Layer> layers_;
+  std::unordered_map<int, Observer> observers_; // ユニットID -> 視界の寄与
+  uint64_t updateCount_ = 0;
+};
+
+#endif // SIMULATION_GAME_FOG_OF_WAR_GRID_H
@@ -0,0 +1,88 @@
+#include "FormationPlanner.h"
+
+/*
+ * FormationPlanner.cpp
+ *
+ * Local frame: "forward" is the facing vector, "right" is facing rotated by
+ * -90 degrees. Row 0 is the front row; rows are centred on the anchor both
+ * along and across the facing so the anchor ends up in the middle of the
+ * block.
+ */
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+size_t FormationPlanner::columnsFor(size_t count) {
+  if (count == 0) {
+    return 0;
+  }
+  return static_cast<size_t>(
+      std::ceil(std::sqrt(static_cast<float>(count)) - 1e-4f));
+}
+
+void FormationPlanner::buildSlotOffsets(size_t count, float spacing,
+                                        float facingX, float facingY,
+                                        std::vector<Position> &outOffsets) {
+  outOffsets.clear();
+  if (count == 0) {
+    return;
+  }
+  const size_t columns = columnsFor(count);
+  const size_t rows = (count + columns - 1) / columns;
+  const float rightX = facingY;
+  const float rightY = -facingX;
+
+  outOffsets.reserve(count);
+  for (size_t row = 0; row < rows; ++row) {
+    const size_t inRow = std::min(columns, count - row * columns);
+    const float forward =
+        (static_cast<float>(rows - 1) * 0.5f - static_cast<float>(row)) *
+        spacing;
+    for (size_t column = 0; column < inRow; ++column) {
+      const float lateral =
+          (static_cast<float>(column) - static_cast<float>(inRow - 1) * 0.5f) *
+          spacing;
+      outOffsets.emplace_back(facingX * forward + rightX * lateral,
+                              facingY * forward + rightY * lateral);
+    }
+  }
+}
+
+void FormationPlanner::assignSlots(const std::vector<Position> &unitPositions,
+                                   float facingX, float facingY,
+                                   std::vector<size_t> &outSlotOfUnit) {
+  const size_t count = unitPositions.size();
+  outSlotOfUnit.assign(count, 0);
+  if (count == 0) {
+    return;
+  }
+  const size_t columns = columnsFor(count);
+  const float rightX = facingY;
+  const float rightY = -facingX;
+
+  std::vector<size_t> order(count);
+  std::iota(order.begin(), order.end(), 0);
+  auto forwardOf = [&](size_t i) {
+    return unitPositions[i].getX() * facingX +
+           unitPositions[i].getY() * facingY;
+  };
+  auto lateralOf = [&](size_t i) {
+    return unitPositions[i].getX() * rightX + unitPositions[i].getY() * rightY;
+  };
+
+  // 進行方向に最も進んでいるユニットから前列へ
+  std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    return forwardOf(lhs) > forwardOf(rhs);
+  });
+  for (size_t rowBegin = 0; rowBegin < count; rowBegin += columns) {
+    const size_t rowEnd = std::min(count, rowBegin + columns);
+    // 行の中では左から（枠も左から並んでいる）
+    std::stable_sort(order.begin() + rowBegin, order.begin() + rowEnd,
+                     [&](size_t lhs, size_t rhs) {
+                       return lateralOf(lhs) < lateralOf(rhs);
+                     });
+    for (size_t slot = rowBegin; slot < rowEnd; ++slot) {
+      outSlotOfUnit[order[slot]] = slot;
+    }
+  }
+}
@@ -0,0 +1,50 @@
+#ifndef SIMULATION_GAME_FORMATION_PLANNER_H
+#define SIMULATION_GAME_FORMATION_PLANNER_H
+
+#include "../value_objects/Position.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief 複数ユニットへの同一目標の移動命令を隊形（枠）に展開する
+ *
+ * 設計方針：
+ * - 隊形は進行方向を前とする矩形。列数は ceil(sqrt(n))、前列から順に埋め、
+ *   端数の列は中央に寄せる。枠はアンカー（隊形の中心）からのオフセット
+ * - 枠の割り当ては整列による近似（O(n log n)）。ユニットを進行方向への
+ *   射影で並べて前から列数ずつ行に分け、各行の中では横方向の射影で並べて
+ *   同じ行の枠に左から割り当てる。経路が交差しにくく、最適割り当て
+ *   （ハンガリアン法, O(n^3)）に近い結果になる
+ * - 地形やユニットには依存しない純粋な計算。枠の検証は呼び出し側が行う
+ */
+class FormationPlanner {
+public:
+  /**
+   * @brief n 体の隊形の列数
+   */
+  static size_t columnsFor(size_t count);
+
+  /**
+   * @brief 枠のオフセットを作る（前列・左から順）
+   * @param facingX, facingY 進行方向（正規化済み）
+   * @param spacing 隣り合う枠の中心間距離
+   */
+  static void buildSlotOffsets(size_t count, float spacing, float facingX,
+                               float facingY,
+                               std::vector<Position> &outOffsets);
+
+  /**
+   * @brief ユニットを枠に割り当てる
+   * @param unitPositions 各ユニットの現在位置
+   * @param facingX, facingY 進行方向（buildSlotOffsets と同じもの）
+   * @param outSlotOfUnit outSlotOfUnit[i] = ユニット i が入る枠の番号
+   *
+   * 枠の番号は buildSlotOffsets の並び（前列・左から順）を前提とする。
+   * 射影が等しい場合は入力順で決まる（決定的）。
+   */
+  static void assignSlots(const std::vector<Position> &unitPositions,
+                          float facingX, float facingY,
+                          std::vector<size_t> &outSlotOfUnit);
+};
+
+#endif // SIMULATION_GAME_FORMATION_PLANNER_H
@@ -0,0 +1,450 @@
+#include "GridPathfinder.h"
+
+/*
+ * GridPathfinder.cpp
+ *
+ * The open list is a binary heap with lazy deletion: a tile whose cost is
+ * lowered is pushed again and the stale entry is skipped when popped (its
+ * tile is already closed). With a consistent heuristic a closed tile never
+ * needs reopening.
+ *
+ * Jump Point Search follows the no-corner-cutting rules: a straight jump
+ * stops where a side tile opens up behind an obstacle, and a diagonal jump
+ * stops where either straight sub-jump finds something. A jump also stops
+ * on the first tile that is not uniform, so every tile it passes over has
+ * the same cost and the usual symmetry argument for pruning holds. Parents
+ * are jump points; the path is filled back in tile by tile on the way out.
+ */
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int kNeighborX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+constexpr int kNeighborY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+constexpr float kDiagonalStep = 1.41421356f;
+constexpr uint32_t kNoParent = UINT32_MAX;
+// tileClasses_ の最上位ビット: 周囲8タイルが同じ地形か通れない
+constexpr uint8_t kUniformBit = 0x80;
+constexpr uint8_t kClassMask = 0x7f;
+
+int sign(int value) { return (value > 0) - (value < 0); }
+
+// 斜め移動を優先したオクタイル距離（タイル単位）
+float octileDistance(int x0, int y0, int x1, int y1) {
+  const float dx = static_cast<float>(std::abs(x1 - x0));
+  const float dy = static_cast<float>(std::abs(y1 - y0));
+  return std::max(dx, dy) + (kDiagonalStep - 1.0f) * std::min(dx, dy);
+}
+
+// ヒープの先頭が f 最小（同点なら g 最大）になる比較
+struct OpenOrder {
+  template <typename Entry>
+  bool operator()(const Entry &a, const Entry &b) const {
+    if (a.f != b.f) {
+      return a.f > b.f;
+    }
+    return a.g < b.g;
+  }
+};
+
+} // namespace
+
+void GridPathfinder::prepare(const GameMap &map) {
+  if (map.getWidth() == width_ && map.getHeight() == height_) {
+    return;
+  }
+  width_ = map.getWidth();
+  height_ = map.getHeight();
+  const size_t count = static_cast<size_t>(width_) * height_;
+  costs_.assign(count, 0.0f);
+  parents_.assign(count, kNoParent);
+  stamps_.assign(count, 0);
+  closed_.assign(count, 0);
+  generation_ = 0;
+}
+
+Position GridPathfinder::tileCenter(const GameMap &map,
+                                    uint32_t index) const {
+  const float tileSize = map.getTileSize();
+  return Position(map.getMinX() + (index % width_ + 0.5f) * tileSize,
+                  map.getMinY() + (index / width_ + 0.5f) * tileSize);
+}
+
+bool GridPathfinder::isOpen(int x, int y) const {
+  return x >= 0 && x < width_ && y >= 0 && y < height_ &&
+         (tileClasses_[static_cast<size_t>(y) * width_ + x] & kClassMask) !=
+             0;
+}
+
+void GridPathfinder::classifyTile(const GameMap &map, int x, int y,
+                                  float radius) {
+  const TerrainType terrain = map.getTile(x, y);
+  const bool open =
+      getTerrainProperties(terrain).movementSpeedMultiplier > 0.0f &&
+      map.isTilePassable(x, y, radius);
+  uint8_t &tile = tileClasses_[static_cast<size_t>(y) * width_ + x];
+  ++classifiedTileCount_;
+  openTileCount_ -= (tile & kClassMask) != 0 ? 1 : 0;
+  uniformTileCount_ -= (tile & kUniformBit) != 0 ? 1 : 0;
+  tile = open ? static_cast<uint8_t>(static_cast<uint8_t>(terrain) + 1) : 0;
+  openTileCount_ += open ? 1 : 0;
+}
+
+void GridPathfinder::markUniform(int x, int y) {
+  uint8_t &tile = tileClasses_[static_cast<size_t>(y) * width_ + x];
+  const uint8_t tileClass = tile & kClassMask;
+  bool uniform = tileClass != 0;
+  for (int n = 0; n < 8 && uniform; ++n) {
+    const int nx = x + kNeighborX[n];
+    const int ny = y + kNeighborY[n];
+    if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) {
+      continue;
+    }
+    const uint8_t neighbor =
+        tileClasses_[static_cast<size_t>(ny) * width_ + nx] & kClassMask;
+    uniform = neighbor == 0 || neighbor == tileClass;
+  }
+  uniformTileCount_ -= (tile & kUniformBit) != 0 ? 1 : 0;
+  tile = uniform ? static_cast<uint8_t>(tileClass | kUniformBit) : tileClass;
+  uniformTileCount_ += uniform ? 1 : 0;
+}
+
+float GridPathfinder::getUniformTileRatio(const GameMap &map, float radius) {
+  prepare(map);
+  refreshTileClasses(map, radius);
+  return openTileCount_ > 0 ? static_cast<float>(uniformTileCount_) /
+                                  static_cast<float>(openTileCount_)
+                            : 0.0f;
+}
+
+void GridPathfinder::swapClassLayer(ClassLayer &layer) {
+  std::swap(tileClasses_, layer.tileClasses);
+  std::swap(openTileCount_, layer.openTileCount);
+  std::swap(uniformTileCount_, layer.uniformTileCount);
+  std::swap(classMap_, layer.map);
+  std::swap(classTerrainId_, layer.terrainId);
+  std::swap(classRadius_, layer.radius);
+  std::swap(classEpoch_, layer.epoch);
+  std::swap(classClearance_, layer.clearance);
+}
+
+void GridPathfinder::selectClassLayer(float radius) {
+  auto found = std::find_if(
+      cachedClasses_.begin(), cachedClasses_.end(),
+      [radius](const ClassLayer &layer) { return layer.radius == radius; });
+  if (found == cachedClasses_.end()) {
+    if (classRadius_ < 0.0f) {
+      return; // 控えに回す分類がない
+    }
+    if (cachedClasses_.size() < kMaxCachedRadii) {
+      cachedClasses_.emplace_back();
+      found = cachedClasses_.end() - 1;
+    } else {
+      // 最も長く使っていない分類の領域を、新しい半径の分類に使い回す
+      found = cachedClasses_.begin();
+    }
+  }
+  swapClassLayer(*found);
+  std::rotate(found, found + 1, cachedClasses_.end());
+}
+
+void GridPathfinder::refreshTileClasses(const GameMap &map, float radius) {
+  if (classRadius_ != radius) {
+    selectClassLayer(radius);
+  }
+  const size_t count = static_cast<size_t>(width_) * height_;
+  // クリアランス層が古いかどうかで isTilePassable の判定方法が変わる
+  const bool sameSource = classMap_ == &map &&
+                          classTerrainId_ == map.getTerrainId() &&
+                          classRadius_ == radius &&
+                          classClearance_ == map.isClearanceCurrent() &&
+                          tileClasses_.size() == count;
+  if (sameSource && classEpoch_ == map.getTerrainEpoch()) {
+    return;
+  }
+  changed_.clear();
+  if (sameSource && map.getTileChangesSince(classEpoch_, changed_)) {
+    // 変更から衝突半径の届く範囲を分類し直し、その1タイル外側まで
+    // 一様かどうかを見直す
+    const int reach =
+        static_cast<int>(std::ceil(radius / map.getTileSize())) + 1;
+    for (uint32_t index : changed_) {
+      const int cx = static_cast<int>(index % width_);
+      const int cy = static_cast<int>(index / width_);
+      for (int y = std::max(0, cy - reach);
+           y <= std::min(height_ - 1, cy + reach); ++y) {
+        for (int x = std::max(0, cx - reach);
+             x <= std::min(width_ - 1, cx + reach); ++x) {
+          classifyTile(map, x, y, radius);
+        }
+      }
+    }
+    for (uint32_t index : changed_) {
+      const int cx = static_cast<int>(index % width_);
+      const int cy = static_cast<int>(index / width_);
+      for (int y = std::max(0, cy - reach - 1);
+           y <= std::min(height_ - 1, cy + reach + 1); ++y) {
+        for (int x = std::max(0, cx - reach - 1);
+             x <= std::min(width_ - 1, cx + reach + 1); ++x) {
+          markUniform(x, y);
+        }
+      }
+    }
+  } else {
+    tileClasses_.assign(count, 0);
+    openTileCount_ = 0;
+    uniformTileCount_ = 0;
+    for (int y = 0; y < height_; ++y) {
+      for (int x = 0; x < width_; ++x) {
+        classifyTile(map, x, y, radius);
+      }
+    }
+    for (int y = 0; y < height_; ++y) {
+      for (int x = 0; x < width_; ++x) {
+        markUniform(x, y);
+      }
+    }
+  }
+  classMap_ = &map;
+  classTerrainId_ = map.getTerrainId();
+  classRadius_ = radius;
+  classEpoch_ = map.getTerrainEpoch();
+  classClearance_ = map.isClearanceCurrent();
+}
+
+uint32_t GridPathfinder::jump(int x, int y, int dx, int dy,
+                              uint32_t goalIndex) const {
+  const uint32_t width = static_cast<uint32_t>(width_);
+  while (true) {
+    // 角を切る斜め移動はしない
+    if (dx != 0 && dy != 0 && (!isOpen(x + dx, y) || !isOpen(x, y + dy))) {
+      return kNoParent;
+    }
+    x += dx;
+    y += dy;
+    if (!isOpen(x, y)) {
+      return kNoParent;
+    }
+    const uint32_t index = static_cast<uint32_t>(y) * width + x;
+    if (index == goalIndex || (tileClasses_[index] & kUniformBit) == 0) {
+      return index;
+    }
+    if (dx != 0 && dy != 0) {
+      if (jump(x, y, dx, 0, goalIndex) != kNoParent ||
+          jump(x, y, 0, dy, goalIndex) != kNoParent) {
+        return index;
+      }
+    } else if (dx != 0) {
+      // 背後が塞がっていた横のタイルが開けたら強制隣接
+      if ((isOpen(x, y - 1) && !isOpen(x - dx, y - 1)) ||
+          (isOpen(x, y + 1) && !isOpen(x - dx, y + 1))) {
+        return index;
+      }
+    } else if ((isOpen(x - 1, y) && !isOpen(x - 1, y - dy)) ||
+               (isOpen(x + 1, y) && !isOpen(x + 1, y - dy))) {
+      return index;
+    }
+  }
+}
+
+bool GridPathfinder::findPath(const GameMap &map, const Position &start,
+                              const Position &goal, float radius,
+                              std::vector<Position> &outWaypoints) {
+  outWaypoints.clear();
+  lastExpansionCount_ = 0;
+  lastPathCost_ = -1.0f;
+  prepare(map);
+
+  int startX = 0;
+  int startY = 0;
+  int goalX = 0;
+  int goalY = 0;
+  if (!map.worldToTile(start, startX, startY) ||
+      !map.worldToTile(goal, goalX, goalY)) {
+    return false;
+  }
+  const uint32_t width = static_cast<uint32_t>(width_);
+  const uint32_t startIndex = static_cast<uint32_t>(startY) * width + startX;
+  const uint32_t goalIndex = static_cast<uint32_t>(goalY) * width + goalX;
+
+  bool jumpPoints = false;
+  if (jumpPointSearch_) {
+    refreshTileClasses(map, radius);
+    // 開始・目標を通れるものとして扱う必要があるときは A* で探す
+    jumpPoints = isOpen(startX, startY) && isOpen(goalX, goalY);
+  }
+  if (!search(map, startIndex, goalIndex, radius, jumpPoints)) {
+    return false;
+  }
+  lastPathCost_ = costs_[goalIndex];
+
+  // ジャンプポイントの間は直線か斜めの一直線なのでタイルを補う
+  tilePath_.clear();
+  for (uint32_t index = goalIndex; index != kNoParent;
+       index = parents_[index]) {
+    tilePath_.push_back(index);
+    const uint32_t parent = parents_[index];
+    if (parent == kNoParent) {
+      break;
+    }
+    const int dx = sign(static_cast<int>(parent % width) -
+                        static_cast<int>(index % width));
+    const int dy = sign(static_cast<int>(parent / width) -
+                        static_cast<int>(index / width));
+    int x = static_cast<int>(index % width) + dx;
+    int y = static_cast<int>(index / width) + dy;
+    for (; static_cast<uint32_t>(y) * width + x != parent; x += dx, y += dy) {
+      tilePath_.push_back(static_cast<uint32_t>(y) * width + x);
+    }
+  }
+  outWaypoints.reserve(tilePath_.size() + 2);
+  outWaypoints.push_back(start);
+  for (auto it = tilePath_.rbegin(); it != tilePath_.rend(); ++it) {
+    outWaypoints.push_back(tileCenter(map, *it));
+  }
+  outWaypoints.push_back(goal);
+  return true;
+}
+
+bool GridPathfinder::search(const GameMap &map, uint32_t startIndex,
+                            uint32_t goalIndex, float radius,
+                            bool jumpPoints) {
+  if (++generation_ == 0) {
+    std::fill(stamps_.begin(), stamps_.end(), 0);
+    std::fill(closed_.begin(), closed_.end(), 0);
+    generation_ = 1;
+  }
+  const uint32_t width = static_cast<uint32_t>(width_);
+  const int goalX = static_cast<int>(goalIndex % width);
+  const int goalY = static_cast<int>(goalIndex / width);
+  auto passable = [&](int x, int y) {
+    const uint32_t index = static_cast<uint32_t>(y) * width + x;
+    return index == startIndex || index == goalIndex ||
+           map.isTilePassable(x, y, radius);
+  };
+  auto push = [&](uint32_t next, float g, uint32_t parent) {
+    if (stamps_[next] == generation_ && costs_[next] <= g) {
+      return;
+    }
+    costs_[next] = g;
+    parents_[next] = parent;
+    stamps_[next] = generation_;
+    open_.push_back({g + octileDistance(static_cast<int>(next % width),
+                                        static_cast<int>(next / width),
+                                        goalX, goalY),
+                     g, next});
+    std::push_heap(open_.begin(), open_.end(), OpenOrder());
+  };
+
+  open_.clear();
+  costs_[startIndex] = 0.0f;
+  parents_[startIndex] = kNoParent;
+  stamps_[startIndex] = generation_;
+  open_.push_back({octileDistance(static_cast<int>(startIndex % width),
+                                  static_cast<int>(startIndex / width),
+                                  goalX, goalY),
+                   0.0f, startIndex});
+
+  while (!open_.empty()) {
+    std::pop_heap(open_.begin(), open_.end(), OpenOrder());
+    const OpenEntry entry = open_.back();
+    open_.pop_back();
+    if (closed_[entry.index] == generation_) {
+      continue; // より安い経路で先に確定済み
+    }
+    closed_[entry.index] = generation_;
+    ++lastExpansionCount_;
+    if (entry.index == goalIndex) {
+      return true;
+    }
+
+    const int x = static_cast<int>(entry.index % width);
+    const int y = static_cast<int>(entry.index / width);
+    if (jumpPoints) {
+      // 一様なタイルでは来た向きから自然な隣接だけを残す
+      int directions[8][2];
+      int count = 0;
+      const uint32_t parent = parents_[entry.index];
+      if (parent == kNoParent ||
+          (tileClasses_[entry.index] & kUniformBit) == 0) {
+        for (int n = 0; n < 8; ++n) {
+          directions[count][0] = kNeighborX[n];
+          directions[count][1] = kNeighborY[n];
+          ++count;
+        }
+      } else {
+        const int dx = sign(x - static_cast<int>(parent % width));
+        const int dy = sign(y - static_cast<int>(parent / width));
+        auto add = [&](int ddx, int ddy) {
+          directions[count][0] = ddx;
+          directions[count][1] = ddy;
+          ++count;
+        };
+        if (dx != 0 && dy != 0) {
+          add(dx, 0);
+          add(0, dy);
+          add(dx, dy);
+        } else if (dx != 0) {
+          add(dx, 0);
+          add(dx, 1);
+          add(dx, -1);
+          add(0, 1);
+          add(0, -1);
+        } else {
+          add(0, dy);
+          add(1, dy);
+          add(-1, dy);
+          add(1, 0);
+          add(-1, 0);
+        }
+      }
+      for (int d = 0; d < count; ++d) {
+        const uint32_t next =
+            jump(x, y, directions[d][0], directions[d][1], goalIndex);
+        if (next == kNoParent || closed_[next] == generation_) {
+          continue;
+        }
+        // 跳び越したタイルはすべて next と同じ地形
+        const int steps =
+            std::max(std::abs(static_cast<int>(next % width) - x),
+                     std::abs(static_cast<int>(next / width) - y));
+        const bool diagonal = directions[d][0] != 0 && directions[d][1] != 0;
+        const float multiplier =
+            getTerrainProperties(map.getTile(static_cast<int>(next % width),
+                                             static_cast<int>(next / width)))
+                .movementSpeedMultiplier;
+        push(next,
+             entry.g + steps * (diagonal ? kDiagonalStep : 1.0f) / multiplier,
+             entry.index);
+      }
+      continue;
+    }
+
+    for (int n = 0; n < 8; ++n) {
+      const int nx = x + kNeighborX[n];
+      const int ny = y + kNeighborY[n];
+      if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) {
+        continue;
+      }
+      const uint32_t next = static_cast<uint32_t>(ny) * width + nx;
+      if (closed_[next] == generation_) {
+        continue;
+      }
+      const bool diagonal = n >= 4;
+      // 角を切る斜め移動は、両側のタイルが通れるときだけ
+      if (!passable(nx, ny) ||
+          (diagonal && (!passable(nx, y) || !passable(x, ny)))) {
+        continue;
+      }
+      const float multiplier =
+          getTerrainProperties(map.getTile(nx, ny)).movementSpeedMultiplier;
+      if (multiplier <= 0.0f) {
+        continue;
+      }
+      push(next, entry.g + (diagonal ? kDiagonalStep : 1.0f) / multiplier,
+           entry.index);
+    }
+  }
+  return false;
+}
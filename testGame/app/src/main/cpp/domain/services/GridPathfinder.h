@@ -0,0 +1,151 @@
+#ifndef SIMULATION_GAME_GRID_PATHFINDER_H
+#define SIMULATION_GAME_GRID_PATHFINDER_H
+
+#include "../entities/GameMap.h"
+#include "../value_objects/Position.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief GameMap のタイル上で、直線では届かない目標までの経路を求める
+ *
+ * 設計方針：
+ * - 8近傍の A*。辺のコストは MoveRange と同じ（歩幅 / 入るタイルの地形の
+ *   速度倍率、斜めは √2 倍、角を切る斜め移動は両側が通れるときだけ）
+ * - ヒューリスティックはオクタイル距離。地形の速度倍率は 1 以下なので
+ *   コストを過大に見積もらず、最短経路が得られる。f が等しい候補は
+ *   g の大きい（目標に近い）ものを先に取り出し、開けた地形での展開を減らす
+ * - ユニットの衝突半径は GameMap::isTilePassable（クリアランス層）で判定
+ *   する。開始タイルと目標タイルはユニットが立てる位置なので常に通れる
+ *   ものとして扱う
+ * - 作業領域はマップの大きさで1回確保し、世代番号で前回の値を無効にする
+ *   （問い合わせごとの全体クリアをしない）
+ * - 既定では Jump Point Search で探す。タイルごとに1バイトの分類（下位
+ *   7ビット = 通れなければ 0、通れれば地形 + 1、最上位ビット = 周囲8タイルが
+ *   すべて同じ地形か通れない「一様」なタイル）を持ち、一様なタイルの上だけ
+ *   跳び越し（枝刈り）を行う。一様でないタイル（地形の境目）で跳び越しを
+ *   止め、そこからは全方向へ1歩ずつ進む重み付き A* になる。枝刈りの根拠は
+ *   周囲が同じコストであることだけなので、求まるコストは A* と同じ
+ * - 分類はマップ・半径・地形が同じ間は使い回し、地形の変更は
+ *   GameMap::getTileChangesSince の周りだけを分類し直す。衝突半径の
+ *   異なるユニットが交互に探しても作り直さないよう、最近使った数個の
+ *   半径の分類を控えておく（半径は完全一致で引く。クリアランスは連続値
+ *   なので、丸めると通れるタイルの判定が変わる）
+ *
+ * 注意：
+ * - 出力はタイル中心を結んだ生の折れ線。PathSmoother で冗長な点を
+ *   取り除いてから使う
+ */
+class GridPathfinder {
+public:
+  /**
+   * @brief start から goal までの経路を求める
+   * @param radius ユニットの衝突半径
+   * @param outWaypoints [start, 開始タイルの中心, ..., 目標タイルの中心,
+   *        goal] の順の折れ線（見つからなければ空）
+   * @return 経路が見つかったか（開始・目標がマップ外なら false）
+   */
+  bool findPath(const GameMap &map, const Position &start,
+                const Position &goal, float radius,
+                std::vector<Position> &outWaypoints);
+
+  /**
+   * @brief 直前の findPath で展開（確定）したタイル数
+   */
+  size_t getLastExpansionCount() const { return lastExpansionCount_; }
+
+  /**
+   * @brief 直前の findPath の開始タイルから目標タイルまでのコスト
+   *        （草原 1 タイル = 1、見つからなければ負）
+   */
+  float getLastPathCost() const { return lastPathCost_; }
+
+  /**
+   * @brief Jump Point Search を使うか（false なら全タイルを1歩ずつ
+   *        展開する A*。比較用）
+   *
+   * 開始・目標のタイルが半径に対して通れない場合は常に A* で探す。
+   */
+  void setJumpPointSearch(bool enabled) { jumpPointSearch_ = enabled; }
+
+  /**
+   * @brief 半径 radius で通れるタイルのうち「一様」なタイルの割合
+   *
+   * Jump Point Search が跳び越せるタイルの割合で、1 に近いほど展開数が
+   * 減る。タイル分類を map に合わせてから返す（分類は findPath と共有）。
+   */
+  float getUniformTileRatio(const GameMap &map, float radius);
+
+  /**
+   * @brief これまでにタイル分類を求めたタイル数の累計（計測用）
+   */
+  size_t getClassifiedTileCount() const { return classifiedTileCount_; }
+
+private:
+  struct OpenEntry {
+    float f;
+    float g;
+    uint32_t index;
+  };
+
+  // マップの大きさが変わったときだけ作業領域を確保し直す
+  void prepare(const GameMap &map);
+  Position tileCenter(const GameMap &map, uint32_t index) const;
+  // 控えている分類。フィールドは使用中の分類（tileClasses_ ほか）と同じ
+  struct ClassLayer {
+    std::vector<uint8_t> tileClasses;
+    size_t openTileCount = 0;
+    size_t uniformTileCount = 0;
+    const GameMap *map = nullptr;
+    uint64_t terrainId = 0;
+    float radius = -1.0f;
+    uint64_t epoch = 0;
+    bool clearance = false;
+  };
+
+  // tileClasses_ を map と radius に合わせる
+  void refreshTileClasses(const GameMap &map, float radius);
+  // 使用中の分類を控えに回し、radius の分類が控えにあれば使用中にする
+  void selectClassLayer(float radius);
+  void swapClassLayer(ClassLayer &layer);
+  void classifyTile(const GameMap &map, int x, int y, float radius);
+  void markUniform(int x, int y);
+  bool isOpen(int x, int y) const;
+  // (x, y) から (dx, dy) 方向へ進んで最初のジャンプポイントを返す
+  // （なければ UINT32_MAX）
+  uint32_t jump(int x, int y, int dx, int dy, uint32_t goalIndex) const;
+  // 経路の探索本体。jumpPoints なら tileClasses_ を使う
+  bool search(const GameMap &map, uint32_t startIndex, uint32_t goalIndex,
+              float radius, bool jumpPoints);
+
+  int width_ = 0;
+  int height_ = 0;
+  std::vector<float> costs_;        // 開始からのコスト g
+  std::vector<uint32_t> parents_;   // 直前のタイル
+  std::vector<uint32_t> stamps_;    // costs_ / parents_ が有効な世代
+  std::vector<uint32_t> closed_;    // 確定した世代
+  uint32_t generation_ = 0;
+  std::vector<OpenEntry> open_;     // 二分ヒープ
+  std::vector<uint32_t> tilePath_;  // 復元用（目標から開始へ）
+
+  // Jump Point Search 用のタイル分類と、その元になったマップの状態
+  bool jumpPointSearch_ = true;
+  std::vector<uint8_t> tileClasses_;
+  size_t openTileCount_ = 0;    // 分類が 0 でないタイル数
+  size_t uniformTileCount_ = 0; // kUniformBit の立ったタイル数
+  const GameMap *classMap_ = nullptr;
+  uint64_t classTerrainId_ = 0; // 同じアドレスに作り直したマップと区別する
+  float classRadius_ = -1.0f;
+  uint64_t classEpoch_ = 0;
+  bool classClearance_ = false;
+  // 使用中以外の半径の分類（最近使ったものほど後ろ）
+  static constexpr size_t kMaxCachedRadii = 3;
+  std::vector<ClassLayer> cachedClasses_;
+  size_t classifiedTileCount_ = 0;
+  std::vector<uint32_t> changed_;
+  size_t lastExpansionCount_ = 0;
+  float lastPathCost_ = -1.0f;
+};
+
+#endif // SIMULATION_GAME_GRID_PATHFINDER_H
@@ -0,0 +1,366 @@
+#include "IncrementalPathfinder.h"
+
+/*
+ * IncrementalPathfinder.cpp
+ *
+ * D* Lite (Koenig & Likhachev) over the tile grid, searching from the goal
+ * so that g(s) is the cost from s to the goal and the start can move
+ * without invalidating anything. The open list is a binary heap with lazy
+ * deletion: each tile remembers the key it was last queued with and
+ * whether it is still queued, and heap entries that disagree are dropped
+ * when they reach the top.
+ *
+ * A repair is given the expansion count of the last from-scratch plan as its
+ * budget. Blocking a tile raises every tile whose route ran through it, so
+ * a wall across an open field can touch more tiles than a new search would;
+ * once the budget is spent the repair gives up and drops the search state,
+ * leaving the caller to search from scratch with whatever it finds cheapest.
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr int kNeighborX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+constexpr int kNeighborY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+constexpr float kDiagonalStep = 1.41421356f;
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+template <typename Key> bool keyLess(const Key &a, const Key &b) {
+  return a.primary < b.primary ||
+         (a.primary == b.primary && a.secondary < b.secondary);
+}
+
+template <typename Key> bool keyEqual(const Key &a, const Key &b) {
+  return a.primary == b.primary && a.secondary == b.secondary;
+}
+
+// ヒープの先頭がキー最小になる比較
+struct OpenOrder {
+  template <typename Entry>
+  bool operator()(const Entry &a, const Entry &b) const {
+    return keyLess(b.key, a.key);
+  }
+};
+
+} // namespace
+
+void IncrementalPathfinder::reset(const GameMap &map) {
+  width_ = map.getWidth();
+  height_ = map.getHeight();
+  const size_t count = static_cast<size_t>(width_) * height_;
+  g_.assign(count, kInfinity);
+  rhs_.assign(count, kInfinity);
+  passable_.assign(count, 0);
+  openKeys_.resize(count);
+  inOpen_.assign(count, 0);
+  open_.clear();
+  if (affectedStamps_.size() != count) {
+    affectedStamps_.assign(count, 0);
+    affectedGeneration_ = 0;
+  }
+  km_ = 0.0f;
+}
+
+float IncrementalPathfinder::heuristic(uint32_t from, uint32_t to) const {
+  const uint32_t width = static_cast<uint32_t>(width_);
+  const float dx = std::fabs(static_cast<float>(from % width) -
+                             static_cast<float>(to % width));
+  const float dy = std::fabs(static_cast<float>(from / width) -
+                             static_cast<float>(to / width));
+  return std::max(dx, dy) + (kDiagonalStep - 1.0f) * std::min(dx, dy);
+}
+
+IncrementalPathfinder::Key
+IncrementalPathfinder::calculateKey(uint32_t index) const {
+  const float best = std::min(g_[index], rhs_[index]);
+  return Key{best + heuristic(startIndex_, index) + km_, best};
+}
+
+bool IncrementalPathfinder::isPassable(const GameMap &map, int x,
+                                       int y) const {
+  if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+    return false;
+  }
+  const uint32_t index =
+      static_cast<uint32_t>(y) * static_cast<uint32_t>(width_) + x;
+  if (index == goalIndex_) {
+    return true;
+  }
+  if (passable_[index] == 0) {
+    passable_[index] = map.isTilePassable(x, y, radius_) ? 1 : 2;
+  }
+  return passable_[index] == 1;
+}
+
+float IncrementalPathfinder::edgeCost(const GameMap &map, uint32_t from,
+                                      uint32_t to) const {
+  const uint32_t width = static_cast<uint32_t>(width_);
+  const int x = static_cast<int>(from % width);
+  const int y = static_cast<int>(from / width);
+  const int nx = static_cast<int>(to % width);
+  const int ny = static_cast<int>(to / width);
+  const bool diagonal = x != nx && y != ny;
+  // 角を切る斜め移動は、両側のタイルが通れるときだけ
+  if (!isPassable(map, nx, ny) ||
+      (diagonal && (!isPassable(map, nx, y) || !isPassable(map, x, ny)))) {
+    return kInfinity;
+  }
+  const float multiplier =
+      getTerrainProperties(map.getTile(nx, ny)).movementSpeedMultiplier;
+  if (multiplier <= 0.0f) {
+    return kInfinity;
+  }
+  return (diagonal ? kDiagonalStep : 1.0f) / multiplier;
+}
+
+void IncrementalPathfinder::pushOpen(uint32_t index) {
+  const Key key = calculateKey(index);
+  openKeys_[index] = key;
+  inOpen_[index] = 1;
+  open_.push_back({key, index});
+  std::push_heap(open_.begin(), open_.end(), OpenOrder());
+}
+
+void IncrementalPathfinder::updateVertex(const GameMap &map,
+                                         uint32_t index) {
+  if (index != goalIndex_) {
+    const int x = static_cast<int>(index % static_cast<uint32_t>(width_));
+    const int y = static_cast<int>(index / static_cast<uint32_t>(width_));
+    float best = kInfinity;
+    for (int n = 0; n < 8; ++n) {
+      const int nx = x + kNeighborX[n];
+      const int ny = y + kNeighborY[n];
+      if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) {
+        continue;
+      }
+      const uint32_t next =
+          static_cast<uint32_t>(ny) * static_cast<uint32_t>(width_) + nx;
+      if (g_[next] == kInfinity) {
+        continue;
+      }
+      best = std::min(best, edgeCost(map, index, next) + g_[next]);
+    }
+    rhs_[index] = best;
+  }
+  inOpen_[index] = 0;
+  if (g_[index] != rhs_[index]) {
+    pushOpen(index);
+  }
+}
+
+bool IncrementalPathfinder::computeShortestPath(const GameMap &map,
+                                                size_t maxExpansions) {
+  auto updateNeighbors = [&](uint32_t index) {
+    const int x = static_cast<int>(index % static_cast<uint32_t>(width_));
+    const int y = static_cast<int>(index / static_cast<uint32_t>(width_));
+    for (int n = 0; n < 8; ++n) {
+      const int nx = x + kNeighborX[n];
+      const int ny = y + kNeighborY[n];
+      if (nx >= 0 && nx < width_ && ny >= 0 && ny < height_) {
+        updateVertex(map, static_cast<uint32_t>(ny) *
+                                  static_cast<uint32_t>(width_) +
+                              nx);
+      }
+    }
+  };
+
+  while (!open_.empty()) {
+    const OpenEntry top = open_.front();
+    if (!inOpen_[top.index] || !keyEqual(top.key, openKeys_[top.index])) {
+      std::pop_heap(open_.begin(), open_.end(), OpenOrder());
+      open_.pop_back(); // 取り除かれたか、キーが更新された古い項目
+      continue;
+    }
+    if (!keyLess(top.key, calculateKey(startIndex_)) &&
+        rhs_[startIndex_] == g_[startIndex_]) {
+      break; // 開始タイルの値が確定した
+    }
+    if (lastExpansionCount_ >= maxExpansions) {
+      return false;
+    }
+    std::pop_heap(open_.begin(), open_.end(), OpenOrder());
+    open_.pop_back();
+    inOpen_[top.index] = 0;
+    ++lastExpansionCount_;
+
+    const uint32_t index = top.index;
+    const Key newKey = calculateKey(index);
+    if (keyLess(top.key, newKey)) {
+      pushOpen(index); // 開始タイルが動いてキーが古くなっていた
+    } else if (g_[index] > rhs_[index]) {
+      g_[index] = rhs_[index];
+      updateNeighbors(index);
+    } else {
+      g_[index] = kInfinity;
+      updateVertex(map, index);
+      updateNeighbors(index);
+    }
+  }
+  return true;
+}
+
+bool IncrementalPathfinder::locateStart(const GameMap &map,
+                                        const Position &start) {
+  int startX = 0;
+  int startY = 0;
+  if (!map.worldToTile(start, startX, startY)) {
+    return false;
+  }
+  startIndex_ =
+      static_cast<uint32_t>(startY) * static_cast<uint32_t>(width_) + startX;
+  return true;
+}
+
+bool IncrementalPathfinder::plan(const GameMap &map, const Position &start,
+                                 const Position &goal, float radius,
+                                 std::vector<Position> &outWaypoints) {
+  outWaypoints.clear();
+  lastExpansionCount_ = 0;
+  lastUpdatedTileCount_ = 0;
+  hasPlan_ = false;
+  reset(map);
+  radius_ = radius;
+  terrainEpoch_ = map.getTerrainEpoch();
+  goal_ = goal;
+
+  int goalX = 0;
+  int goalY = 0;
+  if (!locateStart(map, start) || !map.worldToTile(goal, goalX, goalY)) {
+    return false;
+  }
+  goalIndex_ =
+      static_cast<uint32_t>(goalY) * static_cast<uint32_t>(width_) + goalX;
+  lastStartIndex_ = startIndex_;
+  rhs_[goalIndex_] = 0.0f;
+  pushOpen(goalIndex_);
+  hasPlan_ = true;
+
+  computeShortestPath(map, std::numeric_limits<size_t>::max());
+  planExpansionCount_ = lastExpansionCount_;
+  return extractPath(map, start, outWaypoints);
+}
+
+bool IncrementalPathfinder::repair(const GameMap &map, const Position &start,
+                                   std::vector<Position> &outWaypoints) {
+  outWaypoints.clear();
+  lastExpansionCount_ = 0;
+  lastUpdatedTileCount_ = 0;
+  lastRepairAbandoned_ = false;
+  if (!hasPlan_) {
+    return false;
+  }
+  changed_.clear();
+  if (map.getWidth() != width_ || map.getHeight() != height_ ||
+      !map.getTileChangesSince(terrainEpoch_, changed_)) {
+    return plan(map, start, goal_, radius_, outWaypoints);
+  }
+  terrainEpoch_ = map.getTerrainEpoch();
+  if (!map.isWalkable(goal_, radius_) || !locateStart(map, start)) {
+    return false;
+  }
+  km_ += heuristic(lastStartIndex_, startIndex_);
+  lastStartIndex_ = startIndex_;
+
+  if (!changed_.empty()) {
+    // タイルの通行可否は衝突半径の内側のタイルで決まり、辺はさらに
+    // 1タイル先（入るタイルと角の両側）を見る
+    const int reach =
+        static_cast<int>(std::ceil(radius_ / map.getTileSize())) + 2;
+    if (++affectedGeneration_ == 0) {
+      std::fill(affectedStamps_.begin(), affectedStamps_.end(), 0);
+      affectedGeneration_ = 1;
+    }
+    affected_.clear();
+    const uint32_t width = static_cast<uint32_t>(width_);
+    for (uint32_t tile : changed_) {
+      const int cx = static_cast<int>(tile % width);
+      const int cy = static_cast<int>(tile / width);
+      for (int y = std::max(0, cy - reach);
+           y <= std::min(height_ - 1, cy + reach); ++y) {
+        for (int x = std::max(0, cx - reach);
+             x <= std::min(width_ - 1, cx + reach); ++x) {
+          const uint32_t index = static_cast<uint32_t>(y) * width + x;
+          if (affectedStamps_[index] != affectedGeneration_) {
+            affectedStamps_[index] = affectedGeneration_;
+            affected_.push_back(index);
+          }
+        }
+      }
+    }
+    for (uint32_t index : affected_) {
+      passable_[index] = 0;
+    }
+    for (uint32_t index : affected_) {
+      updateVertex(map, index);
+    }
+    lastUpdatedTileCount_ = affected_.size();
+  }
+
+  if (!computeShortestPath(map, std::max(planExpansionCount_,
+                                         kMinRepairExpansions))) {
+    // 修復の方が高くつく変更だった。途中の探索状態は使えない
+    hasPlan_ = false;
+    lastRepairAbandoned_ = true;
+    return false;
+  }
+  return extractPath(map, start, outWaypoints);
+}
+
+float IncrementalPathfinder::getPathCost() const {
+  if (!hasPlan_ || g_[startIndex_] == kInfinity) {
+    return -1.0f;
+  }
+  return g_[startIndex_];
+}
+
+bool IncrementalPathfinder::extractPath(
+    const GameMap &map, const Position &start,
+    std::vector<Position> &outWaypoints) {
+  if (g_[startIndex_] == kInfinity) {
+    return false;
+  }
+  const uint32_t width = static_cast<uint32_t>(width_);
+  const float tileSize = map.getTileSize();
+  auto center = [&](uint32_t index) {
+    return Position(map.getMinX() + (index % width + 0.5f) * tileSize,
+                    map.getMinY() + (index / width + 0.5f) * tileSize);
+  };
+
+  outWaypoints.push_back(start);
+  outWaypoints.push_back(center(startIndex_));
+  // g に沿って下るだけ（コストが正なので同じタイルに戻ることはない）
+  const size_t maxSteps = g_.size();
+  uint32_t current = startIndex_;
+  for (size_t step = 0; current != goalIndex_; ++step) {
+    const int x = static_cast<int>(current % width);
+    const int y = static_cast<int>(current / width);
+    uint32_t best = current;
+    float bestCost = kInfinity;
+    for (int n = 0; n < 8; ++n) {
+      const int nx = x + kNeighborX[n];
+      const int ny = y + kNeighborY[n];
+      if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) {
+        continue;
+      }
+      const uint32_t next = static_cast<uint32_t>(ny) * width + nx;
+      if (g_[next] == kInfinity) {
+        continue;
+      }
+      const float cost = edgeCost(map, current, next) + g_[next];
+      if (cost < bestCost) {
+        bestCost = cost;
+        best = next;
+      }
+    }
+    if (best == current || step >= maxSteps) {
+      outWaypoints.clear();
+      return false;
+    }
+    current = best;
+    outWaypoints.push_back(center(current));
+  }
+  outWaypoints.push_back(goal_);
+  return true;
+}
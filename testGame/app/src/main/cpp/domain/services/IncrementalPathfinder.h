@@ -0,0 +1,137 @@
+#ifndef SIMULATION_GAME_INCREMENTAL_PATHFINDER_H
+#define SIMULATION_GAME_INCREMENTAL_PATHFINDER_H
+
+#include "../entities/GameMap.h"
+#include "../value_objects/Position.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 地形の変更後に前回の探索結果を使って経路を修復する経路探索
+ *        （D* Lite）
+ *
+ * 設計方針：
+ * - 目標から開始へ向かう逆向きの探索。各タイルに目標までのコスト g と
+ *   一歩先読みした値 rhs を持ち、g != rhs のタイルだけを優先度付きキューで
+ *   処理する。ユニットが進んで開始タイルが変わっても目標側の結果は
+ *   そのまま使える（キーの補正値 km を足すだけ）
+ * - 辺のコストと通行判定は GridPathfinder と同じ（8近傍、歩幅 / 入る
+ *   タイルの速度倍率、角を切らない、GameMap::isTilePassable）。目標タイルは
+ *   常に通れるものとして扱う
+ * - 修復では GameMap::getTileChangesSince の変更タイルから、衝突半径と
+ *   角の判定が届く範囲のタイルだけを再評価する。修復の手間は変更の大きさと
+ *   経路が変わる範囲に比例し、マップの大きさには比例しない
+ * - 修復で展開してよいタイル数は、直前に最初から探索したときの展開数
+ *   まで。開けた地形で経路を横切る壁のように、経路が通っていたタイルを
+ *   広く見直すことになる変更では、途中でやめて探索状態を捨てる。
+ *   呼び出し側は最も安い方法（GridPathfinder など）で探索し直す
+ * - タイルの通行可否は初めて見たときに求めて覚えておき、修復では変更の
+ *   周りの分だけを捨てる。地形の変更でクリアランス層が古くなっても、
+ *   変更から離れたタイルの判定は変わらない
+ * - 1体の1つの目標ごとに1つ使う。作業領域はマップの大きさで確保する
+ *
+ * 注意：
+ * - 変更の記録が足りない場合とマップの大きさが変わった場合は最初から
+ *   探索し直す
+ */
+class IncrementalPathfinder {
+public:
+  /**
+   * @brief 新しい目標への経路を最初から求める
+   * @param outWaypoints [start, 開始タイルの中心, ..., 目標タイルの中心,
+   *        goal] の順の折れ線（見つからなければ空）
+   * @return 経路が見つかったか
+   */
+  bool plan(const GameMap &map, const Position &start, const Position &goal,
+            float radius, std::vector<Position> &outWaypoints);
+
+  /**
+   * @brief 前回の plan / repair 以降の地形の変更を反映し、現在位置からの
+   *        経路を求め直す
+   *
+   * 展開数が直前の plan の展開数を超えたら修復をやめ、探索状態を捨てて
+   * false を返す（wasLastRepairAbandoned() が true になる）。
+   * @param start ユニットの現在位置
+   * @return 経路が見つかったか
+   */
+  bool repair(const GameMap &map, const Position &start,
+              std::vector<Position> &outWaypoints);
+
+  bool hasPlan() const { return hasPlan_; }
+  const Position &getGoal() const { return goal_; }
+
+  /**
+   * @brief 開始タイルから目標タイルまでのコスト（草原 1 タイル = 1、
+   *        経路がなければ負）
+   */
+  float getPathCost() const;
+
+  /**
+   * @brief 直前の plan / repair で展開したタイル数と、再評価した
+   *        変更周辺のタイル数
+   */
+  size_t getLastExpansionCount() const { return lastExpansionCount_; }
+  size_t getLastUpdatedTileCount() const { return lastUpdatedTileCount_; }
+
+  /**
+   * @brief 直前の repair が展開数の上限に達して打ち切られたか
+   */
+  bool wasLastRepairAbandoned() const { return lastRepairAbandoned_; }
+
+private:
+  struct Key {
+    float primary;
+    float secondary;
+  };
+  struct OpenEntry {
+    Key key;
+    uint32_t index;
+  };
+
+  void reset(const GameMap &map);
+  Key calculateKey(uint32_t index) const;
+  float heuristic(uint32_t from, uint32_t to) const;
+  bool isPassable(const GameMap &map, int x, int y) const;
+  // from から隣の to へ進むコスト（通れなければ無限大）
+  float edgeCost(const GameMap &map, uint32_t from, uint32_t to) const;
+  // 後続タイルから rhs を計算し直し、キューへの出し入れを行う
+  void updateVertex(const GameMap &map, uint32_t index);
+  void pushOpen(uint32_t index);
+  // 展開数が maxExpansions に達したら打ち切って false を返す
+  bool computeShortestPath(const GameMap &map, size_t maxExpansions);
+  bool extractPath(const GameMap &map, const Position &start,
+                   std::vector<Position> &outWaypoints);
+  bool locateStart(const GameMap &map, const Position &start);
+
+  int width_ = 0;
+  int height_ = 0;
+  float radius_ = 0.0f;
+  bool hasPlan_ = false;
+  Position goal_;
+  uint32_t goalIndex_ = 0;
+  uint32_t startIndex_ = 0;
+  uint32_t lastStartIndex_ = 0;
+  uint64_t terrainEpoch_ = 0; // 反映済みの地形
+  float km_ = 0.0f;
+
+  std::vector<float> g_;
+  std::vector<float> rhs_;
+  // 通行可否のキャッシュ（0 = 未判定、1 = 通れる、2 = 通れない）
+  mutable std::vector<uint8_t> passable_;
+  std::vector<Key> openKeys_;      // キューにある場合のキー
+  std::vector<uint8_t> inOpen_;
+  std::vector<OpenEntry> open_;    // 二分ヒープ（古い項目は取り出し時に捨てる）
+  std::vector<uint32_t> changed_;  // 修復の作業領域
+  std::vector<uint32_t> affected_;
+  std::vector<uint32_t> affectedStamps_;
+  uint32_t affectedGeneration_ = 0;
+  // 最初から探索した直後の修復でも、数タイルの見直しは許す
+  static constexpr size_t kMinRepairExpansions = 64;
+  size_t planExpansionCount_ = 0; // 直前の plan の展開数（修復の上限）
+  size_t lastExpansionCount_ = 0;
+  size_t lastUpdatedTileCount_ = 0;
+  bool lastRepairAbandoned_ = false;
+};
+
+#endif // SIMULATION_GAME_INCREMENTAL_PATHFINDER_H
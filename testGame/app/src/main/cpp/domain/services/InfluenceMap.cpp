@@ -0,0 +1,241 @@
+#include "InfluenceMap.h"
+
+/*
+ * InfluenceMap.cpp
+ *
+ * beginUpdate():
+ * 1. Resolve each source's layer and cell (creating layers for new factions
+ * here, so that the row-parallel passes never resize shared state).
+ * 2. Count sources whose (layer, cell, strength, radius) differ from the
+ * recorded stamp, plus recorded stamps that disappeared.
+ * 3. If the count exceeds kFullRebuildFraction of the sources, or no full
+ * rebuild happened for kUpdatesPerForcedRebuild updates, ask the caller for a
+ * full rebuild. Otherwise subtract old stamps and add new ones in place.
+ *
+ * rebuildRows() and decayRows() only touch cells of their own row band, so
+ * bands can run on different threads without synchronisation.
+ */
+#include <algorithm>
+#include <cmath>
+
+InfluenceMap::InfluenceMap(float minX, float minY, float maxX, float maxY,
+                           float cellSize)
+    : minX_(minX), minY_(minY), cellSize_(cellSize),
+      columns_(std::max(
+          1, static_cast<int>(std::ceil((maxX - minX) / cellSize)))),
+      rows_(std::max(1,
+                     static_cast<int>(std::ceil((maxY - minY) / cellSize)))) {}
+
+void InfluenceMap::cellAt(float x, float y, int &outCellX,
+                          int &outCellY) const {
+  const int cellX = static_cast<int>(std::floor((x - minX_) / cellSize_));
+  const int cellY = static_cast<int>(std::floor((y - minY_) / cellSize_));
+  outCellX = std::clamp(cellX, 0, columns_ - 1);
+  outCellY = std::clamp(cellY, 0, rows_ - 1);
+}
+
+bool InfluenceMap::beginUpdate(const InfluenceSources &sources) {
+  ++updateCount_;
+  const size_t count = sources.size();
+  sourceLayers_.resize(count);
+
+  size_t changed = 0;
+  size_t recorded = 0;
+  for (size_t i = 0; i < count; ++i) {
+    sourceLayers_[i] = layerIndexFor(sources.factions[i]);
+    auto found = stamps_.find(sources.ids[i]);
+    if (found == stamps_.end()) {
+      ++changed;
+      continue;
+    }
+    ++recorded;
+    Stamp &recordedStamp = found->second;
+    recordedStamp.seenUpdate = updateCount_;
+    int cellX = 0;
+    int cellY = 0;
+    cellAt(sources.xs[i], sources.ys[i], cellX, cellY);
+    if (recordedStamp.layer != sourceLayers_[i] ||
+        recordedStamp.cellX != cellX || recordedStamp.cellY != cellY ||
+        recordedStamp.strength != sources.strengths[i] ||
+        recordedStamp.radius != sources.radii[i]) {
+      ++changed;
+    }
+  }
+  changed += stamps_.size() - recorded; // 消えた影響源
+
+  const bool rebuildDue =
+      updateCount_ - lastRebuild_ >= kUpdatesPerForcedRebuild;
+  const float changeLimit =
+      kFullRebuildFraction * static_cast<float>(std::max<size_t>(count, 1));
+  if (!built_ || rebuildDue || static_cast<float>(changed) > changeLimit) {
+    return true;
+  }
+  if (changed == 0) {
+    return false;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    int cellX = 0;
+    int cellY = 0;
+    cellAt(sources.xs[i], sources.ys[i], cellX, cellY);
+    const Stamp next{sourceLayers_[i],     cellX,
+                     cellY,                sources.strengths[i],
+                     sources.radii[i],     updateCount_};
+
+    auto found = stamps_.find(sources.ids[i]);
+    if (found != stamps_.end()) {
+      Stamp &previous = found->second;
+      if (previous.layer == next.layer && previous.cellX == next.cellX &&
+          previous.cellY == next.cellY && previous.strength == next.strength &&
+          previous.radius == next.radius) {
+        continue;
+      }
+      stamp(layers_[previous.layer].current, previous.cellX, previous.cellY,
+            previous.strength, previous.radius, -1.0f, 0, rows_);
+      previous = next;
+    } else {
+      stamps_.emplace(sources.ids[i], next);
+    }
+    stamp(layers_[next.layer].current, next.cellX, next.cellY, next.strength,
+          next.radius, +1.0f, 0, rows_);
+  }
+
+  for (auto it = stamps_.begin(); it != stamps_.end();) {
+    const Stamp &gone = it->second;
+    if (gone.seenUpdate == updateCount_) {
+      ++it;
+      continue;
+    }
+    stamp(layers_[gone.layer].current, gone.cellX, gone.cellY, gone.strength,
+          gone.radius, -1.0f, 0, rows_);
+    it = stamps_.erase(it);
+  }
+  return false;
+}
+
+void InfluenceMap::rebuildRows(const InfluenceSources &sources, int rowBegin,
+                               int rowEnd) {
+  rowBegin = std::max(rowBegin, 0);
+  rowEnd = std::min(rowEnd, rows_);
+  if (rowBegin >= rowEnd) {
+    return;
+  }
+  const size_t first = static_cast<size_t>(rowBegin) * columns_;
+  const size_t last = static_cast<size_t>(rowEnd) * columns_;
+  for (Layer &layer : layers_) {
+    std::fill(layer.current.begin() + first, layer.current.begin() + last,
+              0.0f);
+  }
+  for (size_t i = 0; i < sources.size(); ++i) {
+    int cellX = 0;
+    int cellY = 0;
+    cellAt(sources.xs[i], sources.ys[i], cellX, cellY);
+    stamp(layers_[sourceLayers_[i]].current, cellX, cellY,
+          sources.strengths[i], sources.radii[i], +1.0f, rowBegin, rowEnd);
+  }
+}
+
+void InfluenceMap::finishRebuild(const InfluenceSources &sources) {
+  stamps_.clear();
+  for (size_t i = 0; i < sources.size(); ++i) {
+    int cellX = 0;
+    int cellY = 0;
+    cellAt(sources.xs[i], sources.ys[i], cellX, cellY);
+    stamps_[sources.ids[i]] = {sourceLayers_[i],     cellX,
+                               cellY,                sources.strengths[i],
+                               sources.radii[i],     updateCount_};
+  }
+  lastRebuild_ = updateCount_;
+  built_ = true;
+}
+
+void InfluenceMap::decayRows(float factor, int rowBegin, int rowEnd) {
+  rowBegin = std::max(rowBegin, 0);
+  rowEnd = std::min(rowEnd, rows_);
+  if (rowBegin >= rowEnd) {
+    return;
+  }
+  const size_t first = static_cast<size_t>(rowBegin) * columns_;
+  const size_t last = static_cast<size_t>(rowEnd) * columns_;
+  for (Layer &layer : layers_) {
+    for (size_t c = first; c < last; ++c) {
+      layer.memory[c] = std::max(layer.current[c], layer.memory[c] * factor);
+    }
+  }
+}
+
+float InfluenceMap::getInfluence(int faction, int cellX, int cellY) const {
+  if (cellX < 0 || cellX >= columns_ || cellY < 0 || cellY >= rows_) {
+    return 0.0f;
+  }
+  const Layer *layer = findLayer(faction);
+  return layer ? layer->memory[static_cast<size_t>(cellY) * columns_ + cellX]
+               : 0.0f;
+}
+
+float InfluenceMap::getEnemyInfluence(int faction, int cellX,
+                                      int cellY) const {
+  if (cellX < 0 || cellX >= columns_ || cellY < 0 || cellY >= rows_) {
+    return 0.0f;
+  }
+  const size_t cell = static_cast<size_t>(cellY) * columns_ + cellX;
+  float total = 0.0f;
+  for (const Layer &layer : layers_) {
+    if (layer.faction != faction) {
+      total += layer.memory[cell];
+    }
+  }
+  return total;
+}
+
+size_t InfluenceMap::layerIndexFor(int faction) {
+  // 陣営は少数なので線形探索で十分
+  for (size_t i = 0; i < layers_.size(); ++i) {
+    if (layers_[i].faction == faction) {
+      return i;
+    }
+  }
+  const size_t cellCount = static_cast<size_t>(columns_) * rows_;
+  layers_.push_back({faction, std::vector<float>(cellCount, 0.0f),
+                     std::vector<float>(cellCount, 0.0f)});
+  built_ = false; // 新しい層は全再構築で埋める
+  return layers_.size() - 1;
+}
+
+const InfluenceMap::Layer *InfluenceMap::findLayer(int faction) const {
+  for (const Layer &layer : layers_) {
+    if (layer.faction == faction) {
+      return &layer;
+    }
+  }
+  return nullptr;
+}
+
+void InfluenceMap::stamp(std::vector<float> &values, int cellX, int cellY,
+                         float strength, float radius, float sign,
+                         int rowBegin, int rowEnd) const {
+  if (radius <= 0.0f || strength == 0.0f) {
+    return;
+  }
+  const int reach = static_cast<int>(std::ceil(radius / cellSize_));
+  const int firstRow = std::max(rowBegin, cellY - reach);
+  const int lastRow = std::min(rowEnd - 1, cellY + reach);
+  const int firstColumn = std::max(0, cellX - reach);
+  const int lastColumn = std::min(columns_ - 1, cellX + reach);
+  const float inverseRadius = 1.0f / radius;
+
+  for (int y = firstRow; y <= lastRow; ++y) {
+    const float dy = static_cast<float>(y - cellY) * cellSize_;
+    float *row = values.data() + static_cast<size_t>(y) * columns_;
+    for (int x = firstColumn; x <= lastColumn; ++x) {
+      const float dx = static_cast<float>(x - cellX) * cellSize_;
+      const float distance = std::sqrt(dx * dx + dy * dy);
+      if (distance >= radius) {
+        continue;
+      }
+      // 減算時の丸め誤差で負にならないようにする
+      row[x] = std::max(
+          0.0f, row[x] + sign * strength * (1.0f - distance * inverseRadius));
+    }
+  }
+}
@@ -0,0 +1,166 @@
+#ifndef SIMULATION_GAME_INFLUENCE_MAP_H
+#define SIMULATION_GAME_INFLUENCE_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 影響源（ユニット）の SoA スナップショット
+ *
+ * 全配列は同じ要素数。strength は影響の強さ（脅威度）、radius は影響が
+ * 0 になる距離（ワールド単位）。
+ */
+struct InfluenceSources {
+  std::vector<int> ids;
+  std::vector<int> factions;
+  std::vector<float> xs;
+  std::vector<float> ys;
+  std::vector<float> strengths;
+  std::vector<float> radii;
+
+  size_t size() const { return ids.size(); }
+  void clear() {
+    ids.clear();
+    factions.clear();
+    xs.clear();
+    ys.clear();
+    strengths.clear();
+    radii.clear();
+  }
+};
+
+/**
+ * @brief 陣営ごとの影響度（脅威）マップ
+ *
+ * 設計方針：
+ * - マップ全体を粗いセルに分割し、各影響源はセル中心からの距離に応じて
+ *   線形に減衰する影響（strength × (1 - d / radius)）を周囲のセルに加える
+ * - 影響源はセル単位で量子化して記録する。セル・強さ・半径が変わった
+ *   影響源だけ古い寄与を引いて新しい寄与を足す（増分更新）
+ * - 変化が多いときは行帯ごとの全再構築（rebuildRows）に切り替える。
+ *   行帯は互いに独立なので、呼び出し側が並列に実行できる
+ * - 「記憶」レイヤーは max(現在値, 記憶 × 減衰率) で更新し、ユニットが
+ *   去った後もしばらく影響が残る。クエリはこのレイヤーを返す
+ *
+ * 使い方（1 回の更新）：
+ *   beginUpdate(sources) が true なら rebuildRows を全行帯に対して呼び、
+ *   finishRebuild(sources) を呼ぶ。その後 decayRows を全行帯に対して呼ぶ。
+ *
+ * 注意：
+ * - rebuildRows / decayRows 以外のメソッドはスレッドセーフではない
+ * - 陣営レイヤーは、その陣営の影響源が初めて現れた時点で作られる
+ */
+class InfluenceMap {
+public:
+  /**
+   * @brief 変化した影響源の割合がこれを超えたら全再構築する
+   */
+  static constexpr float kFullRebuildFraction = 0.25f;
+
+  /**
+   * @brief 増分更新による浮動小数点誤差を消すため、この回数ごとに全再構築する
+   */
+  static constexpr uint32_t kUpdatesPerForcedRebuild = 256;
+
+  InfluenceMap(float minX, float minY, float maxX, float maxY, float cellSize);
+
+  int getColumns() const { return columns_; }
+  int getRows() const { return rows_; }
+  float getCellSize() const { return cellSize_; }
+
+  /**
+   * @brief ワールド座標のセルを求める（マップ外は最も近いセルに丸める）
+   */
+  void cellAt(float x, float y, int &outCellX, int &outCellY) const;
+
+  /**
+   * @brief 更新を開始する
+   * @param sources 今回の影響源
+   * @return true なら全再構築が必要（rebuildRows → finishRebuild）。
+   *         false なら増分更新はこの中で適用済み
+   */
+  bool beginUpdate(const InfluenceSources &sources);
+
+  /**
+   * @brief 行 [rowBegin, rowEnd) の現在値を影響源から作り直す
+   *
+   * 異なる行帯どうしは並列に呼び出してよい。
+   */
+  void rebuildRows(const InfluenceSources &sources, int rowBegin, int rowEnd);
+
+  /**
+   * @brief 全再構築の後に、増分更新用の記録を影響源に合わせる
+   */
+  void finishRebuild(const InfluenceSources &sources);
+
+  /**
+   * @brief 行 [rowBegin, rowEnd) の記憶レイヤーを減衰させる
+   * @param factor 残す割合（0〜1）
+   *
+   * 異なる行帯どうしは並列に呼び出してよい。
+   */
+  void decayRows(float factor, int rowBegin, int rowEnd);
+
+  /**
+   * @brief 指定陣営の影響度（O(1)）
+   */
+  float getInfluence(int faction, int cellX, int cellY) const;
+
+  /**
+   * @brief 指定陣営以外の全陣営の影響度の合計（陣営数に比例、セル数に非依存）
+   */
+  float getEnemyInfluence(int faction, int cellX, int cellY) const;
+
+  float influenceAt(int faction, float x, float y) const {
+    int cellX = 0;
+    int cellY = 0;
+    cellAt(x, y, cellX, cellY);
+    return getInfluence(faction, cellX, cellY);
+  }
+
+  float enemyInfluenceAt(int faction, float x, float y) const {
+    int cellX = 0;
+    int cellY = 0;
+    cellAt(x, y, cellX, cellY);
+    return getEnemyInfluence(faction, cellX, cellY);
+  }
+
+private:
+  struct Layer {
+    int faction;
+    std::vector<float> current; // 現在の影響源による値
+    std::vector<float> memory;  // 減衰付きの記憶（クエリ対象）
+  };
+
+  struct Stamp {
+    size_t layer;
+    int cellX;
+    int cellY;
+    float strength;
+    float radius;
+    uint64_t seenUpdate;
+  };
+
+  size_t layerIndexFor(int faction);
+  const Layer *findLayer(int faction) const;
+  // 影響源1つ分の寄与を sign（+1 / -1）倍して current に加える
+  void stamp(std::vector<float> &values, int cellX, int cellY, float strength,
+             float radius, float sign, int rowBegin, int rowEnd) const;
+
+  float minX_;
+  float minY_;
+  float cellSize_;
+  int columns_;
+  int rows_;
+
+  std::vector<Layer> layers_;
+  std::unordered_map<int, Stamp> stamps_; // 影響源ID -> 記録済みの寄与
+  std::vector<size_t> sourceLayers_; // beginUpdate で求めた影響源ごとの層
+  uint64_t updateCount_ = 0;
+  uint64_t lastRebuild_ = 0;
+  bool built_ = false;
+};
+
+#endif // SIMULATION_GAME_INFLUENCE_MAP_H
@@ -0,0 +1,134 @@
+#include "LineOfSight.h"
+
+/*
+ * LineOfSight.cpp
+ *
+ * - opacity_ mirrors GameMap tiles as sightOpacity values so that the line
+ * walk reads one float per step instead of going through getTile() and the
+ * TerrainProperties switch. It is rebuilt together with the cache whenever the
+ * map's terrain epoch changes.
+ * - walk() is an integer Bresenham from the lower to the higher tile index,
+ * skipping both end tiles and stopping early once the line is fully blocked.
+ * - Cache keys pack the normalised (low, high) tile pair into 64 bits.
+ */
+#include "../value_objects/TerrainType.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+uint64_t pairKey(uint32_t low, uint32_t high) {
+  return (static_cast<uint64_t>(low) << 32) | high;
+}
+} // namespace
+
+LineOfSight::LineOfSight(const GameMap *gameMap) : gameMap_(gameMap) {}
+
+void LineOfSight::setGameMap(const GameMap *gameMap) {
+  gameMap_ = gameMap;
+  synced_ = false;
+  opacity_.clear();
+  cache_.clear();
+}
+
+int32_t LineOfSight::tileIndexAt(const Position &worldPos) const {
+  int tileX = 0;
+  int tileY = 0;
+  if (!gameMap_ || !gameMap_->worldToTile(worldPos, tileX, tileY)) {
+    return kOutsideMap;
+  }
+  return tileY * gameMap_->getWidth() + tileX;
+}
+
+float LineOfSight::visibilityBetweenTiles(int32_t fromTile, int32_t toTile) {
+  syncWithMap();
+  return lookup(fromTile, toTile);
+}
+
+void LineOfSight::visibilityBatch(const int32_t *fromTiles,
+                                  const int32_t *toTiles, size_t count,
+                                  float *outVisibility) {
+  syncWithMap();
+  for (size_t i = 0; i < count; ++i) {
+    outVisibility[i] = lookup(fromTiles[i], toTiles[i]);
+  }
+}
+
+void LineOfSight::syncWithMap() {
+  if (!gameMap_) {
+    return;
+  }
+  const uint64_t epoch = gameMap_->getTerrainEpoch();
+  if (synced_ && epoch == syncedEpoch_) {
+    return;
+  }
+
+  const int width = gameMap_->getWidth();
+  const int height = gameMap_->getHeight();
+  opacity_.resize(static_cast<size_t>(width) * height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      opacity_[static_cast<size_t>(y) * width + x] =
+          getTerrainProperties(gameMap_->getTile(x, y)).sightOpacity;
+    }
+  }
+  cache_.clear();
+  syncedEpoch_ = epoch;
+  synced_ = true;
+}
+
+float LineOfSight::lookup(int32_t fromTile, int32_t toTile) {
+  if (!gameMap_ || fromTile < 0 || toTile < 0 || fromTile == toTile) {
+    return 1.0f;
+  }
+  const uint32_t low = static_cast<uint32_t>(std::min(fromTile, toTile));
+  const uint32_t high = static_cast<uint32_t>(std::max(fromTile, toTile));
+  const uint64_t key = pairKey(low, high);
+
+  auto found = cache_.find(key);
+  if (found != cache_.end()) {
+    return found->second;
+  }
+  if (cache_.size() >= kMaxCacheEntries) {
+    cache_.clear();
+  }
+  const float visibility =
+      walk(static_cast<int32_t>(low), static_cast<int32_t>(high));
+  cache_.emplace(key, visibility);
+  return visibility;
+}
+
+float LineOfSight::walk(int32_t fromTile, int32_t toTile) const {
+  const int width = gameMap_->getWidth();
+  int x = fromTile % width;
+  int y = fromTile / width;
+  const int endX = toTile % width;
+  const int endY = toTile / width;
+
+  const int deltaX = std::abs(endX - x);
+  const int deltaY = -std::abs(endY - y);
+  const int stepX = x < endX ? 1 : -1;
+  const int stepY = y < endY ? 1 : -1;
+  int error = deltaX + deltaY;
+
+  float visibility = 1.0f;
+  while (true) {
+    const int doubledError = 2 * error;
+    if (doubledError >= deltaY) {
+      error += deltaY;
+      x += stepX;
+    }
+    if (doubledError <= deltaX) {
+      error += deltaX;
+      y += stepY;
+    }
+    if (x == endX && y == endY) {
+      break;
+    }
+    // 途中のタイルだけが視線を遮る
+    visibility *= 1.0f - opacity_[static_cast<size_t>(y) * width + x];
+    if (visibility <= 0.0f) {
+      return 0.0f;
+    }
+  }
+  return visibility;
+}
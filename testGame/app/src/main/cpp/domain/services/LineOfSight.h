@@ -0,0 +1,108 @@
+#ifndef SIMULATION_GAME_LINE_OF_SIGHT_H
+#define SIMULATION_GAME_LINE_OF_SIGHT_H
+
+#include "../entities/GameMap.h"
+#include "../value_objects/Position.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 地形を考慮した視線（LOS）判定とタイル組ごとのキャッシュ
+ *
+ * 設計方針：
+ * - 視線は2つのタイル中心を結ぶ整数グリッド上の直線（Bresenham）で判定し、
+ *   途中のタイルの TerrainProperties::sightOpacity を掛け合わせて
+ *   「見通しの良さ」（0 = 完全に遮断, 1 = 遮るものなし）を求める
+ * - 両端のタイル自体は数えない（森の中にいるユニットからも外は見える）。
+ *   同一・隣接タイルの組は常に 1
+ * - 経路は (小さいタイル番号 -> 大きいタイル番号) に正規化して歩くため、
+ *   A→B と B→A の結果は必ず一致する
+ * - 結果は正規化したタイル組をキーにキャッシュする。GameMap の地形エポック
+ *   が変わった時点（地形編集）でキャッシュを破棄する
+ *
+ * 注意：
+ * - GameMap の所有権は呼び出し側が持つ
+ * - キャッシュを更新するため const クエリではない。スレッド間で共有しない
+ */
+class LineOfSight {
+public:
+  /**
+   * @brief この値未満の見通しは「視線が通らない」とみなす
+   */
+  static constexpr float kBlockedThreshold = 0.05f;
+
+  /**
+   * @brief キャッシュの上限件数（超えたら全破棄して作り直す）
+   */
+  static constexpr size_t kMaxCacheEntries = 1u << 16;
+
+  /**
+   * @brief マップ外を表すタイル番号
+   */
+  static constexpr int32_t kOutsideMap = -1;
+
+  explicit LineOfSight(const GameMap *gameMap = nullptr);
+
+  /**
+   * @brief 判定対象のマップを差し替える（キャッシュは破棄される）
+   */
+  void setGameMap(const GameMap *gameMap);
+
+  /**
+   * @brief ワールド座標をタイル番号に変換する
+   * @return タイル番号（マップ外なら kOutsideMap）
+   *
+   * バッチ判定の入力を作るために使う。番号は地形編集では変わらない。
+   */
+  int32_t tileIndexAt(const Position &worldPos) const;
+
+  /**
+   * @brief 2タイル間の見通しを取得する（キャッシュ利用）
+   * @return 0（遮断）〜 1（遮るものなし）。どちらかがマップ外なら 1
+   */
+  float visibilityBetweenTiles(int32_t fromTile, int32_t toTile);
+
+  /**
+   * @brief 2地点間の見通しを取得する
+   */
+  float visibilityBetween(const Position &from, const Position &to) {
+    return visibilityBetweenTiles(tileIndexAt(from), tileIndexAt(to));
+  }
+
+  /**
+   * @brief 2地点間に視線が通るか
+   */
+  bool hasLineOfSight(const Position &from, const Position &to) {
+    return visibilityBetween(from, to) >= kBlockedThreshold;
+  }
+
+  /**
+   * @brief 複数のタイル組の見通しをまとめて求める
+   * @param fromTiles 視点側のタイル番号配列
+   * @param toTiles 対象側のタイル番号配列
+   * @param count 組の数
+   * @param outVisibility 結果の出力先（count 要素）
+   *
+   * 地形エポックの確認は呼び出し1回につき1度だけ行う。
+   */
+  void visibilityBatch(const int32_t *fromTiles, const int32_t *toTiles,
+                       size_t count, float *outVisibility);
+
+  size_t getCacheSize() const { return cache_.size(); }
+
+private:
+  // 地形エポックを確認し、変わっていれば不透明度表とキャッシュを作り直す
+  void syncWithMap();
+  float lookup(int32_t fromTile, int32_t toTile);
+  float walk(int32_t fromTile, int32_t toTile) const;
+
+  const GameMap *gameMap_;
+  uint64_t syncedEpoch_ = 0;
+  bool synced_ = false;
+  std::vector<float> opacity_; // タイルごとの sightOpacity（行優先）
+  std::unordered_map<uint64_t, float> cache_;
+};
+
+#endif // SIMULATION_GAME_LINE_OF_SIGHT_H
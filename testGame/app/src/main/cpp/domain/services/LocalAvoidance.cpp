@@ -0,0 +1,313 @@
+#include "LocalAvoidance.h"
+
+/*
+ * LocalAvoidance.cpp
+ *
+ * 2D ORCA as described by van den Berg et al. ("Reciprocal n-body collision
+ * avoidance"), without static obstacles:
+ * 1. Pick the k nearest neighbours within neighborDistance.
+ * 2. For each neighbour build one half-plane of permitted velocities. When the
+ * pair already overlaps, the half-plane pushes them apart within one tick.
+ * 3. linearProgram2 finds the velocity closest to the preferred one inside all
+ * half-planes and the max-speed disc. If that is infeasible, linearProgram3
+ * minimises the largest penetration into any half-plane instead.
+ */
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float kEpsilon = 1e-5f;
+
+struct Vec2 {
+  float x;
+  float y;
+};
+
+Vec2 operator+(Vec2 a, Vec2 b) { return {a.x + b.x, a.y + b.y}; }
+Vec2 operator-(Vec2 a, Vec2 b) { return {a.x - b.x, a.y - b.y}; }
+Vec2 operator*(Vec2 a, float s) { return {a.x * s, a.y * s}; }
+float dot(Vec2 a, Vec2 b) { return a.x * b.x + a.y * b.y; }
+float det(Vec2 a, Vec2 b) { return a.x * b.y - a.y * b.x; }
+float lengthSq(Vec2 a) { return dot(a, a); }
+
+Vec2 normalize(Vec2 a) {
+  const float length = std::sqrt(lengthSq(a));
+  return length > 0.0f ? a * (1.0f / length) : Vec2{0.0f, 0.0f};
+}
+
+// 許される速度は direction の左側（det(direction, v - point) <= 0）
+struct OrcaLine {
+  Vec2 point;
+  Vec2 direction;
+};
+
+struct Neighbor {
+  float distanceSq;
+  uint32_t index;
+};
+
+// lineNo の線上で、それ以前の全ての線と半径 radius の円を満たす最適点を探す
+bool linearProgram1(const std::vector<OrcaLine> &lines, size_t lineNo,
+                    float radius, Vec2 optVelocity, bool directionOpt,
+                    Vec2 &result) {
+  const OrcaLine &line = lines[lineNo];
+  const float dotProduct = dot(line.point, line.direction);
+  const float discriminant =
+      dotProduct * dotProduct + radius * radius - lengthSq(line.point);
+  if (discriminant < 0.0f) {
+    return false; // 最大速度の円が線と交わらない
+  }
+
+  const float sqrtDiscriminant = std::sqrt(discriminant);
+  float tLeft = -dotProduct - sqrtDiscriminant;
+  float tRight = -dotProduct + sqrtDiscriminant;
+
+  for (size_t i = 0; i < lineNo; ++i) {
+    const float denominator = det(line.direction, lines[i].direction);
+    const float numerator =
+        det(lines[i].direction, line.point - lines[i].point);
+    if (std::fabs(denominator) <= kEpsilon) {
+      // 平行な線
+      if (numerator < 0.0f) {
+        return false;
+      }
+      continue;
+    }
+    const float t = numerator / denominator;
+    if (denominator >= 0.0f) {
+      tRight = std::min(tRight, t);
+    } else {
+      tLeft = std::max(tLeft, t);
+    }
+    if (tLeft > tRight) {
+      return false;
+    }
+  }
+
+  if (directionOpt) {
+    result = line.point +
+             line.direction * (dot(optVelocity, line.direction) > 0.0f
+                                   ? tRight
+                                   : tLeft);
+  } else {
+    const float t = dot(line.direction, optVelocity - line.point);
+    result = line.point + line.direction * std::clamp(t, tLeft, tRight);
+  }
+  return true;
+}
+
+// 全ての線を満たす最適点を探す。失敗した線の番号（成功なら lines.size()）
+size_t linearProgram2(const std::vector<OrcaLine> &lines, float radius,
+                      Vec2 optVelocity, bool directionOpt, Vec2 &result) {
+  if (directionOpt) {
+    result = optVelocity * radius;
+  } else if (lengthSq(optVelocity) > radius * radius) {
+    result = normalize(optVelocity) * radius;
+  } else {
+    result = optVelocity;
+  }
+
+  for (size_t i = 0; i < lines.size(); ++i) {
+    if (det(lines[i].direction, lines[i].point - result) > 0.0f) {
+      const Vec2 previous = result;
+      if (!linearProgram1(lines, i, radius, optVelocity, directionOpt,
+                          result)) {
+        result = previous;
+        return i;
+      }
+    }
+  }
+  return lines.size();
+}
+
+// 実行不能な場合に、線への最大侵入量が最小になる速度を探す
+void linearProgram3(const std::vector<OrcaLine> &lines, size_t beginLine,
+                    float radius, std::vector<OrcaLine> &projectedLines,
+                    Vec2 &result) {
+  float distance = 0.0f;
+  for (size_t i = beginLine; i < lines.size(); ++i) {
+    if (det(lines[i].direction, lines[i].point - result) <= distance) {
+      continue;
+    }
+    projectedLines.clear();
+    for (size_t j = 0; j < i; ++j) {
+      OrcaLine line;
+      const float determinant = det(lines[i].direction, lines[j].direction);
+      if (std::fabs(determinant) <= kEpsilon) {
+        if (dot(lines[i].direction, lines[j].direction) > 0.0f) {
+          continue; // 同じ向きの平行線
+        }
+        line.point = (lines[i].point + lines[j].point) * 0.5f;
+      } else {
+        line.point = lines[i].point +
+                     lines[i].direction *
+                         (det(lines[j].direction,
+                              lines[i].point - lines[j].point) /
+                          determinant);
+      }
+      line.direction = normalize(lines[j].direction - lines[i].direction);
+      projectedLines.push_back(line);
+    }
+
+    const Vec2 previous = result;
+    const Vec2 perpendicular{-lines[i].direction.y, lines[i].direction.x};
+    if (linearProgram2(projectedLines, radius, perpendicular, true, result) <
+        projectedLines.size()) {
+      // 原理上は起きないが、浮動小数点誤差で失敗した場合は直前の値を保つ
+      result = previous;
+    }
+    distance = det(lines[i].direction, lines[i].point - result);
+  }
+}
+} // namespace
+
+struct LocalAvoidance::Workspace {
+  std::vector<Neighbor> neighbors;
+  std::vector<OrcaLine> lines;
+  std::vector<OrcaLine> projectedLines;
+};
+
+LocalAvoidance::LocalAvoidance(const LocalAvoidanceConfig &config)
+    : config_(config), grid_(config.neighborDistance), workspaces_(1) {}
+
+LocalAvoidance::~LocalAvoidance() = default;
+
+void LocalAvoidance::build(const AvoidanceAgents &agents,
+                           size_t workerCount) {
+  agents_ = &agents;
+  grid_.build(agents.xs.data(), agents.ys.data(), agents.size());
+  if (workspaces_.size() < workerCount) {
+    workspaces_.resize(workerCount);
+  }
+}
+
+void LocalAvoidance::computeVelocities(size_t begin, size_t end,
+                                       float timeStep, float *outXs,
+                                       float *outYs, size_t worker) const {
+  if (!agents_ || worker >= workspaces_.size()) {
+    return;
+  }
+  const AvoidanceAgents &agents = *agents_;
+  const float invTimeHorizon = 1.0f / std::max(config_.timeHorizon, kEpsilon);
+  const float invTimeStep = 1.0f / std::max(timeStep, kEpsilon);
+
+  // 作業領域は前の呼び出しの容量をそのまま使う（範囲は1スレッドが担当する）
+  Workspace &workspace = workspaces_[worker];
+  std::vector<Neighbor> &neighbors = workspace.neighbors;
+  neighbors.reserve(config_.maxNeighbors + 1);
+  std::vector<OrcaLine> &lines = workspace.lines;
+  lines.reserve(config_.maxNeighbors);
+  std::vector<OrcaLine> &projectedLines = workspace.projectedLines;
+
+  for (size_t i = begin; i < end; ++i) {
+    if (!agents.movable[i]) {
+      outXs[i] = 0.0f;
+      outYs[i] = 0.0f;
+      continue;
+    }
+    const Vec2 position{agents.xs[i], agents.ys[i]};
+    const Vec2 velocity{agents.velocityXs[i], agents.velocityYs[i]};
+    const Vec2 preferred{agents.preferredXs[i], agents.preferredYs[i]};
+    const float radius = agents.radii[i];
+
+    // 近い順に最大 maxNeighbors 体（挿入ソート。k は小さい）
+    neighbors.clear();
+    grid_.forEachInRadius(
+        position.x, position.y, config_.neighborDistance,
+        [&](uint32_t index, float distanceSq) {
+          if (index == i || config_.maxNeighbors == 0) {
+            return;
+          }
+          if (neighbors.size() == config_.maxNeighbors &&
+              distanceSq >= neighbors.back().distanceSq) {
+            return;
+          }
+          if (neighbors.size() < config_.maxNeighbors) {
+            neighbors.push_back({distanceSq, index});
+          } else {
+            neighbors.back() = {distanceSq, index};
+          }
+          for (size_t k = neighbors.size() - 1; k > 0; --k) {
+            const bool outOfOrder =
+                neighbors[k].distanceSq < neighbors[k - 1].distanceSq ||
+                (neighbors[k].distanceSq == neighbors[k - 1].distanceSq &&
+                 neighbors[k].index < neighbors[k - 1].index);
+            if (!outOfOrder) {
+              break;
+            }
+            std::swap(neighbors[k], neighbors[k - 1]);
+          }
+        });
+
+    lines.clear();
+    for (const Neighbor &neighbor : neighbors) {
+      const uint32_t j = neighbor.index;
+      const Vec2 relativePosition = Vec2{agents.xs[j], agents.ys[j]} - position;
+      const Vec2 otherVelocity{agents.velocityXs[j], agents.velocityYs[j]};
+      const Vec2 relativeVelocity = velocity - otherVelocity;
+      const float distanceSq = lengthSq(relativePosition);
+      const float combinedRadius = radius + agents.radii[j];
+      const float combinedRadiusSq = combinedRadius * combinedRadius;
+
+      OrcaLine line;
+      Vec2 u;
+      if (distanceSq > combinedRadiusSq) {
+        // まだ重なっていない: 時間 timeHorizon の速度障害物
+        const Vec2 w = relativeVelocity - relativePosition * invTimeHorizon;
+        const float wLengthSq = lengthSq(w);
+        const float dotProduct = dot(w, relativePosition);
+        if (dotProduct < 0.0f &&
+            dotProduct * dotProduct > combinedRadiusSq * wLengthSq) {
+          // 切り口の円に射影
+          const float wLength = std::sqrt(wLengthSq);
+          const Vec2 unitW = w * (1.0f / wLength);
+          line.direction = {unitW.y, -unitW.x};
+          u = unitW * (combinedRadius * invTimeHorizon - wLength);
+        } else {
+          // 円錐の脚に射影
+          const float leg = std::sqrt(distanceSq - combinedRadiusSq);
+          if (det(relativePosition, w) > 0.0f) {
+            line.direction =
+                Vec2{relativePosition.x * leg -
+                         relativePosition.y * combinedRadius,
+                     relativePosition.x * combinedRadius +
+                         relativePosition.y * leg} *
+                (1.0f / distanceSq);
+          } else {
+            line.direction =
+                Vec2{relativePosition.x * leg +
+                         relativePosition.y * combinedRadius,
+                     -relativePosition.x * combinedRadius +
+                         relativePosition.y * leg} *
+                (-1.0f / distanceSq);
+          }
+          u = line.direction * dot(relativeVelocity, line.direction) -
+              relativeVelocity;
+        }
+      } else {
+        // 既に重なっている: 1ティックで離れる速度を要求する
+        const Vec2 w = relativeVelocity - relativePosition * invTimeStep;
+        const float wLength = std::sqrt(lengthSq(w));
+        const Vec2 unitW =
+            wLength > 0.0f ? w * (1.0f / wLength) : Vec2{0.0f, 1.0f};
+        line.direction = {unitW.y, -unitW.x};
+        u = unitW * (combinedRadius * invTimeStep - wLength);
+      }
+
+      // 相手も回避するなら半分、動かない相手なら全てをこちらが負担する
+      const float responsibility = agents.movable[j] ? 0.5f : 1.0f;
+      line.point = velocity + u * responsibility;
+      lines.push_back(line);
+    }
+
+    Vec2 result{0.0f, 0.0f};
+    const float maxSpeed = agents.maxSpeeds[i];
+    const size_t failedLine =
+        linearProgram2(lines, maxSpeed, preferred, false, result);
+    if (failedLine < lines.size()) {
+      linearProgram3(lines, failedLine, maxSpeed, projectedLines, result);
+    }
+    outXs[i] = result.x;
+    outYs[i] = result.y;
+  }
+}
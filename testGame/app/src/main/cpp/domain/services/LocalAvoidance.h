@@ -0,0 +1,119 @@
+#ifndef SIMULATION_GAME_LOCAL_AVOIDANCE_H
+#define SIMULATION_GAME_LOCAL_AVOIDANCE_H
+
+#include "SpatialHashGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 局所回避の設定
+ */
+struct LocalAvoidanceConfig {
+  float neighborDistance = 2.0f; // 近傍として考慮する中心間距離
+  size_t maxNeighbors = 8;       // 1体あたりに考慮する近傍の上限（近い順）
+  float timeHorizon = 1.0f;      // この秒数以内の衝突を回避する
+};
+
+/**
+ * @brief 局所回避の入力（1ティック分のスナップショット, SoA）
+ *
+ * movable が 0 のエージェントは速度を求めない（止まっている・戦闘中など）。
+ * 近傍としては参加し、相手側が回避を全面的に引き受ける。
+ */
+struct AvoidanceAgents {
+  std::vector<float> xs;
+  std::vector<float> ys;
+  std::vector<float> velocityXs;  // 前ティックの速度
+  std::vector<float> velocityYs;
+  std::vector<float> preferredXs; // 目標へ向かう希望速度
+  std::vector<float> preferredYs;
+  std::vector<float> radii;
+  std::vector<float> maxSpeeds;
+  std::vector<uint8_t> movable;
+
+  size_t size() const { return xs.size(); }
+
+  void clear() {
+    xs.clear();
+    ys.clear();
+    velocityXs.clear();
+    velocityYs.clear();
+    preferredXs.clear();
+    preferredYs.clear();
+    radii.clear();
+    maxSpeeds.clear();
+    movable.clear();
+  }
+
+  void push(float x, float y, float velocityX, float velocityY,
+            float preferredX, float preferredY, float radius, float maxSpeed,
+            bool canMove) {
+    xs.push_back(x);
+    ys.push_back(y);
+    velocityXs.push_back(velocityX);
+    velocityYs.push_back(velocityY);
+    preferredXs.push_back(preferredX);
+    preferredYs.push_back(preferredY);
+    radii.push_back(radius);
+    maxSpeeds.push_back(maxSpeed);
+    movable.push_back(canMove ? 1 : 0);
+  }
+};
+
+/**
+ * @brief ORCA（Optimal Reciprocal Collision Avoidance）による局所回避
+ *
+ * 設計方針：
+ * - 各近傍との速度障害物から半平面（ORCA 線）を作り、その共通部分のうち
+ *   希望速度に最も近い速度を2次元の線形計画で求める
+ * - 近傍は SpatialHashGrid から近い順に最大 maxNeighbors 体だけ取るため、
+ *   全体で O(N·k)。密集地でも1体あたりのコストは一定
+ * - 互いに動けるペアは回避を半分ずつ負担する（相互回避）。相手が動かない
+ *   場合は自分が全て負担する
+ * - build() 後の computeVelocities() はエージェントを読むだけで、出力範囲と
+ *   作業領域の番号が重ならない限り複数スレッドから同時に呼べる
+ * - 近傍と ORCA 線の作業領域は呼び出しをまたいで使い回し、ティックごとに
+ *   確保しない
+ *
+ * 注意：
+ * - 地形は考慮しない。求めた速度の地形による補正は呼び出し側の責任
+ */
+class LocalAvoidance {
+public:
+  explicit LocalAvoidance(
+      const LocalAvoidanceConfig &config = LocalAvoidanceConfig());
+  ~LocalAvoidance();
+
+  const LocalAvoidanceConfig &getConfig() const { return config_; }
+
+  /**
+   * @brief 近傍探索用のグリッドを構築する
+   * @param agents このティックのスナップショット（computeVelocities の間は
+   *               変更しないこと）
+   * @param workerCount computeVelocities を同時に呼ぶ数（作業領域の数）
+   */
+  void build(const AvoidanceAgents &agents, size_t workerCount = 1);
+
+  /**
+   * @brief [begin, end) のエージェントの新しい速度を求める
+   * @param timeStep ティックの長さ（既に重なっている場合の押し出しに使う）
+   * @param outXs, outYs 出力先（agents と同じ長さ）。movable でない
+   *                     エージェントには 0 を書く
+   * @param worker 使う作業領域（[0, workerCount)。同時に呼ぶ呼び出しどうしで
+   *               重ならないこと）
+   */
+  void computeVelocities(size_t begin, size_t end, float timeStep,
+                         float *outXs, float *outYs, size_t worker = 0) const;
+
+private:
+  struct Workspace; // 近傍と ORCA 線の作業領域（LocalAvoidance.cpp で定義）
+
+  LocalAvoidanceConfig config_;
+  const AvoidanceAgents *agents_ = nullptr;
+  SpatialHashGrid grid_;
+  // 作業領域は計算結果に影響しないため、const の計算中も書き換える
+  mutable std::vector<Workspace> workspaces_;
+};
+
+#endif // SIMULATION_GAME_LOCAL_AVOIDANCE_H
@@ -0,0 +1,131 @@
+#include "MoveRange.h"
+
+/*
+ * MoveRange.cpp
+ *
+ * Every edge costs at least one quantized unit, so a tile popped from bucket
+ * c only pushes into later buckets and each bucket is drained exactly once.
+ * Entries whose cost was lowered after they were pushed are skipped when
+ * popped (lazy deletion) instead of being searched for and removed.
+ */
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int kNeighborX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+constexpr int kNeighborY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+constexpr float kDiagonalStep = 1.41421356f;
+
+} // namespace
+
+void MoveRange::prepare(const GameMap &map) {
+  if (map.getWidth() == width_ && map.getHeight() == height_) {
+    return;
+  }
+  width_ = map.getWidth();
+  height_ = map.getHeight();
+  const size_t count = static_cast<size_t>(width_) * height_;
+  mask_.assign((count + 63) / 64, 0);
+  costs_.assign(count, kUnreached);
+  touched_.clear();
+  reached_.clear();
+}
+
+void MoveRange::clearPrevious() {
+  for (uint32_t index : touched_) {
+    costs_[index] = kUnreached;
+    mask_[index / 64] &= ~(uint64_t{1} << (index % 64));
+  }
+  touched_.clear();
+  reached_.clear();
+}
+
+float MoveRange::getCost(int x, int y) const {
+  if (!isReachable(x, y)) {
+    return -1.0f;
+  }
+  return static_cast<float>(costs_[static_cast<size_t>(y) * width_ + x]) /
+         static_cast<float>(kCostScale);
+}
+
+size_t MoveRange::compute(const GameMap &map, const Position &start,
+                          float budget, float radius) {
+  prepare(map);
+  clearPrevious();
+
+  int startX = 0;
+  int startY = 0;
+  if (!map.worldToTile(start, startX, startY) ||
+      !map.isTilePassable(startX, startY, radius)) {
+    return 0;
+  }
+
+  const uint32_t budgetUnits = static_cast<uint32_t>(std::min(
+      std::max(budget, 0.0f) * static_cast<float>(kCostScale),
+      static_cast<float>(kUnreached - 1)));
+  if (buckets_.size() < budgetUnits + 1) {
+    buckets_.resize(budgetUnits + 1);
+  }
+
+  const uint32_t startIndex =
+      static_cast<uint32_t>(startY) * static_cast<uint32_t>(width_) + startX;
+  costs_[startIndex] = 0;
+  touched_.push_back(startIndex);
+  buckets_[0].push_back(startIndex);
+
+  for (uint32_t cost = 0; cost <= budgetUnits; ++cost) {
+    std::vector<uint32_t> &bucket = buckets_[cost];
+    for (uint32_t index : bucket) {
+      if (costs_[index] != cost) {
+        continue; // より安い経路で先に確定済み
+      }
+      mask_[index / 64] |= uint64_t{1} << (index % 64);
+      reached_.push_back(index);
+
+      const int x = static_cast<int>(index % width_);
+      const int y = static_cast<int>(index / width_);
+      for (int n = 0; n < 8; ++n) {
+        const int nx = x + kNeighborX[n];
+        const int ny = y + kNeighborY[n];
+        if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) {
+          continue;
+        }
+        const uint32_t next =
+            static_cast<uint32_t>(ny) * static_cast<uint32_t>(width_) + nx;
+        if (costs_[next] <= cost) {
+          continue; // 確定済み（コストは非負なので戻ることはない）
+        }
+        const bool diagonal = n >= 4;
+        // 角を切る斜め移動は、両側のタイルが通れるときだけ
+        if (!map.isTilePassable(nx, ny, radius) ||
+            (diagonal && (!map.isTilePassable(nx, y, radius) ||
+                          !map.isTilePassable(x, ny, radius)))) {
+          continue;
+        }
+        const float multiplier =
+            getTerrainProperties(map.getTile(nx, ny)).movementSpeedMultiplier;
+        if (multiplier <= 0.0f) {
+          continue;
+        }
+        const float step = diagonal ? kDiagonalStep : 1.0f;
+        const float edge =
+            std::max(1.0f, std::round(step * static_cast<float>(kCostScale) /
+                                      multiplier));
+        if (edge > static_cast<float>(budgetUnits - cost)) {
+          continue;
+        }
+        const uint32_t nextCost = cost + static_cast<uint32_t>(edge);
+        if (nextCost < costs_[next]) {
+          if (costs_[next] == kUnreached) {
+            touched_.push_back(next);
+          }
+          costs_[next] = static_cast<uint16_t>(nextCost);
+          buckets_[nextCost].push_back(next);
+        }
+      }
+    }
+    bucket.clear();
+  }
+  return reached_.size();
+}
@@ -0,0 +1,94 @@
+#ifndef SIMULATION_GAME_MOVE_RANGE_H
+#define SIMULATION_GAME_MOVE_RANGE_H
+
+#include "../entities/GameMap.h"
+#include "../value_objects/Position.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 選択したユニットがこのターンに到達できるタイルを求める
+ *        （移動範囲の表示用）
+ *
+ * 設計方針：
+ * - 開始タイルからの上限付き Dijkstra。コストは移動ポイントで、草原の
+ *   1タイル（辺の長さ）が 1。タイルに入るコストは歩幅 / 地形の速度倍率、
+ *   斜めは √2 倍（角を切る斜め移動は両側が通れるときだけ）
+ * - コストを 1/kCostScale ポイント単位の整数に量子化し、バケットキュー
+ *   （コスト値ごとのリスト）で取り出す。ヒープを使わず、上限までの
+ *   バケットを順に見るだけで済む
+ * - 作業領域（コスト・バケット・触れたタイルの一覧）はマップの大きさで
+ *   1回確保して使い回す。前回の結果は触れたタイルだけを戻して消すので、
+ *   1回の問い合わせは到達範囲の大きさにだけ比例する
+ * - ユニットの衝突半径はクリアランス層で判定する（クリアランスが半径
+ *   以上のタイルだけ通れる。GameMap::isTilePassable）。層が古い場合は
+ *   タイル中心での GameMap::isWalkable(radius) で代用する
+ *
+ * 注意：
+ * - 結果（マスクとコスト）は次の compute まで有効
+ */
+class MoveRange {
+public:
+  // 1 移動ポイントあたりの量子化単位
+  static constexpr uint32_t kCostScale = 16;
+  static constexpr uint16_t kUnreached = UINT16_MAX;
+
+  /**
+   * @brief 到達範囲を求める
+   * @param start ユニットの位置（この位置のタイルから始める）
+   * @param budget 移動ポイント（1 = 草原 1 タイル）。量子化後に
+   *        kUnreached 未満に収まるよう切り詰める
+   * @param radius ユニットの衝突半径
+   * @return 到達できるタイルの数（開始位置がマップ外・通行不能なら 0）
+   */
+  size_t compute(const GameMap &map, const Position &start, float budget,
+                 float radius);
+
+  int getWidth() const { return width_; }
+  int getHeight() const { return height_; }
+
+  /**
+   * @brief タイルに到達できるか
+   */
+  bool isReachable(int x, int y) const {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+      return false;
+    }
+    const size_t index = static_cast<size_t>(y) * width_ + x;
+    return (mask_[index / 64] >> (index % 64)) & 1u;
+  }
+
+  /**
+   * @brief 到達に必要な移動ポイント（到達できなければ負）
+   */
+  float getCost(int x, int y) const;
+
+  /**
+   * @brief 到達マスク（1ビット = 1タイル、行優先）と量子化コスト
+   *        （kCostScale 単位、到達できないタイルは kUnreached）
+   */
+  const std::vector<uint64_t> &getMask() const { return mask_; }
+  const std::vector<uint16_t> &getCosts() const { return costs_; }
+
+  /**
+   * @brief 到達できるタイルの番号（y * width + x、確定した順）
+   */
+  const std::vector<uint32_t> &getReachedTiles() const { return reached_; }
+
+private:
+  // マップの大きさが変わったときだけ作業領域を確保し直す
+  void prepare(const GameMap &map);
+  // 前回の結果を消す（触れたタイルだけ）
+  void clearPrevious();
+
+  int width_ = 0;
+  int height_ = 0;
+  std::vector<uint64_t> mask_;
+  std::vector<uint16_t> costs_;
+  std::vector<uint32_t> touched_; // コストを書き込んだタイル
+  std::vector<uint32_t> reached_;
+  std::vector<std::vector<uint32_t>> buckets_; // コスト -> タイル
+};
+
+#endif // SIMULATION_GAME_MOVE_RANGE_H
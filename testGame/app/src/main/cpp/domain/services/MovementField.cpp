@@ -0,0 +1,165 @@
+#include "MovementField.h"
+
+/*
+ * MovementField.cpp
+ *
+ * Obstacles are bucketed by the cells their bounding box overlaps, so an
+ * obstacle can be visited more than once by a query spanning several cells.
+ * All queries here are boolean, which makes the duplicates harmless and
+ * saves a per-query visited set.
+ */
+#include "../entities/GameMap.h"
+#include <cmath>
+
+MovementField::MovementField(float minX, float minY, float maxX, float maxY,
+                             float cellSize)
+    : minX_(minX), minY_(minY), maxX_(maxX), maxY_(maxY),
+      cellSize_(cellSize > 0.0f ? cellSize : 1.0f) {
+  cellsX_ = std::max(1, static_cast<int>(std::ceil((maxX_ - minX_) /
+                                                   cellSize_)));
+  cellsY_ = std::max(1, static_cast<int>(std::ceil((maxY_ - minY_) /
+                                                   cellSize_)));
+  cells_.resize(static_cast<size_t>(cellsX_) * cellsY_);
+}
+
+void MovementField::cellRange(float minX, float minY, float maxX, float maxY,
+                              int &cellX0, int &cellY0, int &cellX1,
+                              int &cellY1) const {
+  auto toCell = [&](float coordinate, float origin, int cells) {
+    const int cell =
+        static_cast<int>(std::floor((coordinate - origin) / cellSize_));
+    return std::max(0, std::min(cells - 1, cell));
+  };
+  cellX0 = toCell(minX, minX_, cellsX_);
+  cellX1 = toCell(maxX, minX_, cellsX_);
+  cellY0 = toCell(minY, minY_, cellsY_);
+  cellY1 = toCell(maxY, minY_, cellsY_);
+}
+
+void MovementField::addCircleObstacle(const Position &center, float radius) {
+  const uint32_t index = static_cast<uint32_t>(obstacles_.size());
+  obstacles_.push_back({center, radius});
+  int cellX0 = 0;
+  int cellY0 = 0;
+  int cellX1 = 0;
+  int cellY1 = 0;
+  cellRange(center.getX() - radius, center.getY() - radius,
+            center.getX() + radius, center.getY() + radius, cellX0, cellY0,
+            cellX1, cellY1);
+  for (int cy = cellY0; cy <= cellY1; ++cy) {
+    for (int cx = cellX0; cx <= cellX1; ++cx) {
+      cells_[static_cast<size_t>(cy) * cellsX_ + cx].push_back(index);
+    }
+  }
+}
+
+bool MovementField::isWalkable(const Position &p, float clearance) const {
+  if (!isInsideBounds(p)) {
+    return false;
+  }
+  if (obstacles_.empty()) {
+    return true;
+  }
+  int cellX0 = 0;
+  int cellY0 = 0;
+  int cellX1 = 0;
+  int cellY1 = 0;
+  cellRange(p.getX() - clearance, p.getY() - clearance, p.getX() + clearance,
+            p.getY() + clearance, cellX0, cellY0, cellX1, cellY1);
+  for (int cy = cellY0; cy <= cellY1; ++cy) {
+    for (int cx = cellX0; cx <= cellX1; ++cx) {
+      for (uint32_t index : cells_[static_cast<size_t>(cy) * cellsX_ + cx]) {
+        const CircleObstacle &o = obstacles_[index];
+        const float dx = p.getX() - o.center.getX();
+        const float dy = p.getY() - o.center.getY();
+        const float minDist = o.radius + clearance;
+        if (dx * dx + dy * dy < minDist * minDist) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool MovementField::isSegmentClear(const Position &start, const Position &end,
+                                   float clearance) const {
+  if (!isInsideBounds(start) || !isInsideBounds(end)) {
+    return false;
+  }
+  if (obstacles_.empty()) {
+    return true;
+  }
+  const float segX = end.getX() - start.getX();
+  const float segY = end.getY() - start.getY();
+  const float lengthSq = segX * segX + segY * segY;
+
+  int cellX0 = 0;
+  int cellY0 = 0;
+  int cellX1 = 0;
+  int cellY1 = 0;
+  cellRange(std::min(start.getX(), end.getX()) - clearance,
+            std::min(start.getY(), end.getY()) - clearance,
+            std::max(start.getX(), end.getX()) + clearance,
+            std::max(start.getY(), end.getY()) + clearance, cellX0, cellY0,
+            cellX1, cellY1);
+  for (int cy = cellY0; cy <= cellY1; ++cy) {
+    for (int cx = cellX0; cx <= cellX1; ++cx) {
+      for (uint32_t index : cells_[static_cast<size_t>(cy) * cellsX_ + cx]) {
+        const CircleObstacle &o = obstacles_[index];
+        // 線分上で障害物の中心に最も近い点
+        float t = 0.0f;
+        if (lengthSq > 0.0f) {
+          t = ((o.center.getX() - start.getX()) * segX +
+               (o.center.getY() - start.getY()) * segY) /
+              lengthSq;
+          t = std::max(0.0f, std::min(1.0f, t));
+        }
+        const float dx = start.getX() + segX * t - o.center.getX();
+        const float dy = start.getY() + segY * t - o.center.getY();
+        const float minDist = o.radius + clearance;
+        if (dx * dx + dy * dy < minDist * minDist) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+size_t MovementField::rasterizeInto(GameMap &map) const {
+  const float tileSize = map.getTileSize();
+  size_t blocked = 0;
+  for (const CircleObstacle &o : obstacles_) {
+    const int tileX0 = static_cast<int>(
+        std::floor((o.center.getX() - o.radius - map.getMinX()) / tileSize));
+    const int tileX1 = static_cast<int>(
+        std::floor((o.center.getX() + o.radius - map.getMinX()) / tileSize));
+    const int tileY0 = static_cast<int>(
+        std::floor((o.center.getY() - o.radius - map.getMinY()) / tileSize));
+    const int tileY1 = static_cast<int>(
+        std::floor((o.center.getY() + o.radius - map.getMinY()) / tileSize));
+    for (int ty = std::max(0, tileY0);
+         ty <= std::min(map.getHeight() - 1, tileY1); ++ty) {
+      for (int tx = std::max(0, tileX0);
+           tx <= std::min(map.getWidth() - 1, tileX1); ++tx) {
+        // タイルの矩形で円の中心に最も近い点が円の内側なら塞ぐ
+        const float tileMinX = map.getMinX() + tx * tileSize;
+        const float tileMinY = map.getMinY() + ty * tileSize;
+        const float closestX = std::max(
+            tileMinX, std::min(o.center.getX(), tileMinX + tileSize));
+        const float closestY = std::max(
+            tileMinY, std::min(o.center.getY(), tileMinY + tileSize));
+        const float dx = o.center.getX() - closestX;
+        const float dy = o.center.getY() - closestY;
+        if (dx * dx + dy * dy < o.radius * o.radius &&
+            !map.isTileBlocked(tx, ty)) {
+          map.setTileBlocked(tx, ty, true);
+          ++blocked;
+        }
+      }
+    }
+  }
+  map.rebuildClearance();
+  return blocked;
+}
@@ -2,8 +2,27 @@
 #define SIMULATION_GAME_MOVEMENT_FIELD_H
 
 #include "../value_objects/Position.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
+class GameMap;
+
+/**
+ * @brief 移動範囲（矩形）と円形の静的障害物（小物など）
+ *
+ * 設計方針：
+ * - 障害物は固定サイズのセルに区切った一様グリッドに登録する。各障害物は
+ *   外接矩形が重なるすべてのセルに入るので、点や線分の判定は
+ *   「問い合わせ範囲 + clearance」が重なるセルの障害物だけを見ればよい
+ * - 障害物は配置時に1回登録するだけで、以後の判定で作り直さない
+ * - rasterizeInto で障害物を GameMap の通行レイヤーへ焼き込むと、地形と
+ *   障害物を1回のタイル参照で判定でき、クリアランス層にも反映される
+ *
+ * 注意：
+ * - 焼き込みは障害物の円に少しでも掛かるタイルを塞ぐ（安全側）
+ */
 class MovementField {
 public:
   struct CircleObstacle {
@@ -11,11 +30,17 @@ public:
     float radius;
   };
 
-  MovementField(float minX, float minY, float maxX, float maxY)
-      : minX_(minX), minY_(minY), maxX_(maxX), maxY_(maxY) {}
+  /**
+   * @param cellSize 障害物グリッドのセルの一辺
+   */
+  MovementField(float minX, float minY, float maxX, float maxY,
+                float cellSize = 2.0f);
+
+  void addCircleObstacle(const Position &center, float radius);
 
-  void addCircleObstacle(const Position &center, float radius) {
-    obstacles_.push_back({center, radius});
+  size_t getObstacleCount() const { return obstacles_.size(); }
+  const std::vector<CircleObstacle> &getObstacles() const {
+    return obstacles_;
   }
 
   bool isInsideBounds(const Position &p) const {
@@ -25,19 +50,20 @@ public:
 
   // clearance: required distance from obstacle centers (e.g. movingRadius +
   // otherRadius)
-  bool isWalkable(const Position &p, float clearance = 0.0f) const {
-    if (!isInsideBounds(p))
-      return false;
-    for (const auto &o : obstacles_) {
-      float dx = p.getX() - o.center.getX();
-      float dy = p.getY() - o.center.getY();
-      float dist2 = dx * dx + dy * dy;
-      float minDist = (o.radius + clearance);
-      if (dist2 < (minDist * minDist))
-        return false;
-    }
-    return true;
-  }
+  bool isWalkable(const Position &p, float clearance = 0.0f) const;
+
+  /**
+   * @brief 線分 start -> end を clearance の円が通れるか（掃引判定）
+   */
+  bool isSegmentClear(const Position &start, const Position &end,
+                      float clearance = 0.0f) const;
+
+  /**
+   * @brief 障害物の掛かるタイルを GameMap の通行レイヤーで塞ぎ、
+   *        クリアランス層を作り直す
+   * @return 塞いだタイルの数
+   */
+  size_t rasterizeInto(GameMap &map) const;
 
   // Snap position into bounds (clamp)
   Position snapInside(const Position &p) const {
@@ -47,8 +73,16 @@ public:
   }
 
 private:
+  // 矩形 [minX, maxX] x [minY, maxY] に重なるセルの範囲（グリッド外は端へ）
+  void cellRange(float minX, float minY, float maxX, float maxY, int &cellX0,
+                 int &cellY0, int &cellX1, int &cellY1) const;
+
   float minX_, minY_, maxX_, maxY_;
+  float cellSize_;
+  int cellsX_;
+  int cellsY_;
   std::vector<CircleObstacle> obstacles_;
+  std::vector<std::vector<uint32_t>> cells_; // セル -> 障害物の番号
 };
 
 #endif // SIMULATION_GAME_MOVEMENT_FIELD_H
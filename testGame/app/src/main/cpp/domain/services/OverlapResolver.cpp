@@ -0,0 +1,118 @@
+#include "OverlapResolver.h"
+
+/*
+ * OverlapResolver.cpp
+ *
+ * Each pair is pushed apart symmetrically along the line between the centres
+ * by half of its penetration depth per iteration. Coincident centres use a
+ * fixed +X normal so the result does not depend on rounding noise. After each
+ * iteration the moved points are clamped into the map; a point that would end
+ * up on impassable terrain keeps its last valid position.
+ */
+#include "../entities/GameMap.h"
+#include <algorithm>
+#include <cmath>
+
+OverlapResolver::OverlapResolver(const OverlapResolverConfig &config)
+    : config_(config) {}
+
+size_t OverlapResolver::solve(float *xs, float *ys, const float *radii,
+                              size_t count, const GameMap *gameMap) {
+  pairs_.clear();
+  involved_.clear();
+  if (count < 2) {
+    return 0;
+  }
+
+  float maxRadius = 0.0f;
+  for (size_t i = 0; i < count; ++i) {
+    maxRadius = std::max(maxRadius, radii[i]);
+  }
+  if (maxRadius <= 0.0f) {
+    return 0;
+  }
+  grid_.setCellSize(2.0f * maxRadius);
+  grid_.build(xs, ys, count);
+
+  for (size_t i = 0; i < count; ++i) {
+    const size_t pairsBefore = pairs_.size();
+    grid_.forEachInRadius(
+        xs[i], ys[i], radii[i] + maxRadius,
+        [&](uint32_t j, float distanceSq) {
+          if (j <= i) {
+            return; // 各ペアは小さい方のインデックスから1回だけ
+          }
+          const float combined = radii[i] + radii[j] - config_.slop;
+          if (combined > 0.0f && distanceSq < combined * combined) {
+            pairs_.push_back({static_cast<uint32_t>(i), j});
+          }
+        });
+    // グリッドの列挙順はセル順なので、相手のインデックス順に揃える
+    std::sort(pairs_.begin() + pairsBefore, pairs_.end(),
+              [](const Pair &lhs, const Pair &rhs) {
+                return lhs.second < rhs.second;
+              });
+  }
+  if (pairs_.empty()) {
+    return 0;
+  }
+
+  for (const Pair &pair : pairs_) {
+    involved_.push_back(pair.first);
+    involved_.push_back(pair.second);
+  }
+  std::sort(involved_.begin(), involved_.end());
+  involved_.erase(std::unique(involved_.begin(), involved_.end()),
+                  involved_.end());
+
+  if (gameMap) {
+    validXs_.resize(count);
+    validYs_.resize(count);
+    for (uint32_t index : involved_) {
+      validXs_[index] = xs[index];
+      validYs_[index] = ys[index];
+    }
+  }
+
+  for (int iteration = 0; iteration < config_.iterations; ++iteration) {
+    for (const Pair &pair : pairs_) {
+      const uint32_t a = pair.first;
+      const uint32_t b = pair.second;
+      const float dx = xs[b] - xs[a];
+      const float dy = ys[b] - ys[a];
+      const float distanceSq = dx * dx + dy * dy;
+      const float combined = radii[a] + radii[b];
+      if (distanceSq >= combined * combined) {
+        continue;
+      }
+      const float distance = std::sqrt(distanceSq);
+      float normalX = 1.0f;
+      float normalY = 0.0f;
+      if (distance > 1e-6f) {
+        normalX = dx / distance;
+        normalY = dy / distance;
+      }
+      const float push = 0.5f * (combined - distance);
+      xs[a] -= normalX * push;
+      ys[a] -= normalY * push;
+      xs[b] += normalX * push;
+      ys[b] += normalY * push;
+    }
+
+    if (!gameMap) {
+      continue;
+    }
+    for (uint32_t index : involved_) {
+      const Position clamped =
+          gameMap->clampInside(Position(xs[index], ys[index]), radii[index]);
+      if (gameMap->isWalkable(clamped, radii[index])) {
+        validXs_[index] = xs[index] = clamped.getX();
+        validYs_[index] = ys[index] = clamped.getY();
+      } else {
+        xs[index] = validXs_[index];
+        ys[index] = validYs_[index];
+      }
+    }
+  }
+  return pairs_.size();
+}
@@ -0,0 +1,63 @@
+#ifndef SIMULATION_GAME_OVERLAP_RESOLVER_H
+#define SIMULATION_GAME_OVERLAP_RESOLVER_H
+
+#include "SpatialHashGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class GameMap;
+
+/**
+ * @brief 重なり解消の設定
+ */
+struct OverlapResolverConfig {
+  int iterations = 4;  // 緩和の反復回数（固定）
+  float slop = 0.001f; // これ以下の重なりは許容する（振動を防ぐ）
+};
+
+/**
+ * @brief 円同士の重なりを位置ベースの緩和で解消する
+ *
+ * 設計方針：
+ * - 重なっているペアを SpatialHashGrid で1回だけ集め、(i, j) の昇順に
+ *   並べる。各反復ではそのペアを順に押し離す（ガウス・ザイデル法）
+ * - 反復回数は固定。1ティックで解けなかった分は次のティックに持ち越す
+ * - 各反復の後、動いた点だけを地形で補正する（マップ外はクランプし、
+ *   通行不能な位置へは動かさない）
+ * - 入力の並びとペアの順序だけで結果が決まる（決定的）
+ *
+ * 注意：
+ * - 反復中に新しく生じた重なりは次回の solve で拾う
+ */
+class OverlapResolver {
+public:
+  explicit OverlapResolver(
+      const OverlapResolverConfig &config = OverlapResolverConfig());
+
+  const OverlapResolverConfig &getConfig() const { return config_; }
+
+  /**
+   * @brief 重なりを解消する（xs, ys をその場で書き換える）
+   * @param radii 各点の半径
+   * @param gameMap 地形（nullptr なら補正しない）
+   * @return 見つかった重なりペアの数
+   */
+  size_t solve(float *xs, float *ys, const float *radii, size_t count,
+               const GameMap *gameMap);
+
+private:
+  struct Pair {
+    uint32_t first;
+    uint32_t second;
+  };
+
+  OverlapResolverConfig config_;
+  SpatialHashGrid grid_;
+  std::vector<Pair> pairs_;
+  std::vector<uint32_t> involved_; // ペアに含まれる点（昇順、重複なし）
+  std::vector<float> validXs_;     // 地形上で有効だった直近の位置
+  std::vector<float> validYs_;
+};
+
+#endif // SIMULATION_GAME_OVERLAP_RESOLVER_H
@@ -0,0 +1,69 @@
+#include "PathSmoother.h"
+
+/*
+ * PathSmoother.cpp
+ *
+ * Output points are written over the input in place: the write cursor
+ * never passes the read cursor, so points still to be examined are intact.
+ * The anchor is copied out before it can be overwritten.
+ */
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 速度倍率の比較の許容誤差
+constexpr float kMultiplierTolerance = 1e-4f;
+
+} // namespace
+
+bool PathSmoother::canShortcut(const GameMap &map, const Position &from,
+                               const Position &to, float radius,
+                               float minMultiplier) {
+  if (map.clipMovementRaycast(from, to, radius).hitBlocking) {
+    return false;
+  }
+  // 半タイルごとに標本を取り、遅い地形に踏み込まないかを見る
+  const float length = from.distanceTo(to);
+  const int samples = static_cast<int>(
+      std::ceil(length / (0.5f * map.getTileSize())));
+  for (int i = 1; i < samples; ++i) {
+    const float t = static_cast<float>(i) / static_cast<float>(samples);
+    const Position p(from.getX() + (to.getX() - from.getX()) * t,
+                     from.getY() + (to.getY() - from.getY()) * t);
+    if (map.getMovementMultiplier(p, radius) <
+        minMultiplier - kMultiplierTolerance) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t PathSmoother::smooth(const GameMap &map, float radius,
+                            std::vector<Position> &waypoints) {
+  const size_t count = waypoints.size();
+  if (count <= 2) {
+    return 0;
+  }
+
+  Position anchor = waypoints[0];
+  // 基点から今の候補までに通る点の最も遅い速度倍率
+  float slowest = map.getMovementMultiplier(anchor, radius);
+  size_t written = 1;
+  for (size_t i = 1; i + 1 < count; ++i) {
+    const Position &next = waypoints[i + 1];
+    const float candidateSlowest =
+        std::min({slowest, map.getMovementMultiplier(waypoints[i], radius),
+                  map.getMovementMultiplier(next, radius)});
+    if (canShortcut(map, anchor, next, radius, candidateSlowest)) {
+      slowest = candidateSlowest; // waypoints[i] は不要
+      continue;
+    }
+    anchor = waypoints[i];
+    waypoints[written++] = anchor;
+    slowest = map.getMovementMultiplier(anchor, radius);
+  }
+  waypoints[written++] = waypoints[count - 1];
+  waypoints.resize(written);
+  return count - written;
+}
@@ -0,0 +1,43 @@
+#ifndef SIMULATION_GAME_PATH_SMOOTHER_H
+#define SIMULATION_GAME_PATH_SMOOTHER_H
+
+#include "../entities/GameMap.h"
+#include "../value_objects/Position.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief タイル経路の折れ線から冗長な経由点を取り除く（糸引き）
+ *
+ * 設計方針：
+ * - 先頭から貪欲に、今の基点からまっすぐ歩いて届く最も遠い点まで飛ばす。
+ *   「歩いて届く」の判定は移動処理と同じ GameMap::clipMovementRaycast
+ *   なので、残った区間はどれも移動時の地形検証で切り詰められない
+ * - 近道が経路探索の地形の選択を崩さないよう、区間上の速度倍率
+ *   （GameMap::getMovementMultiplier、衝突半径込み）が飛ばす点の最小値を
+ *   下回る近道は採らない。森を避けた経路が森の角を横切ることはない
+ * - 各点は基点からの判定を1回だけ受ける（判定回数は点の数に比例）
+ *
+ * 注意：
+ * - 先頭（現在位置）と末尾（目標）は常に残る
+ */
+class PathSmoother {
+public:
+  /**
+   * @brief 折れ線をその場で間引く
+   * @param radius ユニットの衝突半径
+   * @return 取り除いた点の数
+   */
+  static size_t smooth(const GameMap &map, float radius,
+                       std::vector<Position> &waypoints);
+
+  /**
+   * @brief from から to まで、まっすぐ歩けて minMultiplier より遅い
+   *        地形を通らないか
+   */
+  static bool canShortcut(const GameMap &map, const Position &from,
+                          const Position &to, float radius,
+                          float minMultiplier);
+};
+
+#endif // SIMULATION_GAME_PATH_SMOOTHER_H
@@ -0,0 +1,462 @@
+#include "RectNavGraph.h"
+
+/*
+ * RectNavGraph.cpp
+ *
+ * Rectangles and portals live in slot vectors with free lists so that ids
+ * stay stable while the area around an edit is torn down and rebuilt. Each
+ * portal becomes two search nodes (one per side); crossing a portal costs
+ * one tile step into the far rectangle, and moving between two nodes on
+ * the same side of a rectangle costs their straight-line distance at that
+ * rectangle's terrain cost. Segments between tile centres of one rectangle
+ * keep at least the clearance of the closest tile centre, so the straight
+ * legs stay as safe as the tile-level search.
+ */
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr uint32_t kNoParent = UINT32_MAX;
+// 目標は仮想ノード（ポータルのノード番号と重ならない値）
+constexpr uint32_t kGoalNode = UINT32_MAX - 1;
+
+struct OpenOrder {
+  template <typename Entry>
+  bool operator()(const Entry &a, const Entry &b) const {
+    if (a.f != b.f) {
+      return a.f > b.f;
+    }
+    return a.g < b.g;
+  }
+};
+
+} // namespace
+
+bool RectNavGraph::isTileUsable(const GameMap &map, int x, int y) const {
+  return getTerrainProperties(map.getTile(x, y)).movementSpeedMultiplier >
+             0.0f &&
+         map.isTilePassable(x, y, radius_);
+}
+
+Position RectNavGraph::tileCenter(int x, int y) const {
+  return Position(originX_ + (x + 0.5f) * tileSize_,
+                  originY_ + (y + 0.5f) * tileSize_);
+}
+
+uint32_t RectNavGraph::getRectAt(int x, int y) const {
+  if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+    return kNone;
+  }
+  return rectOfTile_[static_cast<size_t>(y) * width_ + x];
+}
+
+bool RectNavGraph::isCurrent(const GameMap &map, float radius) const {
+  return built_ && radius <= radius_ && map.getWidth() == width_ &&
+         map.getHeight() == height_ &&
+         map.getTerrainEpoch() == terrainEpoch_;
+}
+
+void RectNavGraph::build(const GameMap &map, float radius) {
+  width_ = map.getWidth();
+  height_ = map.getHeight();
+  tileSize_ = map.getTileSize();
+  originX_ = map.getMinX();
+  originY_ = map.getMinY();
+  radius_ = radius;
+  terrainEpoch_ = map.getTerrainEpoch();
+
+  const size_t count = static_cast<size_t>(width_) * height_;
+  rects_.clear();
+  freeRects_.clear();
+  portals_.clear();
+  freePortals_.clear();
+  rectStamps_.clear();
+  rectOfTile_.assign(count, kNone);
+  passable_.assign(count, 0);
+  for (int y = 0; y < height_; ++y) {
+    for (int x = 0; x < width_; ++x) {
+      passable_[static_cast<size_t>(y) * width_ + x] =
+          isTileUsable(map, x, y) ? 1 : 0;
+    }
+  }
+
+  newRects_.clear();
+  decompose(map, 0, 0, width_ - 1, height_ - 1);
+  connectNewRects();
+  lastRebuiltRectCount_ = newRects_.size();
+  built_ = true;
+}
+
+bool RectNavGraph::update(const GameMap &map) {
+  if (!built_ || map.getWidth() != width_ || map.getHeight() != height_) {
+    build(map, radius_);
+    return true;
+  }
+  if (map.getTerrainEpoch() == terrainEpoch_) {
+    lastRebuiltRectCount_ = 0;
+    return false;
+  }
+  changed_.clear();
+  if (!map.getTileChangesSince(terrainEpoch_, changed_)) {
+    build(map, radius_);
+    return true;
+  }
+  terrainEpoch_ = map.getTerrainEpoch();
+
+  // 衝突半径が届く範囲のタイルは通行可否が変わりうる
+  const int reach = static_cast<int>(std::ceil(radius_ / tileSize_)) + 1;
+  if (++rectGeneration_ == 0) {
+    std::fill(rectStamps_.begin(), rectStamps_.end(), 0);
+    rectGeneration_ = 1;
+  }
+  int minX = width_;
+  int minY = height_;
+  int maxX = -1;
+  int maxY = -1;
+  doomed_.clear();
+  for (uint32_t index : changed_) {
+    const int cx = static_cast<int>(index % width_);
+    const int cy = static_cast<int>(index / width_);
+    const int x0 = std::max(0, cx - reach);
+    const int x1 = std::min(width_ - 1, cx + reach);
+    const int y0 = std::max(0, cy - reach);
+    const int y1 = std::min(height_ - 1, cy + reach);
+    minX = std::min(minX, x0);
+    minY = std::min(minY, y0);
+    maxX = std::max(maxX, x1);
+    maxY = std::max(maxY, y1);
+    for (int y = y0; y <= y1; ++y) {
+      for (int x = x0; x <= x1; ++x) {
+        const size_t tile = static_cast<size_t>(y) * width_ + x;
+        passable_[tile] = isTileUsable(map, x, y) ? 1 : 0;
+        const uint32_t rect = rectOfTile_[tile];
+        if (rect != kNone && rectStamps_[rect] != rectGeneration_) {
+          rectStamps_[rect] = rectGeneration_;
+          doomed_.push_back(rect);
+        }
+      }
+    }
+  }
+
+  // 壊す矩形のタイルを空け、その範囲まで作り直しの範囲を広げる
+  for (uint32_t id : doomed_) {
+    const Rect &rect = rects_[id];
+    minX = std::min(minX, rect.minX);
+    minY = std::min(minY, rect.minY);
+    maxX = std::max(maxX, rect.maxX);
+    maxY = std::max(maxY, rect.maxY);
+    for (int y = rect.minY; y <= rect.maxY; ++y) {
+      std::fill_n(rectOfTile_.begin() + static_cast<size_t>(y) * width_ +
+                      rect.minX,
+                  rect.maxX - rect.minX + 1, kNone);
+    }
+    removeRect(id);
+  }
+
+  newRects_.clear();
+  decompose(map, minX, minY, maxX, maxY);
+  connectNewRects();
+  lastRebuiltRectCount_ = newRects_.size();
+  return true;
+}
+
+void RectNavGraph::decompose(const GameMap &map, int minX, int minY,
+                             int maxX, int maxY) {
+  auto isFree = [&](int x, int y, TerrainType terrain) {
+    const size_t tile = static_cast<size_t>(y) * width_ + x;
+    return passable_[tile] != 0 && rectOfTile_[tile] == kNone &&
+           map.getTile(x, y) == terrain;
+  };
+  for (int y = minY; y <= maxY; ++y) {
+    for (int x = minX; x <= maxX; ++x) {
+      const size_t tile = static_cast<size_t>(y) * width_ + x;
+      if (passable_[tile] == 0 || rectOfTile_[tile] != kNone) {
+        continue;
+      }
+      const TerrainType terrain = map.getTile(x, y);
+      int right = x;
+      while (right < maxX && isFree(right + 1, y, terrain)) {
+        ++right;
+      }
+      int top = y;
+      while (top < maxY) {
+        bool rowFree = true;
+        for (int column = x; column <= right && rowFree; ++column) {
+          rowFree = isFree(column, top + 1, terrain);
+        }
+        if (!rowFree) {
+          break;
+        }
+        ++top;
+      }
+      addRect(map, x, y, right, top);
+    }
+  }
+}
+
+uint32_t RectNavGraph::addRect(const GameMap &map, int minX, int minY,
+                               int maxX, int maxY) {
+  uint32_t id;
+  if (!freeRects_.empty()) {
+    id = freeRects_.back();
+    freeRects_.pop_back();
+  } else {
+    id = static_cast<uint32_t>(rects_.size());
+    rects_.emplace_back();
+    rectStamps_.push_back(0);
+  }
+  Rect &rect = rects_[id];
+  rect.minX = minX;
+  rect.minY = minY;
+  rect.maxX = maxX;
+  rect.maxY = maxY;
+  rect.terrain = map.getTile(minX, minY);
+  rect.costPerTile =
+      1.0f / getTerrainProperties(rect.terrain).movementSpeedMultiplier;
+  rect.portals.clear();
+  rect.alive = true;
+  for (int y = minY; y <= maxY; ++y) {
+    std::fill_n(rectOfTile_.begin() + static_cast<size_t>(y) * width_ + minX,
+                maxX - minX + 1, id);
+  }
+  newRects_.push_back(id);
+  return id;
+}
+
+void RectNavGraph::removeRect(uint32_t id) {
+  Rect &rect = rects_[id];
+  for (uint32_t portalId : rect.portals) {
+    Portal &portal = portals_[portalId];
+    const uint32_t other =
+        portal.rects[0] == id ? portal.rects[1] : portal.rects[0];
+    std::vector<uint32_t> &list = rects_[other].portals;
+    auto it = std::find(list.begin(), list.end(), portalId);
+    if (it != list.end()) {
+      *it = list.back();
+      list.pop_back();
+    }
+    portal.alive = false;
+    freePortals_.push_back(portalId);
+  }
+  rect.portals.clear();
+  rect.alive = false;
+  freeRects_.push_back(id);
+}
+
+void RectNavGraph::connectNewRects() {
+  if (++rectGeneration_ == 0) {
+    std::fill(rectStamps_.begin(), rectStamps_.end(), 0);
+    rectGeneration_ = 1;
+  }
+  for (uint32_t id : newRects_) {
+    rectStamps_[id] = rectGeneration_;
+  }
+  // 新しい矩形どうしの境界は右辺と上辺から1回だけ張る。左辺と下辺は
+  // 既存の矩形との境界だけを見る
+  for (uint32_t id : newRects_) {
+    const Rect rect = rects_[id];
+    if (rect.maxX + 1 < width_) {
+      connectSide(id, true, rect.maxX, rect.minY, rect.maxY, rect.maxX + 1,
+                  false);
+    }
+    if (rect.maxY + 1 < height_) {
+      connectSide(id, false, rect.maxY, rect.minX, rect.maxX, rect.maxY + 1,
+                  false);
+    }
+    if (rect.minX > 0) {
+      connectSide(id, true, rect.minX, rect.minY, rect.maxY, rect.minX - 1,
+                  true);
+    }
+    if (rect.minY > 0) {
+      connectSide(id, false, rect.minY, rect.minX, rect.maxX, rect.minY - 1,
+                  true);
+    }
+  }
+}
+
+void RectNavGraph::connectSide(uint32_t id, bool vertical, int line,
+                               int from, int to, int outside, bool skipNew) {
+  // vertical: 辺は列 line と列 outside の間（from..to は y）
+  // それ以外: 辺は行 line と行 outside の間（from..to は x）
+  auto neighborAt = [&](int along) {
+    return vertical ? getRectAt(outside, along) : getRectAt(along, outside);
+  };
+  int runStart = from;
+  uint32_t runRect = neighborAt(from);
+  for (int along = from + 1; along <= to + 1; ++along) {
+    const uint32_t neighbor = along <= to ? neighborAt(along) : kNone;
+    if (along <= to && neighbor == runRect) {
+      continue;
+    }
+    const bool skip =
+        skipNew && runRect != kNone && rectStamps_[runRect] == rectGeneration_;
+    if (runRect != kNone && !skip) {
+      addPortal(id, runRect, vertical, line, runStart, along - 1, outside);
+    }
+    runStart = along;
+    runRect = neighbor;
+  }
+}
+
+void RectNavGraph::addPortal(uint32_t inside, uint32_t outside,
+                             bool vertical, int line, int from, int to,
+                             int outsideLine) {
+  for (int chunk = from; chunk <= to; chunk += kMaxPortalTiles) {
+    const int chunkEnd = std::min(to, chunk + kMaxPortalTiles - 1);
+    const int middle = (chunk + chunkEnd) / 2;
+    uint32_t id;
+    if (!freePortals_.empty()) {
+      id = freePortals_.back();
+      freePortals_.pop_back();
+    } else {
+      id = static_cast<uint32_t>(portals_.size());
+      portals_.emplace_back();
+    }
+    Portal &portal = portals_[id];
+    portal.rects[0] = inside;
+    portal.rects[1] = outside;
+    portal.points[0] =
+        vertical ? tileCenter(line, middle) : tileCenter(middle, line);
+    portal.points[1] = vertical ? tileCenter(outsideLine, middle)
+                                : tileCenter(middle, outsideLine);
+    portal.alive = true;
+    rects_[inside].portals.push_back(id);
+    rects_[outside].portals.push_back(id);
+  }
+}
+
+bool RectNavGraph::findPath(const Position &start, const Position &goal,
+                            std::vector<Position> &outWaypoints) {
+  outWaypoints.clear();
+  lastExpansionCount_ = 0;
+  if (!built_ || tileSize_ <= 0.0f) {
+    return false;
+  }
+  const uint32_t startRect =
+      getRectAt(static_cast<int>(std::floor((start.getX() - originX_) /
+                                            tileSize_)),
+                static_cast<int>(std::floor((start.getY() - originY_) /
+                                            tileSize_)));
+  const uint32_t goalRect =
+      getRectAt(static_cast<int>(std::floor((goal.getX() - originX_) /
+                                            tileSize_)),
+                static_cast<int>(std::floor((goal.getY() - originY_) /
+                                            tileSize_)));
+  if (startRect == kNone || goalRect == kNone) {
+    return false;
+  }
+  if (startRect == goalRect) {
+    outWaypoints.push_back(start);
+    outWaypoints.push_back(goal);
+    return true;
+  }
+
+  const size_t nodeCount = portals_.size() * 2;
+  if (costs_.size() < nodeCount) {
+    costs_.resize(nodeCount, 0.0f);
+    parents_.resize(nodeCount, kNoParent);
+    stamps_.resize(nodeCount, 0);
+    closed_.resize(nodeCount, 0);
+  }
+  if (++searchGeneration_ == 0) {
+    std::fill(stamps_.begin(), stamps_.end(), 0);
+    std::fill(closed_.begin(), closed_.end(), 0);
+    searchGeneration_ = 1;
+  }
+
+  const float invTile = 1.0f / tileSize_;
+  auto pointOf = [&](uint32_t node) -> const Position & {
+    return portals_[node >> 1].points[node & 1];
+  };
+  auto heuristic = [&](const Position &p) {
+    return p.distanceTo(goal) * invTile;
+  };
+  float goalCost = 0.0f;
+  uint32_t goalParent = kNoParent;
+  bool goalReached = false;
+  open_.clear();
+  auto relax = [&](uint32_t node, float g, uint32_t parent) {
+    if (node == kGoalNode) {
+      if (goalParent != kNoParent && goalCost <= g) {
+        return;
+      }
+      goalCost = g;
+      goalParent = parent;
+      open_.push_back({g, g, kGoalNode});
+    } else {
+      if (closed_[node] == searchGeneration_ ||
+          (stamps_[node] == searchGeneration_ && costs_[node] <= g)) {
+        return;
+      }
+      costs_[node] = g;
+      parents_[node] = parent;
+      stamps_[node] = searchGeneration_;
+      open_.push_back({g + heuristic(pointOf(node)), g, node});
+    }
+    std::push_heap(open_.begin(), open_.end(), OpenOrder());
+  };
+
+  // 開始: 開始矩形の側にある各ポータルの通過点まで直進
+  const Rect &first = rects_[startRect];
+  for (uint32_t portalId : first.portals) {
+    const uint32_t side = portals_[portalId].rects[0] == startRect ? 0 : 1;
+    const uint32_t node = portalId * 2 + side;
+    relax(node, start.distanceTo(pointOf(node)) * invTile * first.costPerTile,
+          kNoParent);
+  }
+
+  while (!open_.empty()) {
+    std::pop_heap(open_.begin(), open_.end(), OpenOrder());
+    const OpenEntry entry = open_.back();
+    open_.pop_back();
+    if (entry.node == kGoalNode) {
+      goalReached = true;
+      break;
+    }
+    if (closed_[entry.node] == searchGeneration_) {
+      continue;
+    }
+    closed_[entry.node] = searchGeneration_;
+    ++lastExpansionCount_;
+
+    const uint32_t portalId = entry.node >> 1;
+    const uint32_t side = entry.node & 1;
+    const Portal &portal = portals_[portalId];
+    const uint32_t rectId = portal.rects[side];
+    const Rect &rect = rects_[rectId];
+    const Position &point = portal.points[side];
+
+    // ポータルを渡る（向こう側のタイルへ1歩）
+    relax(entry.node ^ 1u,
+          entry.g + rects_[portal.rects[side ^ 1]].costPerTile, entry.node);
+    // 同じ矩形の中を直進
+    if (rectId == goalRect) {
+      relax(kGoalNode,
+            entry.g + point.distanceTo(goal) * invTile * rect.costPerTile,
+            entry.node);
+    }
+    for (uint32_t otherId : rect.portals) {
+      if (otherId == portalId) {
+        continue;
+      }
+      const uint32_t otherSide = portals_[otherId].rects[0] == rectId ? 0 : 1;
+      const uint32_t node = otherId * 2 + otherSide;
+      relax(node,
+            entry.g + point.distanceTo(pointOf(node)) * invTile *
+                          rect.costPerTile,
+            entry.node);
+    }
+  }
+  if (!goalReached) {
+    return false;
+  }
+
+  outWaypoints.push_back(goal);
+  for (uint32_t node = goalParent; node != kNoParent; node = parents_[node]) {
+    outWaypoints.push_back(pointOf(node));
+  }
+  outWaypoints.push_back(start);
+  std::reverse(outWaypoints.begin(), outWaypoints.end());
+  return true;
+}
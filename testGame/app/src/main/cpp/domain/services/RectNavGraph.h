@@ -0,0 +1,158 @@
+#ifndef SIMULATION_GAME_RECT_NAV_GRAPH_H
+#define SIMULATION_GAME_RECT_NAV_GRAPH_H
+
+#include "../entities/GameMap.h"
+#include "../value_objects/Position.h"
+#include "../value_objects/TerrainType.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 通れるタイルを同じ地形の矩形にまとめた経路探索用のグラフ
+ *
+ * 設計方針：
+ * - 通れるタイル（GameMap::isTilePassable、構築時の衝突半径）を、同じ
+ *   地形（= 同じ移動コスト）どうしで矩形にまとめる。左下から走査し、
+ *   右へ伸ばせるだけ伸ばしてから上へ伸ばす貪欲法
+ * - 隣り合う矩形の境界をポータルにする。長い境界は kMaxPortalTiles
+ *   タイルごとに分け、分けた区間の中央で境界を挟む2タイルの中心を
+ *   通過点にする。探索のノードは「ポータルのどちら側にいるか」で、
+ *   同じ矩形の中の通過点どうしは直線で結ぶ（矩形の中は地形が一様で、
+ *   タイル中心を結ぶ線分は矩形の外の通れないタイルに半径以上近づかない）
+ * - 探索は A*。コストは GridPathfinder と同じ尺度（草原 1 タイル = 1、
+ *   速度倍率で割る）で、ヒューリスティックは直線距離
+ * - 地形の変更は GameMap::getTileChangesSince から、通行可否が変わりうる
+ *   タイルを含む矩形だけを壊して作り直す（ポータルもその周りだけ）
+ *
+ * 注意：
+ * - 経路はポータルの通過点を経由する近似で、タイル単位の最短経路より
+ *   少し長くなりうる。PathSmoother で間引いてから使う
+ * - 構築時の半径より大きなユニットには使えない（isCurrent で確かめる）
+ * - 部分的な作り直しを重ねると矩形は細かくなる。変更の記録が足りない
+ *   場合は全体を作り直す
+ */
+class RectNavGraph {
+public:
+  // ポータル1つが受け持つ境界の最大タイル数
+  static constexpr int kMaxPortalTiles = 8;
+
+  struct Rect {
+    int minX;
+    int minY;
+    int maxX; // 含む
+    int maxY; // 含む
+    TerrainType terrain;
+    float costPerTile; // 1 / 速度倍率
+    std::vector<uint32_t> portals;
+    bool alive;
+  };
+
+  struct Portal {
+    uint32_t rects[2];
+    Position points[2]; // points[i] は rects[i] 側のタイル中心
+    bool alive;
+  };
+
+  /**
+   * @brief マップ全体から作る
+   * @param radius このグラフを使うユニットの衝突半径（の上限）
+   */
+  void build(const GameMap &map, float radius);
+
+  /**
+   * @brief 前回の build / update 以降の地形の変更を反映する
+   * @return 矩形を作り直したか
+   */
+  bool update(const GameMap &map);
+
+  /**
+   * @brief map の現在の地形で、半径 radius のユニットに使えるか
+   */
+  bool isCurrent(const GameMap &map, float radius) const;
+
+  /**
+   * @brief start から goal までの経路を求める
+   * @param outWaypoints [start, 通過点..., goal] の順の折れ線
+   * @return 経路が見つかったか（開始・目標のタイルが矩形に含まれない
+   *         場合も false。呼び出し側はタイル単位の探索に切り替える）
+   */
+  bool findPath(const Position &start, const Position &goal,
+                std::vector<Position> &outWaypoints);
+
+  size_t getRectCount() const { return rects_.size() - freeRects_.size(); }
+  size_t getPortalCount() const {
+    return portals_.size() - freePortals_.size();
+  }
+  // alive == false の要素は再利用待ちの空き
+  const std::vector<Rect> &getRects() const { return rects_; }
+  const std::vector<Portal> &getPortals() const { return portals_; }
+  uint32_t getRectAt(int x, int y) const;
+
+  /**
+   * @brief 直前の findPath で展開したノード数と、直前の update で
+   *        作り直した矩形の数
+   */
+  size_t getLastExpansionCount() const { return lastExpansionCount_; }
+  size_t getLastRebuiltRectCount() const { return lastRebuiltRectCount_; }
+
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+private:
+  struct OpenEntry {
+    float f;
+    float g;
+    uint32_t node;
+  };
+
+  // 範囲内の未割り当ての通れるタイルを矩形にまとめる（newRects_ に追加）
+  void decompose(const GameMap &map, int minX, int minY, int maxX,
+                 int maxY);
+  uint32_t addRect(const GameMap &map, int minX, int minY, int maxX,
+                   int maxY);
+  void removeRect(uint32_t id);
+  // newRects_ の矩形の周りにポータルを張る
+  void connectNewRects();
+  // 境界の1辺を走査し、隣の矩形ごとの区間をポータルにする
+  void connectSide(uint32_t id, bool vertical, int line, int from, int to,
+                   int outside, bool skipNew);
+  void addPortal(uint32_t inside, uint32_t outside, bool vertical, int line,
+                 int from, int to, int outsideLine);
+  bool isTileUsable(const GameMap &map, int x, int y) const;
+  Position tileCenter(int x, int y) const;
+
+  int width_ = 0;
+  int height_ = 0;
+  float tileSize_ = 1.0f;
+  float originX_ = 0.0f;
+  float originY_ = 0.0f;
+  float radius_ = 0.0f;
+  bool built_ = false;
+  uint64_t terrainEpoch_ = 0;
+
+  std::vector<Rect> rects_;
+  std::vector<uint32_t> freeRects_;
+  std::vector<Portal> portals_;
+  std::vector<uint32_t> freePortals_;
+  std::vector<uint32_t> rectOfTile_;   // タイル -> 矩形（通れなければ kNone）
+  std::vector<uint8_t> passable_;
+
+  // 作り直しの作業領域
+  std::vector<uint32_t> newRects_;
+  std::vector<uint32_t> rectStamps_;   // 今回作った / 壊す矩形の印
+  uint32_t rectGeneration_ = 0;
+  std::vector<uint32_t> changed_;
+  std::vector<uint32_t> doomed_;
+  size_t lastRebuiltRectCount_ = 0;
+
+  // 探索の作業領域（ノード = ポータル * 2 + 側）
+  std::vector<float> costs_;
+  std::vector<uint32_t> parents_;
+  std::vector<uint32_t> stamps_;
+  std::vector<uint32_t> closed_;
+  uint32_t searchGeneration_ = 0;
+  std::vector<OpenEntry> open_;
+  size_t lastExpansionCount_ = 0;
+};
+
+#endif // SIMULATION_GAME_RECT_NAV_GRAPH_H
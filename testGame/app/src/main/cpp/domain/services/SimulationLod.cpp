@@ -0,0 +1,106 @@
+#include "SimulationLod.h"
+
+/*
+ * SimulationLod.cpp
+ *
+ * A reduced-rate unit is stepped when its group's phase comes up or when the
+ * time it has banked would exceed maxDeferredTime, whichever happens first.
+ * The group phase is a hash of the unit's grid cell, so neighbouring groups
+ * are spread over different ticks while units in the same group (which are
+ * likely to be neighbours for avoidance) advance together.
+ *
+ * Banked time is stamped with the tick that deferred it. Every live moving
+ * unit passes through stepFor each tick, so beginTick drops entries that were
+ * not touched in the previous tick; dead or removed ids never accumulate.
+ */
+#include <algorithm>
+#include <cmath>
+
+SimulationLod::SimulationLod(const SimulationLodConfig &config)
+    : config_(config) {}
+
+void SimulationLod::setView(float minX, float minY, float maxX, float maxY) {
+  viewMinX_ = minX - config_.viewMargin;
+  viewMinY_ = minY - config_.viewMargin;
+  viewMaxX_ = maxX + config_.viewMargin;
+  viewMaxY_ = maxY + config_.viewMargin;
+  enabled_ = true;
+}
+
+void SimulationLod::beginTick(const FactionSpatialIndex *enemyIndex) {
+  enemyIndex_ = enemyIndex;
+  for (auto it = deferredTimes_.begin(); it != deferredTimes_.end();) {
+    if (it->second.tick != tick_) {
+      it = deferredTimes_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  ++tick_;
+  steppedCount_ = 0;
+  deferredCount_ = 0;
+}
+
+bool SimulationLod::isFullRate(const UnitEntity &unit) const {
+  if (!enabled_ || unit.getState() == UnitState::COMBAT) {
+    return true;
+  }
+  const float x = unit.getPosition().getX();
+  const float y = unit.getPosition().getY();
+  if (x >= viewMinX_ && x <= viewMaxX_ && y >= viewMinY_ && y <= viewMaxY_) {
+    return true;
+  }
+  // 縮退中にまとめて進む間に、双方が詰めうる距離まで見ておく
+  const float reach =
+      unit.getStats().getAttackRange() +
+      2.0f * unit.getStats().getMoveSpeed() * config_.maxDeferredTime;
+  uint32_t nearest = 0;
+  float distanceSq = 0.0f;
+  return enemyIndex_ &&
+         enemyIndex_->findNearestEnemy(unit.getFaction(), x, y,
+                                       std::max(config_.engageRadius, reach),
+                                       nearest, distanceSq);
+}
+
+bool SimulationLod::isGroupTurn(const UnitEntity &unit) const {
+  const int cellX = static_cast<int>(
+      std::floor(unit.getPosition().getX() / config_.groupCellSize));
+  const int cellY = static_cast<int>(
+      std::floor(unit.getPosition().getY() / config_.groupCellSize));
+  const uint32_t hash = static_cast<uint32_t>(cellX) * 73856093u ^
+                        static_cast<uint32_t>(cellY) * 19349663u;
+  const uint32_t interval =
+      static_cast<uint32_t>(config_.reducedInterval > 1
+                                ? config_.reducedInterval
+                                : 1);
+  return (tick_ + hash) % interval == 0;
+}
+
+float SimulationLod::stepFor(const UnitEntity &unit, float deltaTime) {
+  if (!enabled_) {
+    ++steppedCount_;
+    return deltaTime;
+  }
+
+  auto found = deferredTimes_.find(unit.getId());
+  const float deferred =
+      found != deferredTimes_.end() ? found->second.time : 0.0f;
+  const float total = deferred + deltaTime;
+  if (!isFullRate(unit) && !isGroupTurn(unit) &&
+      total < config_.maxDeferredTime) {
+    if (found != deferredTimes_.end()) {
+      found->second = DeferredTime{total, tick_};
+    } else {
+      deferredTimes_.emplace(unit.getId(), DeferredTime{total, tick_});
+    }
+    ++deferredCount_;
+    return 0.0f;
+  }
+
+  // フルレートに戻ったユニットも、貯めた時間はここでまとめて進める
+  if (found != deferredTimes_.end()) {
+    deferredTimes_.erase(found);
+  }
+  ++steppedCount_;
+  return total;
+}
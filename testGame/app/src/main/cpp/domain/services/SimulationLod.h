@@ -0,0 +1,107 @@
+#ifndef SIMULATION_GAME_SIMULATION_LOD_H
+#define SIMULATION_GAME_SIMULATION_LOD_H
+
+#include "../entities/UnitEntity.h"
+#include "FactionSpatialIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * @brief シミュレーションの詳細度（LOD）の設定
+ */
+struct SimulationLodConfig {
+  int reducedInterval = 4;        // 縮退したユニットを進めるティック間隔
+  float maxDeferredTime = 0.25f;  // 1回の更新にまとめてよい最大の時間（秒）
+  float viewMargin = 2.0f;        // 画面外でもこの距離まではフルレート
+  float engageRadius = 4.0f;      // この距離に敵がいればフルレート
+  float groupCellSize = 8.0f;     // 同じ位相で更新するグループの大きさ
+};
+
+/**
+ * @brief 画面外の離れたユニットの移動を間引くシミュレーション LOD
+ *
+ * 設計方針：
+ * - 画面（+余白）内・戦闘中・近くに敵がいるユニットは毎ティック進める
+ *   （フルレート）。それ以外は reducedInterval ティックに1回、貯めた時間
+ *   分をまとめて進める（縮退）
+ * - 縮退したユニットはグリッドのセル（グループ）単位で位相をずらし、
+ *   間引いた仕事が特定のティックに偏らないようにする
+ * - 貯めた時間は捨てない。フルレートへ戻る（画面に入る・敵に近づく）と
+ *   次のティックで残りをまとめて進めるので、移動量は LOD に依らない
+ * - 戦闘の判定は近くに敵がいるユニットだけに関わるため、常にフルレート
+ *   側で行われる。縮退中のユニットは回避では止まった障害物として扱う
+ *
+ * 注意：
+ * - setView を呼ぶまでは無効（すべてフルレート）
+ * - 前のティックで stepFor が呼ばれなかったユニット（死亡・削除・停止）の
+ *   貯めた時間は beginTick で捨てる
+ * - 1回に進める時間は maxDeferredTime + 1 ティック分を超えない。局所回避の
+ *   timeHorizon より十分短くしておくこと
+ */
+class SimulationLod {
+public:
+  explicit SimulationLod(
+      const SimulationLodConfig &config = SimulationLodConfig());
+
+  /**
+   * @brief フルレートで扱う表示範囲（ワールド座標）を設定し、LOD を有効にする
+   */
+  void setView(float minX, float minY, float maxX, float maxY);
+
+  /**
+   * @brief LOD を無効にする（以後すべてフルレート）
+   */
+  void disable() { enabled_ = false; }
+  bool isEnabled() const { return enabled_; }
+
+  /**
+   * @brief ティックの開始を通知する
+   * @param enemyIndex 敵の近さの判定に使う陣営別インデックス（nullptr なら
+   *        敵による昇格は行わない）
+   */
+  void beginTick(const FactionSpatialIndex *enemyIndex);
+
+  /**
+   * @brief このティックでユニットを進める時間を返す
+   * @param deltaTime このティックの経過時間
+   * @return 進める時間（貯めた分を含む）。0 なら今回は進めない
+   */
+  float stepFor(const UnitEntity &unit, float deltaTime);
+
+  /**
+   * @brief ユニットが毎ティック更新されるべきかどうか
+   */
+  bool isFullRate(const UnitEntity &unit) const;
+
+  /**
+   * @brief 現在のティックで進めた／見送ったユニット数（計測用）
+   */
+  size_t getSteppedCount() const { return steppedCount_; }
+  size_t getDeferredCount() const { return deferredCount_; }
+  // 時間を貯めているユニット数
+  size_t getBankedUnitCount() const { return deferredTimes_.size(); }
+
+private:
+  // ユニットのいるグループに今ティックの番が回ってきているか
+  bool isGroupTurn(const UnitEntity &unit) const;
+
+  SimulationLodConfig config_;
+  bool enabled_ = false;
+  float viewMinX_ = 0.0f;
+  float viewMinY_ = 0.0f;
+  float viewMaxX_ = 0.0f;
+  float viewMaxY_ = 0.0f;
+  const FactionSpatialIndex *enemyIndex_ = nullptr;
+  uint32_t tick_ = 0;
+
+  struct DeferredTime {
+    float time;    // 貯めた時間
+    uint32_t tick; // 最後に stepFor で見送ったティック
+  };
+  std::unordered_map<int, DeferredTime> deferredTimes_; // ユニットID -> 貯金
+  size_t steppedCount_ = 0;
+  size_t deferredCount_ = 0;
+};
+
+#endif // SIMULATION_GAME_SIMULATION_LOD_H
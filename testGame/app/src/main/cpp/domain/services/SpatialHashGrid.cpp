@@ -0,0 +1,73 @@
+#include "SpatialHashGrid.h"
+
+/*
+ * SpatialHashGrid.cpp
+ *
+ * Rebuild strategy:
+ * - Points are bucketed with a two-pass counting sort (count, prefix sum,
+ * scatter). The buffers are kept between builds, so a steady-state rebuild
+ * with a stable unit count performs no heap allocation.
+ * - The bucket table is sized to the next power of two >= 2 * count to keep
+ * the expected bucket occupancy low.
+ */
+#include <algorithm>
+
+namespace {
+constexpr float kMinCellSize = 1e-3f;
+constexpr uint32_t kMinBucketCount = 16;
+
+uint32_t nextPowerOfTwo(uint32_t value) {
+  uint32_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+} // namespace
+
+SpatialHashGrid::SpatialHashGrid(float cellSize)
+    : cellSize_(std::max(cellSize, kMinCellSize)),
+      inverseCellSize_(1.0f / std::max(cellSize, kMinCellSize)) {
+  bucketStart_.assign(2, 0);
+}
+
+void SpatialHashGrid::setCellSize(float cellSize) {
+  cellSize_ = std::max(cellSize, kMinCellSize);
+  inverseCellSize_ = 1.0f / cellSize_;
+}
+
+void SpatialHashGrid::build(const float *xs, const float *ys, size_t count,
+                            const uint32_t *indices) {
+  const uint32_t bucketCount = std::max(
+      kMinBucketCount, nextPowerOfTwo(static_cast<uint32_t>(count) * 2));
+  bucketMask_ = bucketCount - 1;
+  bucketStart_.assign(bucketCount + 1, 0);
+
+  scratch_.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    Entry &entry = scratch_[i];
+    entry.x = xs[i];
+    entry.y = ys[i];
+    entry.cellX = toCell(xs[i]);
+    entry.cellY = toCell(ys[i]);
+    entry.index = indices ? indices[i] : static_cast<uint32_t>(i);
+    ++bucketStart_[bucketOf(entry.cellX, entry.cellY) + 1];
+  }
+
+  // 累積和で各バケットの開始位置を確定
+  for (uint32_t b = 0; b < bucketCount; ++b) {
+    bucketStart_[b + 1] += bucketStart_[b];
+  }
+
+  // 散布（bucketStart_ を書き込みカーソルとして一時利用し、後で戻す）
+  entries_.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    const Entry &entry = scratch_[i];
+    const uint32_t bucket = bucketOf(entry.cellX, entry.cellY);
+    entries_[bucketStart_[bucket]++] = entry;
+  }
+  for (uint32_t b = bucketCount; b > 0; --b) {
+    bucketStart_[b] = bucketStart_[b - 1];
+  }
+  bucketStart_[0] = 0;
+}
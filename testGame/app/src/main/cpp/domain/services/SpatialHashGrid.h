@@ -0,0 +1,129 @@
+#ifndef SIMULATION_GAME_SPATIAL_HASH_GRID_H
+#define SIMULATION_GAME_SPATIAL_HASH_GRID_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 点集合に対する近傍探索用の空間ハッシュグリッド
+ *
+ * 設計方針：
+ * - セルサイズを「最大の探索半径」に合わせることで、半径クエリは高々 3x3
+ *   セルの走査で済む
+ * - バケットはカウンティングソートで連続配列に詰めるため、毎ティックの再構築でも
+ *   ウォームアップ後はヒープ確保が発生しない
+ * - 格納するのは呼び出し側の配列インデックスのみ。エンティティへの依存を持たず、
+ *   戦闘・衝突など複数の用途で再利用できる
+ *
+ * 注意：
+ * - 座標はワールド座標。マップ外（負の座標等）でも正しく動作する
+ * - インデックスの意味付け（units_ の何番目か等）は呼び出し側の責任
+ */
+class SpatialHashGrid {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param cellSize セルの一辺の長さ（ワールド座標）
+   */
+  explicit SpatialHashGrid(float cellSize = 1.0f);
+
+  /**
+   * @brief セルサイズを変更する（次回 build から有効）
+   */
+  void setCellSize(float cellSize);
+  float getCellSize() const { return cellSize_; }
+
+  /**
+   * @brief 点集合からグリッドを再構築する
+   * @param xs X座標配列
+   * @param ys Y座標配列
+   * @param count 点の数
+   * @param indices 各点に対応付けるインデックス（nullptr の場合は 0..count-1）
+   *
+   * indices を渡すと、部分集合だけでグリッドを作りつつ、クエリ結果は
+   * 元配列のインデックスで返せる（陣営別インデックスなどで使用）。
+   */
+  void build(const float *xs, const float *ys, size_t count,
+             const uint32_t *indices = nullptr);
+
+  /**
+   * @brief 登録されている点の数
+   */
+  size_t size() const { return entries_.size(); }
+
+  /**
+   * @brief 指定円内の点を列挙する
+   *
+   * @param x 円の中心X
+   * @param y 円の中心Y
+   * @param radius 探索半径
+   * @param visitor void(uint32_t index, float distanceSq) を受け取る関数
+   *
+   * 距離は平方のまま渡す（sqrt を呼ばない）。列挙順はセル走査順で、
+   * インデックス順ではない。
+   */
+  template <typename Visitor>
+  void forEachInRadius(float x, float y, float radius,
+                       Visitor &&visitor) const {
+    if (entries_.empty() || radius < 0.0f) {
+      return;
+    }
+    const float radiusSq = radius * radius;
+    const int32_t minCellX = toCell(x - radius);
+    const int32_t maxCellX = toCell(x + radius);
+    const int32_t minCellY = toCell(y - radius);
+    const int32_t maxCellY = toCell(y + radius);
+
+    for (int32_t cy = minCellY; cy <= maxCellY; ++cy) {
+      for (int32_t cx = minCellX; cx <= maxCellX; ++cx) {
+        const uint32_t bucket = bucketOf(cx, cy);
+        const uint32_t begin = bucketStart_[bucket];
+        const uint32_t end = bucketStart_[bucket + 1];
+        for (uint32_t i = begin; i < end; ++i) {
+          const Entry &entry = entries_[i];
+          // 異なるセルが同じバケットに衝突している場合は除外
+          if (entry.cellX != cx || entry.cellY != cy) {
+            continue;
+          }
+          const float dx = entry.x - x;
+          const float dy = entry.y - y;
+          const float distanceSq = dx * dx + dy * dy;
+          if (distanceSq <= radiusSq) {
+            visitor(entry.index, distanceSq);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  struct Entry {
+    float x;
+    float y;
+    int32_t cellX;
+    int32_t cellY;
+    uint32_t index;
+  };
+
+  int32_t toCell(float coordinate) const {
+    return static_cast<int32_t>(std::floor(coordinate * inverseCellSize_));
+  }
+
+  uint32_t bucketOf(int32_t cellX, int32_t cellY) const {
+    // 大きな素数を掛けた XOR ハッシュ（Teschner et al.）
+    const uint32_t h = (static_cast<uint32_t>(cellX) * 73856093u) ^
+                       (static_cast<uint32_t>(cellY) * 19349663u);
+    return h & bucketMask_;
+  }
+
+  float cellSize_;
+  float inverseCellSize_;
+  uint32_t bucketMask_ = 0;
+
+  std::vector<Entry> entries_;        // バケット順に並べた点
+  std::vector<uint32_t> bucketStart_; // バケットごとの開始オフセット（+1 要素）
+  std::vector<Entry> scratch_;        // 再構築時の作業領域
+};
+
+#endif // SIMULATION_GAME_SPATIAL_HASH_GRID_H
@@ -0,0 +1,152 @@
+#include "SweptCollision.h"
+
+/*
+ * SweptCollision.cpp
+ *
+ * For a pair (i, j) the relative start d = pj - pi and relative displacement
+ * v = (ej - pj) - (ei - pi) give |d + t v|^2 = R^2, where R is the sum of the
+ * radii shrunk by the allowed penetration. Only the entering root of an
+ * approaching pair (d.v < 0) that is not already closer than R at t = 0 is a
+ * contact; the same t is applied to both bodies.
+ */
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+SweptCollision::SweptCollision(const SweptCollisionConfig &config)
+    : config_(config) {}
+
+void SweptCollision::sortIntervals(const float *startXs, const float *startYs,
+                                   const float *endXs, const float *endYs,
+                                   const float *radii, size_t count) {
+  minXs_.resize(count);
+  maxXs_.resize(count);
+  minYs_.resize(count);
+  maxYs_.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    minXs_[i] = std::min(startXs[i], endXs[i]) - radii[i];
+    maxXs_[i] = std::max(startXs[i], endXs[i]) + radii[i];
+    minYs_[i] = std::min(startYs[i], endYs[i]) - radii[i];
+    maxYs_[i] = std::max(startYs[i], endYs[i]) + radii[i];
+  }
+
+  const auto precedes = [&](uint32_t a, uint32_t b) {
+    return minXs_[a] < minXs_[b] || (minXs_[a] == minXs_[b] && a < b);
+  };
+  const auto sortAll = [&]() {
+    order_.resize(count);
+    std::iota(order_.begin(), order_.end(), 0u);
+    std::sort(order_.begin(), order_.end(), precedes);
+    ++fullSortCount_;
+  };
+  // 要素数が変わったら（死亡ユニットの除去など）並びを作り直す
+  if (order_.size() != count) {
+    sortAll();
+    return;
+  }
+  // 前回の並びはほぼ整列済みなので挿入ソートが速い。同じ値は番号順。
+  // 並びが崩れていて（入力の入れ替えなど）ずらす回数が増えたら、O(n²) に
+  // なる前に全体のソートへ切り替える
+  constexpr size_t kShiftsPerElement = 8;
+  size_t shiftBudget = count * kShiftsPerElement;
+  for (size_t k = 1; k < count; ++k) {
+    const uint32_t index = order_[k];
+    const float key = minXs_[index];
+    size_t slot = k;
+    while (slot > 0) {
+      const uint32_t previous = order_[slot - 1];
+      if (minXs_[previous] < key ||
+          (minXs_[previous] == key && previous < index)) {
+        break;
+      }
+      if (shiftBudget == 0) {
+        sortAll();
+        return;
+      }
+      --shiftBudget;
+      order_[slot] = previous;
+      --slot;
+    }
+    order_[slot] = index;
+  }
+}
+
+size_t SweptCollision::sweep(const float *startXs, const float *startYs,
+                             const float *endXs, const float *endYs,
+                             const float *radii, size_t count) {
+  size_t stopping = 0;
+  for (size_t k = 0; k < count; ++k) {
+    const uint32_t i = order_[k];
+    for (size_t m = k + 1; m < count; ++m) {
+      const uint32_t j = order_[m];
+      if (minXs_[j] > maxXs_[i]) {
+        break; // 以降は x の下端がさらに右
+      }
+      if (minYs_[j] > maxYs_[i] || minYs_[i] > maxYs_[j]) {
+        continue;
+      }
+      ++candidatePairCount_;
+
+      const float dx = startXs[j] - startXs[i];
+      const float dy = startYs[j] - startYs[i];
+      const float vx = (endXs[j] - startXs[j]) - (endXs[i] - startXs[i]);
+      const float vy = (endYs[j] - startYs[j]) - (endYs[i] - startYs[i]);
+      const float combined =
+          (radii[i] + radii[j]) * (1.0f - config_.allowedPenetration);
+      const float a = vx * vx + vy * vy;
+      const float b = dx * vx + dy * vy; // 半分の係数
+      const float c = dx * dx + dy * dy - combined * combined;
+      if (c <= 0.0f || b >= 0.0f || a <= 1e-12f) {
+        continue; // 始点で重なっている・離れていく・相対的に静止
+      }
+      const float discriminant = b * b - a * c;
+      if (discriminant < 0.0f) {
+        continue; // すれ違う
+      }
+      const float time = (-b - std::sqrt(discriminant)) / a;
+      if (time >= 1.0f) {
+        continue;
+      }
+      for (uint32_t body : {i, j}) {
+        if (time < times_[body]) {
+          stopping += times_[body] >= 1.0f ? 1 : 0;
+          times_[body] = time;
+        }
+      }
+    }
+  }
+  return stopping;
+}
+
+size_t SweptCollision::solve(const float *startXs, const float *startYs,
+                             float *endXs, float *endYs, const float *radii,
+                             size_t count) {
+  candidatePairCount_ = 0;
+  fullSortCount_ = 0;
+  stopped_.assign(count, 0);
+  size_t stopped = 0;
+  for (int round = 0; round < std::max(config_.rounds, 1); ++round) {
+    sortIntervals(startXs, startYs, endXs, endYs, radii, count);
+    times_.assign(count, 1.0f);
+    if (sweep(startXs, startYs, endXs, endYs, radii, count) == 0) {
+      break;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      const float time = times_[i];
+      if (time >= 1.0f) {
+        continue;
+      }
+      if (endXs[i] == startXs[i] && endYs[i] == startYs[i]) {
+        continue; // 止まっている円は障害物としてだけ関わる
+      }
+      endXs[i] = startXs[i] + (endXs[i] - startXs[i]) * time;
+      endYs[i] = startYs[i] + (endYs[i] - startYs[i]) * time;
+      // 玉突きで2回目に戻された円は数え直さない
+      if (!stopped_[i]) {
+        stopped_[i] = 1;
+        ++stopped;
+      }
+    }
+  }
+  return stopped;
+}
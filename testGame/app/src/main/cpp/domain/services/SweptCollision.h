@@ -0,0 +1,95 @@
+#ifndef SIMULATION_GAME_SWEPT_COLLISION_H
+#define SIMULATION_GAME_SWEPT_COLLISION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 連続衝突判定の設定
+ */
+struct SweptCollisionConfig {
+  int rounds = 2; // 止めた位置で掃引し直す回数の上限（玉突きへの対処）
+  // 許容する食い込み（半径の和に対する割合）。これより浅い重なりは止めずに
+  // 押し離しに任せる（密集して擦れ違うユニットが止まってしまわないように）
+  float allowedPenetration = 0.5f;
+};
+
+/**
+ * @brief 1ティック分の移動（始点 -> 終点）を円の掃引として判定し、
+ *        最初の接触時刻で止める
+ *
+ * 設計方針：
+ * - 各円の掃引形状（カプセル）の AABB を作り、x 区間で sort-and-sweep する。
+ *   並びは前回の順序から挿入ソートで直すので、ユニットがあまり動かない
+ *   通常のティックではほぼ O(n)。ずらす回数が要素数の数倍を超えたら
+ *   （入力の並びが入れ替わった等）途中でやめて全体をソートし直す
+ * - x 区間と y 区間が重なった候補ペアだけ、相対運動で接触時刻（TOI）を
+ *   解く。両者が動いていても1つの二次方程式で済み、同じペアの2体には
+ *   同じ時刻が出る（正面衝突でも片方だけがすり抜けることはない）
+ * - 接触とみなす距離は半径の和から allowedPenetration 分を引いたもの。
+ *   浅い接触で止めると密集した隊列が動けなくなるため、止めるのは
+ *   すり抜けや深い食い込みになる場合だけ
+ * - 各円は関わったペアの最も早い TOI の位置で止める。止めた位置で
+ *   掃引し直し、後続の円が止まった円に食い込む玉突きを rounds 回まで拾う
+ * - 始点で既に重なっているペアは対象外（押し離しの OverlapResolver が扱う）
+ * - 入力の並びだけで結果が決まる（決定的）
+ *
+ * 注意：
+ * - 止める時刻は円ごとに異なるので、止めた位置同士のわずかな重なりは
+ *   残りうる。残りは後段の重なり解消に任せる
+ */
+class SweptCollision {
+public:
+  explicit SweptCollision(
+      const SweptCollisionConfig &config = SweptCollisionConfig());
+
+  /**
+   * @brief 掃引を判定し、接触する円の終点を接触位置まで戻す
+   * @param startXs, startYs 各円の始点
+   * @param endXs, endYs 各円の終点（その場で書き換える）
+   * @param radii 各円の半径
+   * @return 終点を戻した円の数
+   */
+  size_t solve(const float *startXs, const float *startYs, float *endXs,
+               float *endYs, const float *radii, size_t count);
+
+  /**
+   * @brief 直前の solve で TOI を解いた候補ペアの数（計測用）
+   */
+  size_t getCandidatePairCount() const { return candidatePairCount_; }
+
+  /**
+   * @brief 前回の並びを捨てる（次の solve で全体をソートする）
+   *
+   * 要素数が同じでも、各位置が前回と別の円を指すようになったときに呼ぶ。
+   */
+  void resetOrder() { order_.clear(); }
+
+  /**
+   * @brief 直前の solve で全体をソートし直した回数（計測用）
+   */
+  size_t getFullSortCount() const { return fullSortCount_; }
+
+private:
+  // 掃引 AABB を作り、x の下端で並べる（前回の順序からの挿入ソート）
+  void sortIntervals(const float *startXs, const float *startYs,
+                     const float *endXs, const float *endYs,
+                     const float *radii, size_t count);
+  // 1回分の掃引。接触したペアの TOI を times_ に反映し、止まる円の数を返す
+  size_t sweep(const float *startXs, const float *startYs, const float *endXs,
+               const float *endYs, const float *radii, size_t count);
+
+  SweptCollisionConfig config_;
+  std::vector<uint32_t> order_; // x の下端の昇順（ティック間で引き継ぐ）
+  std::vector<float> minXs_;
+  std::vector<float> maxXs_;
+  std::vector<float> minYs_;
+  std::vector<float> maxYs_;
+  std::vector<float> times_; // 各円が止まる時刻（1 なら終点まで進む）
+  std::vector<uint8_t> stopped_; // solve の中で終点を戻した円
+  size_t candidatePairCount_ = 0;
+  size_t fullSortCount_ = 0;
+};
+
+#endif // SIMULATION_GAME_SWEPT_COLLISION_H
@@ -0,0 +1,147 @@
+#include "TargetSelector.h"
+
+/*
+ * TargetSelector.cpp
+ *
+ * Selection is a single pass over candidates that are already known to be in
+ * range (broadphase pairs) or near (spatial index). Each candidate is scored
+ * against the current best only, so no candidate list is materialised.
+ *
+ * k-nearest uses an expanding radius: if k enemies are found within radius r,
+ * every closer enemy is also within r, so larger rings never need scanning.
+ */
+#include <algorithm>
+
+TargetSelector::TargetSelector(const UnitEntity & /* attacker */,
+                               TargetSelectionPolicy policy)
+    : policy_(policy) {}
+
+float TargetSelector::threatOf(const UnitEntity &unit) {
+  const UnitStats &stats = unit.getStats();
+  const float averageAttack =
+      0.5f * static_cast<float>(stats.getMinAttackPower() +
+                                stats.getMaxAttackPower());
+  return averageAttack * stats.getAttackSpeed();
+}
+
+bool TargetSelector::isBetter(const UnitEntity &candidate, float distanceSq,
+                              uint32_t index) const {
+  if (!hasTarget()) {
+    return true;
+  }
+
+  switch (policy_) {
+  case TargetSelectionPolicy::FIRST_IN_RANGE:
+    return index < bestIndex_;
+  case TargetSelectionPolicy::NEAREST:
+    break;
+  case TargetSelectionPolicy::LOWEST_HP: {
+    const int hp = candidate.getStats().getCurrentHp();
+    if (hp != bestHp_) {
+      return hp < bestHp_;
+    }
+    break;
+  }
+  case TargetSelectionPolicy::HIGHEST_THREAT: {
+    const float threat = threatOf(candidate);
+    if (threat != bestThreat_) {
+      return threat > bestThreat_;
+    }
+    break;
+  }
+  }
+
+  // 同点は近い方、さらに同じならインデックスの小さい方
+  if (distanceSq != bestDistanceSq_) {
+    return distanceSq < bestDistanceSq_;
+  }
+  return index < bestIndex_;
+}
+
+bool TargetSelector::offer(uint32_t index, const UnitEntity &candidate,
+                           float distanceSq) {
+  if (isBetter(candidate, distanceSq, index)) {
+    bestIndex_ = index;
+    bestDistanceSq_ = distanceSq;
+    bestHp_ = candidate.getStats().getCurrentHp();
+    bestThreat_ = policy_ == TargetSelectionPolicy::HIGHEST_THREAT
+                      ? threatOf(candidate)
+                      : 0.0f;
+  }
+
+  switch (policy_) {
+  case TargetSelectionPolicy::FIRST_IN_RANGE:
+    return false;
+  case TargetSelectionPolicy::LOWEST_HP:
+    // 確殺できる相手が複数いても、最もHPの低い相手を選ぶ。生存している
+    // 候補のHPは1以上なので、HP 1 より良い候補はない
+    return bestHp_ > 1;
+  default:
+    return true;
+  }
+}
+
+uint32_t TargetSelector::selectFromBroadphase(
+    const CombatBroadphase &broadphase,
+    const std::vector<std::shared_ptr<UnitEntity>> &units, size_t attackerIndex,
+    TargetSelectionPolicy policy) {
+  TargetSelector selector(*units[attackerIndex], policy);
+  // ペアは対象インデックス昇順なので、FIRST_IN_RANGE は従来の
+  // 「コンテナ順で最初の敵」と一致する
+  for (const auto &pair : broadphase.pairsForAttacker(attackerIndex)) {
+    const UnitEntity &candidate = *units[pair.targetIndex];
+    if (candidate.getStats().getCurrentHp() <= 0) {
+      continue; // 同ティック内に倒された対象
+    }
+    if (!selector.offer(pair.targetIndex, candidate, pair.distanceSq)) {
+      break;
+    }
+  }
+  return selector.getTargetIndex();
+}
+
+size_t TargetSelector::findKNearestEnemies(const FactionSpatialIndex &index,
+                                           int faction, float x, float y,
+                                           float maxRadius, size_t k,
+                                           uint32_t *outIndices,
+                                           float *outDistancesSq) {
+  if (k == 0 || maxRadius < 0.0f || index.countEnemiesOf(faction) == 0) {
+    return 0;
+  }
+
+  // 出力バッファを距離昇順の有界リストとして使う（挿入ソート）
+  float *distances = outDistancesSq;
+  const size_t enemyCount = index.countEnemiesOf(faction);
+  constexpr float kMinSearchRadius = 1e-3f;
+  float radius =
+      std::min(std::max(index.getCellSize(), kMinSearchRadius), maxRadius);
+  size_t found = 0;
+  while (true) {
+    found = 0;
+    index.forEachEnemyInRadius(
+        faction, x, y, radius, [&](uint32_t candidate, float distanceSq) {
+          if (found == k && (distanceSq > distances[k - 1] ||
+                             (distanceSq == distances[k - 1] &&
+                              candidate > outIndices[k - 1]))) {
+            return; // 現在の k 番目より遠い
+          }
+          size_t slot = found < k ? found++ : k - 1;
+          while (slot > 0 && (distances[slot - 1] > distanceSq ||
+                              (distances[slot - 1] == distanceSq &&
+                               outIndices[slot - 1] > candidate))) {
+            distances[slot] = distances[slot - 1];
+            outIndices[slot] = outIndices[slot - 1];
+            --slot;
+          }
+          distances[slot] = distanceSq;
+          outIndices[slot] = candidate;
+        });
+
+    // k 体見つかった・敵を全員見つけた・上限半径に達した時点で確定
+    if (found == k || found == enemyCount || radius >= maxRadius) {
+      break;
+    }
+    radius = std::min(radius * 2.0f, maxRadius);
+  }
+  return found;
+}
@@ -0,0 +1,111 @@
+#ifndef SIMULATION_GAME_TARGET_SELECTOR_H
+#define SIMULATION_GAME_TARGET_SELECTOR_H
+
+#include "../entities/UnitEntity.h"
+#include "CombatBroadphase.h"
+#include "FactionSpatialIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 攻撃対象の選び方
+ */
+enum class TargetSelectionPolicy {
+  FIRST_IN_RANGE, // コンテナ順で最初の敵（従来の挙動）
+  NEAREST,        // 最も近い敵
+  LOWEST_HP,      // 残りHPが最も少ない敵
+  HIGHEST_THREAT  // 期待DPSが最も高い敵
+};
+
+/**
+ * @brief 候補を1体ずつ受け取り、ポリシーに従って最良の攻撃対象を選ぶ
+ *
+ * 設計方針：
+ * - 候補リスト（vector）を作らず、空間インデックスやペアリストを走査しながら
+ *   offer() に流し込むだけで選択が完了する（ヒープ確保なし）
+ * - offer() が false を返したら、それ以上の走査は不要（早期終了）
+ *   - FIRST_IN_RANGE: 最初の候補で確定
+ *   - LOWEST_HP: HP 1 の候補が見つかった時点で確定（それより低い生存
+ *     ユニットはいない）
+ * - 同点の場合は距離が近い方、さらに同じならインデックスが小さい方を選ぶ
+ *
+ * 注意：
+ * - 候補が射程内か・敵陣営か・生存しているかの判定は呼び出し側の責任
+ */
+class TargetSelector {
+public:
+  static constexpr uint32_t kNoTarget = 0xFFFFFFFFu;
+
+  /**
+   * @brief コンストラクタ
+   * @param attacker 攻撃側ユニット
+   * @param policy 選択ポリシー
+   */
+  TargetSelector(const UnitEntity &attacker, TargetSelectionPolicy policy);
+
+  /**
+   * @brief 候補を1体評価する
+   * @param index 候補のインデックス（呼び出し側の配列上の位置）
+   * @param candidate 候補ユニット
+   * @param distanceSq 攻撃者との距離の二乗
+   * @return 走査を続ける必要があれば true
+   */
+  bool offer(uint32_t index, const UnitEntity &candidate, float distanceSq);
+
+  bool hasTarget() const { return bestIndex_ != kNoTarget; }
+  uint32_t getTargetIndex() const { return bestIndex_; }
+
+  /**
+   * @brief ユニットの脅威度（期待DPS = 平均攻撃力 × 攻撃速度）
+   */
+  static float threatOf(const UnitEntity &unit);
+
+  /**
+   * @brief ブロードフェーズのペアから攻撃対象を選ぶ
+   * @param broadphase 構築済みのブロードフェーズ
+   * @param units rebuild に渡したユニット配列
+   * @param attackerIndex 攻撃側ユニットのインデックス
+   * @param policy 選択ポリシー
+   * @return 選ばれた対象のインデックス（いなければ kNoTarget）
+   *
+   * 同ティック内に倒された対象は除外する。
+   */
+  static uint32_t
+  selectFromBroadphase(const CombatBroadphase &broadphase,
+                       const std::vector<std::shared_ptr<UnitEntity>> &units,
+                       size_t attackerIndex, TargetSelectionPolicy policy);
+
+  /**
+   * @brief 近い順に最大 k 体の敵を求める
+   * @param index 陣営別空間インデックス
+   * @param faction 探索する側の陣営
+   * @param maxRadius 探索半径の上限
+   * @param k 求める数（出力バッファの長さ）
+   * @param outIndices 結果のインデックス（距離昇順）
+   * @param outDistancesSq 結果の距離の二乗（長さ k）
+   * @return 見つかった数（k 以下）
+   *
+   * 探索半径をセルサイズから倍々に広げ、k 体見つかった時点で打ち切る。
+   * 出力は呼び出し側のバッファに書き込むため、ヒープ確保は行わない。
+   */
+  static size_t findKNearestEnemies(const FactionSpatialIndex &index,
+                                    int faction, float x, float y,
+                                    float maxRadius, size_t k,
+                                    uint32_t *outIndices,
+                                    float *outDistancesSq);
+
+private:
+  bool isBetter(const UnitEntity &candidate, float distanceSq,
+                uint32_t index) const;
+
+  TargetSelectionPolicy policy_;
+
+  uint32_t bestIndex_ = kNoTarget;
+  float bestDistanceSq_ = 0.0f;
+  int bestHp_ = 0;
+  float bestThreat_ = 0.0f;
+};
+
+#endif // SIMULATION_GAME_TARGET_SELECTOR_H
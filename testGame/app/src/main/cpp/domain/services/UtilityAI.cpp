@@ -0,0 +1,54 @@
+#include "UtilityAI.h"
+
+/*
+ * UtilityAI.cpp
+ *
+ * Response curves (all in [0, 1]):
+ * - ENGAGE:  only when engaged; 0.5 + 0.5 * advantage.
+ * - ADVANCE: only when an enemy is known and nobody is in range yet;
+ *            hp * (0.3 + 0.7 * advantage).
+ * - RETREAT: (1 - hp)^2 * (1 - advantage), boosted when enemies are in range.
+ * - HOLD:    constant kHoldScore.
+ *
+ * While ahead, units finish off weak targets (LOWEST_HP). While behind, they
+ * focus the most dangerous enemy (HIGHEST_THREAT).
+ */
+
+float UtilityAI::advantageOf(const AIContext &context) {
+  const float total = context.ownInfluence + context.enemyInfluence;
+  if (total <= 0.0f) {
+    return 0.5f;
+  }
+  return context.ownInfluence / total;
+}
+
+AIDecision UtilityAI::decide(const AIContext &context) {
+  const float advantage = advantageOf(context);
+  const float hp = context.hpRatio;
+
+  AIDecision decision;
+  decision.score = kHoldScore;
+  decision.targetPolicy = advantage >= 0.5f
+                              ? TargetSelectionPolicy::LOWEST_HP
+                              : TargetSelectionPolicy::HIGHEST_THREAT;
+
+  auto consider = [&decision](AIAction action, float score) {
+    if (score > decision.score) {
+      decision.action = action;
+      decision.score = score;
+    }
+  };
+
+  if (context.engaged) {
+    consider(AIAction::ENGAGE, 0.5f + 0.5f * advantage);
+  } else if (context.enemyKnown) {
+    consider(AIAction::ADVANCE, hp * (0.3f + 0.7f * advantage));
+  }
+
+  if (context.enemyKnown || context.engaged) {
+    const float danger = context.engaged ? 1.5f : 1.0f;
+    const float wounded = (1.0f - hp) * (1.0f - hp);
+    consider(AIAction::RETREAT, wounded * (1.0f - advantage) * danger);
+  }
+  return decision;
+}
@@ -0,0 +1,63 @@
+#ifndef SIMULATION_GAME_UTILITY_AI_H
+#define SIMULATION_GAME_UTILITY_AI_H
+
+#include "TargetSelector.h"
+
+/**
+ * @brief AI が選ぶ行動
+ */
+enum class AIAction {
+  HOLD,    // その場で待機（自動戦闘に任せる）
+  ENGAGE,  // 交戦中。移動せず攻撃対象の選び方だけを変える
+  ADVANCE, // 最寄りの敵へ前進
+  RETREAT  // 最寄りの敵から離れる
+};
+
+/**
+ * @brief 1ユニットの意思決定に使う状況
+ */
+struct AIContext {
+  float hpRatio = 1.0f;         // 現在HP / 最大HP
+  float ownInfluence = 0.0f;    // 自陣営の影響度（現在位置）
+  float enemyInfluence = 0.0f;  // 敵陣営の影響度（現在位置）
+  bool engaged = false;         // 射程内に敵がいる
+  bool enemyKnown = false;      // 探索範囲内に敵が見つかった
+};
+
+/**
+ * @brief 意思決定の結果
+ */
+struct AIDecision {
+  AIAction action = AIAction::HOLD;
+  TargetSelectionPolicy targetPolicy = TargetSelectionPolicy::FIRST_IN_RANGE;
+  float score = 0.0f; // 選ばれた行動の効用（0〜1）
+};
+
+/**
+ * @brief 効用（ユーティリティ）に基づく行動選択
+ *
+ * 設計方針：
+ * - 各行動の効用を 0〜1 の応答曲線で評価し、最大のものを選ぶ
+ * - 入力は AIContext の値のみ。ユニットや影響度マップには触れないため
+ *   純粋関数として単体テストできる
+ * - 優勢度 = 自陣営影響度 / (自陣営 + 敵陣営)。影響度が無い場合は 0.5
+ */
+class UtilityAI {
+public:
+  /**
+   * @brief 何もしない行動の基礎効用（他の行動がこれを下回れば待機）
+   */
+  static constexpr float kHoldScore = 0.1f;
+
+  /**
+   * @brief 状況から行動を選ぶ
+   */
+  static AIDecision decide(const AIContext &context);
+
+  /**
+   * @brief 優勢度（0 = 圧倒的劣勢, 1 = 圧倒的優勢）
+   */
+  static float advantageOf(const AIContext &context);
+};
+
+#endif // SIMULATION_GAME_UTILITY_AI_H
@@ -3,13 +3,13 @@
 #include <algorithm>
 
 namespace {
-// movementSpeedMultiplier / walkable / evasionBonus
-constexpr TerrainProperties kGrassland{1.0f, true, 0.0f};
-constexpr TerrainProperties kForest{0.5f, true, 0.15f};
-constexpr TerrainProperties kMountain{0.3f, true, 0.25f};
-constexpr TerrainProperties kWater{0.0f, false, 0.0f};
-constexpr TerrainProperties kRiver{0.01f, true, 0.05f};
-constexpr TerrainProperties kUnknown{1.0f, true, 0.0f};
+// movementSpeedMultiplier / walkable / evasionBonus / sightOpacity
+constexpr TerrainProperties kGrassland{1.0f, true, 0.0f, 0.0f};
+constexpr TerrainProperties kForest{0.5f, true, 0.15f, 0.4f};
+constexpr TerrainProperties kMountain{0.3f, true, 0.25f, 1.0f};
+constexpr TerrainProperties kWater{0.0f, false, 0.0f, 0.0f};
+constexpr TerrainProperties kRiver{0.01f, true, 0.05f, 0.0f};
+constexpr TerrainProperties kUnknown{1.0f, true, 0.0f, 0.0f};
 } // namespace
 
 TerrainProperties getTerrainProperties(TerrainType type) {
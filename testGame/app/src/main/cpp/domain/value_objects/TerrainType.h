@@ -14,6 +14,7 @@ struct TerrainProperties {
   float movementSpeedMultiplier; // ユニットの基本移動速度に掛ける倍率
   bool walkable; // false の場合、そのタイルは移動を完全に遮断する
   float evasionBonus; // 戦闘ボーナス用の仮プレースホルダー（未使用）
+  float sightOpacity; // 視線が通過する際に遮られる割合（0 = 透過, 1 = 遮断）
 };
 
 TerrainProperties getTerrainProperties(TerrainType type);
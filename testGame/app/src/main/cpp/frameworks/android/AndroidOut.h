@@ -2,7 +2,8 @@
 #define ANDROIDGLINVESTIGATIONS_ANDROIDOUT_H
 
 #include <android/log.h>
-#include <sstream>
+#include <ostream>
+#include <streambuf>
 
 /*!
  * Use this to log strings out to logcat. Note that you should use std::endl to
@@ -16,24 +17,46 @@ extern std::ostream aout;
 /*!
  * Use this class to create an output stream that writes to logcat. By default,
  * a global one is defined as @a aout
+ *
+ * Lines are collected in a fixed buffer owned by the stream, so logging does
+ * not allocate. A line longer than the buffer is written out in pieces.
  */
-class AndroidOut : public std::stringbuf {
+class AndroidOut : public std::streambuf {
 public:
   /*!
    * Creates a new output stream for logcat
    * @param kLogTag the log tag to output
    */
-  inline AndroidOut(const char *kLogTag) : logTag_(kLogTag) {}
+  inline AndroidOut(const char *kLogTag) : logTag_(kLogTag) {
+    setp(buffer_, buffer_ + kBufferSize);
+  }
 
 protected:
   virtual int sync() override {
-    __android_log_print(ANDROID_LOG_DEBUG, logTag_, "%s", str().c_str());
-    str("");
+    flushBuffer();
     return 0;
   }
 
+  virtual int_type overflow(int_type ch) override {
+    flushBuffer();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+    }
+    return traits_type::not_eof(ch);
+  }
+
 private:
+  static constexpr int kBufferSize = 1024;
+
+  inline void flushBuffer() {
+    __android_log_print(ANDROID_LOG_DEBUG, logTag_, "%.*s",
+                        static_cast<int>(pptr() - pbase()), pbase());
+    setp(buffer_, buffer_ + kBufferSize);
+  }
+
   const char *logTag_;
+  char buffer_[kBufferSize];
 };
 
 #endif // ANDROIDGLINVESTIGATIONS_ANDROIDOUT_H
\ No newline at end of file
@@ -81,6 +81,16 @@ Java_com_example_testgame_MainActivity_getElapsedTime(JNIEnv *env,
   return g_renderer->getElapsedTime();
 }
 
+// Latest predicted win chance (0..1) of the player faction, -1 when unknown.
+// The prediction runs as a job-system task; this only reads the atomic cache.
+extern "C" JNIEXPORT jfloat JNICALL
+Java_com_example_testgame_MainActivity_getWinChance(JNIEnv *env,
+                                                    jobject /* this */) {
+  if (!g_renderer)
+    return -1.0f;
+  return g_renderer->getWinChance();
+}
+
 // Return a packed int where each byte is the count for faction 1..4 (supports
 // up to 255 each)
 extern "C" JNIEXPORT jint JNICALL
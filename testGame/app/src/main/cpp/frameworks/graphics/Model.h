@@ -1,6 +1,7 @@
 #ifndef ANDROIDGLINVESTIGATIONS_MODEL_H
 #define ANDROIDGLINVESTIGATIONS_MODEL_H
 
+#include "../utils/FrameArena.h"
 #include "TextureAsset.h"
 #include <vector>
 
@@ -33,7 +34,16 @@ typedef uint16_t Index;
 
 class Model {
 public:
-  inline Model(std::vector<Vertex> vertices, std::vector<Index> indices,
+  inline Model(const std::vector<Vertex> &vertices,
+               const std::vector<Index> &indices,
+               std::shared_ptr<TextureAsset> spTexture)
+      : vertices_(vertices.begin(), vertices.end()),
+        indices_(indices.begin(), indices.end()),
+        spTexture_(std::move(spTexture)) {}
+
+  // Per-frame models keep their buffers in the frame arena; such a model
+  // must not outlive FrameArena::reset().
+  inline Model(FrameVector<Vertex> vertices, FrameVector<Index> indices,
                std::shared_ptr<TextureAsset> spTexture)
       : vertices_(std::move(vertices)), indices_(std::move(indices)),
         spTexture_(std::move(spTexture)) {}
@@ -55,8 +65,8 @@ public:
   }
 
 private:
-  std::vector<Vertex> vertices_;
-  std::vector<Index> indices_;
+  FrameVector<Vertex> vertices_;
+  FrameVector<Index> indices_;
   std::shared_ptr<TextureAsset> spTexture_;
 };
 
@@ -17,6 +17,7 @@
 
 #include <GLES3/gl3.h>
 #include <android/imagedecoder.h>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <game-activity/native_app_glue/android_native_app_glue.h>
@@ -109,7 +110,19 @@ static constexpr float kProjectionNearPlane = -10.f;
  */
 static constexpr float kProjectionFarPlane = 10.f;
 
+/*!
+ * プレイヤーが操作する陣営。勝率予測と戦場の霧はこの陣営から見たもの
+ */
+static constexpr int kPlayerFaction = 1;
+
+/*!
+ * 見えていないタイルに重ねる霧の不透明度（0～255）
+ */
+static constexpr uint8_t kFogAlpha = 160;
+
 Renderer::~Renderer() {
+  // 実行中の予測タスクを待ってから、それが参照するメンバーを破棄する
+  jobSystem_.reset();
   if (display_ != EGL_NO_DISPLAY) {
     eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
     if (context_ != EGL_NO_CONTEXT) {
@@ -136,17 +149,59 @@ float Renderer::calculateDeltaTime() {
 }
 
 void Renderer::updateGameState(float deltaTime) {
+  // 射程内ペアはティック開始時に1回だけ求め、以降の3つの処理で共有する
+  combatBroadphase_.rebuildIndex(units_);
+  // 動いているユニットの近くの敵を起こし、周りに敵のいない待機中のユニットを
+  // 眠らせる（走査するのは起きているユニットだけ）
+  if (activeUnitSets_.covers(units_.size())) {
+    activeUnitSets_.updateSleep(combatBroadphase_.getFactionIndex());
+  }
+  // 眠っているユニットの射程内に敵はいないので、攻撃者としては探さない
+  combatBroadphase_.buildPairs(&activeUnitSets_);
+  // 画面外で敵から離れたユニットの移動は数ティックに1回にまとめる
+  updateSimulationLodView();
+  simulationLod_.beginTick(&combatBroadphase_.getFactionIndex());
+
+  // AI の移動指示は同じティックの移動処理に反映される
+  if (aiSchedulerUseCase_) {
+    aiSchedulerUseCase_->update(elapsedTime_);
+  }
+
+  // 移動前の位置を記録し、移動の後に始点からの掃引ですり抜けを止める
+  if (collisionUseCase_) {
+    collisionUseCase_->captureStartPositions();
+  }
   if (movementUseCase_) {
     movementUseCase_->updateMovements(deltaTime);
   }
 
+  // 回避しきれずに残った重なりを押し離す（攻撃判定より前に行う）
+  if (collisionUseCase_) {
+    collisionUseCase_->resolveSweptContacts();
+    collisionUseCase_->resolveOverlaps();
+  }
+
   if (combatUseCase_) {
     combatUseCase_->executeAutoCombat();
-    combatUseCase_->removeDeadUnits();
   }
 
   resolveCombatEngagements();
 
+  // ペアのインデックスは units_ の並びに依存するため、除去は全消費者の後で行う
+  if (combatUseCase_ && combatUseCase_->removeDeadUnits() > 0) {
+    activeUnitSets_.track(units_);
+  }
+  combatBroadphase_.invalidate();
+
+  // 視界は移動したユニットの分だけ更新される
+  if (fogOfWar_) {
+    fogOfWar_->update(units_);
+  }
+
+  updateBattlePrediction();
+  updateInfluenceMaps();
+  reportProfiler();
+
   if (unitRenderer_) {
     unitRenderer_->updateUnits(deltaTime);
   }
@@ -156,6 +211,83 @@ void Renderer::updateGameState(float deltaTime) {
   elapsedTime_ += deltaTime;
 }
 
+void Renderer::updateBattlePrediction() {
+  // 予測は数ミリ秒の予算内で終わるが、毎フレーム行う必要はない
+  constexpr float kPredictionInterval = 1.0f;
+  if (!battlePredictionUseCase_ || !jobSystem_ ||
+      elapsedTime_ < nextPredictionTime_ ||
+      predictionPending_.load(std::memory_order_acquire)) {
+    return;
+  }
+  nextPredictionTime_ = elapsedTime_ + kPredictionInterval;
+
+  // スナップショットだけ描画スレッドで取り、試行はワーカーで回す
+  battlePredictionUseCase_->snapshotFaction(units_, kPlayerFaction);
+  predictionPending_.store(true, std::memory_order_relaxed);
+  jobSystem_->submit([this]() {
+    const BattlePrediction prediction =
+        battlePredictionUseCase_->predictSnapshot();
+    winChance_.store(prediction.simulations > 0 ? prediction.winProbability
+                                                : -1.0f);
+    predictionPending_.store(false, std::memory_order_release);
+  });
+}
+
+void Renderer::updateInfluenceMaps() {
+  // 影響度は粗いセル単位なので、数フレームに1回の更新で十分
+  constexpr float kInfluenceInterval = 0.25f;
+  if (!influenceMapUseCase_ || elapsedTime_ < nextInfluenceTime_) {
+    return;
+  }
+  influenceMapUseCase_->update(units_, elapsedTime_ - lastInfluenceTime_);
+  lastInfluenceTime_ = elapsedTime_;
+  nextInfluenceTime_ = elapsedTime_ + kInfluenceInterval;
+}
+
+void Renderer::reportProfiler() {
+  constexpr float kReportInterval = 5.0f;
+  if (elapsedTime_ < nextProfilerReportTime_) {
+    return;
+  }
+  nextProfilerReportTime_ = elapsedTime_ + kReportInterval;
+  profiler_.report();
+}
+
+void Renderer::uploadFogOfWar() {
+  if (!fogOfWar_ || !fogTexture_) {
+    return;
+  }
+  fogOfWar_->takeDirtyRows(kPlayerFaction, fogDirtyRows_);
+  if (fogDirtyRows_.empty()) {
+    return;
+  }
+
+  const int width = fogOfWar_->getWidth();
+  const size_t rowBytes = static_cast<size_t>(width) * 4;
+  for (int row : fogDirtyRows_) {
+    const uint64_t *bits = fogOfWar_->getRowBits(kPlayerFaction, row);
+    uint8_t *pixels = fogPixels_.data() + row * rowBytes;
+    for (int x = 0; x < width; ++x) {
+      const bool visible = (bits[x >> 6] >> (x & 63)) & 1u;
+      pixels[x * 4 + 3] = visible ? 0 : kFogAlpha;
+    }
+  }
+
+  // 連続した行はまとめて1回の glTexSubImage2D で転送する
+  size_t runStart = 0;
+  for (size_t i = 1; i <= fogDirtyRows_.size(); ++i) {
+    if (i < fogDirtyRows_.size() &&
+        fogDirtyRows_[i] == fogDirtyRows_[i - 1] + 1) {
+      continue;
+    }
+    const int firstRow = fogDirtyRows_[runStart];
+    const int rowCount = static_cast<int>(i - runStart);
+    fogTexture_->updateRows(firstRow, rowCount, width,
+                            fogPixels_.data() + firstRow * rowBytes);
+    runStart = i;
+  }
+}
+
 void Renderer::updateCameraSmoothing(float deltaTime) {
   // カメラターゲットへ滑らかに追従する
   const float toX = cameraTargetX_ - cameraOffsetX_;
@@ -179,50 +311,44 @@ void Renderer::updateCameraSmoothing(float deltaTime) {
   }
 }
 
-void Renderer::resolveCombatEngagements() {
-  // 全ユニット間の距離を測り、射程内であれば戦闘状態に遷移させる
-  if (units_.size() < 2) {
+void Renderer::updateSimulationLodView() {
+  if (width_ <= 0 || height_ <= 0) {
+    simulationLod_.disable();
     return;
   }
+  // 投影行列と同じパラメータで、カメラが映すワールド範囲を求める
+  const float halfHeight = kProjectionHalfHeight / cameraZoom_;
+  const float aspect = static_cast<float>(width_) / static_cast<float>(height_);
+  const float halfWidth = halfHeight * aspect;
+  simulationLod_.setView(cameraOffsetX_ - halfWidth,
+                         cameraOffsetY_ - halfHeight,
+                         cameraOffsetX_ + halfWidth,
+                         cameraOffsetY_ + halfHeight);
+}
 
-  for (size_t i = 0; i < units_.size(); ++i) {
-    for (size_t j = i + 1; j < units_.size(); ++j) {
-      auto &unit1 = units_[i];
-      auto &unit2 = units_[j];
-
-      if (!unit1->isAlive() || !unit2->isAlive()) {
-        continue;
-      }
-
-      const auto pos1 = unit1->getPosition();
-      const auto pos2 = unit2->getPosition();
-      const float dx = pos2.getX() - pos1.getX();
-      const float dy = pos2.getY() - pos1.getY();
-      const float distance = std::sqrt(dx * dx + dy * dy);
-
-      const bool unit1InRange =
-          distance <= (unit1->getStats().getAttackRange() +
-                       unit2->getStats().getCollisionRadius());
-      const bool unit2InRange =
-          distance <= (unit2->getStats().getAttackRange() +
-                       unit1->getStats().getCollisionRadius());
-
-      if (!unit1InRange && !unit2InRange) {
-        continue;
-      }
+void Renderer::resolveCombatEngagements() {
+  // 射程内に敵がいる攻撃者だけを走査し、待機中なら戦闘状態に遷移させる。
+  // 距離判定は構築時に二乗距離で済んでいるため、ここでは行わない。
+  if (!combatBroadphase_.covers(units_.size())) {
+    return;
+  }
 
-      if (unit1InRange && (unit1->getState() == UnitState::IDLE ||
-                           unit1->getState() == UnitState::COMBAT)) {
-        unit1->setState(UnitState::COMBAT);
-        aout << unit1->getName() << " entering combat with "
-             << unit2->getName() << std::endl;
-      }
+  for (uint32_t attackerIndex : combatBroadphase_.getEngagedAttackers()) {
+    auto &attacker = units_[attackerIndex];
+    // 移動中のユニットは MovementUseCase の自動停止に任せる。既に戦闘中なら
+    // 遷移は不要
+    if (!attacker->isAlive() || attacker->getState() != UnitState::IDLE) {
+      continue;
+    }
 
-      if (unit2InRange && (unit2->getState() == UnitState::IDLE ||
-                           unit2->getState() == UnitState::COMBAT)) {
-        unit2->setState(UnitState::COMBAT);
-        aout << unit2->getName() << " entering combat with "
-             << unit1->getName() << std::endl;
+    // 同ティックの戦闘で倒された相手は除外
+    for (const auto &pair : combatBroadphase_.pairsForAttacker(attackerIndex)) {
+      const auto &target = units_[pair.targetIndex];
+      if (target->isAlive()) {
+        attacker->setState(UnitState::COMBAT);
+        aout << attacker->getName() << " entering combat with "
+             << target->getName() << std::endl;
+        break;
       }
     }
   }
@@ -300,6 +426,8 @@ void Renderer::render() {
   // デバッグログ
   aout << "Begin rendering frame..." << std::endl;
 
+  uploadFogOfWar();
+
   // 背景モデルのレンダリング
   if (!models_.empty()) {
     aout << "Drawing " << models_.size() << " background models" << std::endl;
@@ -346,6 +474,9 @@ void Renderer::render() {
   // Present the rendered image. This is an implicit glFlush.
   auto swapResult = eglSwapBuffers(display_, surface_);
   assert(swapResult == EGL_TRUE);
+
+  // このフレームの一時データをまとめて捨てる
+  frameArena_.reset();
 }
 
 void Renderer::initRenderer() {
@@ -582,6 +713,20 @@ void Renderer::createModels() {
       std::vector<Index> mapIndices = {0, 1, 2, 0, 2, 3};
       models_.emplace_back(mapVertices, mapIndices, mapTexture);
 
+      // 戦場の霧: 初期状態は全タイルが未探索（霧あり）
+      fogOfWar_ = std::make_unique<FogOfWarGrid>(*gameMap_);
+      fogPixels_.assign(static_cast<size_t>(gameMap_->getWidth()) *
+                            gameMap_->getHeight() * 4,
+                        0);
+      for (size_t i = 3; i < fogPixels_.size(); i += 4) {
+        fogPixels_[i] = kFogAlpha;
+      }
+      fogTexture_ = TextureAsset::createFromPixels(
+          gameMap_->getWidth(), gameMap_->getHeight(), fogPixels_);
+      if (fogTexture_) {
+        models_.emplace_back(mapVertices, mapIndices, fogTexture_);
+      }
+
       movementField_ = std::make_unique<MovementField>(
           gameMap_->getMinX(), gameMap_->getMinY(), gameMap_->getMaxX(),
           gameMap_->getMaxY());
@@ -620,10 +765,18 @@ void Renderer::createModels() {
   // ユニットレンダラーを初期化（単色テクスチャ）
   unitRenderer_ = std::make_unique<UnitRenderer>(
       TextureAsset::createSolidColorTexture(0.6f, 0.6f, 0.6f));
+  unitRenderer_->setFrameArena(&frameArena_);
   // デバッグ用途: 当たり判定ワイヤーフレームを常に表示
   unitRenderer_->setShowCollisionWireframes(true);
   // デバッグ用途: 攻撃範囲も表示
   unitRenderer_->setShowAttackRanges(true);
+  // 霧に隠れた敵ユニットは描画しない
+  if (fogOfWar_) {
+    unitRenderer_->setVisibilityFilter([this](const UnitEntity &unit) {
+      return unit.getFaction() == kPlayerFaction ||
+             fogOfWar_->isVisibleAt(kPlayerFaction, unit.getPosition());
+    });
+  }
 
   // Try to load unit spawn configuration from assets/unit_spawns.json
   bool loadedFromJson = false;
@@ -790,6 +943,12 @@ void Renderer::createModels() {
   // addCircleObstacle calls)
   // この変更により、フィールド上の障害物は存在しません。
 
+  // 障害物はマップの通行レイヤーへ焼き込み、地形と1回の参照で判定する
+  // （障害物がなくてもクリアランス層はここで作る）
+  if (gameMap_) {
+    movementField_->rasterizeInto(*gameMap_);
+  }
+
   // HUD：カメラパン用の簡易ボタンモデルを追加します（画面右下に上下左右）
   // ボタンは画面空間で判定するため、ここでは単純なワールド座標の四角を作成しておきます
   auto addButtonModel = [&](float centerX, float centerY, float size, float r,
@@ -817,6 +976,53 @@ void Renderer::createModels() {
   combatUseCase_ = std::make_unique<CombatUseCase>(units_);
   movementUseCase_ = std::make_unique<MovementUseCase>(
       units_, movementField_.get(), gameMap_.get());
+  collisionUseCase_ =
+      std::make_unique<CollisionUseCase>(units_, gameMap_.get());
+  combatUseCase_->setCombatBroadphase(&combatBroadphase_);
+  movementUseCase_->setCombatBroadphase(&combatBroadphase_);
+  activeUnitSets_.track(units_);
+  combatUseCase_->setActiveUnitSets(&activeUnitSets_);
+  movementUseCase_->setActiveUnitSets(&activeUnitSets_);
+  collisionUseCase_->setActiveUnitSets(&activeUnitSets_, &combatBroadphase_);
+  movementUseCase_->setSimulationLod(&simulationLod_);
+  if (gameMap_) {
+    // 迂回経路のグラフは最も大きいユニットの衝突半径で作る
+    float maxRadius = 0.0f;
+    for (const auto &unit : units_) {
+      maxRadius = std::max(maxRadius, unit->getStats().getCollisionRadius());
+    }
+    navGraph_.build(*gameMap_, maxRadius);
+    movementUseCase_->setNavigationGraph(&navGraph_);
+  }
+
+  // 森・山越しの攻撃はブロードフェーズの段階で除外する
+  if (gameMap_) {
+    lineOfSight_ = std::make_unique<LineOfSight>(gameMap_.get());
+    combatBroadphase_.setLineOfSight(lineOfSight_.get());
+  }
+
+  // 勝敗予測はワーカースレッドで並列に試行する
+  jobSystem_ = std::make_unique<ThreadPoolJobSystem>();
+  battlePredictionUseCase_ =
+      std::make_unique<BattlePredictionUseCase>(jobSystem_.get());
+  // 局所回避の速度計算も同じワーカーで分担する
+  movementUseCase_->setJobSystem(jobSystem_.get());
+
+  // AI 用の影響度マップ（全再構築と減衰は同じワーカーで並列化）
+  if (gameMap_) {
+    influenceMapUseCase_ = std::make_unique<InfluenceMapUseCase>(
+        gameMap_->getMinX(), gameMap_->getMinY(), gameMap_->getMaxX(),
+        gameMap_->getMaxY(), jobSystem_.get());
+  }
+
+  // 敵陣営の AI。決定は移動指示と攻撃対象ポリシーとして各ユースケースへ渡す
+  aiSchedulerUseCase_ = std::make_unique<AISchedulerUseCase>(
+      units_, movementUseCase_.get(), combatUseCase_.get());
+  aiSchedulerUseCase_->setCombatBroadphase(&combatBroadphase_);
+  aiSchedulerUseCase_->setProfiler(&profiler_);
+  if (influenceMapUseCase_) {
+    aiSchedulerUseCase_->setInfluenceMap(&influenceMapUseCase_->getMap());
+  }
 
   // 戦闘イベントのコールバックを設定
   combatUseCase_->setCombatEventCallback(
@@ -1145,6 +1351,7 @@ void Renderer::resetGameToInitialState() {
     unitRenderer_->resetAllUnitsToInitialPositions();
     aout << "RESET: All unit positions reset to initial state" << std::endl;
   }
+  activeUnitSets_.track(units_);
 
   // 4. プロジェクション行列の再計算をトリガー
   shaderNeedsNewProjectionMatrix_ = true;
@@ -2,10 +2,15 @@
 #define ANDROIDGLINVESTIGATIONS_RENDERER_H
 
 #include <EGL/egl.h>
+#include <atomic>
 #include <memory>
 
+#include "../../usecases/AISchedulerUseCase.h"
+#include "../../usecases/BattlePredictionUseCase.h"
 #include "../../usecases/CameraControlUseCase.h"
+#include "../../usecases/CollisionUseCase.h"
 #include "../../usecases/CombatUseCase.h"
+#include "../../usecases/InfluenceMapUseCase.h"
 #include "../../usecases/MovementUseCase.h"
 #include "Model.h"
 #include "Shader.h"
@@ -13,8 +18,15 @@
 #include "entities/UnitEntity.h"
 // MovementField is used by Renderer as a concrete type for the movement field
 // instance
+#include "../../domain/services/ActiveUnitSets.h"
 #include "../../domain/services/MovementField.h"
+#include "../../domain/services/RectNavGraph.h"
+#include "../../domain/services/SimulationLod.h"
+#include "../../domain/services/FogOfWarGrid.h"
 #include "../android/TouchInputHandler.h"
+#include "../utils/FrameArena.h"
+#include "../utils/FrameProfiler.h"
+#include "../utils/ThreadPoolJobSystem.h"
 
 class GameMap;
 
@@ -172,9 +184,22 @@ private:
   void updateGameState(float deltaTime);
   // カメラのスムージング処理をまとめる
   void updateCameraSmoothing(float deltaTime);
-  // ユニット同士の射程チェックを行い、戦闘状態を遷移させる
+  // ブロードフェーズのペアリストを読み、射程内のユニットを戦闘状態に遷移させる
   void resolveCombatEngagements();
 
+  /**
+   * @brief 現在のカメラが映す範囲をシミュレーション LOD に渡す
+   */
+  void updateSimulationLodView();
+  // 一定間隔でプレイヤー陣営の勝率をジョブシステムで再予測する（UI 表示用）
+  void updateBattlePrediction();
+  // 一定間隔で AI 用の影響度マップを更新する
+  void updateInfluenceMaps();
+  // 一定間隔でプロファイラの集計をログへ出力する
+  void reportProfiler();
+  // 前回から変化した霧の行だけをテクスチャへ転送する（GL スレッドで呼ぶ）
+  void uploadFogOfWar();
+
   android_app *app_;
   EGLDisplay display_;
   EGLSurface surface_;
@@ -191,13 +216,42 @@ private:
   std::unique_ptr<UnitRenderer> unitRenderer_;
   std::vector<std::shared_ptr<UnitEntity>> units_;
 
+  // ワーカースレッド（予測ユースケースより先に宣言し、後に破棄する）
+  std::unique_ptr<ThreadPoolJobSystem> jobSystem_;
+
   // ユースケース
   std::unique_ptr<CombatUseCase> combatUseCase_;
   std::unique_ptr<MovementUseCase> movementUseCase_;
+  std::unique_ptr<CollisionUseCase> collisionUseCase_;
   std::unique_ptr<CameraControlUseCase> cameraControlUseCase_;
+  std::unique_ptr<BattlePredictionUseCase> battlePredictionUseCase_;
+  std::unique_ptr<InfluenceMapUseCase> influenceMapUseCase_;
+  // 敵陣営（faction 2）の思考。1 ティックあたりの予算内で分散して実行する
+  std::unique_ptr<AISchedulerUseCase> aiSchedulerUseCase_;
+  // 区間ごとの所要時間と予算超過の集計
+  FrameProfiler profiler_;
+  // 描画の一時データ（頂点・インデックス）用。render() の最後に reset する
+  FrameArena frameArena_;
+  // ティック毎に1回構築し、移動・戦闘・交戦判定で共有する射程内ペアリスト
+  CombatBroadphase combatBroadphase_;
+  // 移動中・戦闘中・起きているユニットの集合。状態遷移の通知で保守され、
+  // ユニットの並びが変わったときだけ track し直す
+  ActiveUnitSets activeUnitSets_;
+  // 画面外の離れたユニットの移動を間引く。表示範囲はティックごとに更新する
+  SimulationLod simulationLod_;
   // Movement field for walkability and obstacles
   std::unique_ptr<class MovementField> movementField_;
   std::shared_ptr<GameMap> gameMap_;
+  // 地形による視線判定（gameMap_ を参照するため、その後に宣言する）
+  std::unique_ptr<LineOfSight> lineOfSight_;
+  // 迂回経路の探索用グラフ（地形の境目が多く Jump Point Search が効かない
+  // マップで使われる）。地形の変更は経路を求めるときに反映される
+  RectNavGraph navGraph_;
+  // プレイヤー陣営の視界。霧テクスチャは1タイル = 1ピクセル
+  std::unique_ptr<FogOfWarGrid> fogOfWar_;
+  std::shared_ptr<TextureAsset> fogTexture_;
+  std::vector<uint8_t> fogPixels_;
+  std::vector<int> fogDirtyRows_;
 
   // 新しいタッチ入力システム
   std::unique_ptr<TouchInputHandler> touchInputHandler_;
@@ -219,6 +273,18 @@ private:
   // accumulated elapsed time since renderer start (seconds)
   float elapsedTime_ = 0.0f;
 
+  // 直近のプレイヤー陣営（faction 1）の予測勝率。未計算は -1
+  // 予測タスク（ワーカースレッド）が書き、描画スレッドと JNI が読む
+  std::atomic<float> winChance_{-1.0f};
+  // 予測タスクが実行待ち・実行中の間は true（次の予測を投げない）
+  std::atomic<bool> predictionPending_{false};
+  float nextPredictionTime_ = 0.0f;
+  // 影響度マップの次回更新時刻と前回更新時刻
+  float nextInfluenceTime_ = 0.0f;
+  float lastInfluenceTime_ = 0.0f;
+  // 次にプロファイラの集計を出力する時刻
+  float nextProfilerReportTime_ = 0.0f;
+
   // Simple HUD button rectangles (screen coordinates) for camera control.
   // Each button is represented as: x, y, width, height in pixels
   struct ButtonRect {
@@ -237,7 +303,11 @@ public:
   float getCameraOffsetX() const { return cameraOffsetX_; }
   float getCameraOffsetY() const { return cameraOffsetY_; }
   float getElapsedTime() const { return elapsedTime_; }
+  float getWinChance() const { return winChance_.load(); }
   std::shared_ptr<GameMap> getGameMap() const { return gameMap_; }
+  const InfluenceMap *getInfluenceMap() const {
+    return influenceMapUseCase_ ? &influenceMapUseCase_->getMap() : nullptr;
+  }
   // Public wrapper to convert screen coordinates (pixels) to world/game
   // coordinates Uses the existing private screenToWorldCoordinates
   // implementation.
@@ -219,20 +219,24 @@ float TextRenderer::renderChar(const Shader *shader, char c, float x, float y,
   float charHeight = kCharHeight * adjustedScale;
 
   // 文字のクアッド（四角形）を作成（原点からの相対座標）
-  std::vector<Vertex> vertices = {
-      Vertex(Vector3{charWidth, charHeight, 0.3f}, Vector2{u1, v0}), // 右上
-      Vertex(Vector3{0, charHeight, 0.3f}, Vector2{u0, v0}),         // 左上
-      Vertex(Vector3{0, 0, 0.3f}, Vector2{u0, v1}),                  // 左下
-      Vertex(Vector3{charWidth, 0, 0.3f}, Vector2{u1, v1})           // 右下
-  };
+  // （フレームアリーナがあればそこに確保し、フレームの終わりにまとめて捨てる）
+  FrameVector<Vertex> vertices(
+      {
+          Vertex(Vector3{charWidth, charHeight, 0.3f}, Vector2{u1, v0}), // 右上
+          Vertex(Vector3{0, charHeight, 0.3f}, Vector2{u0, v0}),         // 左上
+          Vertex(Vector3{0, 0, 0.3f}, Vector2{u0, v1}),                  // 左下
+          Vertex(Vector3{charWidth, 0, 0.3f}, Vector2{u1, v1})           // 右下
+      },
+      FrameAllocator<Vertex>(frameArena_));
 
-  std::vector<Index> indices = {0, 1, 2, 0, 2, 3};
+  FrameVector<Index> indices({0, 1, 2, 0, 2, 3},
+                             FrameAllocator<Index>(frameArena_));
 
   // 色付きテクスチャを使用（カラー変調）
   // 注: 現在のシェーダーはテクスチャの色をそのまま使うため、
   // 色の変更には別途カラーテクスチャを使うか、シェーダーの拡張が必要
   // ここでは白色テクスチャをそのまま使用
-  Model charModel(vertices, indices, fontTexture_);
+  Model charModel(std::move(vertices), std::move(indices), fontTexture_);
 
   // モデル行列を設定（xとyの位置に配置）
   float modelMatrix[16] = {0};
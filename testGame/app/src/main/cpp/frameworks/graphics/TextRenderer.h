@@ -4,6 +4,7 @@
 #include "Model.h"
 #include "Shader.h"
 #include "TextureAsset.h"
+#include "../utils/FrameArena.h"
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -81,6 +82,13 @@ public:
                 float y, float scale, float cameraZoom, float r = 1.0f,
                 float g = 1.0f, float b = 1.0f);
 
+  /**
+   * @brief 文字ごとの頂点データを確保するフレームアリーナを設定する
+   *
+   * @param frameArena nullptr の場合は通常のヒープを使う
+   */
+  void setFrameArena(FrameArena *frameArena) { frameArena_ = frameArena; }
+
 private:
   /**
    * @brief 数値フォント用ビットマップテクスチャを生成する
@@ -123,6 +131,9 @@ private:
   // フォントテクスチャ
   std::shared_ptr<TextureAsset> fontTexture_;
 
+  // 文字のモデルの頂点データの確保先（所有しない）
+  FrameArena *frameArena_ = nullptr;
+
   // 文字サイズ情報（ピクセル単位でのフォント画像内のサイズ）
   static constexpr int kFontBitmapWidth = 11;  // 各文字の幅（ピクセル）
   static constexpr int kFontBitmapHeight = 11; // 各文字の高さ（ピクセル）
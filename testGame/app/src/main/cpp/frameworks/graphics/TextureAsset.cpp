@@ -151,6 +151,16 @@ TextureAsset::createFromPixels(int width, int height,
   return std::shared_ptr<TextureAsset>(new TextureAsset(textureId));
 }
 
+void TextureAsset::updateRows(int firstRow, int rowCount, int width,
+                              const uint8_t *rgbaRows) const {
+  if (rowCount <= 0 || width <= 0 || !rgbaRows) {
+    return;
+  }
+  glBindTexture(GL_TEXTURE_2D, textureID_);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, firstRow, width, rowCount, GL_RGBA,
+                  GL_UNSIGNED_BYTE, rgbaRows);
+}
+
 TextureAsset::~TextureAsset() {
   // return texture resources
   glDeleteTextures(1, &textureID_);
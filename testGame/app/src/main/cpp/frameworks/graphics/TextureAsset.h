@@ -33,6 +33,16 @@ public:
   static std::shared_ptr<TextureAsset>
   createFromPixels(int width, int height, const std::vector<uint8_t> &rgbaData);
 
+  /*!
+   * 連続する行だけを書き換える（glTexSubImage2D）
+   * @param firstRow 書き換える最初の行
+   * @param rowCount 行数
+   * @param width テクスチャの幅（ピクセル）
+   * @param rgbaRows firstRow 行目から始まる RGBA データ
+   */
+  void updateRows(int firstRow, int rowCount, int width,
+                  const uint8_t *rgbaRows) const;
+
   ~TextureAsset();
 
   /*!
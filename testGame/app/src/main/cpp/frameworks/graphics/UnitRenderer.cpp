@@ -18,6 +18,7 @@
  */
 #include "../domain/services/CollisionDomainService.h"
 #include "android/AndroidOut.h"
+#include <algorithm>
 #include <cmath>
 
 /**
@@ -42,6 +43,18 @@ UnitRenderer::~UnitRenderer() { aout << "UnitRenderer destroyed" << std::endl; }
  */
 void UnitRenderer::setShowAttackRanges(bool show) { showAttackRanges_ = show; }
 
+void UnitRenderer::setVisibilityFilter(
+    std::function<bool(const UnitEntity &)> filter) {
+  visibilityFilter_ = std::move(filter);
+}
+
+void UnitRenderer::setFrameArena(FrameArena *frameArena) {
+  frameArena_ = frameArena;
+  if (textRenderer_) {
+    textRenderer_->setFrameArena(frameArena);
+  }
+}
+
 /**
  * @brief ユニットをレンダラーに登録します。
  *
@@ -96,8 +109,14 @@ void UnitRenderer::clearAllUnits() {
 std::shared_ptr<TextureAsset> UnitRenderer::getColorTexture(float r, float g,
                                                             float b) {
   // RGB値をキーにして、すでに同じ色のテクスチャがキャッシュにあるか確認
-  std::string colorKey =
-      std::to_string(r) + "_" + std::to_string(g) + "_" + std::to_string(b);
+  // （以前の文字列キーと同じく小数点以下6桁で同じ色とみなす）
+  auto quantize = [](float component) {
+    const float scaled = std::round(component * 1e6f);
+    return static_cast<uint64_t>(
+        std::min(std::max(scaled, 0.0f), float((1 << 21) - 1)));
+  };
+  const uint64_t colorKey =
+      (quantize(r) << 42) | (quantize(g) << 21) | quantize(b);
 
   auto it = colorTextureCache_.find(colorKey);
   if (it != colorTextureCache_.end()) {
@@ -121,6 +140,9 @@ void UnitRenderer::render(const Shader *shader, float cameraZoom) {
   for (const auto &pair : units_) {
     const auto &unitId = pair.first;
     const auto &unit = pair.second;
+    if (!isShown(*unit)) {
+      continue;
+    }
 
     // このユニット用のテクスチャを取得
     std::shared_ptr<TextureAsset> unitTexture = nullptr;
@@ -173,21 +195,6 @@ void UnitRenderer::render(const Shader *shader, float cameraZoom) {
       }
     }
 
-    // 一時的にモデルのテクスチャを変更
-    Model unitModel = unitModel_; // モデルをコピー
-    if (unitTexture) {
-      // モデルクラスにはテクスチャを変更するAPIがないため、新しいモデルを作成
-      // サイズを1/4程度に小さくする
-      std::vector<Vertex> vertices = {
-          Vertex(Vector3{0.2f, 0.2f, 0}, Vector2{1, 0}),   // 右上
-          Vertex(Vector3{-0.2f, 0.2f, 0}, Vector2{0, 0}),  // 左上
-          Vertex(Vector3{-0.2f, -0.2f, 0}, Vector2{0, 1}), // 左下
-          Vertex(Vector3{0.2f, -0.2f, 0}, Vector2{1, 1})   // 右下
-      };
-      std::vector<Index> indices = {0, 1, 2, 0, 2, 3};
-      unitModel = Model(vertices, indices, unitTexture);
-    }
-
     // 描画前にユニットの位置に基づいてモデルマトリックスを設定
     float modelMatrix[16] = {0};
 
@@ -205,8 +212,14 @@ void UnitRenderer::render(const Shader *shader, float cameraZoom) {
     // モデルマトリックスをシェーダに送信
     shader->setModelMatrix(modelMatrix);
 
-    // ユニットを描画
-    shader->drawModel(unitModel);
+    // ユニットを描画。モデルクラスにはテクスチャを変更するAPIがないため、
+    // 色ごとに基本モデルの1/4程度の大きさのモデルをフレームアリーナに作る
+    if (unitTexture) {
+      shader->drawModel(
+          makeQuadModel(-0.2f, -0.2f, 0.2f, 0.2f, 0.0f, unitTexture));
+    } else {
+      shader->drawModel(unitModel_);
+    }
 
     // HP表示を描画（生きているユニットのみ）
     if (unit->isAlive()) {
@@ -237,7 +250,7 @@ void UnitRenderer::renderAttackRanges(const Shader *shader) {
 
   for (const auto &pair : units_) {
     const auto &unit = pair.second;
-    if (!unit)
+    if (!unit || !isShown(*unit))
       continue;
     if (!unit->isAlive())
       continue; // 死亡ユニットの攻撃範囲は表示しない
@@ -247,9 +260,9 @@ void UnitRenderer::renderAttackRanges(const Shader *shader) {
       continue;
 
     // 円頂点を生成
-    std::vector<Vertex> circleVertices;
+    FrameVector<Vertex> circleVertices{FrameAllocator<Vertex>(frameArena_)};
     circleVertices.reserve(segments);
-    std::vector<Index> circleIndices;
+    FrameVector<Index> circleIndices{FrameAllocator<Index>(frameArena_)};
     circleIndices.reserve(segments);
 
     for (int i = 0; i < segments; ++i) {
@@ -282,7 +295,8 @@ void UnitRenderer::renderAttackRanges(const Shader *shader) {
     float alphaMultiplier = 0.35f;
     auto rangeTexture = getColorTexture(
         lr * alphaMultiplier, lg * alphaMultiplier, lb * alphaMultiplier);
-    Model circleModel(circleVertices, circleIndices, rangeTexture);
+    Model circleModel(std::move(circleVertices), std::move(circleIndices),
+                      rangeTexture);
 
     // モデルマトリクスをユニット位置に設定（カメラオフセットを考慮）
     float modelMatrix[16] = {0};
@@ -321,15 +335,15 @@ void UnitRenderer::renderCollisionWireframes(const Shader *shader) {
 
   for (const auto &pair : units_) {
     const auto &unit = pair.second;
-    if (!unit)
+    if (!unit || !isShown(*unit))
       continue;
 
     float radius = unit->getStats().getCollisionRadius();
 
     // 円頂点を生成
-    std::vector<Vertex> circleVertices;
+    FrameVector<Vertex> circleVertices{FrameAllocator<Vertex>(frameArena_)};
     circleVertices.reserve(segments);
-    std::vector<Index> circleIndices;
+    FrameVector<Index> circleIndices{FrameAllocator<Index>(frameArena_)};
     circleIndices.reserve(segments);
 
     for (int i = 0; i < segments; ++i) {
@@ -361,7 +375,8 @@ void UnitRenderer::renderCollisionWireframes(const Shader *shader) {
     lg *= 0.75f;
     lb *= 0.75f;
     auto lineTexture = getColorTexture(lr, lg, lb);
-    Model circleModel(circleVertices, circleIndices, lineTexture);
+    Model circleModel(std::move(circleVertices), std::move(circleIndices),
+                      lineTexture);
 
     // モデルマトリクスをユニット位置に設定（カメラオフセットを考慮）
     float modelMatrix[16] = {0};
@@ -387,26 +402,8 @@ void UnitRenderer::renderCollisionWireframes(const Shader *shader) {
  * 行う設計です。ビジネスロジック（ダメージ計算等）は UseCase 層で扱うべきです。
  */
 void UnitRenderer::updateUnits(float deltaTime) {
-  // すべてのユニットのリストを作成
-  std::vector<std::shared_ptr<UnitEntity>> unitList;
-  unitList.reserve(units_.size());
-
-  for (const auto &pair : units_) {
-    unitList.push_back(pair.second);
-  }
-
-  // 衝突回避の強さ（0.0～1.0）
-  // めり込み防止のために衝突回避の強さを上げる
-  const float AVOIDANCE_STRENGTH = 0.5f;
-
-  // 各ユニットの衝突回避処理（このステップで敵と接触したユニットが攻撃を行う）
-  for (auto &pair : units_) {
-    auto &unit = pair.second;
-    // TODO: UnitEntityには avoidCollisions
-    // メソッドがないため一時的にコメントアウト
-    // 将来的にはCollisionUseCaseで実装予定
-    // unit->avoidCollisions(unitList, AVOIDANCE_STRENGTH);
-  }
+  // ユニット同士の重なりは CollisionUseCase::resolveOverlaps() が
+  // 移動の直後に解消する（ここでは位置を変更しない）
 
   // 攻撃可能なユニットは敵を攻撃（戦闘中のユニットを優先）
   for (auto &pair : units_) {
@@ -440,12 +437,6 @@ void UnitRenderer::updateUnits(float deltaTime) {
   }
 
   // ユニットの更新（移動や状態更新）
-  // 全ユニットのリストを作成
-  std::vector<std::shared_ptr<UnitEntity>> allUnits;
-  for (const auto &pair : units_) {
-    allUnits.push_back(pair.second);
-  }
-
   // 衝突予測機能付きでユニットを更新
   // 注意: 移動更新は MovementUseCase で地形倍率を考慮して行われるため、
   // ここでは unit->updateMovement(deltaTime) を呼ばない
@@ -480,20 +471,11 @@ void UnitRenderer::renderHPBar(const Shader *shader,
 
   // HPバーの背景（灰色）
   {
-    // バーの背景用のモデル
-    std::vector<Vertex> vertices = {
-        Vertex(Vector3{barWidth / 2, barY + barHeight, 0.1f},
-               Vector2{1, 0}), // 右上
-        Vertex(Vector3{-barWidth / 2, barY + barHeight, 0.1f},
-               Vector2{0, 0}),                                     // 左上
-        Vertex(Vector3{-barWidth / 2, barY, 0.1f}, Vector2{0, 1}), // 左下
-        Vertex(Vector3{barWidth / 2, barY, 0.1f}, Vector2{1, 1})   // 右下
-    };
-    std::vector<Index> indices = {0, 1, 2, 0, 2, 3};
-
-    // 灰色のテクスチャ
+    // バーの背景用のモデル（灰色のテクスチャ）
     auto grayTexture = getColorTexture(0.3f, 0.3f, 0.3f);
-    Model barBgModel(vertices, indices, grayTexture);
+    Model barBgModel =
+        makeQuadModel(-barWidth / 2, barY, barWidth / 2, barY + barHeight,
+                      0.1f, grayTexture);
 
     // 描画前にユニットの位置に基づいてモデルマトリックスを設定
     float modelMatrix[16] = {0};
@@ -529,17 +511,10 @@ void UnitRenderer::renderHPBar(const Shader *shader,
     float leftX = -barWidth / 2;
 
     // バーのモデル
-    std::vector<Vertex> vertices = {
-        Vertex(Vector3{leftX + currentWidth, barY + barHeight, 0.2f},
-               Vector2{1, 0}),                                         // 右上
-        Vertex(Vector3{leftX, barY + barHeight, 0.2f}, Vector2{0, 0}), // 左上
-        Vertex(Vector3{leftX, barY, 0.2f}, Vector2{0, 1}),             // 左下
-        Vertex(Vector3{leftX + currentWidth, barY, 0.2f}, Vector2{1, 1}) // 右下
-    };
-    std::vector<Index> indices = {0, 1, 2, 0, 2, 3};
-
     auto hpTexture = getColorTexture(r, g, b);
-    Model hpBarModel(vertices, indices, hpTexture);
+    Model hpBarModel =
+        makeQuadModel(leftX, barY, leftX + currentWidth, barY + barHeight,
+                      0.2f, hpTexture);
 
     // 描画前にユニットの位置に基づいてモデルマトリックスを設定
     float modelMatrix[16] = {0};
@@ -573,6 +548,20 @@ void UnitRenderer::renderHPBar(const Shader *shader,
   }
 }
 
+Model UnitRenderer::makeQuadModel(
+    float left, float bottom, float right, float top, float z,
+    std::shared_ptr<TextureAsset> texture) const {
+  FrameVector<Vertex> vertices{FrameAllocator<Vertex>(frameArena_)};
+  vertices.reserve(4);
+  vertices.emplace_back(Vector3{right, top, z}, Vector2{1, 0});    // 右上
+  vertices.emplace_back(Vector3{left, top, z}, Vector2{0, 0});     // 左上
+  vertices.emplace_back(Vector3{left, bottom, z}, Vector2{0, 1});  // 左下
+  vertices.emplace_back(Vector3{right, bottom, z}, Vector2{1, 1}); // 右下
+  FrameVector<Index> indices({0, 1, 2, 0, 2, 3},
+                             FrameAllocator<Index>(frameArena_));
+  return Model(std::move(vertices), std::move(indices), std::move(texture));
+}
+
 /**
  * @brief ユニット描画に使用する基本モデルを生成します。
  *
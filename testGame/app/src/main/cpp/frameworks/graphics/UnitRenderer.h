@@ -5,6 +5,7 @@
 #include "Shader.h"
 #include "TextRenderer.h"
 #include "entities/UnitEntity.h"
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -128,6 +129,22 @@ public:
    */
   void setShowAttackRanges(bool show);
 
+  /**
+   * @brief 描画するユニットを絞り込む条件を設定する（戦場の霧など）
+   *
+   * false を返したユニットは本体・HPバー・デバッグ表示のいずれも描画しない。
+   * 空の関数を渡すと全ユニットを描画する。
+   */
+  void setVisibilityFilter(std::function<bool(const UnitEntity &)> filter);
+
+  /**
+   * @brief 描画のたびに作るモデルの頂点を置くフレームアリーナを設定する
+   *
+   * HP数値のテキストレンダラーにも渡す。nullptr の場合は通常のヒープを
+   * 使う。アリーナは描画の後（フレームの終わり）に呼び出し側が reset する。
+   */
+  void setFrameArena(FrameArena *frameArena);
+
   /**
    * @brief 当たり判定ワイヤーフレームを描画する
    */
@@ -140,12 +157,21 @@ public:
   void renderAttackRanges(const Shader *shader);
 
 private:
+  // 絞り込み条件を満たし、描画対象となるユニットか
+  bool isShown(const UnitEntity &unit) const {
+    return !visibilityFilter_ || visibilityFilter_(unit);
+  }
+
   // ユニットのモデルデータを生成する
   Model createUnitModel();
 
   // 指定した色のテクスチャを取得する（キャッシュあり）
   std::shared_ptr<TextureAsset> getColorTexture(float r, float g, float b);
 
+  // ユニット基準の四角形のモデルを作る（頂点はフレームアリーナに置く）
+  Model makeQuadModel(float left, float bottom, float right, float top,
+                      float z, std::shared_ptr<TextureAsset> texture) const;
+
   // ユニットの表示に使用するデフォルトテクスチャ
   std::shared_ptr<TextureAsset> spTexture_;
 
@@ -157,8 +183,9 @@ private:
   // ユニットのテクスチャマップ (ユニットID -> テクスチャ)
   std::unordered_map<int, std::shared_ptr<TextureAsset>> unitTextures_;
 
-  // カラーテクスチャのキャッシュ (RGBキー -> テクスチャ)
-  std::unordered_map<std::string, std::shared_ptr<TextureAsset>>
+  // カラーテクスチャのキャッシュ (RGBキー -> テクスチャ)。キーは各成分を
+  // 1e-6 単位に丸めて 21 ビットずつ詰めたもの（文字列を作らない）
+  std::unordered_map<uint64_t, std::shared_ptr<TextureAsset>>
       colorTextureCache_;
 
   // ユニットのモデル
@@ -167,10 +194,15 @@ private:
   // テキストレンダラー（HP数値表示用）
   std::unique_ptr<TextRenderer> textRenderer_;
 
+  // 描画のたびに作るモデル用（nullptr ならヒープ）
+  FrameArena *frameArena_ = nullptr;
+
   // 当たり判定ワイヤーフレームの表示フラグ
   bool showCollisionWireframes_ = false;
   // 攻撃範囲表示フラグ
   bool showAttackRanges_ = false;
+  // 描画対象の絞り込み条件（空なら全ユニット）
+  std::function<bool(const UnitEntity &)> visibilityFilter_;
   // 初期位置を保存/復元する機能のフラグ (通常有効)
   bool trackInitialPositions_ = true;
   // Render attack range visualization (declaration is public above)
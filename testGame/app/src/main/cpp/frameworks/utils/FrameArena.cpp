@@ -0,0 +1,55 @@
+#include "FrameArena.h"
+
+/*
+ * FrameArena.cpp
+ *
+ * Overflow blocks are sized for the request that did not fit (at least the
+ * head block's size), so a frame that overruns pays one heap allocation
+ * per overflow block. reset() then replaces the head block with one large
+ * enough for the whole frame (doubling the old size until it fits) and
+ * frees the overflow blocks. Once a frame's usage is covered, reset()
+ * allocates nothing.
+ */
+#include <algorithm>
+#include <cstdint>
+
+FrameArena::FrameArena(size_t initialCapacity)
+    : buffer_(new unsigned char[initialCapacity]),
+      capacity_(initialCapacity) {}
+
+void *FrameArena::allocate(size_t bytes, size_t alignment) {
+  usedBytes_ += bytes;
+  const uintptr_t base = reinterpret_cast<uintptr_t>(buffer_.get());
+  const uintptr_t aligned =
+      (base + offset_ + alignment - 1) & ~(uintptr_t(alignment) - 1);
+  const size_t end = static_cast<size_t>(aligned - base) + bytes;
+  if (end <= capacity_) {
+    offset_ = end;
+    return reinterpret_cast<void *>(aligned);
+  }
+
+  // 先頭ブロックに収まらない分は追加ブロックで受ける
+  // （new[] は最大の基本アラインメントで返る）
+  const size_t blockSize = std::max(bytes + alignment, capacity_);
+  overflow_.emplace_back(new unsigned char[blockSize]);
+  ++heapAllocationCount_;
+  const uintptr_t block = reinterpret_cast<uintptr_t>(overflow_.back().get());
+  return reinterpret_cast<void *>((block + alignment - 1) &
+                                  ~(uintptr_t(alignment) - 1));
+}
+
+void FrameArena::reset() {
+  if (!overflow_.empty()) {
+    // アラインメントの詰め物の分だけ余裕を見て、倍々に広げる
+    size_t capacity = std::max<size_t>(capacity_, 64);
+    while (capacity < usedBytes_ + usedBytes_ / 8) {
+      capacity *= 2;
+    }
+    overflow_.clear();
+    buffer_.reset(new unsigned char[capacity]);
+    capacity_ = capacity;
+    ++heapAllocationCount_;
+  }
+  offset_ = 0;
+  usedBytes_ = 0;
+}
@@ -0,0 +1,115 @@
+#ifndef SIMULATION_GAME_FRAME_ARENA_H
+#define SIMULATION_GAME_FRAME_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief 1フレームの間だけ使う一時データ用のバンプアロケータ
+ *
+ * 設計方針：
+ * - 確保はポインタを進めるだけで、個別の解放はしない。フレームの終わりに
+ *   reset() で全体を一度に捨てる
+ * - 先頭ブロックに収まらない確保は追加ブロックで受け、reset() で
+ *   そのフレームの使用量が収まる大きさに先頭ブロックを確保し直す。
+ *   使用量が落ち着いた後のフレームでは malloc を呼ばない
+ * - STL コンテナからは FrameAllocator / FrameVector で使う
+ *
+ * 注意：
+ * - スレッドセーフではない。ゲームループのスレッドからのみ使うこと
+ * - reset() より後まで残るオブジェクトに確保した領域を持たせないこと
+ * - フレーム全体で malloc を呼ばないことは、シミュレーションのティック
+ *   だけを tests/FrameAllocationTest.h で確かめている（GL 描画側と、
+ *   数秒おきの予測・影響度マップの更新は対象外）
+ */
+class FrameArena {
+public:
+  static constexpr size_t kDefaultCapacity = 64 * 1024;
+
+  explicit FrameArena(size_t initialCapacity = kDefaultCapacity);
+  FrameArena(const FrameArena &) = delete;
+  FrameArena &operator=(const FrameArena &) = delete;
+
+  /**
+   * @brief bytes バイトを alignment 境界で確保する（失敗しない）
+   */
+  void *allocate(size_t bytes, size_t alignment);
+
+  /**
+   * @brief フレームの終わりに呼び、このフレームの確保をすべて無効にする
+   */
+  void reset();
+
+  size_t getCapacity() const { return capacity_; }
+  // 直前の reset 以降に確保したバイト数（追加ブロックの分を含む）
+  size_t getUsedBytes() const { return usedBytes_; }
+  // 先頭ブロックの確保し直しと追加ブロックの確保の累計回数
+  size_t getHeapAllocationCount() const { return heapAllocationCount_; }
+
+private:
+  std::unique_ptr<unsigned char[]> buffer_;
+  size_t capacity_ = 0;
+  size_t offset_ = 0;
+  size_t usedBytes_ = 0;
+  std::vector<std::unique_ptr<unsigned char[]>> overflow_;
+  size_t heapAllocationCount_ = 0;
+};
+
+/**
+ * @brief FrameArena から確保する STL 互換のアロケータ
+ *
+ * アリーナを持たない（既定構築した）アロケータは通常のヒープを使う。
+ * コンテナのコピーはヒープ側に作る（コピーがフレームを越えて残っても
+ * 安全なように）。ムーブではアリーナごと引き継ぐ。
+ */
+template <typename T> class FrameAllocator {
+public:
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  FrameAllocator() noexcept = default;
+  explicit FrameAllocator(FrameArena *arena) noexcept : arena_(arena) {}
+  template <typename U>
+  FrameAllocator(const FrameAllocator<U> &other) noexcept
+      : arena_(other.getArena()) {}
+
+  T *allocate(size_t count) {
+    if (!arena_) {
+      return static_cast<T *>(::operator new(count * sizeof(T)));
+    }
+    return static_cast<T *>(arena_->allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *pointer, size_t) noexcept {
+    if (!arena_) {
+      ::operator delete(pointer);
+    }
+  }
+
+  FrameAllocator select_on_container_copy_construction() const {
+    return FrameAllocator();
+  }
+
+  FrameArena *getArena() const noexcept { return arena_; }
+
+private:
+  FrameArena *arena_ = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(const FrameAllocator<T> &a, const FrameAllocator<U> &b) {
+  return a.getArena() == b.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const FrameAllocator<T> &a, const FrameAllocator<U> &b) {
+  return !(a == b);
+}
+
+template <typename T> using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#endif // SIMULATION_GAME_FRAME_ARENA_H
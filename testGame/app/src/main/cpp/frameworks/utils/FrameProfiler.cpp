@@ -0,0 +1,70 @@
+#include "FrameProfiler.h"
+
+/*
+ * FrameProfiler.cpp
+ *
+ * Sections are matched by string content, not by pointer, so identical
+ * literals from different translation units share one entry.
+ */
+#include "../android/AndroidOut.h"
+#include <algorithm>
+#include <cstring>
+
+void FrameProfiler::recordSample(const char *section, float microseconds) {
+  SectionStats &stats = statsFor(section);
+  ++stats.samples;
+  stats.totalMicroseconds += microseconds;
+  stats.maxMicroseconds = std::max(stats.maxMicroseconds, microseconds);
+}
+
+void FrameProfiler::recordBudgetOverrun(const char *section,
+                                        float budgetMicroseconds,
+                                        float usedMicroseconds) {
+  SectionStats &stats = statsFor(section);
+  ++stats.overruns;
+  stats.worstOverrunMicroseconds =
+      std::max(stats.worstOverrunMicroseconds,
+               usedMicroseconds - budgetMicroseconds);
+}
+
+const FrameProfiler::SectionStats *
+FrameProfiler::find(const char *section) const {
+  for (const SectionStats &stats : sections_) {
+    if (std::strcmp(stats.section, section) == 0) {
+      return &stats;
+    }
+  }
+  return nullptr;
+}
+
+void FrameProfiler::report() {
+  for (SectionStats &stats : sections_) {
+    if (stats.samples == 0 && stats.overruns == 0) {
+      continue;
+    }
+    const float average =
+        stats.samples > 0 ? stats.totalMicroseconds / stats.samples : 0.0f;
+    aout << "Profiler: " << stats.section << " avg=" << average
+         << "us max=" << stats.maxMicroseconds << "us samples=" << stats.samples
+         << " overruns=" << stats.overruns;
+    if (stats.overruns > 0) {
+      aout << " worstOverrun=+" << stats.worstOverrunMicroseconds << "us";
+    }
+    aout << std::endl;
+
+    const char *section = stats.section;
+    stats = SectionStats();
+    stats.section = section;
+  }
+}
+
+FrameProfiler::SectionStats &FrameProfiler::statsFor(const char *section) {
+  for (SectionStats &stats : sections_) {
+    if (std::strcmp(stats.section, section) == 0) {
+      return stats;
+    }
+  }
+  sections_.emplace_back();
+  sections_.back().section = section;
+  return sections_.back();
+}
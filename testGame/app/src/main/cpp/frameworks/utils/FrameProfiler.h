@@ -0,0 +1,53 @@
+#ifndef SIMULATION_GAME_FRAME_PROFILER_H
+#define SIMULATION_GAME_FRAME_PROFILER_H
+
+#include "../../usecases/interfaces/IProfiler.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 区間ごとの所要時間と予算超過を集計し、ログへ出力するプロファイラ
+ *
+ * 設計方針：
+ * - 区間は少数なので、区間名 -> 統計の対応は線形探索で十分
+ * - 集計は report() で aout に出力してリセットする（呼び出し側が数秒おきに
+ *   呼ぶ想定）。毎フレームのログ出力はしない
+ *
+ * 注意：
+ * - スレッドセーフではない。ゲームループのスレッドからのみ呼ぶこと
+ */
+class FrameProfiler : public IProfiler {
+public:
+  /**
+   * @brief 1区間分の集計
+   */
+  struct SectionStats {
+    const char *section = nullptr;
+    uint32_t samples = 0;
+    float totalMicroseconds = 0.0f;
+    float maxMicroseconds = 0.0f;
+    uint32_t overruns = 0;
+    float worstOverrunMicroseconds = 0.0f; // 予算を超えた分の最大値
+  };
+
+  void recordSample(const char *section, float microseconds) override;
+  void recordBudgetOverrun(const char *section, float budgetMicroseconds,
+                           float usedMicroseconds) override;
+
+  /**
+   * @brief 指定区間の集計（未記録なら nullptr）
+   */
+  const SectionStats *find(const char *section) const;
+
+  /**
+   * @brief 集計を aout に出力してリセットする
+   */
+  void report();
+
+private:
+  SectionStats &statsFor(const char *section);
+
+  std::vector<SectionStats> sections_;
+};
+
+#endif // SIMULATION_GAME_FRAME_PROFILER_H
@@ -0,0 +1,156 @@
+#include "ThreadPoolJobSystem.h"
+
+/*
+ * ThreadPoolJobSystem.cpp
+ *
+ * A parallelFor call publishes the job function and count under mutex_, wakes
+ * the workers and then takes jobs itself. Jobs are handed out one index at a
+ * time; the caller returns once finishedJobs_ reaches jobCount_. generation_
+ * lets sleeping workers tell a new batch from a spurious wake-up.
+ *
+ * Tasks from submit() sit in tasks_ and are picked up by idle workers. A
+ * worker drains the current parallelFor batch before starting a task. A
+ * parallelFor issued from inside a task does not take callMutex_ (that would
+ * stall the render thread's batches); its jobs are pushed onto tasks_ so idle
+ * workers spread them across cores, and the issuing worker keeps running
+ * queued work until its own jobs are done.
+ * Tasks still queued at destruction are dropped; running ones are joined.
+ */
+namespace {
+thread_local bool tIsPoolWorker = false;
+} // namespace
+
+ThreadPoolJobSystem::ThreadPoolJobSystem(size_t workerCount) {
+  if (workerCount == 0) {
+    const unsigned hardware = std::thread::hardware_concurrency();
+    workerCount = hardware > 1 ? hardware - 1 : 1;
+  }
+  workers_.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; ++i) {
+    workers_.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+ThreadPoolJobSystem::~ThreadPoolJobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  workAvailable_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPoolJobSystem::parallelFor(size_t jobCount,
+                                      const std::function<void(size_t)> &job) {
+  if (jobCount == 0) {
+    return;
+  }
+  if (tIsPoolWorker) {
+    runNestedParallelFor(jobCount, job);
+    return;
+  }
+  std::lock_guard<std::mutex> callLock(callMutex_);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  job_ = &job;
+  jobCount_ = jobCount;
+  nextJob_ = 0;
+  finishedJobs_ = 0;
+  ++generation_;
+  workAvailable_.notify_all();
+
+  // 呼び出しスレッドもジョブを処理する
+  while (runNextJob(lock)) {
+  }
+  workFinished_.wait(lock, [this]() { return finishedJobs_ == jobCount_; });
+  job_ = nullptr;
+}
+
+bool ThreadPoolJobSystem::runNextJob(std::unique_lock<std::mutex> &lock) {
+  if (!job_ || nextJob_ >= jobCount_) {
+    return false;
+  }
+  const size_t index = nextJob_++;
+  const auto *job = job_;
+
+  lock.unlock();
+  (*job)(index);
+  lock.lock();
+
+  if (++finishedJobs_ == jobCount_) {
+    workFinished_.notify_all();
+  }
+  return true;
+}
+
+void ThreadPoolJobSystem::runNestedParallelFor(
+    size_t jobCount, const std::function<void(size_t)> &job) {
+  // ジョブをタスクとして積み、空いているワーカーに分担させる
+  size_t remaining = jobCount;
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < jobCount; ++i) {
+    tasks_.push_back([this, &job, &remaining, i]() {
+      job(i);
+      std::lock_guard<std::mutex> done(mutex_);
+      if (--remaining == 0) {
+        workFinished_.notify_all();
+      }
+    });
+  }
+  workAvailable_.notify_all();
+
+  // 自分のジョブが終わるまで、待たずに済む仕事は自分でも処理する
+  while (remaining > 0) {
+    if (runNextJob(lock) || runNextTask(lock)) {
+      continue;
+    }
+    workFinished_.wait(lock, [&]() {
+      return remaining == 0 || !tasks_.empty() ||
+             (job_ && nextJob_ < jobCount_);
+    });
+  }
+}
+
+void ThreadPoolJobSystem::submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  workAvailable_.notify_one();
+}
+
+bool ThreadPoolJobSystem::runNextTask(std::unique_lock<std::mutex> &lock) {
+  if (tasks_.empty()) {
+    return false;
+  }
+  std::function<void()> task = std::move(tasks_.front());
+  tasks_.pop_front();
+
+  lock.unlock();
+  task();
+  lock.lock();
+  return true;
+}
+
+void ThreadPoolJobSystem::workerLoop() {
+  tIsPoolWorker = true;
+  uint64_t seenGeneration = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    workAvailable_.wait(lock, [&]() {
+      return stopping_ || generation_ != seenGeneration || !tasks_.empty();
+    });
+    if (stopping_) {
+      return;
+    }
+    if (generation_ != seenGeneration) {
+      seenGeneration = generation_;
+      while (runNextJob(lock)) {
+      }
+      continue;
+    }
+    runNextTask(lock);
+  }
+}
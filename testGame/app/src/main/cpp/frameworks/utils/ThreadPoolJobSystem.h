@@ -0,0 +1,71 @@
+#ifndef SIMULATION_GAME_THREAD_POOL_JOB_SYSTEM_H
+#define SIMULATION_GAME_THREAD_POOL_JOB_SYSTEM_H
+
+#include "../../usecases/interfaces/IJobSystem.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief std::thread による固定サイズのスレッドプール
+ *
+ * 設計方針：
+ * - ワーカーは起動時に生成し、破棄まで使い回す（ジョブごとのスレッド生成なし）
+ * - parallelFor の呼び出しスレッドもジョブを実行するため、ワーカー数は
+ *   「コア数 - 1」で全コアを使える
+ * - ジョブは粗い粒度（1ジョブ = 数十〜数百マイクロ秒以上）を想定し、
+ *   配布は単純なミューテックス + 条件変数で行う
+ * - submit したタスクはワーカーが1つずつ取り出して実行する。ワーカーは
+ *   parallelFor のジョブを優先する
+ * - タスク内の parallelFor は描画スレッドの parallelFor を待たせないよう、
+ *   ジョブをタスクとして積み直して他のワーカーと分担する
+ */
+class ThreadPoolJobSystem : public IJobSystem {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param workerCount ワーカースレッド数（0 の場合はコア数 - 1）
+   */
+  explicit ThreadPoolJobSystem(size_t workerCount = 0);
+  ~ThreadPoolJobSystem() override;
+
+  ThreadPoolJobSystem(const ThreadPoolJobSystem &) = delete;
+  ThreadPoolJobSystem &operator=(const ThreadPoolJobSystem &) = delete;
+
+  size_t getConcurrency() const override { return workers_.size() + 1; }
+
+  void parallelFor(size_t jobCount,
+                   const std::function<void(size_t)> &job) override;
+
+  void submit(std::function<void()> task) override;
+
+private:
+  void workerLoop();
+  // 未着手のジョブを1つ実行する。実行するものが無ければ false
+  bool runNextJob(std::unique_lock<std::mutex> &lock);
+  // 待っているタスクを1つ実行する。無ければ false
+  bool runNextTask(std::unique_lock<std::mutex> &lock);
+  // ワーカー上（タスク内）から呼ばれた parallelFor
+  void runNestedParallelFor(size_t jobCount,
+                            const std::function<void(size_t)> &job);
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable workAvailable_;
+  std::condition_variable workFinished_;
+  std::mutex callMutex_; // parallelFor の同時呼び出しを直列化
+
+  const std::function<void(size_t)> *job_ = nullptr;
+  size_t jobCount_ = 0;
+  size_t nextJob_ = 0;
+  size_t finishedJobs_ = 0;
+  uint64_t generation_ = 0;
+  std::deque<std::function<void()>> tasks_;
+  bool stopping_ = false;
+};
+
+#endif // SIMULATION_GAME_THREAD_POOL_JOB_SYSTEM_H
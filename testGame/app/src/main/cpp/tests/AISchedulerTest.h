@@ -0,0 +1,129 @@
+#ifndef SIMULATION_GAME_AI_SCHEDULER_TEST_H
+#define SIMULATION_GAME_AI_SCHEDULER_TEST_H
+
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/UtilityAI.h"
+#include "../usecases/AISchedulerUseCase.h"
+#include "../usecases/CombatUseCase.h"
+#include "../usecases/MovementUseCase.h"
+#include "../usecases/interfaces/IProfiler.h"
+#include "TestFixtures.h"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief UtilityAI と AI スケジューラのテスト
+ */
+class AISchedulerTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running AIScheduler tests..." << std::endl;
+    testUtilityDecisions();
+    testBudgetSpreadsThinkingRoundRobin();
+    testAdvanceIssuesMoveOrder();
+    std::cout << "AIScheduler tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  // 呼び出し回数だけを数えるプロファイラ
+  class CountingProfiler : public IProfiler {
+  public:
+    int samples = 0;
+    int overruns = 0;
+    void recordSample(const char *, float) override { ++samples; }
+    void recordBudgetOverrun(const char *, float, float) override {
+      ++overruns;
+    }
+  };
+
+  static void testUtilityDecisions() {
+    // 無傷で敵を発見 -> 前進
+    AIContext healthy;
+    healthy.enemyKnown = true;
+    assert(UtilityAI::decide(healthy).action == AIAction::ADVANCE);
+
+    // 交戦中で優勢 -> その場で戦い、弱った敵を狙う
+    AIContext winning;
+    winning.engaged = true;
+    winning.ownInfluence = 3.0f;
+    winning.enemyInfluence = 1.0f;
+    AIDecision decision = UtilityAI::decide(winning);
+    assert(decision.action == AIAction::ENGAGE);
+    assert(decision.targetPolicy == TargetSelectionPolicy::LOWEST_HP);
+
+    // 瀕死で劣勢 -> 後退し、最も危険な敵を狙う
+    AIContext losing;
+    losing.engaged = true;
+    losing.hpRatio = 0.1f;
+    losing.ownInfluence = 0.1f;
+    losing.enemyInfluence = 3.0f;
+    decision = UtilityAI::decide(losing);
+    assert(decision.action == AIAction::RETREAT);
+    assert(decision.targetPolicy == TargetSelectionPolicy::HIGHEST_THREAT);
+
+    // 敵がいなければ待機
+    assert(UtilityAI::decide(AIContext()).action == AIAction::HOLD);
+    std::cout << "✓ Utility decisions test passed" << std::endl;
+  }
+
+  static void testBudgetSpreadsThinkingRoundRobin() {
+    UnitList units;
+    const int agentCount = 10;
+    for (int i = 0; i < agentCount; ++i) {
+      units.push_back(makeUnit(i + 1, static_cast<float>(i), 0.0f, 2));
+    }
+    CombatUseCase combat(units);
+    CountingProfiler profiler;
+
+    AISchedulerConfig config;
+    config.budgetMicroseconds = 0.0f; // 1 回の update で 1 体だけ思考する
+    AISchedulerUseCase scheduler(units, nullptr, &combat, config);
+    scheduler.setProfiler(&profiler);
+
+    scheduler.update(0.0f);
+    assert(scheduler.getAgentCount() == static_cast<size_t>(agentCount));
+    assert(scheduler.getLastThinkCount() == 1);
+
+    // 全員の思考時刻が過ぎた後は、1 体ずつ順番に思考する
+    for (int i = 0; i < agentCount; ++i) {
+      scheduler.update(10.0f);
+      assert(scheduler.getLastThinkCount() == 1);
+    }
+    for (const auto &unit : units) {
+      assert(combat.getTargetPolicyFor(unit->getId()) !=
+             TargetSelectionPolicy::FIRST_IN_RANGE);
+    }
+    assert(profiler.samples == agentCount + 1);
+    assert(profiler.overruns > 0);
+
+    // 全員が思考した直後は、次の思考時刻まで誰も思考しない
+    scheduler.update(10.0f);
+    assert(scheduler.getLastThinkCount() == 0);
+    assert(!scheduler.wasLastUpdateCut());
+    std::cout << "✓ Budget round-robin test passed" << std::endl;
+  }
+
+  static void testAdvanceIssuesMoveOrder() {
+    UnitList units;
+    auto ai = makeUnit(1, 0.0f, 0.0f, 2);
+    units.push_back(ai);
+    units.push_back(makeUnit(2, 10.0f, 0.0f, 1));
+    MovementUseCase movement(units);
+    CombatUseCase combat(units);
+    AISchedulerUseCase scheduler(units, &movement, &combat);
+
+    scheduler.update(0.0f);
+    assert(scheduler.getLastThinkCount() == 1);
+    assert(ai->getTargetPosition().distanceTo(Position(10.0f, 0.0f)) < 1.0f);
+
+    // 陣営 2 以外は管理しない
+    assert(scheduler.getAgentCount() == 1);
+    std::cout << "✓ Advance move order test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_AI_SCHEDULER_TEST_H
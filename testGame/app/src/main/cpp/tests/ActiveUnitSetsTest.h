@@ -0,0 +1,204 @@
+#ifndef SIMULATION_GAME_ACTIVE_UNIT_SETS_TEST_H
+#define SIMULATION_GAME_ACTIVE_UNIT_SETS_TEST_H
+
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/ActiveUnitSets.h"
+#include "../domain/services/CombatBroadphase.h"
+#include "../usecases/CollisionUseCase.h"
+#include "../usecases/MovementUseCase.h"
+#include "TestFixtures.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief アクティブ集合（ActiveUnitSets）と、それを使う移動処理のテスト
+ */
+class ActiveUnitSetsTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running ActiveUnitSets tests..." << std::endl;
+    testTransitionsUpdateSets();
+    testSleepAndWake();
+    testMovementVisitsActiveUnitsOnly();
+    testPairsSkipSleepingAttackers();
+    testOverlapsResolvedAroundAwakeUnits();
+    std::cout << "ActiveUnitSets tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  static bool contains(const std::vector<uint32_t> &set, uint32_t index) {
+    return std::find(set.begin(), set.end(), index) != set.end();
+  }
+
+  static void testTransitionsUpdateSets() {
+    UnitList units = {makeUnit(1, 0.0f, 0.0f, 1), makeUnit(2, 5.0f, 0.0f, 2)};
+    ActiveUnitSets sets;
+    sets.track(units);
+    assert(sets.getMoving().empty() && sets.getInCombat().empty());
+
+    units[0]->setTargetPosition(Position(3.0f, 0.0f));
+    assert(contains(sets.getMoving(), 0));
+    units[0]->enterCombat();
+    assert(!contains(sets.getMoving(), 0));
+    assert(contains(sets.getInCombat(), 0));
+    units[0]->exitCombat(); // 目標が残っているので移動に戻る
+    assert(contains(sets.getMoving(), 0));
+
+    units[0]->takeDamage(1000);
+    assert(sets.getMoving().empty() && sets.getInCombat().empty());
+    assert(!sets.isAwake(0));
+
+    // コピーしたユニットの遷移は元の集合に影響しない
+    UnitEntity copy = *units[1];
+    copy.setTargetPosition(Position(6.0f, 0.0f));
+    assert(sets.getMoving().empty());
+    std::cout << "✓ Transition bookkeeping test passed" << std::endl;
+  }
+
+  static void testSleepAndWake() {
+    UnitList units = {makeUnit(1, 0.0f, 0.0f, 1), makeUnit(2, 30.0f, 0.0f, 2)};
+    ActiveUnitSets sets(4.0f);
+    sets.track(units);
+    CombatBroadphase broadphase;
+    broadphase.rebuild(units);
+    sets.updateSleep(broadphase.getFactionIndex());
+    assert(!sets.isAwake(0) && !sets.isAwake(1));
+
+    // 被ダメージで起きる
+    units[0]->takeDamage(1);
+    assert(sets.isAwake(0));
+
+    // 敵が近づいてくると、眠っているユニットも起きる
+    units[1]->setTargetPosition(Position(2.0f, 0.0f));
+    units[1]->updatePosition(Position(3.0f, 0.0f));
+    sets.updateSleep(broadphase.getFactionIndex()); // 構築時の位置では遠い
+    broadphase.rebuild(units);
+    sets.updateSleep(broadphase.getFactionIndex());
+    assert(sets.isAwake(0) && sets.isAwake(1));
+    std::cout << "✓ Sleep and wake test passed" << std::endl;
+  }
+
+  static void testMovementVisitsActiveUnitsOnly() {
+    // 止まっている味方の列の横を1体だけが通り抜ける
+    UnitList units;
+    for (int i = 0; i < 20; ++i) {
+      units.push_back(makeUnit(i + 1, 0.5f * static_cast<float>(i), 2.0f, 1));
+    }
+    units.push_back(makeUnit(100, 0.0f, 1.7f, 1));
+    ActiveUnitSets sets;
+    sets.track(units);
+    CombatBroadphase broadphase;
+    MovementUseCase movement(units);
+    movement.setCombatBroadphase(&broadphase);
+    movement.setActiveUnitSets(&sets);
+
+    assert(movement.moveUnitTo(100, Position(9.0f, 1.7f)));
+    assert(movement.getMovingUnitsCount() == 1);
+    for (int frame = 0; frame < 400 && movement.getMovingUnitsCount() > 0;
+         ++frame) {
+      broadphase.rebuild(units);
+      movement.updateMovements(0.05f);
+      // 止まっている列とは重ならない（回避の近傍に入っている）
+      for (size_t i = 0; i + 1 < units.size(); ++i) {
+        assert(units.back()->getPosition().distanceTo(
+                   units[i]->getPosition()) > 0.15f);
+      }
+    }
+    assert(movement.getMovingUnitsCount() == 0);
+    assert(units.back()->getPosition().getX() > 8.5f);
+    std::cout << "✓ Active-only movement test passed" << std::endl;
+  }
+
+  // Renderer と同じ順序でブロードフェーズと眠りを更新する
+  static void beginTick(UnitList &units, ActiveUnitSets &sets,
+                        CombatBroadphase &broadphase) {
+    broadphase.rebuildIndex(units);
+    sets.updateSleep(broadphase.getFactionIndex());
+    broadphase.buildPairs(&sets);
+  }
+
+  static void testPairsSkipSleepingAttackers() {
+    // 離れた2か所の野営地（待機中の陣営1）と、片方の端にいる敵
+    UnitList units;
+    for (int i = 0; i < 40; ++i) {
+      const float x = static_cast<float>(i % 10) + (i < 20 ? 0.0f : 60.0f);
+      units.push_back(makeUnit(i + 1, x, static_cast<float>(i % 20 / 10), 1));
+    }
+    units.push_back(makeUnit(100, 12.0f, 0.0f, 2));
+    ActiveUnitSets sets;
+    sets.track(units);
+    CombatBroadphase broadphase;
+    beginTick(units, sets, broadphase);
+    // 敵の周り（wakeRadius = 6）の7体と敵だけが起きている
+    assert(sets.getAwake().size() == 8);
+    assert(broadphase.getScannedAttackerCount() == sets.getAwake().size());
+
+    // 敵が野営地に入っても、ペアは全員を探した場合と一致する
+    CombatBroadphase full;
+    for (int step = 0; step < 6; ++step) {
+      units.back()->setTargetPosition(Position(0.0f, 0.0f));
+      units.back()->updatePosition(
+          units.back()->getPosition().moveBy(-1.0f, 0.0f));
+      beginTick(units, sets, broadphase);
+      full.rebuild(units);
+      assert(broadphase.getPairs().size() == full.getPairs().size());
+      for (size_t p = 0; p < full.getPairs().size(); ++p) {
+        assert(broadphase.getPairs()[p].attackerIndex ==
+               full.getPairs()[p].attackerIndex);
+        assert(broadphase.getPairs()[p].targetIndex ==
+               full.getPairs()[p].targetIndex);
+      }
+      assert(broadphase.getEngagedAttackers() == full.getEngagedAttackers());
+      assert(broadphase.getScannedAttackerCount() < units.size());
+    }
+    assert(!broadphase.getPairs().empty());
+    std::cout << "✓ Sleeping attacker skip test passed" << std::endl;
+  }
+
+  static void testOverlapsResolvedAroundAwakeUnits() {
+    // 待機中の列（触れ合わない間隔）の端に、移動中の2体が食い込んでいる
+    UnitList units;
+    for (int i = 0; i < 30; ++i) {
+      units.push_back(makeUnit(i + 1, 0.21f * static_cast<float>(i), 0.0f));
+    }
+    units.push_back(makeUnit(100, -0.1f, 0.0f));
+    units.push_back(makeUnit(101, -0.12f, 0.05f));
+    ActiveUnitSets sets;
+    sets.track(units);
+    CombatBroadphase broadphase;
+    beginTick(units, sets, broadphase);
+    units[30]->setTargetPosition(Position(-5.0f, 0.0f));
+    units[31]->setTargetPosition(Position(-5.0f, 1.0f));
+    beginTick(units, sets, broadphase);
+    assert(sets.getAwake().size() == 2);
+
+    CollisionUseCase collision(units);
+    collision.setActiveUnitSets(&sets, &broadphase);
+    collision.resolveOverlaps();
+    // 起きている2体と、それに触れうる列の先頭だけを解く
+    assert(collision.getLastSolvedUnitCount() < 6);
+    assert(units[0]->getPosition().getX() > 0.0f);
+
+    // 押し出された先頭は次の列と重なる。押し出した眠っているユニットは
+    // 次回も解くので、列の奥へ順に伝わって重なりが残らない
+    for (int tick = 0; tick < 60; ++tick) {
+      beginTick(units, sets, broadphase);
+      collision.resolveOverlaps();
+    }
+    for (size_t i = 0; i + 1 < 30; ++i) {
+      assert(units[i + 1]->getPosition().distanceTo(units[i]->getPosition()) >
+             0.2f - 0.01f);
+    }
+    for (size_t i = 0; i < 30; ++i) {
+      assert(!sets.isAwake(i)); // 押されても眠ったまま
+    }
+    std::cout << "✓ Awake-only overlap resolution test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_ACTIVE_UNIT_SETS_TEST_H
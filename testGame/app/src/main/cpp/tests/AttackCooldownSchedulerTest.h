@@ -0,0 +1,170 @@
+#ifndef SIMULATION_GAME_ATTACK_COOLDOWN_SCHEDULER_TEST_H
+#define SIMULATION_GAME_ATTACK_COOLDOWN_SCHEDULER_TEST_H
+
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/AttackCooldownScheduler.h"
+#include "../domain/services/CombatBroadphase.h"
+#include "../usecases/CombatUseCase.h"
+#include "TestFixtures.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 攻撃クールダウンのスケジューラと、それを使う自動戦闘のテスト
+ */
+class AttackCooldownSchedulerTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running AttackCooldownScheduler tests..." << std::endl;
+    testExpiresInReadyOrder();
+    testRescheduleReplacesOldEntry();
+    testCancelAndCompaction();
+    testScheduledCombatMatchesPerFrame();
+    testDeadUnitsLeaveScheduler();
+    std::cout << "AttackCooldownScheduler tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+  using AttackLog = std::vector<std::pair<int, int>>;
+
+  static std::vector<int> popAll(AttackCooldownScheduler &scheduler,
+                                 float now) {
+    std::vector<int> expired;
+    scheduler.popExpired(now, [&](int unitId) { expired.push_back(unitId); });
+    return expired;
+  }
+
+  static void testExpiresInReadyOrder() {
+    AttackCooldownScheduler scheduler;
+    scheduler.schedule(3, 3.0f);
+    scheduler.schedule(1, 1.0f);
+    scheduler.schedule(2, 2.0f);
+    assert(scheduler.isCoolingDown(1, 0.5f));
+    assert(!scheduler.isCoolingDown(1, 1.0f));
+
+    // 明けた順（readyTime の小さい順）に取り出し、残りは登録のまま
+    assert(popAll(scheduler, 2.5f) == std::vector<int>({1, 2}));
+    assert(scheduler.scheduledCount() == 1);
+    assert(scheduler.isCoolingDown(3, 2.5f));
+    assert(popAll(scheduler, 2.9f).empty());
+    assert(popAll(scheduler, 3.0f) == std::vector<int>({3}));
+    assert(scheduler.scheduledCount() == 0);
+    std::cout << "✓ Ready ordering test passed" << std::endl;
+  }
+
+  static void testRescheduleReplacesOldEntry() {
+    AttackCooldownScheduler scheduler;
+    scheduler.schedule(1, 1.0f);
+    // 攻撃し直した（再登録）ユニットは古い時刻では明けない
+    scheduler.schedule(1, 2.0f);
+    assert(scheduler.scheduledCount() == 1);
+    assert(popAll(scheduler, 1.5f).empty());
+    assert(scheduler.isCoolingDown(1, 1.5f));
+    // 新しい時刻で1回だけ明ける
+    assert(popAll(scheduler, 2.0f) == std::vector<int>({1}));
+    assert(popAll(scheduler, 10.0f).empty());
+    std::cout << "✓ Reschedule test passed" << std::endl;
+  }
+
+  static void testCancelAndCompaction() {
+    AttackCooldownScheduler scheduler;
+    scheduler.schedule(1, 1.0f);
+    scheduler.schedule(2, 1.0f);
+    scheduler.cancel(1);
+    assert(!scheduler.isCoolingDown(1, 0.0f));
+    assert(popAll(scheduler, 1.0f) == std::vector<int>({2}));
+
+    // 再登録を繰り返して古い要素を溜め、作り直し後も結果が変わらないこと
+    for (int round = 0; round < 100; ++round) {
+      for (int id = 0; id < 4; ++id) {
+        scheduler.schedule(id, 5.0f + static_cast<float>(round + id) * 0.01f);
+      }
+    }
+    assert(scheduler.scheduledCount() == 4);
+    std::vector<int> expired = popAll(scheduler, 100.0f);
+    assert(expired == std::vector<int>({0, 1, 2, 3}));
+    std::cout << "✓ Cancel and compaction test passed" << std::endl;
+  }
+
+  static UnitList makeSkirmish() {
+    // 2列で向かい合う。各ユニットの最寄りの敵は一意に決まる
+    UnitList units;
+    for (int i = 0; i < 6; ++i) {
+      const float y = static_cast<float>(i) * 1.7f;
+      UnitStats stats(1000, 1000, 5, 5, 1.0f, 1.0f, 1.0f, 0.1f);
+      units.push_back(makeUnit(i + 1, 0.0f, y, stats, 1));
+      units.push_back(makeUnit(i + 101, 0.6f + 0.05f * i, y, stats, 2));
+    }
+    return units;
+  }
+
+  static AttackLog runTick(CombatUseCase &combat, AttackLog &log, float now) {
+    log.clear();
+    combat.executeAutoCombat(now);
+    std::sort(log.begin(), log.end());
+    return log;
+  }
+
+  static void testScheduledCombatMatchesPerFrame() {
+    UnitList scheduledUnits = makeSkirmish();
+    UnitList perFrameUnits = makeSkirmish();
+    CombatBroadphase broadphase;
+    CombatUseCase scheduled(scheduledUnits);
+    scheduled.setCombatBroadphase(&broadphase);
+    CombatUseCase perFrame(perFrameUnits);
+    AttackLog scheduledLog;
+    AttackLog perFrameLog;
+    for (auto *combat : {&scheduled, &perFrame}) {
+      AttackLog &log = combat == &scheduled ? scheduledLog : perFrameLog;
+      combat->setTargetSelectionPolicy(TargetSelectionPolicy::NEAREST);
+      combat->setCombatEventCallback(
+          [&log](const UnitEntity &attacker, const UnitEntity &target,
+                 const CombatDomainService::CombatResult &) {
+            log.emplace_back(attacker.getId(), target.getId());
+          });
+    }
+
+    // 攻撃間隔は1秒。0.25秒刻みで進め、攻撃の組と時刻が両経路で一致し、
+    // 攻撃したユニットはクールダウンが明けた時刻に再び攻撃すること
+    size_t attacks = 0;
+    for (int tick = 0; tick <= 8; ++tick) {
+      const float now = 0.25f * static_cast<float>(tick);
+      broadphase.rebuild(scheduledUnits);
+      const AttackLog fromScheduler = runTick(scheduled, scheduledLog, now);
+      const AttackLog fromScan = runTick(perFrame, perFrameLog, now);
+      assert(fromScheduler == fromScan);
+      assert(fromScheduler.size() == (tick % 4 == 0 ? 12u : 0u));
+      attacks += fromScheduler.size();
+      if (tick % 4 != 0) {
+        assert(scheduled.getCoolingDownCount() == 12);
+      }
+    }
+    assert(attacks == 36);
+    std::cout << "✓ Scheduled combat matches per-frame test passed"
+              << std::endl;
+  }
+
+  static void testDeadUnitsLeaveScheduler() {
+    UnitList units = makeSkirmish();
+    CombatBroadphase broadphase;
+    CombatUseCase combat(units);
+    combat.setCombatBroadphase(&broadphase);
+    broadphase.rebuild(units);
+    combat.executeAutoCombat(0.0f);
+    assert(combat.getCoolingDownCount() == units.size());
+
+    // 倒れたユニットは除去と同時にクールダウン登録からも外れる
+    units[0]->takeDamage(100000);
+    units[1]->takeDamage(100000);
+    assert(combat.removeDeadUnits() == 2);
+    assert(combat.getCoolingDownCount() == units.size());
+    std::cout << "✓ Dead unit removal test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_ATTACK_COOLDOWN_SCHEDULER_TEST_H
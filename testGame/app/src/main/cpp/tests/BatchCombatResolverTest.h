@@ -0,0 +1,119 @@
+#ifndef SIMULATION_GAME_BATCH_COMBAT_RESOLVER_TEST_H
+#define SIMULATION_GAME_BATCH_COMBAT_RESOLVER_TEST_H
+
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/BatchCombatResolver.h"
+#include "TestFixtures.h"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief BatchCombatResolver のユニットテスト
+ *
+ * 同時攻撃の決定性・反撃・撃破イベントの記録を検証する。
+ */
+class BatchCombatResolverTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running BatchCombatResolver tests..." << std::endl;
+    testDeterministicForSameSeed();
+    testSimultaneousHitsAndKillAttribution();
+    testCounterAttackOnlyWhenTargetSurvives();
+    std::cout << "BatchCombatResolver tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  static std::shared_ptr<UnitEntity> makeFighter(int id, float x, int faction,
+                                                 int hp, int attack) {
+    UnitStats stats(hp, hp, attack, attack + 5, 1.0f, 1.0f, 1.0f, 0.1f);
+    return makeUnit(id, x, 0.0f, stats, faction);
+  }
+
+  static UnitList makeSkirmish() {
+    UnitList units;
+    units.push_back(makeFighter(1, 0.0f, 1, 100, 10));
+    units.push_back(makeFighter(2, 0.5f, 2, 100, 10));
+    units.push_back(makeFighter(3, 1.0f, 1, 100, 10));
+    units.push_back(makeFighter(4, 1.5f, 2, 100, 10));
+    return units;
+  }
+
+  static void testDeterministicForSameSeed() {
+    std::vector<AttackRequest> attacks = {{0, 1}, {1, 2}, {2, 3}, {3, 2}};
+    UnitList first = makeSkirmish();
+    UnitList second = makeSkirmish();
+    BatchCombatResolver resolverA(42);
+    BatchCombatResolver resolverB(42);
+    for (int tick = 0; tick < 5; ++tick) {
+      resolverA.resolve(first, attacks);
+      resolverB.resolve(second, attacks);
+      assert(resolverA.getDamageDealt() == resolverB.getDamageDealt());
+      assert(resolverA.getCounterDamage() == resolverB.getCounterDamage());
+    }
+    for (size_t i = 0; i < first.size(); ++i) {
+      assert(first[i]->getStats().getCurrentHp() ==
+             second[i]->getStats().getCurrentHp());
+    }
+    // ダメージは calculateDamage と同じ範囲に収まる
+    for (int damage : resolverA.getDamageDealt()) {
+      assert(damage >= 8 && damage <= 18);
+    }
+  }
+
+  static void testSimultaneousHitsAndKillAttribution() {
+    UnitList units;
+    units.push_back(makeFighter(1, 0.0f, 1, 100, 40)); // 1発 32〜54
+    units.push_back(makeFighter(2, 0.3f, 1, 100, 40));
+    units.push_back(makeFighter(3, 0.6f, 2, 60, 10)); // 2発で倒れる
+    units.push_back(makeFighter(4, 5.0f, 2, 100, 10)); // 射程外（反撃不可）
+
+    // 対象 2 は 1発目では倒れず、2発目で倒れる。倒れた対象も同ティックの
+    // 攻撃は行える（同時命中）
+    std::vector<AttackRequest> attacks = {{0, 2}, {1, 2}, {2, 0}};
+    BatchCombatResolver resolver(7);
+    resolver.resolve(units, attacks);
+
+    assert(!units[2]->isAlive());
+    assert(units[2]->getState() == UnitState::DEAD);
+    int killsOfTarget = 0;
+    for (const auto &kill : resolver.getKills()) {
+      if (kill.victimIndex == 2) {
+        ++killsOfTarget;
+        assert(!kill.byCounter);
+        assert(kill.attackIndex == 1); // 累積が HP に達した2発目
+        assert(kill.killerIndex == 1);
+      }
+    }
+    assert(killsOfTarget == 1);
+    assert(resolver.resultFor(1).targetKilled);
+    assert(!resolver.resultFor(0).targetKilled);
+
+    const int expectedHp = 100 - resolver.getDamageDealt()[2] -
+                           resolver.getCounterDamage()[0];
+    assert(units[0]->getStats().getCurrentHp() == std::max(0, expectedHp));
+  }
+
+  static void testCounterAttackOnlyWhenTargetSurvives() {
+    UnitList units;
+    units.push_back(makeFighter(1, 0.0f, 1, 100, 200)); // 一撃で倒す
+    units.push_back(makeFighter(2, 0.5f, 2, 50, 10));
+    units.push_back(makeFighter(3, 0.0f, 1, 100, 1));
+    units.push_back(makeFighter(4, 0.5f, 2, 100, 10));
+
+    std::vector<AttackRequest> attacks = {{0, 1}, {2, 3}};
+    BatchCombatResolver resolver;
+    resolver.resolve(units, attacks);
+
+    assert(resolver.getCounterDamage()[0] == 0); // 倒された対象は反撃しない
+    assert(resolver.getCounterDamage()[1] > 0);  // 生き残った対象は反撃する
+    assert(units[0]->getStats().getCurrentHp() == 100);
+    assert(units[2]->getStats().getCurrentHp() ==
+           100 - resolver.getCounterDamage()[1]);
+  }
+};
+
+#endif // SIMULATION_GAME_BATCH_COMBAT_RESOLVER_TEST_H
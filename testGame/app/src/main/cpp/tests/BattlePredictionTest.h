@@ -0,0 +1,151 @@
+#ifndef SIMULATION_GAME_BATTLE_PREDICTION_TEST_H
+#define SIMULATION_GAME_BATTLE_PREDICTION_TEST_H
+
+#include "../domain/services/BattleSimulator.h"
+#include "../frameworks/utils/ThreadPoolJobSystem.h"
+#include "../usecases/BattlePredictionUseCase.h"
+#include "TestFixtures.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief BattleSimulator と勝敗予測（BattlePredictionUseCase）のテスト
+ */
+class BattlePredictionTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running BattlePrediction tests..." << std::endl;
+    testSimulatorIsDeterministicPerStream();
+    testSeededPredictionIsDeterministic();
+    testWinChanceAggregatesBatches();
+    testPredictionInsideSubmittedTask();
+    std::cout << "BattlePrediction tests passed!" << std::endl;
+  }
+
+private:
+  static constexpr uint32_t kSimulations = 640;
+
+  // 攻撃力だけ A がわずかに上回る 5 対 5（勝率が 0 と 1 の間に収まる）
+  static std::vector<UnitStats> makeSide(int minAttack, int maxAttack) {
+    return std::vector<UnitStats>(
+        5, UnitStats(60, 60, minAttack, maxAttack, 1.0f, 1.0f, 1.0f, 0.1f));
+  }
+
+  // 時間予算・信頼区間では打ち切らず、ちょうど kSimulations 回試行する
+  static BattlePredictionConfig fixedConfig(uint64_t seed) {
+    BattlePredictionConfig config;
+    config.timeBudgetMs = 1e6f;
+    config.targetHalfWidth = 0.0f;
+    config.maxSimulations = kSimulations;
+    config.seed = seed;
+    return config;
+  }
+
+  static void testSimulatorIsDeterministicPerStream() {
+    const auto sideA = makeSide(10, 14);
+    const auto sideB = makeSide(9, 13);
+    BattleSimulator first;
+    BattleSimulator second;
+    std::mt19937 rngA(42);
+    std::mt19937 rngB(42);
+    for (int i = 0; i < 20; ++i) {
+      const BattleSimulationResult a = first.run(sideA, sideB, rngA);
+      const BattleSimulationResult b = second.run(sideA, sideB, rngB);
+      assert(a.winner == b.winner && a.survivorsA == b.survivorsA &&
+             a.survivorsB == b.survivorsB && a.duration == b.duration);
+    }
+    std::cout << "✓ Simulator stream determinism test passed" << std::endl;
+  }
+
+  static void testSeededPredictionIsDeterministic() {
+    const auto sideA = makeSide(10, 14);
+    const auto sideB = makeSide(9, 13);
+
+    // 同じシードと同時実行数なら、どのスレッドがどのジョブを実行しても同じ
+    ThreadPoolJobSystem pool(3);
+    ReverseJobSystem reverse(4);
+    BattlePredictionUseCase pooled(&pool);
+    BattlePredictionUseCase reversed(&reverse);
+    pooled.setConfig(fixedConfig(7));
+    reversed.setConfig(fixedConfig(7));
+    const BattlePrediction a = pooled.predict(sideA, sideB);
+    const BattlePrediction b = reversed.predict(sideA, sideB);
+    const BattlePrediction again = pooled.predict(sideA, sideB);
+    assert(a.simulations == kSimulations && b.simulations == kSimulations);
+    assert(a.winProbability == b.winProbability);
+    assert(a.drawProbability == b.drawProbability);
+    assert(again.winProbability == a.winProbability);
+
+    // シードを変えると別の乱数ストリームになる
+    pooled.setConfig(fixedConfig(8));
+    assert(pooled.predict(sideA, sideB).winProbability != a.winProbability);
+    std::cout << "✓ Seeded prediction determinism test passed" << std::endl;
+  }
+
+  static void testWinChanceAggregatesBatches() {
+    const auto sideA = makeSide(10, 14);
+    const auto sideB = makeSide(9, 13);
+    ReverseJobSystem jobs(4);
+    BattlePredictionUseCase useCase(&jobs);
+    const BattlePredictionConfig config = fixedConfig(11);
+    useCase.setConfig(config);
+    const BattlePrediction prediction = useCase.predict(sideA, sideB);
+
+    // 同じ (シード, ラウンド, ジョブ) のストリームで試行し直して数える
+    const uint32_t jobCount = 4;
+    const uint32_t perJob = config.simulationsPerJob;
+    uint32_t winsA = 0;
+    BattleSimulator simulator;
+    for (uint32_t round = 0; round * jobCount * perJob < kSimulations;
+         ++round) {
+      for (uint32_t job = 0; job < jobCount; ++job) {
+        std::seed_seq streamSeed{static_cast<uint32_t>(config.seed),
+                                 static_cast<uint32_t>(config.seed >> 32),
+                                 round, job};
+        std::mt19937 rng(streamSeed);
+        for (uint32_t i = 0; i < perJob; ++i) {
+          winsA += simulator.run(sideA, sideB, rng).winner == 0 ? 1 : 0;
+        }
+      }
+    }
+    const float expected = static_cast<float>(winsA) / kSimulations;
+    assert(prediction.simulations == kSimulations);
+    assert(prediction.winProbability == expected);
+    assert(expected > 0.5f && expected < 1.0f);
+    assert(!prediction.converged);
+    std::cout << "✓ Win chance aggregation test passed" << std::endl;
+  }
+
+  static void testPredictionInsideSubmittedTask() {
+    // 描画スレッドと同じ使い方: submit したタスクの中で予測する
+    const auto sideA = makeSide(10, 14);
+    const auto sideB = makeSide(9, 13);
+    ThreadPoolJobSystem pool(3);
+    BattlePredictionUseCase direct(&pool);
+    BattlePredictionUseCase background(&pool);
+    direct.setConfig(fixedConfig(5));
+    background.setConfig(fixedConfig(5));
+    const float expected = direct.predict(sideA, sideB).winProbability;
+
+    std::atomic<float> winChance{-1.0f};
+    pool.submit([&]() {
+      winChance.store(background.predict(sideA, sideB).winProbability);
+    });
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (winChance.load() < 0.0f &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    assert(winChance.load() == expected);
+    std::cout << "✓ Prediction in submitted task test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_BATTLE_PREDICTION_TEST_H
@@ -0,0 +1,171 @@
+#ifndef SIMULATION_GAME_COLLISION_USECASE_TEST_H
+#define SIMULATION_GAME_COLLISION_USECASE_TEST_H
+
+#include "../domain/entities/GameMap.h"
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/OverlapResolver.h"
+#include "../usecases/CollisionUseCase.h"
+#include "TestFixtures.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 重なり解消（CollisionUseCase / OverlapResolver）のテスト
+ */
+class CollisionUseCaseTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running CollisionUseCase tests..." << std::endl;
+    testStackedUnitsAreSeparated();
+    testDeterministic();
+    testTerrainIsRespected();
+    testThousandsOfUnitsScale();
+    std::cout << "CollisionUseCase tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  // 中心付近にほぼ同じ位置で積み重なったユニット
+  static UnitList makeStack(int count) {
+    UnitList units;
+    for (int i = 0; i < count; ++i) {
+      units.push_back(makeUnit(i + 1, 5.0f + 0.01f * static_cast<float>(i % 3),
+                               5.0f + 0.01f * static_cast<float>(i / 3)));
+    }
+    return units;
+  }
+
+  static float minimumGap(const UnitList &units) {
+    float gap = 1e9f;
+    for (size_t i = 0; i < units.size(); ++i) {
+      for (size_t j = i + 1; j < units.size(); ++j) {
+        const float combined = units[i]->getStats().getCollisionRadius() +
+                               units[j]->getStats().getCollisionRadius();
+        gap = std::min(gap, units[i]->getPosition().distanceTo(
+                                units[j]->getPosition()) -
+                                combined);
+      }
+    }
+    return gap;
+  }
+
+  static void testStackedUnitsAreSeparated() {
+    UnitList units = makeStack(9);
+    CollisionUseCase collision(units);
+    assert(minimumGap(units) < 0.0f);
+    for (int tick = 0; tick < 20; ++tick) {
+      collision.resolveOverlaps();
+    }
+    assert(minimumGap(units) > -0.01f);
+
+    // 止まっていたユニットは押し出された位置で止まったまま
+    for (const auto &unit : units) {
+      assert(unit->getPosition() == unit->getTargetPosition());
+    }
+    std::cout << "✓ Stacked units separation test passed" << std::endl;
+  }
+
+  static void testDeterministic() {
+    UnitList first = makeStack(12);
+    UnitList second = makeStack(12);
+    CollisionUseCase firstCollision(first);
+    CollisionUseCase secondCollision(second);
+    for (int tick = 0; tick < 3; ++tick) {
+      firstCollision.resolveOverlaps();
+      secondCollision.resolveOverlaps();
+    }
+    for (size_t i = 0; i < first.size(); ++i) {
+      assert(first[i]->getPosition().getX() ==
+             second[i]->getPosition().getX());
+      assert(first[i]->getPosition().getY() ==
+             second[i]->getPosition().getY());
+    }
+    std::cout << "✓ Deterministic separation test passed" << std::endl;
+  }
+
+  static void testTerrainIsRespected() {
+    // 上端の行が水のマップで、水際に重なった2体を押し離す
+    GameMap map(4, 4, 1.0f, 0.0f, 0.0f);
+    for (int y = 0; y < 4; ++y) {
+      for (int x = 0; x < 4; ++x) {
+        map.setTile(x, y, y == 3 ? TerrainType::Water : TerrainType::Grassland);
+      }
+    }
+    UnitList units;
+    units.push_back(makeUnit(1, 1.5f, 2.8f));
+    units.push_back(makeUnit(2, 1.5f, 2.85f));
+    CollisionUseCase collision(units, &map);
+    for (int tick = 0; tick < 10; ++tick) {
+      collision.resolveOverlaps();
+    }
+    for (const auto &unit : units) {
+      assert(map.isWalkable(unit->getPosition(), 0.1f));
+    }
+    // 水側には動けないので、陸側のユニットが押し出される
+    assert(units[0]->getPosition().getY() < 2.8f);
+    std::cout << "✓ Terrain-aware separation test passed" << std::endl;
+  }
+
+  // side × side の格子。間隔 0.18 では半径 0.1 の点が上下左右の4点とだけ
+  // 重なる（斜めは 0.25 離れている）
+  static void makeLattice(int side, std::vector<float> &xs,
+                          std::vector<float> &ys, std::vector<float> &radii) {
+    xs.clear();
+    ys.clear();
+    for (int i = 0; i < side * side; ++i) {
+      xs.push_back(0.18f * static_cast<float>(i % side));
+      ys.push_back(0.18f * static_cast<float>(i / side));
+    }
+    radii.assign(xs.size(), 0.1f);
+  }
+
+  // 同じ入力で solve を繰り返し、最速の1回の時間（ミリ秒）を返す
+  static double bestSolveMs(int side, size_t &outPairs) {
+    std::vector<float> xs, ys, radii;
+    OverlapResolver resolver;
+    double best = 1e9;
+    for (int repeat = 0; repeat < 5; ++repeat) {
+      makeLattice(side, xs, ys, radii);
+      const auto start = std::chrono::steady_clock::now();
+      outPairs = resolver.solve(xs.data(), ys.data(), radii.data(),
+                                xs.size(), nullptr);
+      best = std::min(best, std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - start)
+                                .count());
+    }
+    return best;
+  }
+
+  static void testThousandsOfUnitsScale() {
+    // 候補は近傍のセルだけなので、見つかるペアは格子の隣接数ちょうど
+    size_t smallPairs = 0;
+    size_t largePairs = 0;
+    const double smallMs = bestSolveMs(32, smallPairs);
+    const double largeMs = bestSolveMs(64, largePairs);
+    assert(smallPairs == 2u * 32u * 31u);
+    assert(largePairs == 2u * 64u * 63u);
+    std::cout << "  overlap resolve: 1024 units " << smallMs
+              << " ms, 4096 units " << largeMs << " ms" << std::endl;
+
+    // 4倍のユニットで時間は約4倍（総当たりなら16倍）。サニタイザ付きの
+    // ビルドや計測のぶれを見込み、10倍未満であることだけを保証する
+    assert(largeMs < 10.0 * smallMs);
+
+    // ユースケース経由でも同じ格子の重なりが解消に向かう
+    UnitList units;
+    for (int i = 0; i < 64 * 64; ++i) {
+      units.push_back(makeUnit(i + 1, 0.18f * static_cast<float>(i % 64),
+                               0.18f * static_cast<float>(i / 64)));
+    }
+    CollisionUseCase collision(units);
+    assert(collision.resolveOverlaps() > 0);
+    std::cout << "✓ Thousands of units scale test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_COLLISION_USECASE_TEST_H
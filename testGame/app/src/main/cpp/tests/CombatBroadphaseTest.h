@@ -0,0 +1,276 @@
+#ifndef SIMULATION_GAME_COMBAT_BROADPHASE_TEST_H
+#define SIMULATION_GAME_COMBAT_BROADPHASE_TEST_H
+
+#include "../domain/entities/GameMap.h"
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/CombatBroadphase.h"
+#include "../domain/services/FactionSpatialIndex.h"
+#include "../domain/services/SpatialHashGrid.h"
+#include "../domain/services/TargetSelector.h"
+#include "TestFixtures.h"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 空間インデックス・CombatBroadphase・TargetSelector のユニットテスト
+ *
+ * ブロードフェーズの結果が従来の全探索（UnitEntity::isInAttackRange）と
+ * 一致することを中心に検証する。
+ */
+class CombatBroadphaseTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running CombatBroadphase tests..." << std::endl;
+    testGridRadiusQuery();
+    testPairsMatchBruteForce();
+    testSameFactionAndDeadUnitsExcluded();
+    testCoversDetectsResizedContainer();
+    testFactionIndexSkipsAllies();
+    testTargetSelectionPolicies();
+    testLowestHpPrefersWeakestLethalTarget();
+    testKNearestEnemies();
+    testLineOfSightFiltersPairs();
+    std::cout << "CombatBroadphase tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  static void testGridRadiusQuery() {
+    std::vector<float> xs = {0.0f, 0.5f, -0.5f, 3.0f, -2.9f};
+    std::vector<float> ys = {0.0f, 0.0f, 0.5f, 3.0f, -0.1f};
+    SpatialHashGrid grid(1.0f);
+    grid.build(xs.data(), ys.data(), xs.size());
+
+    int found = 0;
+    grid.forEachInRadius(0.0f, 0.0f, 1.0f, [&](uint32_t index, float dSq) {
+      assert(index <= 2);
+      assert(dSq <= 1.0f);
+      ++found;
+    });
+    assert(found == 3);
+  }
+
+  static void testPairsMatchBruteForce() {
+    UnitList units;
+    int id = 1;
+    for (int y = 0; y < 6; ++y) {
+      for (int x = 0; x < 6; ++x) {
+        const int faction = (x + y) % 2 == 0 ? 1 : 2;
+        const float range = 0.5f + 0.25f * static_cast<float>(x % 3);
+        units.push_back(makeUnit(id++, x * 0.7f - 2.0f, y * 0.6f - 1.5f,
+                                 faction, range));
+      }
+    }
+
+    CombatBroadphase broadphase;
+    broadphase.rebuild(units);
+    assert(broadphase.covers(units.size()));
+
+    size_t bruteForcePairs = 0;
+    for (size_t a = 0; a < units.size(); ++a) {
+      std::vector<uint32_t> expected;
+      for (size_t t = 0; t < units.size(); ++t) {
+        if (a == t || units[a]->getFaction() == units[t]->getFaction()) {
+          continue;
+        }
+        if (units[a]->isInAttackRange(*units[t])) {
+          expected.push_back(static_cast<uint32_t>(t));
+        }
+      }
+      bruteForcePairs += expected.size();
+
+      size_t k = 0;
+      for (const auto &pair : broadphase.pairsForAttacker(a)) {
+        assert(pair.attackerIndex == a);
+        assert(k < expected.size());
+        assert(pair.targetIndex == expected[k]); // 対象インデックス昇順
+        ++k;
+      }
+      assert(k == expected.size());
+    }
+    assert(broadphase.getPairs().size() == bruteForcePairs);
+  }
+
+  static void testSameFactionAndDeadUnitsExcluded() {
+    UnitList units;
+    units.push_back(makeUnit(1, 0.0f, 0.0f, 1, 1.0f));
+    units.push_back(makeUnit(2, 0.2f, 0.0f, 1, 1.0f)); // 味方
+    units.push_back(makeUnit(3, 0.4f, 0.0f, 2, 1.0f)); // 敵（死亡させる）
+    units.push_back(makeUnit(4, 0.6f, 0.0f, 2, 1.0f)); // 敵
+    units[2]->takeDamage(1000);
+
+    CombatBroadphase broadphase;
+    broadphase.rebuild(units);
+
+    auto range = broadphase.pairsForAttacker(0);
+    assert(!range.empty());
+    assert(range.begin()->targetIndex == 3);
+    assert(range.end() - range.begin() == 1);
+    assert(broadphase.pairsForAttacker(2).empty()); // 死亡ユニットは攻撃しない
+  }
+
+  static void testCoversDetectsResizedContainer() {
+    UnitList units;
+    units.push_back(makeUnit(1, 0.0f, 0.0f, 1, 1.0f));
+    units.push_back(makeUnit(2, 0.5f, 0.0f, 2, 1.0f));
+
+    CombatBroadphase broadphase;
+    broadphase.rebuild(units);
+    assert(broadphase.covers(2));
+    units.pop_back();
+    assert(!broadphase.covers(units.size()));
+    broadphase.invalidate();
+    assert(!broadphase.covers(2));
+  }
+
+  static void testFactionIndexSkipsAllies() {
+    // 3 陣営。陣営1から見ると 2 と 3 が敵
+    std::vector<float> xs = {0.0f, 0.1f, 0.2f, 0.9f, 0.5f, 0.3f};
+    std::vector<float> ys = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    std::vector<int> factions = {1, 1, 1, 2, 3, 3};
+    std::vector<uint8_t> alive = {1, 1, 1, 1, 1, 0};
+
+    FactionSpatialIndex index;
+    index.setCellSize(1.0f);
+    index.build(xs.data(), ys.data(), factions.data(), alive.data(),
+                xs.size());
+    assert(index.factionCount() == 3);
+    assert(index.countInFaction(3) == 1); // 死亡ユニットは登録されない
+    assert(index.countEnemiesOf(1) == 2);
+
+    int visited = 0;
+    index.forEachEnemyInRadius(1, 0.0f, 0.0f, 2.0f,
+                               [&](uint32_t i, float) {
+                                 assert(factions[i] != 1);
+                                 ++visited;
+                               });
+    assert(visited == 2);
+
+    uint32_t nearest = 0;
+    float nearestDistanceSq = 0.0f;
+    assert(index.findNearestEnemy(1, 0.0f, 0.0f, 2.0f, nearest,
+                                  nearestDistanceSq));
+    assert(nearest == 4);
+    assert(!index.findNearestEnemy(1, 0.0f, 0.0f, 0.4f, nearest,
+                                   nearestDistanceSq));
+
+    // 陣営が消えても再構築できる
+    alive = {1, 1, 1, 0, 0, 0};
+    index.build(xs.data(), ys.data(), factions.data(), alive.data(),
+                xs.size());
+    assert(index.factionCount() == 1);
+    assert(index.countEnemiesOf(1) == 0);
+  }
+
+  static void testTargetSelectionPolicies() {
+    UnitList units;
+    units.push_back(makeUnit(1, 0.0f, 0.0f, 1, 2.0f));
+    units.push_back(makeUnit(2, 1.5f, 0.0f, 2, 1.0f)); // 遠い・HP低
+    units.push_back(makeUnit(3, 0.5f, 0.0f, 2, 1.0f)); // 近い
+    UnitStats strong(100, 100, 40, 60, 1.0f, 1.0f, 2.0f, 0.1f);
+    units.push_back(std::make_shared<UnitEntity>(4, "Strong",
+                                                 Position(1.0f, 0.0f), strong,
+                                                 2)); // 高脅威
+    units[1]->takeDamage(70);
+
+    CombatBroadphase broadphase;
+    broadphase.rebuild(units);
+    auto select = [&](TargetSelectionPolicy policy) {
+      return TargetSelector::selectFromBroadphase(broadphase, units, 0, policy);
+    };
+    assert(select(TargetSelectionPolicy::FIRST_IN_RANGE) == 1);
+    assert(select(TargetSelectionPolicy::NEAREST) == 2);
+    assert(select(TargetSelectionPolicy::LOWEST_HP) == 1);
+    assert(select(TargetSelectionPolicy::HIGHEST_THREAT) == 3);
+
+    units[2]->takeDamage(1000); // 同ティック内に倒された対象は選ばない
+    assert(select(TargetSelectionPolicy::NEAREST) == 3);
+  }
+
+  static void testLowestHpPrefersWeakestLethalTarget() {
+    // どちらも一撃で倒せる2体を、HPの高い方から渡す
+    UnitStats heavy(100, 100, 40, 60, 1.0f, 2.0f, 1.0f, 0.1f);
+    auto attacker = makeUnit(1, 0.0f, 0.0f, heavy, 1);
+    auto sturdier = makeUnit(2, 0.5f, 0.0f, 2);
+    auto weaker = makeUnit(3, 1.0f, 0.0f, 2);
+    sturdier->takeDamage(80); // HP 20
+    weaker->takeDamage(95);   // HP 5
+
+    TargetSelector selector(*attacker, TargetSelectionPolicy::LOWEST_HP);
+    assert(selector.offer(0, *sturdier, 0.25f));
+    assert(selector.offer(1, *weaker, 1.0f));
+    assert(selector.getTargetIndex() == 1);
+
+    // HP 1 より低い生存ユニットはいないので、そこで走査を打ち切ってよい
+    auto dying = makeUnit(4, 1.5f, 0.0f, 2);
+    dying->takeDamage(99);
+    assert(!selector.offer(2, *dying, 2.25f));
+    assert(selector.getTargetIndex() == 2);
+  }
+
+  static void testKNearestEnemies() {
+    std::vector<float> xs = {0.0f, 3.0f, 0.5f, -1.0f, 0.2f, 6.0f};
+    std::vector<float> ys = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    std::vector<int> factions = {1, 2, 2, 3, 1, 2};
+    std::vector<uint8_t> alive = {1, 1, 1, 1, 1, 1};
+
+    FactionSpatialIndex index;
+    index.setCellSize(1.0f);
+    index.build(xs.data(), ys.data(), factions.data(), alive.data(),
+                xs.size());
+
+    uint32_t nearest[3];
+    float distancesSq[3];
+    size_t found = TargetSelector::findKNearestEnemies(
+        index, 1, 0.0f, 0.0f, 10.0f, 3, nearest, distancesSq);
+    assert(found == 3);
+    assert(nearest[0] == 2 && nearest[1] == 3 && nearest[2] == 1);
+    assert(distancesSq[0] <= distancesSq[1] && distancesSq[1] <= distancesSq[2]);
+
+    // 半径の上限で打ち切られる
+    found = TargetSelector::findKNearestEnemies(index, 1, 0.0f, 0.0f, 1.0f, 3,
+                                                nearest, distancesSq);
+    assert(found == 2);
+  }
+
+  static void testLineOfSightFiltersPairs() {
+    // 1行のマップ: 草地 | 山 | 草地 | 森 | 草地
+    GameMap map(5, 1, 1.0f, 0.0f, 0.0f);
+    for (int x = 0; x < 5; ++x) {
+      map.setTile(x, 0, TerrainType::Grassland);
+    }
+    map.setTile(1, 0, TerrainType::Mountain);
+    map.setTile(3, 0, TerrainType::Forest);
+    LineOfSight los(&map);
+
+    UnitList units;
+    units.push_back(makeUnit(1, 2.5f, 0.5f, 1, 3.0f));
+    units.push_back(makeUnit(2, 0.5f, 0.5f, 2, 0.5f)); // 山の向こう
+    units.push_back(makeUnit(3, 4.5f, 0.5f, 2, 0.5f)); // 森の向こう
+
+    CombatBroadphase broadphase;
+    broadphase.rebuild(units);
+    assert(broadphase.pairsForAttacker(0).last -
+               broadphase.pairsForAttacker(0).first ==
+           2);
+
+    broadphase.setLineOfSight(&los);
+    broadphase.rebuild(units);
+    auto range = broadphase.pairsForAttacker(0);
+    assert(range.last - range.first == 1);
+    assert(range.first->targetIndex == 2);
+    assert(range.first->visibility > 0.0f && range.first->visibility < 1.0f);
+
+    // 山を崩すと次の rebuild から射程内に戻る
+    map.setTile(1, 0, TerrainType::Grassland);
+    broadphase.rebuild(units);
+    assert(broadphase.pairsForAttacker(0).last -
+               broadphase.pairsForAttacker(0).first ==
+           2);
+  }
+};
+
+#endif // SIMULATION_GAME_COMBAT_BROADPHASE_TEST_H
@@ -0,0 +1,146 @@
+#ifndef SIMULATION_GAME_FORMATION_TEST_H
+#define SIMULATION_GAME_FORMATION_TEST_H
+
+#include "../domain/entities/GameMap.h"
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/FormationPlanner.h"
+#include "../usecases/MovementUseCase.h"
+#include "TestFixtures.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 隊形移動（FormationPlanner / MovementUseCase::moveFormationTo）のテスト
+ */
+class FormationTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running Formation tests..." << std::endl;
+    testSlotAssignmentKeepsRelativeOrder();
+    testFormationOrdersAreSpread();
+    testSlotsOnWaterArePulledBack();
+    testFormationRoutesAroundWater();
+    std::cout << "Formation tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  static void testSlotAssignmentKeepsRelativeOrder() {
+    // +Y 方向へ進む 2x2 の隊形。前列は左から枠 0, 1
+    std::vector<Position> offsets;
+    FormationPlanner::buildSlotOffsets(4, 1.0f, 0.0f, 1.0f, offsets);
+    assert(offsets.size() == 4);
+    assert(offsets[0].getY() > offsets[2].getY()); // 枠 0 は前列
+    assert(offsets[0].getX() < offsets[1].getX()); // 枠 0 は左
+
+    std::vector<Position> units = {Position(1.0f, 0.0f), Position(0.0f, 0.0f),
+                                   Position(1.0f, 1.0f), Position(0.0f, 1.0f)};
+    std::vector<size_t> slotOfUnit;
+    FormationPlanner::assignSlots(units, 0.0f, 1.0f, slotOfUnit);
+    assert(slotOfUnit[3] == 0); // 前・左
+    assert(slotOfUnit[2] == 1); // 前・右
+    assert(slotOfUnit[1] == 2); // 後・左
+    assert(slotOfUnit[0] == 3); // 後・右
+    std::cout << "✓ Slot assignment test passed" << std::endl;
+  }
+
+  static void testFormationOrdersAreSpread() {
+    UnitList units;
+    std::vector<int> ids;
+    for (int i = 0; i < 9; ++i) {
+      units.push_back(makeUnit(i + 1, 2.0f + 0.05f * (i % 3),
+                               2.0f + 0.05f * (i / 3)));
+      ids.push_back(i + 1);
+    }
+    MovementUseCase movement(units);
+    const size_t ordered = movement.moveFormationTo(ids, Position(8.0f, 2.0f));
+    assert(ordered == units.size());
+
+    float sumX = 0.0f;
+    float sumY = 0.0f;
+    for (size_t i = 0; i < units.size(); ++i) {
+      const Position &target = units[i]->getTargetPosition();
+      sumX += target.getX();
+      sumY += target.getY();
+      for (size_t j = i + 1; j < units.size(); ++j) {
+        assert(target.distanceTo(units[j]->getTargetPosition()) >=
+               0.3f - 1e-4f);
+      }
+    }
+    // 隊形の中心が指定した目標に一致する
+    assert(std::fabs(sumX / units.size() - 8.0f) < 1e-3f);
+    assert(std::fabs(sumY / units.size() - 2.0f) < 1e-3f);
+    std::cout << "✓ Formation spread test passed" << std::endl;
+  }
+
+  static void testSlotsOnWaterArePulledBack() {
+    // x = 5 の列が水のマップ。目標は水際なので一部の枠が水にかかる
+    GameMap map(10, 10, 1.0f, 0.0f, 0.0f);
+    for (int y = 0; y < 10; ++y) {
+      for (int x = 0; x < 10; ++x) {
+        map.setTile(x, y, x == 5 ? TerrainType::Water : TerrainType::Grassland);
+      }
+    }
+    UnitList units;
+    std::vector<int> ids;
+    for (int i = 0; i < 9; ++i) {
+      units.push_back(makeUnit(i + 1, 1.0f + 0.3f * (i % 3),
+                               4.0f + 0.3f * (i / 3)));
+      ids.push_back(i + 1);
+    }
+    MovementUseCase movement(units, nullptr, &map);
+    assert(movement.moveFormationTo(ids, Position(4.6f, 4.5f), 0.5f) > 0);
+    for (const auto &unit : units) {
+      assert(map.isWalkable(unit->getTargetPosition(), 0.1f));
+    }
+
+    std::vector<Position> probes = {Position(4.5f, 4.5f), Position(5.5f, 4.5f)};
+    uint8_t walkable[2] = {0, 0};
+    map.areWalkable(probes.data(), probes.size(), 0.1f, walkable);
+    assert(walkable[0] == 1 && walkable[1] == 0);
+    std::cout << "✓ Formation terrain test passed" << std::endl;
+  }
+
+  static void testFormationRoutesAroundWater() {
+    // x = 5 の列が水で、上端の2行（y = 8, 9）だけが渡れる。目標は対岸
+    GameMap map(12, 10, 1.0f, 0.0f, 0.0f);
+    for (int y = 0; y < 10; ++y) {
+      for (int x = 0; x < 12; ++x) {
+        map.setTile(x, y,
+                    x == 5 && y < 8 ? TerrainType::Water
+                                    : TerrainType::Grassland);
+      }
+    }
+    UnitList units;
+    std::vector<int> ids;
+    for (int i = 0; i < 6; ++i) {
+      units.push_back(makeUnit(i + 1, 1.5f + 0.5f * (i % 3),
+                               2.5f + 0.5f * (i / 3)));
+      ids.push_back(i + 1);
+    }
+    MovementUseCase movement(units, nullptr, &map);
+    assert(movement.moveFormationTo(ids, Position(9.0f, 3.0f), 0.5f) ==
+           units.size());
+
+    // 岸で止まらず、全員がアンカーの経由点（橋）を通る経路を持つ
+    for (const auto &unit : units) {
+      assert(movement.getRouteWaypointCount(unit->getId()) >= 2);
+      assert(map.isWalkable(unit->getTargetPosition(), 0.1f));
+    }
+    for (int tick = 0; tick < 600; ++tick) {
+      movement.updateMovements(0.05f);
+    }
+    for (const auto &unit : units) {
+      assert(unit->getPosition().getX() > 6.0f);
+      assert(unit->getPosition().distanceTo(Position(9.0f, 3.0f)) < 1.5f);
+      assert(map.isWalkable(unit->getPosition(), 0.1f));
+    }
+    std::cout << "✓ Formation water detour test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_FORMATION_TEST_H
@@ -0,0 +1,159 @@
+#ifndef SIMULATION_GAME_FRAME_ALLOCATION_TEST_H
+#define SIMULATION_GAME_FRAME_ALLOCATION_TEST_H
+
+#include "../domain/services/ActiveUnitSets.h"
+#include "../domain/services/CombatBroadphase.h"
+#include "../domain/services/SimulationLod.h"
+#include "../usecases/AISchedulerUseCase.h"
+#include "../usecases/CollisionUseCase.h"
+#include "../usecases/CombatUseCase.h"
+#include "../usecases/MovementUseCase.h"
+#include "TestFixtures.h"
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+/*
+ * FrameAllocationTest.h
+ *
+ * Counts global operator new calls across steady-state simulation ticks.
+ * The replacement operator new / delete below are ordinary (non-inline)
+ * definitions, so include this header from the test runner's translation
+ * unit only.
+ *
+ * The check covers the simulation half of Renderer::updateGameState. The GL
+ * half cannot run here and is not measured. Its transient vertex and index
+ * data already lives in the FrameArena. Allocations known to remain outside
+ * the measured tick:
+ * - the battle prediction task submitted once per second (std::function)
+ * - influence map updates every 0.25 s
+ * - events such as route planning, unit death and AI agent migration
+ */
+
+namespace frame_allocation_test {
+inline std::atomic<size_t> &allocationCount() {
+  static std::atomic<size_t> count{0};
+  return count;
+}
+} // namespace frame_allocation_test
+
+void *operator new(std::size_t size) {
+  ++frame_allocation_test::allocationCount();
+  if (void *memory = std::malloc(size != 0 ? size : 1)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+// std::stable_sort などの一時領域は nothrow 版で確保する
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  ++frame_allocation_test::allocationCount();
+  return std::malloc(size != 0 ? size : 1);
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept {
+  std::free(memory);
+}
+
+/**
+ * @brief 定常状態のティックがヒープ確保をしないことのテスト
+ */
+class FrameAllocationTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running FrameAllocation tests..." << std::endl;
+    testSteadyStateTicksDoNotAllocate();
+    std::cout << "FrameAllocation tests passed!" << std::endl;
+  }
+
+private:
+  static void testSteadyStateTicksDoNotAllocate() {
+    GameMap map = makeGrassland(64, 64);
+    map.rebuildClearance();
+    // 2列で向かい合い、倒れない（HP が十分に多い）まま戦い続ける
+    std::vector<std::shared_ptr<UnitEntity>> units;
+    for (int i = 0; i < 40; ++i) {
+      UnitStats stats(100000, 100000, 1, 1, 1.0f, 1.0f, 1.0f, 0.3f);
+      const float y = i < 20 ? 20.0f : 26.0f;
+      units.push_back(makeUnit(i + 1, 20.0f + static_cast<float>(i % 20), y,
+                               stats, i < 20 ? 1 : 2));
+    }
+
+    // Renderer と同じ組み合わせ（描画・霧・予測・影響度マップを除く）
+    CombatBroadphase broadphase;
+    ActiveUnitSets activeUnits;
+    SimulationLod lod;
+    CombatUseCase combat(units);
+    MovementUseCase movement(units, nullptr, &map);
+    CollisionUseCase collision(units, &map);
+    combat.setCombatBroadphase(&broadphase);
+    movement.setCombatBroadphase(&broadphase);
+    activeUnits.track(units);
+    combat.setActiveUnitSets(&activeUnits);
+    movement.setActiveUnitSets(&activeUnits);
+    collision.setActiveUnitSets(&activeUnits, &broadphase);
+    movement.setSimulationLod(&lod);
+    AISchedulerUseCase ai(units, &movement, &combat);
+    ai.setCombatBroadphase(&broadphase);
+    size_t attacks = 0;
+    combat.setCombatEventCallback(
+        [&attacks](const UnitEntity &, const UnitEntity &,
+                   const CombatDomainService::CombatResult &) { ++attacks; });
+    for (int i = 0; i < 20; ++i) {
+      const float x = 20.0f + static_cast<float>(i);
+      movement.moveUnitTo(i + 1, Position(x, 25.0f));
+    }
+
+    // Renderer::updateGameState と同じ順で1ティック進める
+    float now = 0.0f;
+    auto tick = [&]() {
+      broadphase.rebuildIndex(units);
+      if (activeUnits.covers(units.size())) {
+        activeUnits.updateSleep(broadphase.getFactionIndex());
+      }
+      broadphase.buildPairs(&activeUnits);
+      lod.beginTick(&broadphase.getFactionIndex());
+      ai.update(now);
+      collision.captureStartPositions();
+      movement.updateMovements(0.05f);
+      collision.resolveSweptContacts();
+      collision.resolveOverlaps();
+      combat.executeAutoCombat(now);
+      if (combat.removeDeadUnits() > 0) {
+        activeUnits.track(units);
+      }
+      broadphase.invalidate();
+      now += 0.05f;
+    };
+
+    // 作業領域が育ち、経路の計画が済むまで回してから数える
+    for (int frame = 0; frame < 300; ++frame) {
+      tick();
+    }
+    const size_t attacksBefore = attacks;
+    const size_t before = frame_allocation_test::allocationCount().load();
+    for (int frame = 0; frame < 100; ++frame) {
+      tick();
+    }
+    const size_t allocations =
+        frame_allocation_test::allocationCount().load() - before;
+    std::cout << "  100 ticks of 40 units: " << allocations
+              << " heap allocations, " << attacks - attacksBefore
+              << " attacks" << std::endl;
+    assert(attacks > attacksBefore);
+    assert(allocations == 0);
+    std::cout << "✓ Steady-state tick allocation test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_FRAME_ALLOCATION_TEST_H
@@ -0,0 +1,126 @@
+#ifndef SIMULATION_GAME_FRAME_ARENA_TEST_H
+#define SIMULATION_GAME_FRAME_ARENA_TEST_H
+
+#include "../frameworks/utils/FrameArena.h"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief フレームアリーナ（FrameArena / FrameAllocator）のテスト
+ */
+class FrameArenaTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running FrameArena tests..." << std::endl;
+    testBumpAndReset();
+    testOverflowGrowsHeadBlock();
+    testFrameVector();
+    testSteadyStateFrames();
+    std::cout << "FrameArena tests passed!" << std::endl;
+  }
+
+private:
+  static void testBumpAndReset() {
+    FrameArena arena(256);
+    void *first = arena.allocate(10, 1);
+    void *second = arena.allocate(8, 8);
+    assert(reinterpret_cast<uintptr_t>(second) % 8 == 0);
+    assert(static_cast<char *>(second) >= static_cast<char *>(first) + 10);
+    assert(arena.getUsedBytes() == 18);
+
+    // reset 後は同じ領域を先頭から使い直す
+    arena.reset();
+    assert(arena.getUsedBytes() == 0);
+    assert(arena.allocate(10, 1) == first);
+    assert(arena.getHeapAllocationCount() == 0);
+    std::cout << "✓ Bump and reset test passed" << std::endl;
+  }
+
+  static void testOverflowGrowsHeadBlock() {
+    FrameArena arena(64);
+    // 先頭ブロックに収まらない分は追加ブロックで受ける
+    for (int i = 0; i < 20; ++i) {
+      void *block = arena.allocate(48, 16);
+      assert(reinterpret_cast<uintptr_t>(block) % 16 == 0);
+    }
+    assert(arena.getHeapAllocationCount() > 0);
+
+    // reset で1フレーム分が収まる大きさになり、以降は確保しない
+    arena.reset();
+    assert(arena.getCapacity() >= 20 * 48);
+    const size_t count = arena.getHeapAllocationCount();
+    for (int frame = 0; frame < 5; ++frame) {
+      for (int i = 0; i < 20; ++i) {
+        arena.allocate(48, 16);
+      }
+      arena.reset();
+    }
+    assert(arena.getHeapAllocationCount() == count);
+    std::cout << "✓ Overflow grows head block test passed" << std::endl;
+  }
+
+  static void testFrameVector() {
+    FrameArena arena(1024);
+    {
+      FrameVector<int> values{FrameAllocator<int>(&arena)};
+      for (int i = 0; i < 100; ++i) {
+        values.push_back(i);
+      }
+      assert(values.get_allocator().getArena() == &arena);
+      assert(arena.getUsedBytes() > 0);
+
+      // コピーはヒープに作り、フレームを越えて残せる
+      FrameVector<int> copy(values);
+      assert(copy.get_allocator().getArena() == nullptr);
+      assert(copy.size() == 100 && copy[99] == 99);
+
+      // ムーブはアリーナごと引き継ぐ
+      FrameVector<int> moved(std::move(values));
+      assert(moved.get_allocator().getArena() == &arena);
+      assert(moved[50] == 50);
+    }
+    arena.reset();
+
+    // アリーナのないアロケータは通常のヒープを使う
+    FrameVector<int> heap;
+    heap.assign(10, 7);
+    assert(heap.get_allocator().getArena() == nullptr && heap[9] == 7);
+    std::cout << "✓ FrameVector test passed" << std::endl;
+  }
+
+  static void testSteadyStateFrames() {
+    // 描画と同じ使い方: フレームごとに四角形の頂点・インデックスを
+    // ユニット数だけ作り、フレームの終わりに reset する
+    struct Vertex {
+      float position[3];
+      float uv[2];
+    };
+    FrameArena arena(64);
+    size_t warmedUp = 0;
+    for (int frame = 0; frame < 10; ++frame) {
+      for (int unit = 0; unit < 50; ++unit) {
+        FrameVector<Vertex> vertices{FrameAllocator<Vertex>(&arena)};
+        vertices.reserve(4);
+        for (int corner = 0; corner < 4; ++corner) {
+          vertices.push_back(Vertex{{float(corner), 0.0f, 0.0f}, {0, 0}});
+        }
+        FrameVector<uint16_t> indices({0, 1, 2, 0, 2, 3},
+                                      FrameAllocator<uint16_t>(&arena));
+        assert(vertices.size() == 4 && indices[5] == 3);
+      }
+      arena.reset();
+      // 1フレーム目の reset で先頭ブロックが広がり、以降は確保しない
+      if (frame == 0) {
+        warmedUp = arena.getHeapAllocationCount();
+      }
+    }
+    assert(warmedUp > 0);
+    assert(arena.getHeapAllocationCount() == warmedUp);
+    std::cout << "✓ Steady state frames test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_FRAME_ARENA_TEST_H
@@ -2,9 +2,13 @@
 #define SIMULATION_GAME_GAME_MAP_TEST_H
 
 #include "../domain/entities/GameMap.h"
+#include "../domain/services/FogOfWarGrid.h"
+#include "../domain/services/LineOfSight.h"
 #include "../domain/value_objects/Position.h"
 #include <cassert>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 class GameMapTest {
 public:
@@ -13,6 +17,8 @@ public:
     testTerrainLookup();
     testMovementStoppingBeforeWater();
     testClampInside();
+    testLineOfSight();
+    testFogOfWarIncrementalUpdate();
     std::cout << "GameMap tests passed!" << std::endl;
   }
 
@@ -60,6 +66,84 @@ private:
     assert(clamped.getX() >= map.getMinX());
     assert(clamped.getY() <= map.getMaxY());
   }
+
+  static void testLineOfSight() {
+    GameMap map = buildSampleMap();
+    LineOfSight los(&map);
+    const Position west(0.5f, 1.5f);
+    const Position east(3.5f, 1.5f);
+    const Position behindForest(2.5f, 1.5f);
+
+    // 草地だけを通る視線は遮られない
+    assert(los.visibilityBetween(Position(0.5f, 0.5f), Position(3.5f, 0.5f)) ==
+           1.0f);
+    // 森は視線を弱め、山は遮断する
+    const float throughForest = los.visibilityBetween(west, behindForest);
+    assert(throughForest > 0.0f && throughForest < 1.0f);
+    assert(los.hasLineOfSight(west, behindForest));
+    assert(!los.hasLineOfSight(west, east));
+    // 向きによらず同じ結果になる
+    assert(los.visibilityBetween(east, west) ==
+           los.visibilityBetween(west, east));
+    assert(los.getCacheSize() == 3);
+
+    // 同じ地形での上書きはキャッシュを無効化しない
+    const uint64_t epoch = map.getTerrainEpoch();
+    map.setTile(2, 1, TerrainType::Mountain);
+    assert(map.getTerrainEpoch() == epoch);
+
+    // 地形編集後は新しい地形で再判定される
+    map.setTile(2, 1, TerrainType::Grassland);
+    assert(map.getTerrainEpoch() != epoch);
+    assert(los.hasLineOfSight(west, east));
+    assert(los.getCacheSize() == 1);
+  }
+
+  static void testFogOfWarIncrementalUpdate() {
+    GameMap map(80, 4, 1.0f, 0.0f, 0.0f);
+    FogOfWarGrid fog(map);
+    fog.setSightBonus(1.0f);
+
+    // 射程 0.5 + 視界 1.0 = 半径 1.5 タイル
+    UnitStats stats(100, 100, 10, 10, 1.0f, 0.5f, 1.0f, 0.1f);
+    std::vector<std::shared_ptr<UnitEntity>> units;
+    units.push_back(
+        std::make_shared<UnitEntity>(1, "Scout", Position(1.5f, 1.5f), stats, 1));
+    units.push_back(
+        std::make_shared<UnitEntity>(2, "Ally", Position(2.5f, 1.5f), stats, 1));
+
+    fog.update(units);
+    assert(fog.isVisible(1, 1, 1));
+    assert(fog.isVisible(1, 0, 0));
+    assert(!fog.isVisible(1, 5, 1));
+    assert(!fog.isVisible(2, 1, 1)); // 他陣営からは見えない
+    std::vector<int> rows;
+    fog.takeDirtyRows(1, rows);
+    assert(rows.size() == 3); // 行 0..2
+
+    // 移動していなければ何も変わらない
+    fog.update(units);
+    fog.takeDirtyRows(1, rows);
+    assert(rows.empty());
+
+    // 64 タイル目を跨ぐ移動: 新しい位置が見え、味方が見ている範囲は残る
+    units[0]->updatePosition(Position(64.5f, 0.5f));
+    fog.update(units);
+    assert(fog.isVisible(1, 63, 0) && fog.isVisible(1, 65, 1));
+    assert(fog.isVisible(1, 1, 1));
+    assert(!fog.isVisible(1, 0, 0));
+    const uint64_t *row0 = fog.getRowBits(1, 0);
+    assert(fog.getWordsPerRow() == 2);
+    assert((row0[1] & 1u) != 0); // タイル 64
+    fog.takeDirtyRows(1, rows);
+    assert(!rows.empty());
+
+    // 除去されたユニットの視界は取り除かれる
+    units.pop_back();
+    fog.update(units);
+    assert(!fog.isVisible(1, 2, 1));
+    assert(fog.isVisibleAt(1, Position(64.2f, 0.8f)));
+  }
 };
 
 #endif // SIMULATION_GAME_GAME_MAP_TEST_H
@@ -0,0 +1,225 @@
+#ifndef SIMULATION_GAME_INCREMENTAL_PATH_TEST_H
+#define SIMULATION_GAME_INCREMENTAL_PATH_TEST_H
+
+#include "../domain/entities/GameMap.h"
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/GridPathfinder.h"
+#include "../domain/services/IncrementalPathfinder.h"
+#include "../usecases/MovementUseCase.h"
+#include "TestFixtures.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * @brief 地形変更後の経路の修復（IncrementalPathfinder / D* Lite）と
+ *        GameMap の変更記録、移動中の迂回経路の修復のテスト
+ */
+class IncrementalPathTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running IncrementalPath tests..." << std::endl;
+    testPlanMatchesAStar();
+    testRepairAfterEdits();
+    testLocalRepairBeatsFreshSearch();
+    testChangeJournal();
+    testUnitReroutesAroundNewWall();
+    std::cout << "IncrementalPath tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  static bool sameCost(float a, float b) { return std::fabs(a - b) < 1e-3f; }
+
+  static void testPlanMatchesAStar() {
+    GameMap map = makeGrassland(48, 48);
+    std::mt19937 random(5);
+    std::uniform_int_distribution<int> tile(0, 47);
+    for (int i = 0; i < 500; ++i) {
+      map.setTile(tile(random), tile(random),
+                  i % 3 == 0 ? TerrainType::Forest : TerrainType::Water);
+    }
+    map.rebuildClearance();
+
+    GridPathfinder astar;
+    IncrementalPathfinder dstar;
+    std::vector<Position> path;
+    int found = 0;
+    for (int i = 0; i < 30; ++i) {
+      const Position start(tile(random) + 0.5f, tile(random) + 0.5f);
+      const Position goal(tile(random) + 0.5f, tile(random) + 0.5f);
+      if (!map.isTilePassable(static_cast<int>(start.getX()),
+                              static_cast<int>(start.getY()), 0.3f)) {
+        continue;
+      }
+      const bool byAStar = astar.findPath(map, start, goal, 0.3f, path);
+      const bool byDStar = dstar.plan(map, start, goal, 0.3f, path);
+      assert(byAStar == byDStar);
+      if (byDStar) {
+        ++found;
+        assert(path.front() == start && path.back() == goal);
+        assert(sameCost(astar.getLastPathCost(), dstar.getPathCost()));
+      }
+    }
+    assert(found > 10);
+    std::cout << "✓ Plan matches A* test passed" << std::endl;
+  }
+
+  static void testRepairAfterEdits() {
+    GameMap map = makeGrassland(64, 64);
+    map.rebuildClearance();
+    GridPathfinder astar;
+    astar.setJumpPointSearch(false); // 展開数はタイル単位の A* と比べる
+    IncrementalPathfinder dstar;
+    std::vector<Position> path;
+    const Position start(2.5f, 32.5f);
+    const Position goal(61.5f, 32.5f);
+    assert(dstar.plan(map, start, goal, 0.3f, path));
+    const size_t planExpanded = dstar.getLastExpansionCount();
+    assert(sameCost(dstar.getPathCost(), 59.0f));
+
+    // 経路から遠い1タイルの変更: 周りの数タイルを見直すだけ
+    map.setTile(10, 5, TerrainType::Water);
+    assert(dstar.repair(map, start, path));
+    assert(sameCost(dstar.getPathCost(), 59.0f));
+    assert(dstar.getLastUpdatedTileCount() <= 49);
+    assert(dstar.getLastExpansionCount() == 0);
+
+    // 開けた地形で経路を横切る壁: 経路が通っていたタイルを広く見直す
+    // ことになり、最初から探すより高くつく。plan の展開数で打ち切る
+    for (int y = 26; y <= 38; ++y) {
+      map.setTile(32, y, TerrainType::Water);
+    }
+    assert(!dstar.repair(map, start, path));
+    assert(dstar.wasLastRepairAbandoned() && !dstar.hasPlan());
+    assert(dstar.getLastExpansionCount() <= std::max<size_t>(planExpanded, 64));
+    assert(astar.findPath(map, start, goal, 0.3f, path));
+    std::cout << "  plan " << planExpanded << " tiles, repair after wall "
+              << "abandoned at " << dstar.getLastExpansionCount()
+              << " tiles (A* from scratch " << astar.getLastExpansionCount()
+              << ")" << std::endl;
+    assert(dstar.plan(map, start, goal, 0.3f, path));
+    assert(sameCost(dstar.getPathCost(), astar.getLastPathCost()));
+
+    // 進んだ先から（地形の変更なし）: 目標側の結果をそのまま使う
+    const Position moved(20.5f, 30.5f);
+    assert(dstar.repair(map, moved, path));
+    assert(path.front() == moved);
+    assert(astar.findPath(map, moved, goal, 0.3f, path));
+    assert(sameCost(dstar.getPathCost(), astar.getLastPathCost()));
+    assert(dstar.getLastUpdatedTileCount() == 0);
+
+    // 壁を取り除けば直線に戻る
+    for (int y = 26; y <= 38; ++y) {
+      map.setTile(32, y, TerrainType::Grassland);
+    }
+    const Position back(20.5f, 32.5f);
+    assert(dstar.repair(map, back, path));
+    assert(sameCost(dstar.getPathCost(), 41.0f));
+
+    std::cout << "✓ Repair after edits test passed" << std::endl;
+  }
+
+  static void testLocalRepairBeatsFreshSearch() {
+    // 目標の手前に長い水の壁（上の端だけ開いている）。最初から探すと
+    // 壁の手前を広く展開する
+    GameMap map = makeGrassland(64, 64);
+    for (int y = 0; y < 60; ++y) {
+      map.setTile(40, y, TerrainType::Water);
+    }
+    map.rebuildClearance();
+    GridPathfinder astar;
+    astar.setJumpPointSearch(false);
+    IncrementalPathfinder dstar;
+    std::vector<Position> path;
+    const Position goal(50.5f, 20.5f);
+    assert(dstar.plan(map, Position(10.5f, 20.5f), goal, 0.3f, path));
+
+    // 少し進んだユニットの目の前を塞ぐ。見直すのは塞いだ所の周りだけ
+    const Position moved(10.5f, 30.5f);
+    assert(dstar.repair(map, moved, path));
+    for (int x = 8; x <= 13; ++x) {
+      map.setTile(x, 33, TerrainType::Water);
+    }
+    assert(dstar.repair(map, moved, path));
+    assert(!dstar.wasLastRepairAbandoned());
+    assert(astar.findPath(map, moved, goal, 0.3f, path));
+    assert(sameCost(dstar.getPathCost(), astar.getLastPathCost()));
+    std::cout << "  local block near the unit: repair "
+              << dstar.getLastExpansionCount() << " tiles (A* from scratch "
+              << astar.getLastExpansionCount() << ")" << std::endl;
+    assert(dstar.getLastExpansionCount() * 4 <
+           astar.getLastExpansionCount());
+    std::cout << "✓ Local repair test passed" << std::endl;
+  }
+
+  static void testChangeJournal() {
+    GameMap map = makeGrassland(8, 8);
+    const uint64_t epoch = map.getTerrainEpoch();
+    std::vector<uint32_t> changes;
+    assert(map.getTileChangesSince(epoch, changes) && changes.empty());
+
+    map.setTile(3, 2, TerrainType::Forest);
+    map.setTile(3, 2, TerrainType::Forest); // 変化なしは記録しない
+    map.setTileBlocked(1, 1, true);
+    assert(map.getTileChangesSince(epoch, changes));
+    assert(changes.size() == 2 && changes[0] == 2 * 8 + 3 &&
+           changes[1] == 1 * 8 + 1);
+
+    // 記録より古い epoch は「すべて変わった」扱い
+    GameMap large = makeGrassland(128, 128);
+    changes.clear();
+    assert(!large.getTileChangesSince(0, changes));
+    assert(large.getTileChangesSince(large.getTerrainEpoch() - 100, changes));
+    assert(changes.size() == 100);
+    std::cout << "✓ Change journal test passed" << std::endl;
+  }
+
+  static void testUnitReroutesAroundNewWall() {
+    // x = 10 に水の壁（上側 y >= 15 だけ開いている）
+    GameMap map = makeGrassland(20, 20);
+    for (int y = 0; y < 15; ++y) {
+      map.setTile(10, y, TerrainType::Water);
+    }
+    map.rebuildClearance();
+    UnitStats stats(100, 100, 10, 10, 2.0f, 1.0f, 1.0f, 0.3f);
+    UnitList units = {std::make_shared<UnitEntity>(
+        1, "Unit", Position(5.5f, 5.5f), stats, 1)};
+    MovementUseCase movement(units, nullptr, &map);
+    const Position goal(15.5f, 5.5f);
+    assert(movement.moveUnitTo(1, goal));
+    assert(movement.getRouteWaypointCount(1) > 0);
+    assert(movement.getIncrementalRouteCount() == 0);
+    for (int frame = 0; frame < 20; ++frame) {
+      movement.updateMovements(0.05f);
+    }
+
+    // 上の隙間を塞ぎ、下に隙間を開ける。ユニットは下を回って着く
+    for (int y = 15; y < 20; ++y) {
+      map.setTile(10, y, TerrainType::Water);
+    }
+    for (int y = 0; y < 3; ++y) {
+      map.setTile(10, y, TerrainType::Grassland);
+    }
+    // 地形の変更で求め直した経路は D* Lite の探索状態を持ち、次の変更
+    // （遠くの1タイル）は修復で済ませる
+    movement.updateMovements(0.05f);
+    assert(movement.getIncrementalRouteCount() == 1);
+    map.setTile(18, 18, TerrainType::Forest);
+    for (int frame = 0; frame < 600; ++frame) {
+      movement.updateMovements(0.05f);
+      assert(map.isWalkable(units[0]->getPosition(), 0.3f));
+    }
+    assert(units[0]->getPosition() == goal);
+    assert(movement.getRouteWaypointCount(1) == 0);
+    assert(movement.getIncrementalRouteCount() == 0);
+    std::cout << "✓ Unit reroute test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_INCREMENTAL_PATH_TEST_H
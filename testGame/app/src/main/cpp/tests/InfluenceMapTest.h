@@ -0,0 +1,93 @@
+#ifndef SIMULATION_GAME_INFLUENCE_MAP_TEST_H
+#define SIMULATION_GAME_INFLUENCE_MAP_TEST_H
+
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/InfluenceMap.h"
+#include "../usecases/InfluenceMapUseCase.h"
+#include "TestFixtures.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 影響度マップのテスト
+ */
+class InfluenceMapTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running InfluenceMap tests..." << std::endl;
+    testIncrementalMatchesRebuild();
+    testEnemyInfluenceAndDecay();
+    std::cout << "InfluenceMap tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  static bool sameMaps(const InfluenceMap &lhs, const InfluenceMap &rhs,
+                       int faction) {
+    for (int y = 0; y < lhs.getRows(); ++y) {
+      for (int x = 0; x < lhs.getColumns(); ++x) {
+        if (std::fabs(lhs.getInfluence(faction, x, y) -
+                      rhs.getInfluence(faction, x, y)) > 1e-3f) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  static void testIncrementalMatchesRebuild() {
+    ReverseJobSystem jobs(3);
+    InfluenceMapConfig config;
+    config.memoryHalfLife = 0.0f; // 記憶なし（現在値そのもの）
+    InfluenceMapUseCase incremental(0.0f, 0.0f, 40.0f, 20.0f, &jobs, config);
+
+    UnitList units;
+    for (int i = 0; i < 12; ++i) {
+      units.push_back(makeUnit(i, 2.0f + 3.0f * i, 5.0f + (i % 3) * 4.0f,
+                               i % 2 == 0 ? 1 : 2));
+    }
+    incremental.update(units, 0.1f);
+
+    // 1体だけ移動、1体が除去される（増分更新の範囲）
+    units[3]->updatePosition(Position(30.0f, 15.0f));
+    units.erase(units.begin() + 7);
+    incremental.update(units, 0.1f);
+
+    InfluenceMapUseCase fresh(0.0f, 0.0f, 40.0f, 20.0f, nullptr, config);
+    fresh.update(units, 0.1f);
+    assert(sameMaps(incremental.getMap(), fresh.getMap(), 1));
+    assert(sameMaps(incremental.getMap(), fresh.getMap(), 2));
+  }
+
+  static void testEnemyInfluenceAndDecay() {
+    InfluenceMapConfig config;
+    config.memoryHalfLife = 1.0f;
+    InfluenceMapUseCase useCase(0.0f, 0.0f, 20.0f, 20.0f, nullptr, config);
+
+    UnitList units;
+    units.push_back(makeUnit(1, 5.0f, 5.0f, 1));
+    units.push_back(makeUnit(2, 15.0f, 15.0f, 2));
+    useCase.update(units, 0.0f);
+
+    const InfluenceMap &map = useCase.getMap();
+    const float own = map.influenceAt(1, 5.0f, 5.0f);
+    assert(own > 0.0f);
+    assert(map.enemyInfluenceAt(1, 5.0f, 5.0f) == 0.0f);
+    assert(map.enemyInfluenceAt(1, 15.0f, 15.0f) > 0.0f);
+    assert(map.influenceAt(3, 5.0f, 5.0f) == 0.0f); // 未知の陣営
+
+    // 敵が倒れても影響は半減期に従って残る
+    const float enemyBefore = map.influenceAt(2, 15.0f, 15.0f);
+    units.pop_back();
+    useCase.update(units, 1.0f);
+    const float enemyAfter = map.influenceAt(2, 15.0f, 15.0f);
+    assert(std::fabs(enemyAfter - enemyBefore * 0.5f) < 1e-4f);
+    assert(map.influenceAt(1, 5.0f, 5.0f) == own);
+  }
+};
+
+#endif // SIMULATION_GAME_INFLUENCE_MAP_TEST_H
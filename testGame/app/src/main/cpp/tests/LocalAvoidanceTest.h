@@ -0,0 +1,97 @@
+#ifndef SIMULATION_GAME_LOCAL_AVOIDANCE_TEST_H
+#define SIMULATION_GAME_LOCAL_AVOIDANCE_TEST_H
+
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/LocalAvoidance.h"
+#include "../usecases/MovementUseCase.h"
+#include "TestFixtures.h"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief ORCA による局所回避のテスト
+ */
+class LocalAvoidanceTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running LocalAvoidance tests..." << std::endl;
+    testHeadOnAgentsPassWithoutOverlap();
+    testParallelMatchesSerial();
+    std::cout << "LocalAvoidance tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  static void testHeadOnAgentsPassWithoutOverlap() {
+    UnitList units;
+    auto left = makeUnit(1, 0.0f, 0.0f, 1, 1.0f, 0.3f);
+    auto right = makeUnit(2, 4.0f, 0.05f, 1, 1.0f, 0.3f);
+    units.push_back(left);
+    units.push_back(right);
+    MovementUseCase movement(units);
+    assert(movement.moveUnitTo(1, Position(4.0f, 0.0f)));
+    assert(movement.moveUnitTo(2, Position(0.0f, 0.05f)));
+
+    float closest = left->getPosition().distanceTo(right->getPosition());
+    for (int step = 0; step < 200; ++step) {
+      movement.updateMovements(0.05f);
+      closest = std::min(closest,
+                         left->getPosition().distanceTo(right->getPosition()));
+    }
+    // 正面衝突せずにすれ違い、両者とも目標に着く
+    assert(closest >= 0.6f - 0.02f);
+    assert(left->getPosition().distanceTo(Position(4.0f, 0.0f)) < 0.05f);
+    assert(right->getPosition().distanceTo(Position(0.0f, 0.05f)) < 0.05f);
+    std::cout << "✓ Head-on avoidance test passed" << std::endl;
+  }
+
+  static void testParallelMatchesSerial() {
+    // 格子状に並んだエージェントが全員中心へ向かう
+    AvoidanceAgents agents;
+    for (int y = 0; y < 12; ++y) {
+      for (int x = 0; x < 12; ++x) {
+        const float px = static_cast<float>(x) * 0.5f;
+        const float py = static_cast<float>(y) * 0.5f;
+        agents.push(px, py, 0.0f, 0.0f, 2.75f - px, 2.75f - py, 0.2f, 1.0f,
+                    (x + y) % 5 != 0);
+      }
+    }
+    const size_t count = agents.size();
+
+    LocalAvoidance avoidance;
+    avoidance.build(agents);
+    std::vector<float> serialXs(count), serialYs(count);
+    avoidance.computeVelocities(0, count, 0.05f, serialXs.data(),
+                                serialYs.data());
+
+    std::vector<float> parallelXs(count), parallelYs(count);
+    ReverseJobSystem jobs(4);
+    const size_t perJob = (count + 3) / 4;
+    // 区間ごとに別の作業領域を使っても、使い回した作業領域と結果は同じ
+    avoidance.build(agents, 4);
+    jobs.parallelFor(4, [&](size_t job) {
+      const size_t begin = job * perJob;
+      const size_t end = std::min(count, begin + perJob);
+      avoidance.computeVelocities(begin, end, 0.05f, parallelXs.data(),
+                                  parallelYs.data(), job);
+    });
+
+    for (size_t i = 0; i < count; ++i) {
+      assert(serialXs[i] == parallelXs[i]);
+      assert(serialYs[i] == parallelYs[i]);
+      const float speedSq =
+          serialXs[i] * serialXs[i] + serialYs[i] * serialYs[i];
+      assert(speedSq <= 1.0f + 1e-3f);
+      if (!agents.movable[i]) {
+        assert(speedSq == 0.0f);
+      }
+    }
+    std::cout << "✓ Parallel avoidance test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_LOCAL_AVOIDANCE_TEST_H
@@ -0,0 +1,124 @@
+#ifndef SIMULATION_GAME_MOVE_RANGE_TEST_H
+#define SIMULATION_GAME_MOVE_RANGE_TEST_H
+
+#include "../domain/entities/GameMap.h"
+#include "../domain/services/MoveRange.h"
+#include "TestFixtures.h"
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+/**
+ * @brief 移動範囲（MoveRange）のテスト
+ */
+class MoveRangeTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running MoveRange tests..." << std::endl;
+    testOpenGround();
+    testTerrainCost();
+    testClearanceGap();
+    testSelectionLatency();
+    std::cout << "MoveRange tests passed!" << std::endl;
+  }
+
+private:
+  static bool near(float value, float expected) {
+    return std::fabs(value - expected) < 0.1f;
+  }
+
+  static void testOpenGround() {
+    GameMap map = makeGrassland(20, 20);
+    map.rebuildClearance();
+    MoveRange range;
+    const size_t reached =
+        range.compute(map, Position(10.5f, 10.5f), 3.0f, 0.1f);
+    assert(reached > 0 && reached == range.getReachedTiles().size());
+    assert(range.getCost(10, 10) == 0.0f);
+    assert(near(range.getCost(13, 10), 3.0f));
+    assert(!range.isReachable(14, 10));
+    assert(near(range.getCost(12, 12), 2.0f * 1.41421356f));
+    assert(!range.isReachable(13, 13));
+    assert(range.getCosts()[10 * 20 + 14] == MoveRange::kUnreached);
+
+    // 2回目は前回の結果を残さない
+    range.compute(map, Position(1.5f, 1.5f), 1.0f, 0.1f);
+    assert(!range.isReachable(10, 10) && range.isReachable(2, 1));
+    assert(range.getReachedTiles().size() == 5);
+    std::cout << "✓ Open ground range test passed" << std::endl;
+  }
+
+  static void testTerrainCost() {
+    GameMap map = makeGrassland(20, 20);
+    for (int y = 0; y < 20; ++y) {
+      map.setTile(12, y, TerrainType::Forest); // 入るのに 2 ポイント
+    }
+    map.rebuildClearance();
+    MoveRange range;
+    range.compute(map, Position(10.5f, 10.5f), 4.0f, 0.1f);
+    assert(near(range.getCost(12, 10), 3.0f));
+    assert(near(range.getCost(13, 10), 4.0f));
+    assert(near(range.getCost(8, 10), 2.0f));
+    assert(range.isReachable(6, 10) && !range.isReachable(14, 10));
+    std::cout << "✓ Terrain cost test passed" << std::endl;
+  }
+
+  static void testClearanceGap() {
+    // 水の壁に1タイルの隙間
+    GameMap map = makeGrassland(20, 20);
+    for (int y = 0; y < 20; ++y) {
+      if (y != 10) {
+        map.setTile(12, y, TerrainType::Water);
+      }
+    }
+    map.rebuildClearance();
+    MoveRange range;
+    range.compute(map, Position(10.5f, 10.5f), 5.0f, 0.1f);
+    assert(!range.isReachable(12, 9));
+    assert(range.isReachable(12, 10) && range.isReachable(14, 10));
+
+    // 隙間より大きなユニットは通れない
+    range.compute(map, Position(10.5f, 10.5f), 5.0f, 0.6f);
+    assert(!range.isReachable(12, 10) && !range.isReachable(14, 10));
+    assert(range.isReachable(9, 10));
+
+    // クリアランス層が古くても、タイル中心での判定で同じ結果になる
+    map.setTile(0, 0, TerrainType::Water);
+    assert(!map.isClearanceCurrent());
+    range.compute(map, Position(10.5f, 10.5f), 5.0f, 0.6f);
+    assert(!range.isReachable(12, 10) && range.isReachable(9, 10));
+    std::cout << "✓ Clearance gap test passed" << std::endl;
+  }
+
+  static void testSelectionLatency() {
+    // 128x128 のマップに森を散らし、選択のたびに範囲を求める
+    GameMap map = makeGrassland(128, 128);
+    for (int y = 0; y < 128; ++y) {
+      for (int x = 0; x < 128; ++x) {
+        if ((x * 7 + y * 13) % 11 == 0) {
+          map.setTile(x, y, TerrainType::Forest);
+        }
+      }
+    }
+    map.rebuildClearance();
+    MoveRange range;
+    constexpr int kTaps = 200;
+    size_t reached = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int tap = 0; tap < kTaps; ++tap) {
+      const float x = 20.5f + static_cast<float>(tap % 80);
+      reached += range.compute(map, Position(x, 64.5f), 12.0f, 0.1f);
+    }
+    const double averageMs = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count() /
+                             kTaps;
+    std::cout << "  range 12 on 128x128: " << reached / kTaps
+              << " tiles, " << averageMs << " ms per query" << std::endl;
+    assert(averageMs < 1.0);
+    std::cout << "✓ Selection latency test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_MOVE_RANGE_TEST_H
@@ -0,0 +1,123 @@
+#ifndef SIMULATION_GAME_MOVEMENT_FIELD_TEST_H
+#define SIMULATION_GAME_MOVEMENT_FIELD_TEST_H
+
+#include "../domain/entities/GameMap.h"
+#include "../domain/services/MovementField.h"
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+/**
+ * @brief 障害物インデックス（MovementField）と GameMap の通行・クリアランス
+ *        レイヤーのテスト
+ */
+class MovementFieldTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running MovementField tests..." << std::endl;
+    testPointAndSegmentQueries();
+    testIndexMatchesBruteForce();
+    testRasterizeAndClearance();
+    std::cout << "MovementField tests passed!" << std::endl;
+  }
+
+private:
+  static void testPointAndSegmentQueries() {
+    MovementField field(0.0f, 0.0f, 20.0f, 20.0f);
+    field.addCircleObstacle(Position(10.0f, 10.0f), 1.0f);
+    assert(field.isWalkable(Position(5.0f, 5.0f)));
+    assert(!field.isWalkable(Position(10.5f, 10.0f)));
+    assert(field.isWalkable(Position(11.5f, 10.0f)));
+    assert(!field.isWalkable(Position(11.5f, 10.0f), 0.6f)); // 半径込み
+    assert(!field.isWalkable(Position(-1.0f, 5.0f)));       // 範囲外
+
+    // 端点はどちらも通れるが、途中で障害物を横切る
+    const Position west(5.0f, 10.0f);
+    const Position east(15.0f, 10.0f);
+    assert(!field.isSegmentClear(west, east));
+    assert(field.isSegmentClear(west.moveBy(0, 2), east.moveBy(0, 2)));
+    assert(!field.isSegmentClear(west.moveBy(0, 1.5f), east.moveBy(0, 1.5f),
+                                 0.6f));
+    std::cout << "✓ Point and segment query test passed" << std::endl;
+  }
+
+  static void testIndexMatchesBruteForce() {
+    MovementField field(0.0f, 0.0f, 100.0f, 100.0f);
+    std::mt19937 random(11);
+    std::uniform_real_distribution<float> coordinate(0.0f, 100.0f);
+    std::uniform_real_distribution<float> radius(0.2f, 3.0f);
+    for (int i = 0; i < 500; ++i) {
+      field.addCircleObstacle(Position(coordinate(random), coordinate(random)),
+                              radius(random));
+    }
+
+    size_t mismatches = 0;
+    size_t blocked = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20000; ++i) {
+      const Position p(coordinate(random), coordinate(random));
+      const float clearance = 0.3f;
+      bool expected = true;
+      for (const auto &o : field.getObstacles()) {
+        if (p.distanceTo(o.center) < o.radius + clearance) {
+          expected = false;
+          break;
+        }
+      }
+      const bool walkable = field.isWalkable(p, clearance);
+      mismatches += walkable != expected ? 1 : 0;
+      blocked += walkable ? 0 : 1;
+    }
+    const double ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+    std::cout << "  500 obstacles, 20000 queries (with brute-force check): "
+              << blocked << " blocked, " << ms << " ms" << std::endl;
+    assert(mismatches == 0);
+    std::cout << "✓ Index vs brute force test passed" << std::endl;
+  }
+
+  static void testRasterizeAndClearance() {
+    GameMap map(10, 10, 1.0f, 0.0f, 0.0f);
+    for (int y = 0; y < 10; ++y) {
+      for (int x = 0; x < 10; ++x) {
+        map.setTile(x, y, TerrainType::Grassland);
+      }
+    }
+    map.setTile(0, 9, TerrainType::Water);
+    assert(!map.isClearanceCurrent());
+
+    MovementField field(0.0f, 0.0f, 10.0f, 10.0f);
+    field.addCircleObstacle(Position(5.0f, 5.0f), 0.4f); // 4 タイルに掛かる
+    const uint64_t epoch = map.getTerrainEpoch();
+    assert(field.rasterizeInto(map) == 4);
+    assert(map.getTerrainEpoch() > epoch); // 経路のキャッシュは無効になる
+    assert(map.isClearanceCurrent());
+
+    // 地形と障害物は同じ通行レイヤーで判定される
+    assert(map.isTileBlocked(4, 4) && map.isTileBlocked(5, 5));
+    assert(!map.isTileWalkable(4, 4) && !map.isTileWalkable(0, 9));
+    assert(!map.isWalkable(Position(4.5f, 4.5f)));
+    assert(!map.isWalkable(Position(3.5f, 4.5f), 0.6f));
+    assert(map.isWalkable(Position(2.5f, 2.5f), 0.4f));
+
+    // クリアランス：歩行不能タイルは 0、隣接タイルは半タイル、
+    // 障害物から離れたタイルはマップの端までの距離で決まる
+    assert(map.getTileClearance(4, 4) == 0.0f);
+    assert(std::fabs(map.getTileClearance(3, 4) - 0.5f) < 1e-5f);
+    assert(std::fabs(map.getTileClearance(1, 8) - std::sqrt(0.5f)) < 1e-5f);
+    assert(std::fabs(map.getTileClearance(1, 1) - 1.5f) < 1e-5f);
+    // 斜め方向は障害物タイルの角までの距離（端までの 2.5 より近い）
+    assert(std::fabs(map.getTileClearance(2, 2) - std::sqrt(2.0f) * 1.5f) <
+           1e-5f);
+
+    // 障害物を取り除けばクリアランスは古くなる
+    map.setTileBlocked(4, 4, false);
+    assert(!map.isClearanceCurrent() && map.isTileWalkable(4, 4));
+    std::cout << "✓ Rasterize and clearance test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_MOVEMENT_FIELD_TEST_H
@@ -0,0 +1,124 @@
+#ifndef SIMULATION_GAME_MOVEMENT_PATH_TEST_H
+#define SIMULATION_GAME_MOVEMENT_PATH_TEST_H
+
+#include "../domain/entities/GameMap.h"
+#include "../domain/entities/UnitEntity.h"
+#include "../usecases/MovementUseCase.h"
+#include "TestFixtures.h"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 移動命令の経路検証（検証済みの経路は毎フレーム再検証しない）のテスト
+ */
+class MovementPathTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running MovementPath tests..." << std::endl;
+    testPathIsValidatedOnce();
+    testTerrainChangeRevalidates();
+    testRetargetRevalidates();
+    testCrowdDetourKeepsValidatedPaths();
+    std::cout << "MovementPath tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  static void testPathIsValidatedOnce() {
+    GameMap map = makeGrassland(10, 10);
+    UnitList units = {makeUnit(1, 1.5f, 5.5f)};
+    MovementUseCase movement(units, nullptr, &map);
+    assert(movement.moveUnitTo(1, Position(8.5f, 5.5f)));
+    assert(movement.getPathValidationCount() == 1);
+
+    for (int frame = 0; frame < 200; ++frame) {
+      movement.updateMovements(0.05f);
+    }
+    assert(units[0]->getPosition() == Position(8.5f, 5.5f));
+    assert(movement.getPathValidationCount() == 1);
+    std::cout << "✓ Validate-once test passed" << std::endl;
+  }
+
+  static void testTerrainChangeRevalidates() {
+    GameMap map = makeGrassland(10, 10);
+    UnitList units = {makeUnit(1, 1.5f, 5.5f)};
+    MovementUseCase movement(units, nullptr, &map);
+    assert(movement.moveUnitTo(1, Position(8.5f, 5.5f)));
+    movement.updateMovements(0.05f);
+
+    // 移動中に経路上へ水を置くと、次のフレームで検証し直して手前で止まる
+    for (int y = 0; y < 10; ++y) {
+      map.setTile(6, y, TerrainType::Water);
+    }
+    for (int frame = 0; frame < 200; ++frame) {
+      movement.updateMovements(0.05f);
+    }
+    assert(movement.getPathValidationCount() == 2);
+    assert(units[0]->getPosition().getX() < 6.0f);
+    assert(map.isWalkable(units[0]->getPosition(), 0.1f));
+    std::cout << "✓ Terrain change revalidation test passed" << std::endl;
+  }
+
+  static void testRetargetRevalidates() {
+    GameMap map = makeGrassland(10, 10);
+    UnitList units = {makeUnit(1, 1.5f, 1.5f)};
+    MovementUseCase movement(units, nullptr, &map);
+    assert(movement.moveUnitTo(1, Position(1.5f, 8.5f)));
+    movement.updateMovements(0.05f);
+
+    // MovementUseCase を通さずに目標が変わった場合も検証される
+    units[0]->setTargetPosition(Position(8.5f, 1.5f));
+    movement.updateMovements(0.05f);
+    assert(movement.getPathValidationCount() == 2);
+    movement.updateMovements(0.05f);
+    assert(movement.getPathValidationCount() == 2);
+    std::cout << "✓ Retarget revalidation test passed" << std::endl;
+  }
+
+  static void testCrowdDetourKeepsValidatedPaths() {
+    // 16 体の密集した部隊が、水の壁を回り込んで同じ地点へ向かう
+    GameMap map = makeGrassland(20, 12);
+    for (int y = 0; y < 9; ++y) {
+      map.setTile(8, y, TerrainType::Water);
+    }
+    UnitList units;
+    for (int row = 0; row < 4; ++row) {
+      for (int column = 0; column < 4; ++column) {
+        units.push_back(makeUnit(static_cast<int>(units.size()) + 1,
+                                 2.5f + 0.6f * static_cast<float>(column),
+                                 2.5f + 0.6f * static_cast<float>(row), 1,
+                                 1.0f, 0.25f));
+      }
+    }
+    MovementUseCase movement(units, nullptr, &map);
+    for (const auto &unit : units) {
+      assert(movement.moveUnitTo(unit->getId(), Position(14.5f, 3.5f)));
+      assert(movement.getRouteWaypointCount(unit->getId()) > 1);
+    }
+    const size_t ordered = movement.getPathValidationCount();
+    for (int frame = 0; frame < 1200; ++frame) {
+      movement.updateMovements(0.05f);
+    }
+
+    // 押し合いで逸れるたびに検証・探し直しをすると、それぞれ約 9500 回・
+    // 約 150 回になる（直線の近くへの押し出しは検証を残し、探し直しは
+    // ユニットごとに間隔を空ける）
+    const size_t validations = movement.getPathValidationCount() - ordered;
+    std::cout << "  " << units.size() << " units: " << validations
+              << " validations, " << movement.getRouteReplanCount()
+              << " replans" << std::endl;
+    assert(validations < 1000);
+    assert(movement.getRouteReplanCount() < 50);
+    for (const auto &unit : units) {
+      assert(unit->getPosition().getX() > 9.0f);
+      assert(unit->getPosition().distanceTo(Position(14.5f, 3.5f)) < 2.0f);
+      assert(map.isWalkable(unit->getPosition(), 0.25f));
+    }
+    std::cout << "✓ Crowd detour validation test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_MOVEMENT_PATH_TEST_H
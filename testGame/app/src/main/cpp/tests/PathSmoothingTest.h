@@ -0,0 +1,361 @@
+#ifndef SIMULATION_GAME_PATH_SMOOTHING_TEST_H
+#define SIMULATION_GAME_PATH_SMOOTHING_TEST_H
+
+#include "../domain/entities/GameMap.h"
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/GridPathfinder.h"
+#include "../domain/services/PathSmoother.h"
+#include "../domain/services/RectNavGraph.h"
+#include "../usecases/MovementUseCase.h"
+#include "TestFixtures.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * @brief タイル経路探索（GridPathfinder）と糸引きによる経由点の間引き
+ *        （PathSmoother）、MovementUseCase の迂回経路のテスト
+ */
+class PathSmoothingTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running PathSmoothing tests..." << std::endl;
+    testPathAroundWall();
+    testSmoothingKeepsTerrainChoice();
+    testWaypointReduction();
+    testJumpPointsMatchAStar();
+    testTileClassesCachedPerRadius();
+    testUnitFollowsRoute();
+    testUnitRoutesUseJumpPoints();
+    std::cout << "PathSmoothing tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  // x = 10 に水の壁（上側 y >= 15 だけ開いている）
+  static GameMap makeWallMap() {
+    GameMap map = makeGrassland(20, 20);
+    for (int y = 0; y < 15; ++y) {
+      map.setTile(10, y, TerrainType::Water);
+    }
+    map.rebuildClearance();
+    return map;
+  }
+
+  static bool allSegmentsWalkable(const GameMap &map,
+                                  const std::vector<Position> &path,
+                                  float radius) {
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+      if (map.clipMovementRaycast(path[i], path[i + 1], radius)
+              .hitBlocking) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static void testPathAroundWall() {
+    GameMap map = makeWallMap();
+    GridPathfinder pathfinder;
+    std::vector<Position> path;
+    const Position start(5.5f, 5.5f);
+    const Position goal(15.5f, 5.5f);
+    assert(pathfinder.findPath(map, start, goal, 0.3f, path));
+    assert(path.front() == start && path.back() == goal);
+    assert(pathfinder.getLastExpansionCount() > 0);
+    const size_t rawCount = path.size();
+    assert(rawCount > 20); // 壁の端まで上って下りる
+
+    const size_t removed = PathSmoother::smooth(map, 0.3f, path);
+    assert(removed == rawCount - path.size());
+    assert(path.front() == start && path.back() == goal);
+    assert(path.size() <= 4);
+    assert(allSegmentsWalkable(map, path, 0.3f));
+    std::cout << "  around wall: " << rawCount << " -> " << path.size()
+              << " waypoints" << std::endl;
+
+    // 壁で閉じれば経路はない
+    for (int y = 15; y < 20; ++y) {
+      map.setTile(10, y, TerrainType::Water);
+    }
+    map.rebuildClearance();
+    assert(!pathfinder.findPath(map, start, goal, 0.3f, path));
+    assert(path.empty());
+    std::cout << "✓ Path around wall test passed" << std::endl;
+  }
+
+  static void testSmoothingKeepsTerrainChoice() {
+    // 中央の森（速度半分）は迂回したほうが早い。間引いても森には入らない
+    GameMap map = makeGrassland(20, 20);
+    for (int y = 6; y < 14; ++y) {
+      for (int x = 8; x < 12; ++x) {
+        map.setTile(x, y, TerrainType::Forest);
+      }
+    }
+    map.rebuildClearance();
+    GridPathfinder pathfinder;
+    std::vector<Position> path;
+    assert(pathfinder.findPath(map, Position(3.5f, 10.5f),
+                               Position(16.5f, 10.5f), 0.1f, path));
+    PathSmoother::smooth(map, 0.1f, path);
+    assert(path.size() >= 3); // 森の角を回る
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+      assert(PathSmoother::canShortcut(map, path[i], path[i + 1], 0.1f,
+                                       1.0f));
+    }
+    std::cout << "✓ Terrain choice test passed" << std::endl;
+  }
+
+  static void testWaypointReduction() {
+    // 柱を並べたマップで多数の経路を求め、間引きの効果を見る
+    GameMap map = makeGrassland(64, 64);
+    for (int y = 4; y < 60; y += 8) {
+      for (int x = 4; x < 60; x += 8) {
+        for (int dy = 0; dy < 3; ++dy) {
+          for (int dx = 0; dx < 3; ++dx) {
+            map.setTile(x + dx, y + dy, TerrainType::Water);
+          }
+        }
+      }
+    }
+    map.rebuildClearance();
+    GridPathfinder pathfinder;
+    GridPathfinder baseline;
+    baseline.setJumpPointSearch(false);
+    std::vector<Position> path;
+    std::vector<Position> baselinePath;
+    size_t rawTotal = 0;
+    size_t smoothTotal = 0;
+    size_t expanded = 0;
+    size_t baselineExpanded = 0;
+    for (int i = 0; i < 40; ++i) {
+      const Position start(1.5f + static_cast<float>(i % 8), 1.5f);
+      const Position goal(62.5f - static_cast<float>(i % 5),
+                          62.5f - static_cast<float>(i % 7));
+      assert(pathfinder.findPath(map, start, goal, 0.4f, path));
+      assert(baseline.findPath(map, start, goal, 0.4f, baselinePath));
+      assert(std::fabs(pathfinder.getLastPathCost() -
+                       baseline.getLastPathCost()) < 1e-3f);
+      expanded += pathfinder.getLastExpansionCount();
+      baselineExpanded += baseline.getLastExpansionCount();
+      rawTotal += path.size();
+      PathSmoother::smooth(map, 0.4f, path);
+      smoothTotal += path.size();
+      assert(allSegmentsWalkable(map, path, 0.4f));
+    }
+    std::cout << "  40 paths on 64x64: " << rawTotal << " -> " << smoothTotal
+              << " waypoints, " << expanded << " nodes expanded (A* "
+              << baselineExpanded << ")" << std::endl;
+    assert(smoothTotal * 4 < rawTotal);
+    assert(expanded * 4 < baselineExpanded);
+    std::cout << "✓ Waypoint reduction test passed" << std::endl;
+  }
+
+  static void testJumpPointsMatchAStar() {
+    // 森・山・水が混ざった地形でも、跳び越しは一様な範囲だけなので
+    // コストは A* と同じ
+    std::mt19937 random(41);
+    std::uniform_int_distribution<int> tile(0, 47);
+    std::uniform_int_distribution<int> patch(1, 6);
+    const TerrainType kinds[] = {TerrainType::Forest, TerrainType::Mountain,
+                                 TerrainType::Water, TerrainType::River};
+    GridPathfinder pathfinder;
+    GridPathfinder baseline;
+    baseline.setJumpPointSearch(false);
+    std::vector<Position> path;
+    std::vector<Position> baselinePath;
+    size_t expanded = 0;
+    size_t baselineExpanded = 0;
+    int found = 0;
+    for (int round = 0; round < 4; ++round) {
+      GameMap map = makeGrassland(48, 48);
+      for (int i = 0; i < 40; ++i) {
+        const int x0 = tile(random);
+        const int y0 = tile(random);
+        const int w = patch(random);
+        const int h = patch(random);
+        for (int y = y0; y < std::min(48, y0 + h); ++y) {
+          for (int x = x0; x < std::min(48, x0 + w); ++x) {
+            map.setTile(x, y, kinds[(i + round) % 4]);
+          }
+        }
+      }
+      map.rebuildClearance();
+      for (int i = 0; i < 30; ++i) {
+        const Position start(tile(random) + 0.5f, tile(random) + 0.5f);
+        const Position goal(tile(random) + 0.5f, tile(random) + 0.5f);
+        const float radius = i % 2 == 0 ? 0.3f : 0.8f;
+        const bool byJumps =
+            pathfinder.findPath(map, start, goal, radius, path);
+        assert(byJumps ==
+               baseline.findPath(map, start, goal, radius, baselinePath));
+        if (!byJumps) {
+          continue;
+        }
+        ++found;
+        assert(std::fabs(pathfinder.getLastPathCost() -
+                         baseline.getLastPathCost()) < 1e-3f);
+        // 補った経路は隣り合うタイルの列
+        for (size_t k = 2; k + 1 < path.size(); ++k) {
+          assert(std::fabs(path[k].getX() - path[k - 1].getX()) <= 1.0f &&
+                 std::fabs(path[k].getY() - path[k - 1].getY()) <= 1.0f);
+        }
+        expanded += pathfinder.getLastExpansionCount();
+        baselineExpanded += baseline.getLastExpansionCount();
+      }
+      // 地形を変えても分類は変更の周りだけ作り直され、結果は一致する
+      // （2回目以降はクリアランス層の状態が同じなので部分的に作り直す）
+      for (int edit = 0; edit < 3; ++edit) {
+        map.setTile(tile(random), tile(random), kinds[edit]);
+        map.setTile(tile(random), tile(random), TerrainType::Grassland);
+        const Position start(tile(random) + 0.5f, tile(random) + 0.5f);
+        const Position goal(tile(random) + 0.5f, tile(random) + 0.5f);
+        const bool byJumps =
+            pathfinder.findPath(map, start, goal, 0.3f, path);
+        assert(byJumps ==
+               baseline.findPath(map, start, goal, 0.3f, baselinePath));
+        if (byJumps) {
+          assert(std::fabs(pathfinder.getLastPathCost() -
+                           baseline.getLastPathCost()) < 1e-3f);
+        }
+      }
+      // 部分的に作り直した分類の一様タイルの割合も作り直しと一致する
+      GridPathfinder fresh;
+      assert(pathfinder.getUniformTileRatio(map, 0.3f) ==
+             fresh.getUniformTileRatio(map, 0.3f));
+    }
+    assert(found > 40);
+    std::cout << "  mixed terrain: " << found << " paths, " << expanded
+              << " nodes expanded (A* " << baselineExpanded << ")"
+              << std::endl;
+    std::cout << "✓ Jump points match A* test passed" << std::endl;
+  }
+
+  static void testTileClassesCachedPerRadius() {
+    GameMap map = makeGrassland(128, 128);
+    for (int y = 0; y < 120; ++y) {
+      map.setTile(64, y, TerrainType::Water);
+    }
+    map.rebuildClearance();
+    const size_t tiles = 128 * 128;
+    GridPathfinder pathfinder;
+    GridPathfinder baseline;
+    baseline.setJumpPointSearch(false);
+    std::vector<Position> path;
+    const Position start(10.5f, 10.5f);
+    const Position goal(120.5f, 10.5f);
+    const float radii[] = {0.3f, 0.45f, 0.8f};
+
+    // 半径ごとに1回だけ分類する。交互に探しても作り直さない
+    for (int round = 0; round < 5; ++round) {
+      for (float radius : radii) {
+        assert(pathfinder.findPath(map, start, goal, radius, path));
+      }
+    }
+    assert(pathfinder.getClassifiedTileCount() == 3 * tiles);
+
+    // 地形の変更は、控えていた半径の分類にも変更の周りだけ反映する
+    map.setTile(30, 10, TerrainType::Forest);
+    map.rebuildClearance();
+    for (float radius : radii) {
+      assert(pathfinder.findPath(map, start, goal, radius, path));
+      assert(baseline.findPath(map, start, goal, radius, path));
+      assert(std::fabs(pathfinder.getLastPathCost() -
+                       baseline.getLastPathCost()) < 1e-3f);
+    }
+    assert(pathfinder.getClassifiedTileCount() < 3 * tiles + 3 * 100);
+
+    // 使用中と控えを合わせて4つを超える半径を使うと、最も長く使って
+    // いないもの（ここでは 0.3）から作り直す
+    assert(pathfinder.findPath(map, start, goal, 0.2f, path));
+    assert(pathfinder.findPath(map, start, goal, 0.6f, path));
+    const size_t beforeEvicted = pathfinder.getClassifiedTileCount();
+    assert(pathfinder.findPath(map, start, goal, 0.3f, path));
+    assert(pathfinder.getClassifiedTileCount() == beforeEvicted + tiles);
+    std::cout << "✓ Tile classes per radius test passed" << std::endl;
+  }
+
+  static void testUnitFollowsRoute() {
+    GameMap map = makeWallMap();
+    UnitStats stats(100, 100, 10, 10, 2.0f, 1.0f, 1.0f, 0.3f);
+    UnitList units = {std::make_shared<UnitEntity>(
+        1, "Unit", Position(5.5f, 5.5f), stats, 1)};
+    MovementUseCase movement(units, nullptr, &map);
+    const Position goal(15.5f, 5.5f);
+    assert(movement.moveUnitTo(1, goal));
+    const size_t waypoints = movement.getRouteWaypointCount(1);
+    assert(waypoints >= 2 && waypoints <= 3);
+    assert(units[0]->getTargetPosition() != goal);
+
+    // 経由点の切り替えでは地形を検証し直さず、待機にも戻らない
+    for (int frame = 0; frame < 400; ++frame) {
+      movement.updateMovements(0.05f);
+      if (units[0]->getPosition() != goal) {
+        assert(units[0]->getState() == UnitState::MOVING);
+      }
+    }
+    assert(units[0]->getPosition() == goal);
+    assert(units[0]->getState() == UnitState::IDLE);
+    assert(movement.getRouteWaypointCount(1) == 0);
+    assert(movement.getPathValidationCount() == 1);
+
+    // 直線で届く目標には経路を作らない
+    assert(movement.moveUnitTo(1, Position(17.5f, 2.5f)));
+    assert(movement.getRouteWaypointCount(1) == 0);
+    std::cout << "✓ Unit follows route test passed" << std::endl;
+  }
+
+  static void testUnitRoutesUseJumpPoints() {
+    // 開けた草原の長い壁: ナビゲーショングラフがあっても、一様なタイルが
+    // 多い地形の迂回経路は Jump Point Search で求める
+    GameMap map = makeGrassland(64, 64);
+    for (int y = 0; y < 56; ++y) {
+      map.setTile(32, y, TerrainType::Water);
+    }
+    map.rebuildClearance();
+    RectNavGraph graph;
+    graph.build(map, 0.3f);
+    UnitStats stats(100, 100, 10, 10, 2.0f, 1.0f, 1.0f, 0.3f);
+    UnitList units = {std::make_shared<UnitEntity>(
+        1, "Unit", Position(10.5f, 10.5f), stats, 1)};
+    MovementUseCase movement(units, nullptr, &map);
+    movement.setNavigationGraph(&graph);
+    GridPathfinder pathfinder;
+    assert(pathfinder.getUniformTileRatio(map, 0.3f) >=
+           MovementUseCase::kJumpPointMinUniformRatio);
+
+    const Position goal(54.5f, 10.5f);
+    assert(movement.moveUnitTo(1, goal));
+    assert(movement.getLastRouteBackend() ==
+           MovementUseCase::RouteBackend::JumpPoint);
+    assert(movement.getRouteWaypointCount(1) > 0);
+    assert(movement.getIncrementalRouteCount() == 0);
+    for (int frame = 0; frame < 2000; ++frame) {
+      movement.updateMovements(0.05f);
+    }
+    assert(units[0]->getPosition() == goal);
+
+    // 地形の境目ばかりの縞模様ではグラフに切り替える
+    for (int y = 0; y < 64; ++y) {
+      for (int x = 1; x < 64; x += 2) {
+        if (x != 33) {
+          map.setTile(x, y, TerrainType::Forest);
+        }
+      }
+    }
+    map.rebuildClearance();
+    assert(pathfinder.getUniformTileRatio(map, 0.3f) <
+           MovementUseCase::kJumpPointMinUniformRatio);
+    assert(movement.moveUnitTo(1, Position(10.5f, 10.5f)));
+    assert(movement.getLastRouteBackend() ==
+           MovementUseCase::RouteBackend::NavigationGraph);
+    std::cout << "✓ Unit routes use jump points test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_PATH_SMOOTHING_TEST_H
@@ -0,0 +1,298 @@
+#ifndef SIMULATION_GAME_RECT_NAV_GRAPH_TEST_H
+#define SIMULATION_GAME_RECT_NAV_GRAPH_TEST_H
+
+#include "../domain/entities/GameMap.h"
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/GridPathfinder.h"
+#include "../domain/services/PathSmoother.h"
+#include "../domain/services/RectNavGraph.h"
+#include "../usecases/MovementUseCase.h"
+#include "TestFixtures.h"
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * @brief 矩形分割のナビゲーショングラフ（RectNavGraph）の分割・探索・
+ *        部分的な作り直しのテスト
+ */
+class RectNavGraphTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running RectNavGraph tests..." << std::endl;
+    testDecomposition();
+    testFewerExpansionsThanTileSearch();
+    testIncrementalUpdate();
+    testUnitFollowsGraphRoute();
+    std::cout << "RectNavGraph tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  // 湖（水の正方形）と森を散らした地形
+  static GameMap makeLakeland(int size, int lakes, unsigned seed) {
+    GameMap map = makeGrassland(size, size);
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> corner(0, size - 8);
+    std::uniform_int_distribution<int> extent(2, 7);
+    for (int i = 0; i < lakes; ++i) {
+      const int x0 = corner(random);
+      const int y0 = corner(random);
+      const int w = extent(random);
+      const int h = extent(random);
+      const TerrainType terrain =
+          i % 4 == 0 ? TerrainType::Forest : TerrainType::Water;
+      for (int y = y0; y < y0 + h; ++y) {
+        for (int x = x0; x < x0 + w; ++x) {
+          map.setTile(x, y, terrain);
+        }
+      }
+    }
+    map.rebuildClearance();
+    return map;
+  }
+
+  // 通れるタイルはちょうど1つの矩形に属し、矩形の地形は一様で、
+  // ポータルは両側の矩形に登録されている
+  static void checkConsistency(const GameMap &map, const RectNavGraph &graph,
+                               float radius) {
+    size_t covered = 0;
+    const auto &rects = graph.getRects();
+    for (uint32_t id = 0; id < rects.size(); ++id) {
+      const RectNavGraph::Rect &rect = rects[id];
+      if (!rect.alive) {
+        continue;
+      }
+      for (int y = rect.minY; y <= rect.maxY; ++y) {
+        for (int x = rect.minX; x <= rect.maxX; ++x) {
+          assert(graph.getRectAt(x, y) == id);
+          assert(map.getTile(x, y) == rect.terrain);
+          ++covered;
+        }
+      }
+      for (uint32_t portalId : rect.portals) {
+        const RectNavGraph::Portal &portal = graph.getPortals()[portalId];
+        assert(portal.alive);
+        assert(portal.rects[0] == id || portal.rects[1] == id);
+      }
+    }
+    size_t passable = 0;
+    for (int y = 0; y < map.getHeight(); ++y) {
+      for (int x = 0; x < map.getWidth(); ++x) {
+        const bool usable =
+            map.isTilePassable(x, y, radius) &&
+            getTerrainProperties(map.getTile(x, y)).movementSpeedMultiplier >
+                0.0f;
+        assert(usable == (graph.getRectAt(x, y) != RectNavGraph::kNone));
+        passable += usable ? 1 : 0;
+      }
+    }
+    assert(covered == passable);
+    for (const RectNavGraph::Portal &portal : graph.getPortals()) {
+      if (!portal.alive) {
+        continue;
+      }
+      for (int side = 0; side < 2; ++side) {
+        const RectNavGraph::Rect &rect = rects[portal.rects[side]];
+        assert(rect.alive);
+        int x = 0;
+        int y = 0;
+        assert(map.worldToTile(portal.points[side], x, y));
+        assert(graph.getRectAt(x, y) == portal.rects[side]);
+      }
+      assert(portal.points[0].distanceTo(portal.points[1]) < 1.0f + 1e-4f);
+    }
+  }
+
+  static float pathLength(const std::vector<Position> &path) {
+    float length = 0.0f;
+    for (size_t i = 1; i < path.size(); ++i) {
+      length += path[i - 1].distanceTo(path[i]);
+    }
+    return length;
+  }
+
+  static void testDecomposition() {
+    // 開けた草原は1つの矩形
+    GameMap open = makeGrassland(32, 32);
+    open.rebuildClearance();
+    RectNavGraph graph;
+    graph.build(open, 0.3f);
+    assert(graph.getRectCount() == 1 && graph.getPortalCount() == 0);
+
+    // 中央の森の帯で3つに分かれ、境界は 8 タイルごとのポータル
+    for (int y = 0; y < 32; ++y) {
+      for (int x = 12; x < 20; ++x) {
+        open.setTile(x, y, TerrainType::Forest);
+      }
+    }
+    graph.build(open, 0.3f);
+    assert(graph.getRectCount() == 3 && graph.getPortalCount() == 8);
+    checkConsistency(open, graph, 0.3f);
+
+    GameMap lakes = makeLakeland(64, 16, 3);
+    graph.build(lakes, 0.4f);
+    checkConsistency(lakes, graph, 0.4f);
+    std::cout << "  64x64 lakes: " << graph.getRectCount() << " rects, "
+              << graph.getPortalCount() << " portals" << std::endl;
+    std::cout << "✓ Decomposition test passed" << std::endl;
+  }
+
+  static void testFewerExpansionsThanTileSearch() {
+    // 開けた地形（湖は少なめ）の長い経路
+    GameMap map = makeLakeland(256, 16, 11);
+    const float radius = 0.4f;
+    RectNavGraph graph;
+    graph.build(map, radius);
+    GridPathfinder astar;
+    astar.setJumpPointSearch(false); // タイルを1歩ずつ展開する A* と比べる
+    std::mt19937 random(17);
+    std::uniform_int_distribution<int> tile(0, 255);
+    std::vector<Position> byGraph;
+    std::vector<Position> byTiles;
+    size_t graphExpanded = 0;
+    size_t tileExpanded = 0;
+    float graphLength = 0.0f;
+    float tileLength = 0.0f;
+    int found = 0;
+    for (int i = 0; i < 60; ++i) {
+      const Position start(tile(random) + 0.5f, tile(random) + 0.5f);
+      const Position goal(tile(random) + 0.5f, tile(random) + 0.5f);
+      if (graph.getRectAt(static_cast<int>(start.getX()),
+                          static_cast<int>(start.getY())) ==
+              RectNavGraph::kNone ||
+          graph.getRectAt(static_cast<int>(goal.getX()),
+                          static_cast<int>(goal.getY())) ==
+              RectNavGraph::kNone) {
+        continue;
+      }
+      const bool graphFound = graph.findPath(start, goal, byGraph);
+      const bool tileFound =
+          astar.findPath(map, start, goal, radius, byTiles);
+      assert(graphFound == tileFound);
+      if (!graphFound) {
+        continue;
+      }
+      ++found;
+      graphExpanded += graph.getLastExpansionCount();
+      tileExpanded += astar.getLastExpansionCount();
+      assert(byGraph.front() == start && byGraph.back() == goal);
+      // グラフの経路の直線区間は歩ける
+      for (size_t k = 1; k < byGraph.size(); ++k) {
+        const int steps = static_cast<int>(
+            byGraph[k - 1].distanceTo(byGraph[k]) * 4.0f) + 1;
+        for (int s = 0; s <= steps; ++s) {
+          const float t = static_cast<float>(s) / steps;
+          const Position p(
+              byGraph[k - 1].getX() +
+                  (byGraph[k].getX() - byGraph[k - 1].getX()) * t,
+              byGraph[k - 1].getY() +
+                  (byGraph[k].getY() - byGraph[k - 1].getY()) * t);
+          assert(map.isWalkable(p, radius));
+        }
+      }
+      PathSmoother::smooth(map, radius, byGraph);
+      PathSmoother::smooth(map, radius, byTiles);
+      graphLength += pathLength(byGraph);
+      tileLength += pathLength(byTiles);
+    }
+    assert(found > 30);
+    std::cout << "  " << found << " paths on 256x256: graph expanded "
+              << graphExpanded << " nodes, tile A* " << tileExpanded
+              << " tiles; smoothed length " << graphLength << " vs "
+              << tileLength << std::endl;
+    assert(graphExpanded * 30 < tileExpanded);
+    assert(graphLength < tileLength * 1.1f);
+    std::cout << "✓ Fewer expansions than tile search test passed"
+              << std::endl;
+  }
+
+  static void testIncrementalUpdate() {
+    GameMap map = makeLakeland(96, 24, 23);
+    const float radius = 0.4f;
+    RectNavGraph graph;
+    graph.build(map, radius);
+    const size_t fullCount = graph.getRectCount();
+    assert(!graph.update(map));
+
+    // 縦の壁（上端だけ開いている）を足す: 周りの矩形だけを作り直す
+    for (int y = 0; y < 90; ++y) {
+      map.setTile(48, y, TerrainType::Water);
+    }
+    assert(!graph.isCurrent(map, radius));
+    assert(graph.update(map));
+    assert(graph.isCurrent(map, radius));
+    checkConsistency(map, graph, radius);
+    std::cout << "  wall edit rebuilt " << graph.getLastRebuiltRectCount()
+              << " of " << graph.getRectCount() << " rects (full build "
+              << fullCount << ")" << std::endl;
+    assert(graph.getLastRebuiltRectCount() < graph.getRectCount());
+
+    std::vector<Position> path;
+    const Position start(20.5f, 10.5f);
+    const Position goal(76.5f, 10.5f);
+    if (graph.getRectAt(20, 10) != RectNavGraph::kNone &&
+        graph.getRectAt(76, 10) != RectNavGraph::kNone) {
+      assert(graph.findPath(start, goal, path));
+      bool wentOver = false;
+      for (const Position &p : path) {
+        wentOver = wentOver || p.getY() > 89.0f;
+      }
+      assert(wentOver);
+    }
+
+    // 小さな変更を重ねても整合性は保たれる
+    std::mt19937 random(29);
+    std::uniform_int_distribution<int> tile(0, 95);
+    for (int i = 0; i < 40; ++i) {
+      map.setTile(tile(random), tile(random),
+                  i % 2 == 0 ? TerrainType::Grassland : TerrainType::Forest);
+      if (i % 5 == 4) {
+        graph.update(map);
+        checkConsistency(map, graph, radius);
+      }
+    }
+    std::cout << "✓ Incremental update test passed" << std::endl;
+  }
+
+  static void testUnitFollowsGraphRoute() {
+    // 草原と森の縦縞（一様なタイルがなく、Jump Point Search が効かない）に
+    // x = 10 の水の壁（上側 y >= 15 だけ開いている）
+    GameMap map = makeGrassland(20, 20);
+    for (int y = 0; y < 20; ++y) {
+      for (int x = 1; x < 20; x += 2) {
+        map.setTile(x, y, TerrainType::Forest);
+      }
+    }
+    for (int y = 0; y < 15; ++y) {
+      map.setTile(10, y, TerrainType::Water);
+    }
+    map.rebuildClearance();
+    RectNavGraph graph;
+    graph.build(map, 0.3f);
+    UnitStats stats(100, 100, 10, 10, 2.0f, 1.0f, 1.0f, 0.3f);
+    UnitList units = {std::make_shared<UnitEntity>(
+        1, "Unit", Position(5.5f, 5.5f), stats, 1)};
+    MovementUseCase movement(units, nullptr, &map);
+    movement.setNavigationGraph(&graph);
+    const Position goal(15.5f, 5.5f);
+    assert(movement.moveUnitTo(1, goal));
+    assert(movement.getRouteWaypointCount(1) > 0);
+    assert(movement.getLastRouteBackend() ==
+           MovementUseCase::RouteBackend::NavigationGraph);
+    // グラフで求めた経路は修復用の探索状態を持たない
+    assert(movement.getIncrementalRouteCount() == 0);
+    for (int frame = 0; frame < 1200; ++frame) {
+      movement.updateMovements(0.05f);
+      assert(map.isWalkable(units[0]->getPosition(), 0.3f));
+    }
+    assert(units[0]->getPosition() == goal);
+    assert(movement.getRouteWaypointCount(1) == 0);
+    std::cout << "✓ Unit follows graph route test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_RECT_NAV_GRAPH_TEST_H
@@ -0,0 +1,175 @@
+#ifndef SIMULATION_GAME_SIMULATION_LOD_TEST_H
+#define SIMULATION_GAME_SIMULATION_LOD_TEST_H
+
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/CombatBroadphase.h"
+#include "../domain/services/SimulationLod.h"
+#include "../usecases/MovementUseCase.h"
+#include "TestFixtures.h"
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief シミュレーション LOD（SimulationLod と移動処理への組み込み）のテスト
+ */
+class SimulationLodTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running SimulationLod tests..." << std::endl;
+    testDeferredTimeIsNotLost();
+    testPromotionOnViewAndEnemies();
+    testDeadUnitsArePruned();
+    testLargeBattleThroughput();
+    std::cout << "SimulationLod tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+  static constexpr float kDeltaTime = 0.016f;
+
+  static void testDeferredTimeIsNotLost() {
+    // 画面から遠いユニットと、LOD なしの同じユニットを並べて進める
+    UnitList reduced = {makeUnit(1, 0.0f, 0.0f)};
+    UnitList full = {makeUnit(1, 0.0f, 0.0f)};
+    SimulationLod lod;
+    lod.setView(100.0f, 100.0f, 110.0f, 110.0f);
+    MovementUseCase reducedMovement(reduced);
+    reducedMovement.setSimulationLod(&lod);
+    MovementUseCase fullMovement(full);
+    assert(reducedMovement.moveUnitTo(1, Position(20.0f, 0.0f)));
+    assert(fullMovement.moveUnitTo(1, Position(20.0f, 0.0f)));
+
+    size_t stepped = 0;
+    for (int tick = 0; tick < 120; ++tick) {
+      lod.beginTick(nullptr);
+      reducedMovement.updateMovements(kDeltaTime);
+      fullMovement.updateMovements(kDeltaTime);
+      stepped += lod.getSteppedCount();
+      // 遅れは貯めてよい時間分まで
+      const float lag = full[0]->getPosition().getX() -
+                        reduced[0]->getPosition().getX();
+      assert(lag >= -1e-4f && lag <= 0.25f + kDeltaTime + 1e-4f);
+    }
+    assert(stepped < 120 / 2);
+
+    // 画面に入るとフルレートに戻り、貯めた時間は次のティックで消化される
+    lod.setView(-10.0f, -10.0f, 30.0f, 10.0f);
+    lod.beginTick(nullptr);
+    reducedMovement.updateMovements(kDeltaTime);
+    fullMovement.updateMovements(kDeltaTime);
+    assert(std::fabs(full[0]->getPosition().getX() -
+                     reduced[0]->getPosition().getX()) < 1e-3f);
+    std::cout << "✓ Deferred time conservation test passed" << std::endl;
+  }
+
+  static void testPromotionOnViewAndEnemies() {
+    UnitList units = {makeUnit(1, 50.0f, 50.0f, 1),
+                      makeUnit(2, 53.0f, 50.0f, 2),
+                      makeUnit(3, 90.0f, 90.0f, 1)};
+    CombatBroadphase broadphase;
+    broadphase.rebuild(units);
+    SimulationLod lod;
+    lod.setView(0.0f, 0.0f, 10.0f, 10.0f);
+    lod.beginTick(&broadphase.getFactionIndex());
+    assert(lod.isFullRate(*units[0])); // 敵が近い
+    assert(!lod.isFullRate(*units[2])); // 画面外で敵も遠い
+    lod.setView(85.0f, 85.0f, 95.0f, 95.0f);
+    assert(lod.isFullRate(*units[2]));
+    units[2]->enterCombat();
+    lod.setView(0.0f, 0.0f, 10.0f, 10.0f);
+    assert(lod.isFullRate(*units[2])); // 戦闘中は常にフルレート
+    std::cout << "✓ LOD promotion test passed" << std::endl;
+  }
+
+  static void testDeadUnitsArePruned() {
+    // 同じグループの2体を画面外で動かし、時間を貯めさせる
+    UnitList units = {makeUnit(1, 0.0f, 0.0f), makeUnit(2, 0.5f, 0.0f)};
+    SimulationLod lod;
+    lod.setView(100.0f, 100.0f, 110.0f, 110.0f);
+    MovementUseCase movement(units);
+    movement.setSimulationLod(&lod);
+    assert(movement.moveUnitTo(1, Position(20.0f, 0.0f)));
+    assert(movement.moveUnitTo(2, Position(20.5f, 0.0f)));
+    for (int tick = 0; tick < 8 && lod.getBankedUnitCount() < 2; ++tick) {
+      lod.beginTick(nullptr);
+      movement.updateMovements(kDeltaTime);
+    }
+    assert(lod.getBankedUnitCount() == 2);
+
+    // 死んだユニットは stepFor を通らなくなり、次の掃除で消える
+    units[1]->takeDamage(1000);
+    for (int tick = 0; tick < 2; ++tick) {
+      lod.beginTick(nullptr);
+      movement.updateMovements(kDeltaTime);
+    }
+    assert(lod.getBankedUnitCount() <= 1);
+    for (int tick = 0; tick < 20; ++tick) {
+      lod.beginTick(nullptr);
+      movement.updateMovements(kDeltaTime);
+      assert(lod.getBankedUnitCount() <= 1);
+    }
+    std::cout << "✓ Dead unit pruning test passed" << std::endl;
+  }
+
+  // 画面外で大軍同士が行軍する場面の更新コスト（LOD あり / なし）
+  static void testLargeBattleThroughput() {
+    constexpr int kPerSide = 1000;
+    constexpr int kTicks = 120;
+    auto makeArmies = [] {
+      UnitList units;
+      for (int i = 0; i < kPerSide; ++i) {
+        const float x = 0.6f * static_cast<float>(i % 40);
+        const float y = 0.6f * static_cast<float>(i / 40);
+        units.push_back(makeUnit(i + 1, x, y, 1));
+        units.push_back(makeUnit(kPerSide + i + 1, x + 200.0f, y, 2));
+      }
+      return units;
+    };
+    auto run = [&](bool useLod, size_t &outStepped) {
+      UnitList units = makeArmies();
+      CombatBroadphase broadphase;
+      SimulationLod lod;
+      lod.setView(-500.0f, -500.0f, -490.0f, -490.0f);
+      MovementUseCase movement(units);
+      movement.setCombatBroadphase(&broadphase);
+      if (useLod) {
+        movement.setSimulationLod(&lod);
+      }
+      for (const auto &unit : units) {
+        const float dx = unit->getFaction() == 1 ? 30.0f : -30.0f;
+        movement.moveUnitTo(unit->getId(), unit->getPosition().moveBy(dx, 0));
+      }
+      outStepped = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for (int tick = 0; tick < kTicks; ++tick) {
+        broadphase.rebuild(units);
+        lod.beginTick(&broadphase.getFactionIndex());
+        movement.updateMovements(kDeltaTime);
+        outStepped += useLod ? lod.getSteppedCount() : units.size();
+      }
+      return std::chrono::duration<double, std::milli>(
+                 std::chrono::steady_clock::now() - start)
+          .count();
+    };
+
+    size_t fullSteps = 0;
+    size_t lodSteps = 0;
+    const double fullMs = run(false, fullSteps);
+    const double lodMs = run(true, lodSteps);
+    std::cout << "  large battle: " << kTicks << " ticks, full-rate "
+              << fullSteps << " unit-steps / " << fullMs << " ms, LOD "
+              << lodSteps << " unit-steps / " << lodMs << " ms" << std::endl;
+    assert(lodSteps * 2 < fullSteps);
+    // 進めるユニット数が半分以下になった分、時間も短くなること。回避の
+    // 近傍としては毎ティック全員が参加するので、時間は歩数ほどは減らない
+    // （最適化ビルドで約3倍、サニタイザ付きで約2倍）。1.5倍を下限とする
+    assert(lodMs * 1.5 < fullMs);
+    std::cout << "✓ Large battle throughput test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_SIMULATION_LOD_TEST_H
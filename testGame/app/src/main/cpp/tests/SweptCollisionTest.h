@@ -0,0 +1,196 @@
+#ifndef SIMULATION_GAME_SWEPT_COLLISION_TEST_H
+#define SIMULATION_GAME_SWEPT_COLLISION_TEST_H
+
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/SweptCollision.h"
+#include "../usecases/CollisionUseCase.h"
+#include "TestFixtures.h"
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * @brief 連続衝突判定（SweptCollision と CollisionUseCase への組み込み）の
+ *        テスト
+ */
+class SweptCollisionTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running SweptCollision tests..." << std::endl;
+    testHeadOnDoesNotTunnel();
+    testFastUnitStopsAtWall();
+    testGrazingIsLeftToSeparation();
+    testUseCaseStopsFastUnit();
+    testSweepScales();
+    testShuffledInputFallsBackToSort();
+    std::cout << "SweptCollision tests passed!" << std::endl;
+  }
+
+private:
+  using UnitList = std::vector<std::shared_ptr<UnitEntity>>;
+
+  static void testHeadOnDoesNotTunnel() {
+    // 1ティックで互いの位置を入れ替えるほど速い正面衝突
+    const float startXs[] = {0.0f, 1.0f};
+    const float startYs[] = {0.0f, 0.0f};
+    float endXs[] = {2.0f, -1.0f};
+    float endYs[] = {0.0f, 0.0f};
+    const float radii[] = {0.1f, 0.1f};
+    SweptCollision swept;
+    assert(swept.solve(startXs, startYs, endXs, endYs, radii, 2) == 2);
+    assert(endXs[0] < endXs[1]);
+    // 同じ時刻で止まるので、中点を挟んで対称
+    assert(std::fabs((endXs[0] + endXs[1]) - 1.0f) < 1e-5f);
+    assert(std::fabs((endXs[1] - endXs[0]) - 0.1f) < 1e-4f);
+    std::cout << "✓ Head-on test passed" << std::endl;
+  }
+
+  static void testFastUnitStopsAtWall() {
+    // 止まっている列を、速いユニットが横切ろうとする
+    std::vector<float> startXs = {0.0f};
+    std::vector<float> startYs = {-3.0f};
+    std::vector<float> endXs = {0.0f};
+    std::vector<float> endYs = {3.0f};
+    for (int i = -5; i <= 5; ++i) {
+      startXs.push_back(0.2f * static_cast<float>(i));
+      startYs.push_back(0.0f);
+      endXs.push_back(startXs.back());
+      endYs.push_back(0.0f);
+    }
+    const std::vector<float> radii(startXs.size(), 0.1f);
+    SweptCollision swept;
+    assert(swept.solve(startXs.data(), startYs.data(), endXs.data(),
+                       endYs.data(), radii.data(), startXs.size()) == 1);
+    assert(endYs[0] < 0.0f && endYs[0] > -0.2f);
+    for (size_t i = 1; i < startXs.size(); ++i) {
+      assert(endXs[i] == startXs[i] && endYs[i] == startYs[i]);
+    }
+    std::cout << "✓ Wall test passed" << std::endl;
+  }
+
+  static void testGrazingIsLeftToSeparation() {
+    // 接したまま横に擦れ違う程度の浅い接触では止めない
+    const float startXs[] = {0.0f, 0.19f};
+    const float startYs[] = {0.0f, -0.2f};
+    float endXs[] = {0.0f, 0.17f};
+    float endYs[] = {0.0f, 0.2f};
+    const float radii[] = {0.1f, 0.1f};
+    SweptCollision swept;
+    assert(swept.solve(startXs, startYs, endXs, endYs, radii, 2) == 0);
+    assert(endXs[1] == 0.17f && endYs[1] == 0.2f);
+    std::cout << "✓ Grazing test passed" << std::endl;
+  }
+
+  static void testUseCaseStopsFastUnit() {
+    UnitList units = {makeUnit(1, 0.0f, 0.0f), makeUnit(2, 2.0f, 0.0f)};
+    CollisionUseCase collision(units);
+    units[0]->setTargetPosition(Position(4.0f, 0.0f));
+
+    // 記録していなければ何もしない
+    units[0]->updatePosition(Position(3.0f, 0.0f));
+    assert(collision.resolveSweptContacts() == 0);
+    units[0]->updatePosition(Position(0.0f, 0.0f));
+
+    collision.captureStartPositions();
+    units[0]->updatePosition(Position(3.0f, 0.0f)); // 1ティックで飛び越える
+    assert(collision.resolveSweptContacts() == 1);
+    assert(units[0]->getPosition().getX() < 2.0f);
+    // 目標は残るので、次のティックも移動を続けようとする
+    assert(units[0]->getState() == UnitState::MOVING);
+
+    collision.resolveOverlaps();
+    assert(units[0]->getPosition().distanceTo(units[1]->getPosition()) >
+           0.19f);
+    std::cout << "✓ Use case swept contact test passed" << std::endl;
+  }
+
+  static void testSweepScales() {
+    // 4000 体が少しずつ動くティック（総当たりなら 800 万ペア）
+    constexpr size_t kCount = 4000;
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> coordinate(0.0f, 100.0f);
+    std::uniform_real_distribution<float> step(-0.05f, 0.05f);
+    std::vector<float> xs(kCount);
+    std::vector<float> ys(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+      xs[i] = coordinate(random);
+      ys[i] = coordinate(random);
+    }
+    const std::vector<float> radii(kCount, 0.1f);
+    std::vector<float> endXs(kCount);
+    std::vector<float> endYs(kCount);
+
+    SweptCollision swept;
+    size_t candidates = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < 20; ++tick) {
+      for (size_t i = 0; i < kCount; ++i) {
+        endXs[i] = xs[i] + step(random);
+        endYs[i] = ys[i] + step(random);
+      }
+      swept.solve(xs.data(), ys.data(), endXs.data(), endYs.data(),
+                  radii.data(), kCount);
+      candidates += swept.getCandidatePairCount();
+      xs.swap(endXs);
+      ys.swap(endYs);
+    }
+    const double ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+    std::cout << "  " << kCount << " units x 20 ticks: " << candidates
+              << " candidate pairs, " << ms << " ms" << std::endl;
+    assert(candidates < 20 * kCount);
+    std::cout << "✓ Sweep scaling test passed" << std::endl;
+  }
+
+  static double solveMs(SweptCollision &swept, const std::vector<float> &xs,
+                        const std::vector<float> &ys,
+                        const std::vector<float> &radii) {
+    std::vector<float> endXs = xs;
+    std::vector<float> endYs = ys;
+    const auto start = std::chrono::steady_clock::now();
+    swept.solve(xs.data(), ys.data(), endXs.data(), endYs.data(),
+                radii.data(), xs.size());
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+  }
+
+  static void testShuffledInputFallsBackToSort() {
+    // 静止した横一列。前回と同じ要素数で、並びだけを逆にして渡す
+    constexpr size_t kCount = 20000;
+    std::vector<float> xs(kCount);
+    const std::vector<float> ys(kCount, 0.0f);
+    const std::vector<float> radii(kCount, 0.1f);
+    for (size_t i = 0; i < kCount; ++i) {
+      xs[i] = 0.5f * static_cast<float>(i);
+    }
+    SweptCollision swept;
+    solveMs(swept, xs, ys, radii);
+    assert(swept.getFullSortCount() == 1);
+    solveMs(swept, xs, ys, radii);
+    assert(swept.getFullSortCount() == 0);
+
+    // 挿入ソートのままなら 2 億回ずらす。途中で全体のソートに切り替える
+    std::vector<float> reversed(xs.rbegin(), xs.rend());
+    const double shuffledMs = solveMs(swept, reversed, ys, radii);
+    assert(swept.getFullSortCount() == 1);
+    SweptCollision fresh;
+    const double freshMs = solveMs(fresh, reversed, ys, radii);
+    std::cout << "  " << kCount << " reversed: " << shuffledMs
+              << " ms (fresh solver " << freshMs << " ms)" << std::endl;
+    assert(shuffledMs < 5.0 * freshMs + 1.0);
+
+    // 呼び出し側が入れ替えを知っていれば、最初から全体をソートする
+    swept.resetOrder();
+    solveMs(swept, xs, ys, radii);
+    assert(swept.getFullSortCount() == 1);
+    std::cout << "✓ Shuffled input test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_SWEPT_COLLISION_TEST_H
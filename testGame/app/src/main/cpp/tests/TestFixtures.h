@@ -0,0 +1,78 @@
+#ifndef SIMULATION_GAME_TEST_FIXTURES_H
+#define SIMULATION_GAME_TEST_FIXTURES_H
+
+#include "../domain/entities/GameMap.h"
+#include "../domain/entities/UnitEntity.h"
+#include "../usecases/interfaces/IJobSystem.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+/*
+ * TestFixtures.h
+ *
+ * Unit and map builders and a job-system double shared by the test headers.
+ * The unit defaults describe the standard test unit (100 HP, 10 attack,
+ * speed 1, range 1, radius 0.1); tests pass only the values they exercise.
+ */
+
+/**
+ * @brief 任意のステータスでユニットを作る
+ */
+inline std::shared_ptr<UnitEntity> makeUnit(int id, float x, float y,
+                                            const UnitStats &stats,
+                                            int faction = 1) {
+  return std::make_shared<UnitEntity>(id, "Unit", Position(x, y), stats,
+                                      faction);
+}
+
+/**
+ * @brief 標準ステータスのユニットを作る
+ * @param faction 陣営
+ * @param range 射程
+ * @param radius 衝突半径
+ */
+inline std::shared_ptr<UnitEntity> makeUnit(int id, float x, float y,
+                                            int faction = 1,
+                                            float range = 1.0f,
+                                            float radius = 0.1f) {
+  return makeUnit(id, x, y,
+                  UnitStats(100, 100, 10, 10, 1.0f, range, 1.0f, radius),
+                  faction);
+}
+
+/**
+ * @brief ジョブを逆順に実行するジョブシステム
+ *
+ * 並列処理の分割単位（行帯・区間など）が実行順に依存しないことを確かめる。
+ */
+class ReverseJobSystem : public IJobSystem {
+public:
+  explicit ReverseJobSystem(size_t concurrency) : concurrency_(concurrency) {}
+
+  size_t getConcurrency() const override { return concurrency_; }
+  void parallelFor(size_t jobCount,
+                   const std::function<void(size_t)> &job) override {
+    for (size_t i = jobCount; i > 0; --i) {
+      job(i - 1);
+    }
+  }
+
+private:
+  size_t concurrency_;
+};
+
+/**
+ * @brief 全タイルが草原のマップを作る（タイル1辺 1.0、原点 (0, 0)）
+ */
+inline GameMap makeGrassland(int width, int height) {
+  GameMap map(width, height, 1.0f, 0.0f, 0.0f);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      map.setTile(x, y, TerrainType::Grassland);
+    }
+  }
+  return map;
+}
+
+#endif // SIMULATION_GAME_TEST_FIXTURES_H
@@ -0,0 +1,106 @@
+#ifndef SIMULATION_GAME_THREAD_POOL_JOB_SYSTEM_TEST_H
+#define SIMULATION_GAME_THREAD_POOL_JOB_SYSTEM_TEST_H
+
+#include "../frameworks/utils/ThreadPoolJobSystem.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief スレッドプール（ThreadPoolJobSystem）のテスト
+ */
+class ThreadPoolJobSystemTest {
+public:
+  static void runAllTests() {
+    std::cout << "Running ThreadPoolJobSystem tests..." << std::endl;
+    testParallelForRunsEachJobOnce();
+    testSubmittedTasksComplete();
+    testNestedParallelForUsesOtherWorkers();
+    std::cout << "ThreadPoolJobSystem tests passed!" << std::endl;
+  }
+
+private:
+  // 条件が満たされるまで待つ（テストが止まらないよう上限付き）
+  template <typename Predicate> static bool waitFor(Predicate &&done) {
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done()) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      std::this_thread::yield();
+    }
+    return true;
+  }
+
+  static void testParallelForRunsEachJobOnce() {
+    ThreadPoolJobSystem pool(3);
+    assert(pool.getConcurrency() == 4);
+    std::vector<std::atomic<int>> runs(1000);
+    for (int repeat = 0; repeat < 20; ++repeat) {
+      pool.parallelFor(runs.size(), [&](size_t job) { ++runs[job]; });
+    }
+    for (const auto &count : runs) {
+      assert(count == 20);
+    }
+    pool.parallelFor(0, [](size_t) { assert(false); });
+    std::cout << "✓ parallelFor coverage test passed" << std::endl;
+  }
+
+  static void testSubmittedTasksComplete() {
+    ThreadPoolJobSystem pool(2);
+    std::atomic<int> finished{0};
+    for (int i = 0; i < 50; ++i) {
+      pool.submit([&finished]() { ++finished; });
+    }
+    // タスクの実行中も描画スレッド側の parallelFor は進む
+    std::atomic<int> jobs{0};
+    pool.parallelFor(64, [&](size_t) { ++jobs; });
+    assert(jobs == 64);
+    assert(waitFor([&]() { return finished == 50; }));
+    std::cout << "✓ submit completion test passed" << std::endl;
+  }
+
+  static void testNestedParallelForUsesOtherWorkers() {
+    ThreadPoolJobSystem pool(3);
+    constexpr size_t kJobs = 12;
+    std::vector<std::atomic<int>> runs(kJobs);
+    std::mutex threadsMutex;
+    std::set<std::thread::id> threads;
+    std::atomic<bool> done{false};
+
+    // タスク内の parallelFor は1つのワーカーで順に回さず、他のワーカーにも
+    // ジョブを配る
+    pool.submit([&]() {
+      pool.parallelFor(kJobs, [&](size_t job) {
+        ++runs[job];
+        {
+          std::lock_guard<std::mutex> lock(threadsMutex);
+          threads.insert(std::this_thread::get_id());
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      });
+      done = true;
+    });
+
+    // その間も呼び出し側の parallelFor は待たされずに完了する
+    std::atomic<int> outer{0};
+    for (int repeat = 0; repeat < 50; ++repeat) {
+      pool.parallelFor(8, [&](size_t) { ++outer; });
+    }
+    assert(outer == 400);
+    assert(waitFor([&]() { return done.load(); }));
+    for (const auto &count : runs) {
+      assert(count == 1);
+    }
+    assert(threads.size() > 1);
+    std::cout << "✓ Nested parallelFor test passed" << std::endl;
+  }
+};
+
+#endif // SIMULATION_GAME_THREAD_POOL_JOB_SYSTEM_TEST_H
@@ -0,0 +1,298 @@
+#include "AISchedulerUseCase.h"
+
+/*
+ * AISchedulerUseCase.cpp
+ *
+ * Each update:
+ * 1. Re-sync agents when the unit array changed size (spawn / removal). New
+ * agents get staggered first think times so they do not all think at once.
+ * 2. Walk the combat ring, then the calm ring, from their cursors. Agents that
+ * are not due yet are skipped; the walk stops after one lap or when the
+ * budget is spent (checked after every decision, and every kClockCheckStride
+ * skipped agents).
+ * 3. Agents whose situation changed move to the other ring at the end, so
+ * neither ring is mutated while it is being walked.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// 思考しなかったエージェントをこの数だけ読み飛ばすごとに時計を確認する
+constexpr size_t kClockCheckStride = 64;
+// 新しいエージェントの初回思考時刻を散らす段数
+constexpr size_t kStaggerSlots = 16;
+
+float microsecondsSince(Clock::time_point start) {
+  return std::chrono::duration<float, std::micro>(Clock::now() - start)
+      .count();
+}
+} // namespace
+
+AISchedulerUseCase::AISchedulerUseCase(
+    std::vector<std::shared_ptr<UnitEntity>> &units,
+    MovementUseCase *movementUseCase, CombatUseCase *combatUseCase,
+    const AISchedulerConfig &config)
+    : units_(units), movementUseCase_(movementUseCase),
+      combatUseCase_(combatUseCase), config_(config) {}
+
+void AISchedulerUseCase::update(float nowSec) {
+  const Clock::time_point start = Clock::now();
+  syncAgents(nowSec);
+
+  lastThinkCount_ = 0;
+  lastUpdateCut_ = false;
+  bool budgetSpent = false;
+
+  for (int ringIndex : {kCombatRing, kCalmRing}) {
+    Ring &ring = rings_[ringIndex];
+    const size_t count = ring.agents.size();
+    if (count == 0) {
+      continue;
+    }
+    size_t cursor = ring.cursor % count;
+    size_t skipped = 0;
+    for (size_t visited = 0; visited < count; ++visited) {
+      if (budgetSpent) {
+        lastUpdateCut_ = true;
+        break;
+      }
+      Agent &agent = ring.agents[cursor];
+      if (agent.nextThinkTime <= nowSec) {
+        think(agent, nowSec);
+        ++lastThinkCount_;
+        budgetSpent = microsecondsSince(start) >= config_.budgetMicroseconds;
+      } else if (++skipped % kClockCheckStride == 0) {
+        budgetSpent = lastThinkCount_ > 0 &&
+                      microsecondsSince(start) >= config_.budgetMicroseconds;
+      }
+      cursor = (cursor + 1) % count;
+    }
+    ring.cursor = cursor;
+  }
+
+  migrateAgents();
+
+  if (profiler_) {
+    const float used = microsecondsSince(start);
+    profiler_->recordSample("ai.update", used);
+    if (used > config_.budgetMicroseconds) {
+      profiler_->recordBudgetOverrun("ai.update", config_.budgetMicroseconds,
+                                     used);
+    }
+  }
+}
+
+void AISchedulerUseCase::syncAgents(float nowSec) {
+  if (synced_ && syncedUnitCount_ == units_.size()) {
+    return;
+  }
+
+  // 既存のエージェントは状態（思考時刻・最後の指示）を引き継ぐ
+  std::unordered_map<const UnitEntity *, Agent> previous;
+  for (Ring &ring : rings_) {
+    for (Agent &agent : ring.agents) {
+      previous.emplace(agent.unit.get(), std::move(agent));
+    }
+    ring.agents.clear();
+  }
+
+  size_t fresh = 0;
+  for (size_t i = 0; i < units_.size(); ++i) {
+    const auto &unit = units_[i];
+    if (!unit || !unit->isAlive() || unit->getFaction() != config_.faction) {
+      continue;
+    }
+    auto found = previous.find(unit.get());
+    if (found != previous.end()) {
+      Agent &agent = found->second;
+      agent.unitIndex = i;
+      rings_[agent.ring].agents.push_back(std::move(agent));
+      continue;
+    }
+    Agent agent{unit, i, 0.0f, kCalmRing, unit->getPosition(), false};
+    // 初回の思考は平常時の思考間隔の中でずらす（同じフレームに集中させない）
+    agent.nextThinkTime =
+        nowSec + config_.calmThinkInterval *
+                     static_cast<float>(fresh % kStaggerSlots) / kStaggerSlots;
+    ++fresh;
+    rings_[kCalmRing].agents.push_back(std::move(agent));
+  }
+
+  for (Ring &ring : rings_) {
+    if (ring.cursor >= ring.agents.size()) {
+      ring.cursor = 0;
+    }
+  }
+  syncedUnitCount_ = units_.size();
+  synced_ = true;
+}
+
+void AISchedulerUseCase::think(Agent &agent, float nowSec) {
+  const UnitEntity &unit = *agent.unit;
+  if (!unit.isAlive() || !refreshIndex(agent)) {
+    // 次の同期で取り除かれるまで思考しない
+    agent.nextThinkTime = nowSec + config_.calmThinkInterval;
+    return;
+  }
+
+  const Position position = unit.getPosition();
+  const int faction = unit.getFaction();
+
+  AIContext context;
+  const UnitStats &stats = unit.getStats();
+  context.hpRatio = stats.getMaxHp() > 0
+                        ? static_cast<float>(stats.getCurrentHp()) /
+                              static_cast<float>(stats.getMaxHp())
+                        : 0.0f;
+  if (influenceMap_) {
+    context.ownInfluence =
+        influenceMap_->influenceAt(faction, position.getX(), position.getY());
+    context.enemyInfluence = influenceMap_->enemyInfluenceAt(
+        faction, position.getX(), position.getY());
+  }
+  if (combatBroadphase_ && combatBroadphase_->covers(units_.size())) {
+    context.engaged =
+        !combatBroadphase_->pairsForAttacker(agent.unitIndex).empty();
+  } else {
+    context.engaged = unit.getState() == UnitState::COMBAT;
+  }
+  Position enemyPosition;
+  context.enemyKnown = findNearestEnemy(unit, agent.unitIndex, enemyPosition);
+
+  const AIDecision decision = UtilityAI::decide(context);
+  if (combatUseCase_) {
+    combatUseCase_->setUnitTargetPolicy(unit.getId(), decision.targetPolicy);
+  }
+
+  switch (decision.action) {
+  case AIAction::ADVANCE:
+    issueMove(agent, enemyPosition);
+    break;
+  case AIAction::RETREAT: {
+    float dx = position.getX() - enemyPosition.getX();
+    float dy = position.getY() - enemyPosition.getY();
+    const float length = std::sqrt(dx * dx + dy * dy);
+    if (length > 0.0f) {
+      dx /= length;
+      dy /= length;
+    } else {
+      dx = 1.0f;
+      dy = 0.0f;
+    }
+    issueMove(agent,
+              Position(position.getX() + dx * config_.retreatDistance,
+                       position.getY() + dy * config_.retreatDistance));
+    break;
+  }
+  case AIAction::ENGAGE:
+  case AIAction::HOLD:
+    // 移動はさせない。次に前進・後退するときは必ず指示し直す
+    agent.hasOrder = false;
+    break;
+  }
+
+  // 射程内に敵がいるか、敵の影響圏にいれば交戦側で短い間隔で考える
+  const bool nearCombat = context.engaged || context.enemyInfluence > 0.0f;
+  agent.ring = nearCombat ? kCombatRing : kCalmRing;
+  agent.nextThinkTime =
+      nowSec + (nearCombat ? config_.combatThinkInterval
+                           : config_.calmThinkInterval);
+}
+
+void AISchedulerUseCase::issueMove(Agent &agent, const Position &target) {
+  if (!movementUseCase_) {
+    return;
+  }
+  // moveUnitTo は経路計算と攻撃の一時停止を伴うため、移動先が十分に
+  // 変わったときだけ指示し直す
+  if (agent.hasOrder &&
+      agent.lastOrder.distanceTo(target) <= config_.repathDistance) {
+    return;
+  }
+  if (movementUseCase_->moveUnitTo(agent.unit->getId(), target)) {
+    agent.lastOrder = target;
+    agent.hasOrder = true;
+  }
+}
+
+void AISchedulerUseCase::migrateAgents() {
+  moved_.clear();
+  for (int ringIndex : {kCombatRing, kCalmRing}) {
+    Ring &ring = rings_[ringIndex];
+    size_t write = 0;
+    size_t cursor = ring.cursor;
+    for (size_t read = 0; read < ring.agents.size(); ++read) {
+      if (ring.agents[read].ring != ringIndex) {
+        if (read < ring.cursor) {
+          --cursor;
+        }
+        moved_.push_back(std::move(ring.agents[read]));
+        continue;
+      }
+      if (write != read) {
+        ring.agents[write] = std::move(ring.agents[read]);
+      }
+      ++write;
+    }
+    ring.agents.resize(write);
+    ring.cursor = write > 0 ? cursor % write : 0;
+  }
+  // 移ったユニットは相手のリングの末尾（カーソルから最も遠い位置）に入る
+  for (Agent &agent : moved_) {
+    rings_[agent.ring].agents.push_back(std::move(agent));
+  }
+  moved_.clear();
+}
+
+bool AISchedulerUseCase::refreshIndex(Agent &agent) const {
+  if (agent.unitIndex < units_.size() &&
+      units_[agent.unitIndex] == agent.unit) {
+    return true;
+  }
+  for (size_t i = 0; i < units_.size(); ++i) {
+    if (units_[i] == agent.unit) {
+      agent.unitIndex = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AISchedulerUseCase::findNearestEnemy(const UnitEntity &unit,
+                                          size_t unitIndex,
+                                          Position &outPosition) const {
+  const Position position = unit.getPosition();
+  if (combatBroadphase_ && combatBroadphase_->covers(units_.size())) {
+    uint32_t enemyIndex = 0;
+    float distanceSq = 0.0f;
+    if (!combatBroadphase_->getFactionIndex().findNearestEnemy(
+            unit.getFaction(), position.getX(), position.getY(),
+            config_.searchRadius, enemyIndex, distanceSq)) {
+      return false;
+    }
+    outPosition = units_[enemyIndex]->getPosition();
+    return true;
+  }
+
+  // ブロードフェーズが無い（または古い）場合は全走査
+  float bestDistance = config_.searchRadius;
+  bool found = false;
+  for (size_t i = 0; i < units_.size(); ++i) {
+    const auto &other = units_[i];
+    if (i == unitIndex || !other || !other->isAlive() ||
+        other->getFaction() == unit.getFaction()) {
+      continue;
+    }
+    const float distance = position.distanceTo(other->getPosition());
+    if (distance < bestDistance || (!found && distance <= bestDistance)) {
+      bestDistance = distance;
+      outPosition = other->getPosition();
+      found = true;
+    }
+  }
+  return found;
+}
@@ -0,0 +1,154 @@
+#ifndef SIMULATION_GAME_AI_SCHEDULER_USECASE_H
+#define SIMULATION_GAME_AI_SCHEDULER_USECASE_H
+
+/*
+ * AISchedulerUseCase.h
+ *
+ * Time-sliced decision making for computer-controlled units.
+ *
+ * Contract:
+ * - update() spends at most about the configured budget per call (at least one
+ * decision is always made so that every unit eventually thinks).
+ * - Decisions are applied only through MovementUseCase::moveUnitTo and
+ * CombatUseCase::setUnitTargetPolicy; units are never mutated directly.
+ */
+
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/CombatBroadphase.h"
+#include "../domain/services/InfluenceMap.h"
+#include "../domain/services/UtilityAI.h"
+#include "CombatUseCase.h"
+#include "MovementUseCase.h"
+#include "interfaces/IProfiler.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief AI スケジューラの設定
+ */
+struct AISchedulerConfig {
+  int faction = 2;                 // AI が操作する陣営
+  float budgetMicroseconds = 500.0f; // 1 回の update で使ってよい時間
+  float combatThinkInterval = 0.25f; // 交戦中・交戦間近のユニットの思考間隔
+  float calmThinkInterval = 1.0f;    // それ以外のユニットの思考間隔
+  float searchRadius = 20.0f;      // 敵を探す範囲（ワールド単位）
+  float retreatDistance = 3.0f;    // 1 回の後退で離れる距離
+  float repathDistance = 1.0f;     // 移動先がこれ以上変わったときだけ再指示
+};
+
+/**
+ * @brief ユニットの思考をフレーム間に分散させる AI スケジューラ
+ *
+ * 設計方針：
+ * - 対象陣営のユニットを「交戦中・交戦間近」と「平常」の2つのリングに
+ *   分け、それぞれカーソル位置から順に（ラウンドロビンで）思考させる。
+ *   交戦側のリングを先に処理し、思考間隔も短い
+ * - 1 回の update は予算（マイクロ秒）を使い切った時点で打ち切り、続きは
+ *   次の update でカーソルの位置から再開する
+ * - 予算超過と所要時間はプロファイラに報告する
+ * - 行動の選択は UtilityAI（純粋関数）、状況の収集と適用はこのクラス
+ *
+ * 責任：
+ * - 思考順序と予算の管理
+ * - 状況（HP・影響度・交戦状態・最寄りの敵）の収集
+ * - 決定の適用（移動指示・攻撃対象ポリシー）
+ */
+class AISchedulerUseCase {
+public:
+  AISchedulerUseCase(std::vector<std::shared_ptr<UnitEntity>> &units,
+                     MovementUseCase *movementUseCase,
+                     CombatUseCase *combatUseCase,
+                     const AISchedulerConfig &config = AISchedulerConfig());
+
+  /**
+   * @brief 影響度マップを注入する（nullptr なら優勢度は常に 0.5）
+   */
+  void setInfluenceMap(const InfluenceMap *influenceMap) {
+    influenceMap_ = influenceMap;
+  }
+
+  /**
+   * @brief ブロードフェーズを注入する（交戦判定と最寄りの敵探索に使う）
+   */
+  void setCombatBroadphase(const CombatBroadphase *broadphase) {
+    combatBroadphase_ = broadphase;
+  }
+
+  /**
+   * @brief プロファイラを注入する（nullptr なら報告しない）
+   */
+  void setProfiler(IProfiler *profiler) { profiler_ = profiler; }
+
+  const AISchedulerConfig &getConfig() const { return config_; }
+
+  /**
+   * @brief 思考時刻に達したユニットを予算内で思考させる
+   * @param nowSec 現在のゲーム時刻（秒）
+   */
+  void update(float nowSec);
+
+  /**
+   * @brief 直前の update で思考したユニット数
+   */
+  size_t getLastThinkCount() const { return lastThinkCount_; }
+
+  /**
+   * @brief 直前の update が予算切れで周回の途中で打ち切られたか
+   */
+  bool wasLastUpdateCut() const { return lastUpdateCut_; }
+
+  /**
+   * @brief 管理しているユニット数（交戦・平常の合計）
+   */
+  size_t getAgentCount() const {
+    return rings_[kCombatRing].agents.size() + rings_[kCalmRing].agents.size();
+  }
+
+private:
+  static constexpr int kCombatRing = 0;
+  static constexpr int kCalmRing = 1;
+
+  struct Agent {
+    std::shared_ptr<UnitEntity> unit;
+    size_t unitIndex;    // units_ 上の位置（同期時点）
+    float nextThinkTime; // 次に思考する時刻
+    int ring;            // 所属するリング（kCombatRing / kCalmRing）
+    Position lastOrder;  // 最後に出した移動先
+    bool hasOrder;
+  };
+
+  struct Ring {
+    std::vector<Agent> agents;
+    size_t cursor = 0;
+  };
+
+  // units_ と管理中のユニットを突き合わせる（配列の要素数が変わった時だけ）
+  void syncAgents(float nowSec);
+  // 1ユニット分の思考（agent.ring と次の思考時刻を更新する）
+  void think(Agent &agent, float nowSec);
+  // 思考の結果、所属が変わったユニットを相手のリングへ移す
+  void migrateAgents();
+  // agent.unitIndex が古ければ探し直す。見つからなければ false
+  bool refreshIndex(Agent &agent) const;
+  bool findNearestEnemy(const UnitEntity &unit, size_t unitIndex,
+                        Position &outPosition) const;
+  void issueMove(Agent &agent, const Position &target);
+
+  std::vector<std::shared_ptr<UnitEntity>> &units_;
+  MovementUseCase *movementUseCase_;
+  CombatUseCase *combatUseCase_;
+  const InfluenceMap *influenceMap_ = nullptr;
+  const CombatBroadphase *combatBroadphase_ = nullptr;
+  IProfiler *profiler_ = nullptr;
+  AISchedulerConfig config_;
+
+  Ring rings_[2];
+  std::vector<Agent> moved_; // 思考中にリングを移るユニット（一時領域）
+  size_t syncedUnitCount_ = 0;
+  bool synced_ = false;
+  size_t lastThinkCount_ = 0;
+  bool lastUpdateCut_ = false;
+};
+
+#endif // SIMULATION_GAME_AI_SCHEDULER_USECASE_H
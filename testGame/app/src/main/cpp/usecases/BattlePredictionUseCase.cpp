@@ -0,0 +1,141 @@
+#include "BattlePredictionUseCase.h"
+
+/*
+ * BattlePredictionUseCase.cpp
+ *
+ * Rounds:
+ * - Each round runs one job per available core. Job j of round r seeds its
+ * own mt19937 from (seed, r, j), so streams are independent and the result of
+ * a round does not depend on which thread ran which job.
+ * - Jobs check the deadline between simulations (always running at least
+ * one), so a round never overshoots the budget by more than one simulation.
+ * - After each round the per-job tallies are summed and the Agresti-Coull 95%
+ * interval is evaluated for early termination.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+constexpr float kZ95 = 1.96f;
+
+using Clock = std::chrono::steady_clock;
+
+float halfWidth95(uint32_t wins, uint32_t trials) {
+  // Agresti–Coull: 成功2回・失敗2回を加えてから正規近似する（p≈0,1 でも安定）
+  const float n = static_cast<float>(trials) + kZ95 * kZ95;
+  const float p = (static_cast<float>(wins) + 0.5f * kZ95 * kZ95) / n;
+  return kZ95 * std::sqrt(p * (1.0f - p) / n);
+}
+} // namespace
+
+BattlePredictionUseCase::BattlePredictionUseCase(IJobSystem *jobSystem)
+    : jobSystem_(jobSystem) {}
+
+BattlePrediction
+BattlePredictionUseCase::predict(const std::vector<UnitStats> &sideA,
+                                 const std::vector<UnitStats> &sideB) {
+  const auto start = Clock::now();
+  const auto deadline =
+      start + std::chrono::duration_cast<Clock::duration>(
+                  std::chrono::duration<float, std::milli>(config_.timeBudgetMs));
+
+  const size_t concurrency = jobSystem_ ? jobSystem_->getConcurrency() : 1;
+  if (workers_.size() < concurrency) {
+    workers_.resize(concurrency);
+  }
+
+  BattlePrediction prediction;
+  uint32_t winsA = 0;
+  uint32_t draws = 0;
+  uint32_t round = 0;
+  const uint32_t seedLow = static_cast<uint32_t>(config_.seed);
+  const uint32_t seedHigh = static_cast<uint32_t>(config_.seed >> 32);
+
+  while (prediction.simulations < config_.maxSimulations) {
+    const uint32_t remaining = config_.maxSimulations - prediction.simulations;
+    const size_t jobs = std::min<size_t>(concurrency, remaining);
+    const uint32_t perJob = std::max<uint32_t>(
+        1, std::min<uint32_t>(config_.simulationsPerJob,
+                              remaining / static_cast<uint32_t>(jobs)));
+
+    auto runJob = [&](size_t jobIndex) {
+      Worker &worker = workers_[jobIndex];
+      std::seed_seq streamSeed{seedLow, seedHigh, round,
+                               static_cast<uint32_t>(jobIndex)};
+      worker.rng.seed(streamSeed);
+      worker.simulations = worker.winsA = worker.draws = 0;
+      for (uint32_t i = 0; i < perJob; ++i) {
+        if (i > 0 && Clock::now() >= deadline) {
+          break;
+        }
+        const BattleSimulationResult result =
+            worker.simulator.run(sideA, sideB, worker.rng);
+        ++worker.simulations;
+        if (result.winner == 0) {
+          ++worker.winsA;
+        } else if (result.winner < 0) {
+          ++worker.draws;
+        }
+      }
+    };
+
+    if (jobSystem_ && jobs > 1) {
+      jobSystem_->parallelFor(jobs, runJob);
+    } else {
+      for (size_t j = 0; j < jobs; ++j) {
+        runJob(j);
+      }
+    }
+
+    for (size_t j = 0; j < jobs; ++j) {
+      prediction.simulations += workers_[j].simulations;
+      winsA += workers_[j].winsA;
+      draws += workers_[j].draws;
+    }
+    ++round;
+
+    prediction.confidenceHalfWidth = halfWidth95(winsA, prediction.simulations);
+    if (prediction.simulations >= config_.minSimulations &&
+        prediction.confidenceHalfWidth <= config_.targetHalfWidth) {
+      prediction.converged = true;
+      break;
+    }
+    if (Clock::now() >= deadline) {
+      break;
+    }
+  }
+
+  if (prediction.simulations > 0) {
+    const float n = static_cast<float>(prediction.simulations);
+    prediction.winProbability = static_cast<float>(winsA) / n;
+    prediction.drawProbability = static_cast<float>(draws) / n;
+  }
+  prediction.elapsedMs =
+      std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+  return prediction;
+}
+
+BattlePrediction BattlePredictionUseCase::predictFaction(
+    const std::vector<std::shared_ptr<UnitEntity>> &units, int faction) {
+  snapshotFaction(units, faction);
+  return predictSnapshot();
+}
+
+void BattlePredictionUseCase::snapshotFaction(
+    const std::vector<std::shared_ptr<UnitEntity>> &units, int faction) {
+  // ステータスをコピーした時点でライブ状態との関係は切れる
+  snapshotA_.clear();
+  snapshotB_.clear();
+  for (const auto &unit : units) {
+    if (!unit || !unit->isAlive()) {
+      continue;
+    }
+    (unit->getFaction() == faction ? snapshotA_ : snapshotB_)
+        .push_back(unit->getStats());
+  }
+}
+
+BattlePrediction BattlePredictionUseCase::predictSnapshot() {
+  return predict(snapshotA_, snapshotB_);
+}
@@ -0,0 +1,131 @@
+#ifndef SIMULATION_GAME_BATTLE_PREDICTION_USECASE_H
+#define SIMULATION_GAME_BATTLE_PREDICTION_USECASE_H
+
+/*
+ * BattlePredictionUseCase.h
+ *
+ * Monte Carlo estimate of the outcome of a fight between two groups of units,
+ * used for the "win chance" UI and AI decisions.
+ *
+ * Contract:
+ * - Inputs are copied into UnitStats snapshots before any simulation starts;
+ * live UnitEntity objects are never modified.
+ * - predict() returns within roughly the configured time budget.
+ */
+
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/BattleSimulator.h"
+#include "interfaces/IJobSystem.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+/**
+ * @brief 勝敗予測の設定
+ */
+struct BattlePredictionConfig {
+  float timeBudgetMs = 5.0f;       // 1回の予測にかけてよい時間
+  float targetHalfWidth = 0.03f;   // 95%信頼区間の半幅がこれ以下なら打ち切る
+  uint32_t minSimulations = 64;    // 打ち切り判定を始める最小試行数
+  uint32_t maxSimulations = 20000; // 試行数の上限
+  uint32_t simulationsPerJob = 16; // 1ジョブあたりの試行数（粒度）
+  uint64_t seed = 0x5EEDu;         // 乱数ストリームの基準シード
+};
+
+/**
+ * @brief 勝敗予測の結果
+ */
+struct BattlePrediction {
+  float winProbability = 0.0f;  // 陣営Aの勝率
+  float drawProbability = 0.0f; // 時間切れ引き分けの割合
+  float confidenceHalfWidth = 1.0f; // 勝率の95%信頼区間の半幅
+  uint32_t simulations = 0;     // 実行した試行数
+  float elapsedMs = 0.0f;       // 実際にかかった時間
+  bool converged = false;       // 信頼区間が目標に達したか
+};
+
+/**
+ * @brief 集団戦の勝敗をモンテカルロ法で予測するユースケース
+ *
+ * 設計方針：
+ * - 1試行は BattleSimulator（CombatDomainService と同じ攻撃・反撃規則）
+ * - 試行はジョブシステムで並列実行する。ジョブごとに独立した乱数ストリーム
+ *   （シード・ラウンド・ジョブ番号から生成）と作業領域を持ち、共有状態は
+ *   ラウンド終了時の集計だけ
+ * - ラウンドごとに信頼区間（Agresti–Coull）を評価し、目標幅に達するか
+ *   時間予算を使い切った時点で打ち切る
+ *
+ * 責任：
+ * - ライブ状態からのスナップショット作成
+ * - 並列試行の配分と集計
+ */
+class BattlePredictionUseCase {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param jobSystem ジョブシステム（nullptr の場合は呼び出しスレッドで実行）
+   *
+   * ジョブシステムの所有権は呼び出し側が持つ。
+   */
+  explicit BattlePredictionUseCase(IJobSystem *jobSystem = nullptr);
+
+  void setConfig(const BattlePredictionConfig &config) { config_ = config; }
+  const BattlePredictionConfig &getConfig() const { return config_; }
+
+  /**
+   * @brief 2集団の勝敗を予測する
+   * @param sideA 陣営Aのステータス
+   * @param sideB 陣営Bのステータス
+   * @return 陣営Aから見た予測結果
+   */
+  BattlePrediction predict(const std::vector<UnitStats> &sideA,
+                           const std::vector<UnitStats> &sideB);
+
+  /**
+   * @brief 指定陣営とそれ以外の全陣営の勝敗を予測する
+   * @param units ユニット配列（読み取りのみ）
+   * @param faction 陣営A とする陣営
+   */
+  BattlePrediction
+  predictFaction(const std::vector<std::shared_ptr<UnitEntity>> &units,
+                 int faction);
+
+  /**
+   * @brief predictFaction の前半。生存ユニットのステータスを写し取る
+   * @param units ユニット配列（読み取りのみ）
+   * @param faction 陣営A とする陣営
+   *
+   * ライブ状態に触れるのはここだけなので、ゲームを更新するスレッドで呼ぶ。
+   */
+  void snapshotFaction(const std::vector<std::shared_ptr<UnitEntity>> &units,
+                       int faction);
+
+  /**
+   * @brief predictFaction の後半。最後のスナップショットで予測する
+   *
+   * ライブ状態を読まないため、別スレッド（IJobSystem::submit）で実行できる。
+   * 実行中に snapshotFaction を呼ばないこと。
+   */
+  BattlePrediction predictSnapshot();
+
+private:
+  // ジョブ1つ分の作業領域と集計（ジョブ間で共有しない）
+  struct Worker {
+    BattleSimulator simulator;
+    std::mt19937 rng;
+    uint32_t simulations = 0;
+    uint32_t winsA = 0;
+    uint32_t draws = 0;
+  };
+
+  IJobSystem *jobSystem_;
+  BattlePredictionConfig config_;
+  std::vector<Worker> workers_;
+
+  // predictFaction 用のスナップショット
+  std::vector<UnitStats> snapshotA_;
+  std::vector<UnitStats> snapshotB_;
+};
+
+#endif // SIMULATION_GAME_BATTLE_PREDICTION_USECASE_H
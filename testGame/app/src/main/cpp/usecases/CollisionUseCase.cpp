@@ -0,0 +1,195 @@
+#include "CollisionUseCase.h"
+
+/*
+ * CollisionUseCase.cpp
+ *
+ * Snapshot alive units, let OverlapResolver relax the overlapping pairs, then
+ * write back only the units whose coordinates actually changed. The swept
+ * stage uses the same snapshot layout, with the start positions captured by
+ * units_ index before movement.
+ *
+ * Awake-only overlap resolution seeds the snapshot with the awake units and
+ * last call's pushed sleepers, then adds every alive unit within
+ * (own radius + largest radius) of a seed from the broadphase faction index.
+ * Sleepers do not move, so their index positions are current. The gathered
+ * indices are sorted, so the solve order follows units_ as in a full pass.
+ */
+#include <algorithm>
+
+CollisionUseCase::CollisionUseCase(
+    std::vector<std::shared_ptr<UnitEntity>> &units, const GameMap *gameMap,
+    const OverlapResolverConfig &config,
+    const SweptCollisionConfig &sweptConfig)
+    : units_(units), gameMap_(gameMap), resolver_(config),
+      swept_(sweptConfig) {}
+
+void CollisionUseCase::captureStartPositions() {
+  startXs_.resize(units_.size());
+  startYs_.resize(units_.size());
+  for (size_t i = 0; i < units_.size(); ++i) {
+    if (units_[i]) {
+      startXs_[i] = units_[i]->getPosition().getX();
+      startYs_[i] = units_[i]->getPosition().getY();
+    }
+  }
+  startCaptured_ = true;
+}
+
+size_t CollisionUseCase::resolveSweptContacts() {
+  if (!startCaptured_ || startXs_.size() != units_.size()) {
+    return 0;
+  }
+  startCaptured_ = false;
+
+  xs_.clear();
+  ys_.clear();
+  radii_.clear();
+  unitIndices_.clear();
+  sweptStartXs_.clear();
+  sweptStartYs_.clear();
+  // 掃引の並びは前回の順序を引き継ぐので、スナップショットの各位置が
+  // 前回と別のユニットを指すようになったら捨てる
+  bool sameUnits = true;
+  for (size_t i = 0; i < units_.size(); ++i) {
+    const auto &unit = units_[i];
+    if (!unit || !unit->isAlive()) {
+      continue;
+    }
+    const size_t slot = xs_.size();
+    if (slot == sweptUnits_.size()) {
+      sweptUnits_.push_back(nullptr);
+    }
+    if (sweptUnits_[slot] != unit.get()) {
+      sweptUnits_[slot] = unit.get();
+      sameUnits = false;
+    }
+    sweptStartXs_.push_back(startXs_[i]);
+    sweptStartYs_.push_back(startYs_[i]);
+    xs_.push_back(unit->getPosition().getX());
+    ys_.push_back(unit->getPosition().getY());
+    radii_.push_back(unit->getStats().getCollisionRadius());
+    unitIndices_.push_back(i);
+  }
+
+  if (sweptUnits_.size() != xs_.size()) {
+    sweptUnits_.resize(xs_.size());
+    sameUnits = false;
+  }
+  if (!sameUnits) {
+    swept_.resetOrder();
+  }
+  if (swept_.solve(sweptStartXs_.data(), sweptStartYs_.data(), xs_.data(),
+                   ys_.data(), radii_.data(), xs_.size()) == 0) {
+    return 0;
+  }
+
+  size_t stopped = 0;
+  for (size_t k = 0; k < unitIndices_.size(); ++k) {
+    UnitEntity &unit = *units_[unitIndices_[k]];
+    const Position contact(xs_[k], ys_[k]);
+    if (contact != unit.getPosition()) {
+      unit.pushTo(contact);
+      ++stopped;
+    }
+  }
+  return stopped;
+}
+
+size_t CollisionUseCase::resolveOverlaps() {
+  const bool awakeOnly = activeUnitSets_ &&
+                         activeUnitSets_->covers(units_.size()) &&
+                         combatBroadphase_ &&
+                         combatBroadphase_->covers(units_.size());
+  if (awakeOnly) {
+    gatherAwakeOverlaps();
+  } else {
+    pushedSleepers_.clear();
+    overlapIndices_.clear();
+    for (size_t i = 0; i < units_.size(); ++i) {
+      overlapIndices_.push_back(i);
+    }
+  }
+
+  xs_.clear();
+  ys_.clear();
+  radii_.clear();
+  unitIndices_.clear();
+  for (size_t i : overlapIndices_) {
+    const auto &unit = units_[i];
+    if (!unit || !unit->isAlive()) {
+      continue;
+    }
+    xs_.push_back(unit->getPosition().getX());
+    ys_.push_back(unit->getPosition().getY());
+    radii_.push_back(unit->getStats().getCollisionRadius());
+    unitIndices_.push_back(i);
+  }
+  lastSolvedUnitCount_ = xs_.size();
+
+  if (resolver_.solve(xs_.data(), ys_.data(), radii_.data(), xs_.size(),
+                      gameMap_) == 0) {
+    return 0;
+  }
+
+  size_t moved = 0;
+  for (size_t k = 0; k < unitIndices_.size(); ++k) {
+    const size_t index = unitIndices_[k];
+    UnitEntity &unit = *units_[index];
+    const Position resolved(xs_[k], ys_[k]);
+    if (resolved != unit.getPosition()) {
+      unit.pushTo(resolved);
+      ++moved;
+      if (awakeOnly && !activeUnitSets_->isAwake(index)) {
+        pushedSleepers_.push_back({static_cast<uint32_t>(index), &unit});
+      }
+    }
+  }
+  return moved;
+}
+
+void CollisionUseCase::gatherAwakeOverlaps() {
+  if (overlapStamps_.size() != units_.size()) {
+    overlapStamps_.assign(units_.size(), 0);
+    overlapStampGeneration_ = 0;
+  }
+  if (++overlapStampGeneration_ == 0) {
+    std::fill(overlapStamps_.begin(), overlapStamps_.end(), 0);
+    overlapStampGeneration_ = 1;
+  }
+  overlapIndices_.clear();
+  auto add = [&](size_t index) {
+    if (overlapStamps_[index] != overlapStampGeneration_) {
+      overlapStamps_[index] = overlapStampGeneration_;
+      overlapIndices_.push_back(index);
+    }
+  };
+
+  for (uint32_t index : activeUnitSets_->getAwake()) {
+    add(index);
+  }
+  for (const PushedSleeper &pushed : pushedSleepers_) {
+    if (pushed.index < units_.size() &&
+        units_[pushed.index].get() == pushed.unit) {
+      add(pushed.index);
+    }
+  }
+  pushedSleepers_.clear();
+
+  // 種の周りで触れうるユニットを足す（足したユニットからは広げない）
+  const FactionSpatialIndex &index = combatBroadphase_->getFactionIndex();
+  const float maxRadius = combatBroadphase_->getMaxCollisionRadius();
+  auto addNeighbor = [&](uint32_t other, float) { add(other); };
+  const size_t seeds = overlapIndices_.size();
+  for (size_t k = 0; k < seeds; ++k) {
+    const UnitEntity &unit = *units_[overlapIndices_[k]];
+    if (!unit.isAlive()) {
+      continue;
+    }
+    const float x = unit.getPosition().getX();
+    const float y = unit.getPosition().getY();
+    const float reach = unit.getStats().getCollisionRadius() + maxRadius;
+    index.forEachInFactionRadius(unit.getFaction(), x, y, reach, addNeighbor);
+    index.forEachEnemyInRadius(unit.getFaction(), x, y, reach, addNeighbor);
+  }
+  std::sort(overlapIndices_.begin(), overlapIndices_.end());
+}
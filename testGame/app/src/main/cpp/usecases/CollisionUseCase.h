@@ -0,0 +1,135 @@
+#ifndef SIMULATION_GAME_COLLISION_USECASE_H
+#define SIMULATION_GAME_COLLISION_USECASE_H
+
+/*
+ * CollisionUseCase.h
+ *
+ * Stops fast units at their first contact (continuous collision) and
+ * resolves residual overlaps between units once per tick, after movement.
+ *
+ * Contract:
+ * - Units are only displaced through UnitEntity::pushTo; states and movement
+ * orders are left untouched.
+ * - Dead units are ignored and never pushed.
+ * - With an active-set source (ActiveUnitSets + CombatBroadphase covering
+ * units_), overlap resolution only looks at awake units, the units touching
+ * them, and sleepers it pushed on the previous call.
+ */
+
+#include "../domain/entities/GameMap.h"
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/ActiveUnitSets.h"
+#include "../domain/services/CombatBroadphase.h"
+#include "../domain/services/OverlapResolver.h"
+#include "../domain/services/SweptCollision.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief ユニット同士の重なりを解消するユースケース
+ *
+ * 設計方針：
+ * - 移動中の回避（MovementUseCase の ORCA）で防ぎきれなかった重なりを、
+ *   移動の後に OverlapResolver の位置ベース緩和でまとめて押し離す
+ * - 移動の前に始点を記録しておき、移動の後に始点 -> 現在位置を掃引として
+ *   SweptCollision で判定する。速いユニットがすり抜けたり深く食い込んだり
+ *   する場合は接触時刻の位置まで戻す（重なり解消より前に行う）
+ * - 生存ユニットの座標と半径を SoA にスナップショットしてから解き、
+ *   位置が変わったユニットだけを書き戻す
+ * - アクティブ集合があれば、重なり解消は起きているユニットと、それに
+ *   触れうるユニット（ブロードフェーズの陣営別インデックスで引く）だけを
+ *   解く。眠っているユニットは動かないので、眠っているユニット同士の
+ *   重なりは新しく生じない。ただし押し出した眠っているユニットは次回も
+ *   解く対象に入れ、押し出した先の重なりを拾う
+ *
+ * 責任：
+ * - スナップショットの作成と書き戻し
+ * - 地形（GameMap）の受け渡し
+ */
+class CollisionUseCase {
+public:
+  explicit CollisionUseCase(
+      std::vector<std::shared_ptr<UnitEntity>> &units,
+      const GameMap *gameMap = nullptr,
+      const OverlapResolverConfig &config = OverlapResolverConfig(),
+      const SweptCollisionConfig &sweptConfig = SweptCollisionConfig());
+
+  /**
+   * @brief 移動前の位置を記録する（ティックの移動処理より前に呼ぶ）
+   */
+  void captureStartPositions();
+
+  /**
+   * @brief 記録した位置からの移動を掃引で判定し、すり抜けを止める
+   * @return 接触位置まで戻したユニットの数
+   *
+   * captureStartPositions の後に units_ の要素数が変わっていたら何もしない。
+   */
+  size_t resolveSweptContacts();
+
+  /**
+   * @brief 直前の resolveSweptContacts で TOI を解いた候補ペアの数（計測用）
+   */
+  size_t getSweptCandidatePairCount() const {
+    return swept_.getCandidatePairCount();
+  }
+
+  /**
+   * @brief 重なり解消を起きているユニットの周りに限る（nullptr で全員）
+   *
+   * broadphase は同じティックに units_ から構築したもの。どちらかが
+   * units_ を覆っていない間は全員を解く。
+   */
+  void setActiveUnitSets(const ActiveUnitSets *activeUnitSets,
+                         const CombatBroadphase *broadphase) {
+    activeUnitSets_ = activeUnitSets;
+    combatBroadphase_ = broadphase;
+  }
+
+  /**
+   * @brief 重なっているユニットを押し離す
+   * @return 位置を動かしたユニットの数
+   */
+  size_t resolveOverlaps();
+
+  /**
+   * @brief 直前の resolveOverlaps で解いたユニットの数（計測用）
+   */
+  size_t getLastSolvedUnitCount() const { return lastSolvedUnitCount_; }
+
+private:
+  // 解く対象（units_ の位置）を overlapIndices_ に集める
+  void gatherAwakeOverlaps();
+
+  std::vector<std::shared_ptr<UnitEntity>> &units_;
+  const GameMap *gameMap_;
+  const ActiveUnitSets *activeUnitSets_ = nullptr;
+  const CombatBroadphase *combatBroadphase_ = nullptr;
+  OverlapResolver resolver_;
+  SweptCollision swept_;
+
+  // スナップショット（容量はティック間で再利用する）
+  std::vector<float> xs_;
+  std::vector<float> ys_;
+  std::vector<float> radii_;
+  std::vector<size_t> unitIndices_; // スナップショット -> units_ の位置
+  std::vector<float> startXs_;       // units_ の位置ごとの移動前の座標
+  std::vector<float> startYs_;
+  std::vector<float> sweptStartXs_; // 掃引のスナップショット（始点）
+  std::vector<float> sweptStartYs_;
+  std::vector<const UnitEntity *> sweptUnits_; // 前回の掃引の各位置のユニット
+  bool startCaptured_ = false;
+
+  // 起きているユニットの周りに限った重なり解消の作業領域
+  struct PushedSleeper {
+    uint32_t index;         // units_ の位置
+    const UnitEntity *unit; // 並べ替え・除去で位置がずれていないかの確認用
+  };
+  std::vector<size_t> overlapIndices_;
+  std::vector<uint32_t> overlapStamps_; // 集めたかの印（世代番号）
+  uint32_t overlapStampGeneration_ = 0;
+  std::vector<PushedSleeper> pushedSleepers_;
+  size_t lastSolvedUnitCount_ = 0;
+};
+
+#endif // SIMULATION_GAME_COLLISION_USECASE_H
@@ -16,77 +16,198 @@
 #include "../frameworks/android/AndroidOut.h"
 #include <algorithm>
 #include <chrono>
+#include <iterator>
 
 CombatUseCase::CombatUseCase(std::vector<std::shared_ptr<UnitEntity>> &units)
-    : units_(units) {}
+    : units_(units), startTime_(std::chrono::steady_clock::now()) {}
 
 void CombatUseCase::setCombatEventCallback(CombatEventCallback callback) {
   combatEventCallback_ = callback;
 }
 
+void CombatUseCase::setCombatBroadphase(const CombatBroadphase *broadphase) {
+  combatBroadphase_ = broadphase;
+}
+
+void CombatUseCase::setTargetSelectionPolicy(TargetSelectionPolicy policy) {
+  targetSelectionPolicy_ = policy;
+}
+
+void CombatUseCase::setUnitTargetPolicy(int unitId,
+                                        TargetSelectionPolicy policy) {
+  unitTargetPolicies_[unitId] = policy;
+}
+
+void CombatUseCase::clearUnitTargetPolicy(int unitId) {
+  unitTargetPolicies_.erase(unitId);
+}
+
+TargetSelectionPolicy CombatUseCase::getTargetPolicyFor(int unitId) const {
+  auto found = unitTargetPolicies_.find(unitId);
+  return found != unitTargetPolicies_.end() ? found->second
+                                            : targetSelectionPolicy_;
+}
+
 void CombatUseCase::executeAutoCombat() {
   // 自動戦闘のエントリポイント:
   // フレームごとに呼ばれ、攻撃可能なユニットを探して攻撃を実行します。
   // 現在時刻を秒で取得
-  auto now = std::chrono::high_resolution_clock::now();
-  float nowSec = std::chrono::duration<float>(now.time_since_epoch()).count();
+  executeAutoCombat(std::chrono::duration<float>(
+                        std::chrono::steady_clock::now() - startTime_)
+                        .count());
+}
 
-  // 全ユニットをチェックして自動戦闘を実行
-  for (auto &unit : units_) {
-    if (unit->getStats().getCurrentHp() <= 0) {
-      continue; // 死亡ユニットはスキップ
+void CombatUseCase::executeAutoCombat(float nowSec) {
+  pendingAttacks_.clear();
+  if (combatBroadphase_ && combatBroadphase_->covers(units_.size())) {
+    executeScheduledAutoCombat(nowSec);
+  } else if (activeUnitSets_ && activeUnitSets_->covers(units_.size())) {
+    // 起きているユニットだけを units_ の順に訪問する（攻撃や離脱で集合が
+    // 変わりうるので、訪問前に写しを取る）
+    awakeIndices_.assign(activeUnitSets_->getAwake().begin(),
+                         activeUnitSets_->getAwake().end());
+    std::sort(awakeIndices_.begin(), awakeIndices_.end());
+    for (uint32_t i : awakeIndices_) {
+      if (units_[i]->getStats().getCurrentHp() > 0) {
+        resolveAutoCombatFor(i, nowSec);
+      }
+    }
+  } else {
+    // フォールバック: 全ユニットをチェックして自動戦闘を実行
+    for (size_t i = 0; i < units_.size(); ++i) {
+      if (units_[i]->getStats().getCurrentHp() <= 0) {
+        continue; // 死亡ユニットはスキップ
+      }
+      resolveAutoCombatFor(i, nowSec);
     }
+  }
 
-    // Find a target inside effective range (considering collision radii)
-    auto target = findTargetInRange(*unit);
-    
-    // COMBAT状態で敵が範囲外に出た場合、戦闘状態から離脱
-    if (unit->getState() == UnitState::COMBAT && !target) {
-      unit->exitCombat();
-      aout << "CombatUseCase: Unit " << unit->getId() 
-           << " exited COMBAT state - no enemy in range"
-           << " - New state: " << unit->getStateString()
-           << std::endl;
-      continue;
+  resolvePendingAttacks();
+}
+
+void CombatUseCase::executeScheduledAutoCombat(float nowSec) {
+  // クールダウンが明けたユニットを登録から外す。明けたユニットのうち交戦中の
+  // ものは下の交戦リスト走査で拾われ、交戦していないものは何もする必要がない。
+  cooldownScheduler_.popExpired(nowSec, [](int) {});
+
+  // 射程内に敵がいる攻撃者だけを訪問する。クールダウン中ならヒープ登録の
+  // 参照だけで飛ばし、canAttack（攻撃速度による除算）は呼ばない。
+  engagedThisTick_.clear();
+  for (uint32_t index : combatBroadphase_->getEngagedAttackers()) {
+    const auto &unit = units_[index];
+    if (unit->getStats().getCurrentHp() <= 0) {
+      continue; // 同ティック内に倒されたユニット
     }
-    
-    if (!(target && target->getStats().getCurrentHp() > 0)) {
+    engagedThisTick_.push_back(unit);
+    if (cooldownScheduler_.isCoolingDown(unit->getId(), nowSec)) {
       continue;
     }
+    resolveAutoCombatFor(index, nowSec);
+  }
 
-    // 攻撃可能かどうか（攻撃速度によるクールダウンを尊重）
-    // COMBAT状態のユニットは移動しながらでも攻撃可能
-    // MOVING状態（戦闘前の移動）のユニットは攻撃不可
-    if (unit->getState() == UnitState::MOVING) {
-      // 純粋な移動中（まだ戦闘に入っていない）は攻撃しない
-      continue;
+  // 前ティックは交戦していたが今ティックは射程内に敵がいない（対象集合が
+  // 空に変化した）ユニットだけを戦闘状態から離脱させる
+  auto byPointer = [](const std::shared_ptr<UnitEntity> &lhs,
+                      const std::shared_ptr<UnitEntity> &rhs) {
+    return lhs.get() < rhs.get();
+  };
+  std::sort(engagedThisTick_.begin(), engagedThisTick_.end(), byPointer);
+  disengaged_.clear();
+  std::set_difference(engagedLastTick_.begin(), engagedLastTick_.end(),
+                      engagedThisTick_.begin(), engagedThisTick_.end(),
+                      std::back_inserter(disengaged_), byPointer);
+  for (const auto &unit : disengaged_) {
+    if (unit->getStats().getCurrentHp() > 0 &&
+        unit->getState() == UnitState::COMBAT) {
+      unit->exitCombat();
+      aout << "CombatUseCase: Unit " << unit->getId()
+           << " exited COMBAT state - no enemy in range"
+           << " - New state: " << unit->getStateString() << std::endl;
     }
+  }
+  disengaged_.clear();
+  engagedLastTick_.swap(engagedThisTick_);
+}
 
-    if (!unit->canAttack(nowSec)) {
-      continue;
-    }
+void CombatUseCase::resolveAutoCombatFor(size_t unitIndex, float nowSec) {
+  auto &unit = units_[unitIndex];
 
-    // Execute combat via domain service. The domain service performs the damage
-    // application and any state changes (enter/exit combat).
-    auto result = CombatDomainService::executeCombat(*unit, *target);
+  // Find a target inside effective range (considering collision radii)
+  const uint32_t targetIndex = findTargetInRange(unitIndex);
 
-    // 攻撃時刻の更新（ユースケース側で管理）
-    unit->setLastAttackTime(nowSec);
+  // COMBAT状態で敵が範囲外に出た場合、戦闘状態から離脱
+  if (unit->getState() == UnitState::COMBAT &&
+      targetIndex == TargetSelector::kNoTarget) {
+    unit->exitCombat();
+    aout << "CombatUseCase: Unit " << unit->getId()
+         << " exited COMBAT state - no enemy in range"
+         << " - New state: " << unit->getStateString() << std::endl;
+    return;
+  }
+
+  if (targetIndex == TargetSelector::kNoTarget) {
+    return;
+  }
+  const auto &target = units_[targetIndex];
+
+  // 攻撃可能かどうか（攻撃速度によるクールダウンを尊重）
+  // COMBAT状態のユニットは移動しながらでも攻撃可能
+  // MOVING状態（戦闘前の移動）のユニットは攻撃不可
+  if (unit->getState() != UnitState::IDLE &&
+      unit->getState() != UnitState::COMBAT) {
+    // 純粋な移動中（まだ戦闘に入っていない）は攻撃しない
+    return;
+  }
+
+  if (!unit->canAttack(nowSec)) {
+    return;
+  }
+
+  // ブロードフェーズは移動前のスナップショットなので、現在位置で射程を
+  // 確認してから攻撃要求を登録する（CombatDomainService::executeCombat と
+  // 同じガード）
+  if (!unit->isInAttackRange(*target)) {
+    return;
+  }
+
+  // 攻撃はティックの最後にまとめて解決する。攻撃時刻の更新（ユースケース側で
+  // 管理）と、次に攻撃可能になる時刻のスケジューラ登録はここで行い、
+  // それまでのティックではこのユニットを訪問しない。
+  pendingAttacks_.push_back(
+      {static_cast<uint32_t>(unitIndex), targetIndex});
+  unit->setLastAttackTime(nowSec);
+  cooldownScheduler_.schedule(unit->getId(),
+                              nowSec + 1.0f / unit->getStats().getAttackSpeed());
+}
+
+void CombatUseCase::resolvePendingAttacks() {
+  if (pendingAttacks_.empty()) {
+    return;
+  }
+
+  // Execute combat via the batch resolver. Damage, counter-attacks and HP
+  // updates for the whole tick are applied here in one pass.
+  batchResolver_.resolve(units_, pendingAttacks_);
+
+  for (size_t i = 0; i < pendingAttacks_.size(); ++i) {
+    const UnitEntity &attacker = *units_[pendingAttacks_[i].attackerIndex];
+    const UnitEntity &target = *units_[pendingAttacks_[i].targetIndex];
+    const auto result = batchResolver_.resultFor(i);
 
     // 攻撃実行のログ
-    aout << "CombatUseCase: Unit " << unit->getId() 
-         << " (state=" << unit->getStateString() << ")"
-         << " ATTACKED enemy " << target->getId()
+    aout << "CombatUseCase: Unit " << attacker.getId()
+         << " (state=" << attacker.getStateString() << ")"
+         << " ATTACKED enemy " << target.getId()
          << " - Damage: " << result.damageDealt
-         << ", Target HP: " << target->getStats().getCurrentHp()
-         << "/" << target->getStats().getMaxHp()
-         << std::endl;
+         << ", Target HP: " << target.getStats().getCurrentHp() << "/"
+         << target.getStats().getMaxHp() << std::endl;
 
     // イベント通知
     if (combatEventCallback_) {
-      combatEventCallback_(*unit, *target, result);
+      combatEventCallback_(attacker, target, result);
     }
   }
+  pendingAttacks_.clear();
 }
 
 bool CombatUseCase::executeAttack(int attackerId, int targetId) {
@@ -132,12 +253,20 @@ bool CombatUseCase::executeAttack(int attackerId, int targetId) {
   return true;
 }
 
-void CombatUseCase::removeDeadUnits() {
+size_t CombatUseCase::removeDeadUnits() {
+  for (const auto &unit : units_) {
+    if (unit->getStats().getCurrentHp() <= 0) {
+      unitTargetPolicies_.erase(unit->getId());
+      cooldownScheduler_.cancel(unit->getId());
+    }
+  }
+  const size_t before = units_.size();
   units_.erase(std::remove_if(units_.begin(), units_.end(),
                               [](const std::shared_ptr<UnitEntity> &unit) {
                                 return unit->getStats().getCurrentHp() <= 0;
                               }),
                units_.end());
+  return before - units_.size();
 }
 
 size_t CombatUseCase::getAliveUnitsCount() const {
@@ -165,11 +294,23 @@ std::shared_ptr<UnitEntity> CombatUseCase::findUnitById(int unitId) const {
   return (it != units_.end()) ? *it : nullptr;
 }
 
-std::shared_ptr<UnitEntity>
-CombatUseCase::findTargetInRange(const UnitEntity &attacker) {
-  // 攻撃対象を射程内から探索して最初に見つかった敵ユニットを返す（衝突半径は
-  // domain 側で考慮）
-  for (auto &unit : units_) {
+uint32_t CombatUseCase::findTargetInRange(size_t attackerIndex) {
+  // ブロードフェーズのペアは射程内の生存している敵だけなので、そのまま
+  // 選択ポリシーに流し込む（候補リストは作らない）
+  const UnitEntity &attacker = *units_[attackerIndex];
+  const TargetSelectionPolicy policy =
+      unitTargetPolicies_.empty() ? targetSelectionPolicy_
+                                  : getTargetPolicyFor(attacker.getId());
+  if (combatBroadphase_ && combatBroadphase_->covers(units_.size())) {
+    return TargetSelector::selectFromBroadphase(*combatBroadphase_, units_,
+                                                attackerIndex, policy);
+  }
+
+  // フォールバック: 全ユニットを走査し、射程内の敵を選択ポリシーで評価する
+  // （衝突半径は domain 側で考慮）
+  TargetSelector selector(attacker, policy);
+  for (size_t i = 0; i < units_.size(); ++i) {
+    const auto &unit = units_[i];
     if (unit->getId() == attacker.getId()) {
       continue; // 自分自身は除外
     }
@@ -183,10 +324,16 @@ CombatUseCase::findTargetInRange(const UnitEntity &attacker) {
       continue;
     }
 
-    if (CombatDomainService::isInAttackRange(attacker, *unit)) {
-      return unit;
+    if (!CombatDomainService::isInAttackRange(attacker, *unit)) {
+      continue;
+    }
+
+    const float dx = unit->getPosition().getX() - attacker.getPosition().getX();
+    const float dy = unit->getPosition().getY() - attacker.getPosition().getY();
+    if (!selector.offer(static_cast<uint32_t>(i), *unit, dx * dx + dy * dy)) {
+      break;
     }
   }
 
-  return nullptr;
+  return selector.getTargetIndex();
 }
@@ -14,9 +14,16 @@
  */
 
 #include "../domain/entities/UnitEntity.h"
+#include "../domain/services/ActiveUnitSets.h"
+#include "../domain/services/AttackCooldownScheduler.h"
+#include "../domain/services/BatchCombatResolver.h"
+#include "../domain/services/CombatBroadphase.h"
 #include "../domain/services/CombatDomainService.h"
+#include "../domain/services/TargetSelector.h"
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -51,14 +58,71 @@ public:
    */
   void setCombatEventCallback(CombatEventCallback callback);
 
+  /**
+   * @brief ティックごとに構築される戦闘ブロードフェーズを注入する
+   * @param broadphase 射程内ペアのリスト（nullptr の場合は全探索）
+   *
+   * 所有権は呼び出し側が持つ。units と同じ配列に対して構築されている必要がある。
+   */
+  void setCombatBroadphase(const CombatBroadphase *broadphase);
+
+  /**
+   * @brief 起きているユニットの集合を注入する
+   * @param activeUnitSets nullptr の場合は全ユニットを走査する
+   *
+   * ブロードフェーズが無いときの自動戦闘で、眠っている（周囲に敵のいない
+   * 待機中の）ユニットを訪問しないために使う。
+   */
+  void setActiveUnitSets(const ActiveUnitSets *activeUnitSets) {
+    activeUnitSets_ = activeUnitSets;
+  }
+
+  /**
+   * @brief 自動戦闘で攻撃対象を選ぶポリシーを設定
+   * @param policy 選択ポリシー（既定は FIRST_IN_RANGE）
+   */
+  void setTargetSelectionPolicy(TargetSelectionPolicy policy);
+  TargetSelectionPolicy getTargetSelectionPolicy() const {
+    return targetSelectionPolicy_;
+  }
+
+  /**
+   * @brief 特定ユニットの攻撃対象選択ポリシーを上書きする（AI 用）
+   * @param unitId 対象ユニットのID
+   * @param policy このユニットが使うポリシー
+   */
+  void setUnitTargetPolicy(int unitId, TargetSelectionPolicy policy);
+
+  /**
+   * @brief ユニットごとの上書きを解除し、全体のポリシーに戻す
+   */
+  void clearUnitTargetPolicy(int unitId);
+
+  /**
+   * @brief 指定ユニットに適用されるポリシー（上書きが無ければ全体の設定）
+   */
+  TargetSelectionPolicy getTargetPolicyFor(int unitId) const;
+
   /**
    * @brief 自動戦闘処理を実行
    *
    * 全ユニットに対して攻撃範囲内の敵ユニットがいるかチェックし、
    * 自動的に戦闘を実行します。
+   *
+   * ブロードフェーズが注入されている場合は、射程内に敵がいてクールダウンが
+   * 明けているユニットと、交戦状態が解けたユニットだけを訪問します。
+   *
+   * 攻撃はティック中に収集し、最後に BatchCombatResolver でまとめて
+   * 解決します（同ティック内の攻撃は同時に命中したものとして扱う）。
    */
   void executeAutoCombat();
 
+  /**
+   * @brief 時刻を指定して自動戦闘処理を実行（テスト・固定ステップ更新用）
+   * @param nowSec 現在時刻（秒）。呼び出しごとに単調増加させること
+   */
+  void executeAutoCombat(float nowSec);
+
   /**
    * @brief 指定されたユニットで攻撃実行
    * @param attackerId 攻撃するユニットのID
@@ -69,8 +133,9 @@ public:
 
   /**
    * @brief 死亡したユニットを除去
+   * @return 除去したユニット数（0 以外ならユニットの並びが変わっている）
    */
-  void removeDeadUnits();
+  size_t removeDeadUnits();
 
   /**
    * @brief 生存ユニット数を取得
@@ -78,9 +143,55 @@ public:
    */
   size_t getAliveUnitsCount() const;
 
+  /**
+   * @brief クールダウン中として登録されているユニット数（計測・テスト用）
+   */
+  size_t getCoolingDownCount() const {
+    return cooldownScheduler_.scheduledCount();
+  }
+
 private:
   std::vector<std::shared_ptr<UnitEntity>> &units_;
+  // 自動戦闘の時刻の基準。float でもミリ秒以下の精度を保てるよう、
+  // エポックではなく生成時刻からの経過秒を使う
+  std::chrono::steady_clock::time_point startTime_;
   CombatEventCallback combatEventCallback_;
+  const CombatBroadphase *combatBroadphase_ = nullptr;
+  const ActiveUnitSets *activeUnitSets_ = nullptr;
+  std::vector<uint32_t> awakeIndices_; // 自動戦闘で訪問する起きているユニット
+  TargetSelectionPolicy targetSelectionPolicy_ =
+      TargetSelectionPolicy::FIRST_IN_RANGE;
+  // ユニットID -> 上書きされたポリシー
+  std::unordered_map<int, TargetSelectionPolicy> unitTargetPolicies_;
+
+  // 攻撃直後のユニットを次の攻撃可能時刻まで管理する
+  AttackCooldownScheduler cooldownScheduler_;
+  // 交戦中（射程内に敵がいる）ユニット。前ティックとの差分で離脱を判定する
+  std::vector<std::shared_ptr<UnitEntity>> engagedLastTick_;
+  std::vector<std::shared_ptr<UnitEntity>> engagedThisTick_;
+  std::vector<std::shared_ptr<UnitEntity>> disengaged_;
+
+  // このティックに発生した攻撃。executeAutoCombat の最後にまとめて解決する
+  std::vector<AttackRequest> pendingAttacks_;
+  BatchCombatResolver batchResolver_;
+
+  /**
+   * @brief ブロードフェーズとクールダウンスケジューラを使った自動戦闘
+   * @param nowSec 現在時刻（秒）
+   */
+  void executeScheduledAutoCombat(float nowSec);
+
+  /**
+   * @brief 1ユニット分の自動戦闘判定（離脱・攻撃要求の登録）
+   * @param unitIndex units_ 上のインデックス
+   * @param nowSec 現在時刻（秒）
+   */
+  void resolveAutoCombatFor(size_t unitIndex, float nowSec);
+
+  /**
+   * @brief 収集した攻撃要求をまとめて解決し、ログとイベントを通知する
+   */
+  void resolvePendingAttacks();
 
   /**
    * @brief ユニットIDからユニットを検索
@@ -92,10 +203,15 @@ private:
 
   /**
    * @brief 攻撃範囲内の敵ユニットを検索
-   * @param attacker 攻撃側ユニット
-   * @return 攻撃可能な敵ユニット（見つからない場合はnullptr）
+   * @param attackerIndex 攻撃側ユニットの units_ 上のインデックス
+   * @return 攻撃対象の units_ 上のインデックス（見つからない場合は
+   *         TargetSelector::kNoTarget）
+   *
+   * ブロードフェーズが利用可能ならそのペアリストを読み、そうでなければ
+   * 全ユニットを走査する。どちらの場合も対象は getTargetPolicyFor() の
+   * ポリシーに従って選ぶ。
    */
-  std::shared_ptr<UnitEntity> findTargetInRange(const UnitEntity &attacker);
+  uint32_t findTargetInRange(size_t attackerIndex);
 };
 
 #endif // SIMULATION_GAME_COMBAT_USECASE_H
@@ -0,0 +1,70 @@
+#include "InfluenceMapUseCase.h"
+
+/*
+ * InfluenceMapUseCase.cpp
+ *
+ * Each update:
+ * 1. Snapshot alive units into InfluenceSources (SoA).
+ * 2. InfluenceMap::beginUpdate applies small changes incrementally; when it
+ * asks for a full rebuild, the rows are split into one band per available core
+ * and rebuilt in parallel.
+ * 3. The memory layer is decayed by 0.5^(dt / halfLife), again per row band.
+ */
+#include "../domain/services/TargetSelector.h"
+#include <algorithm>
+#include <cmath>
+
+InfluenceMapUseCase::InfluenceMapUseCase(float minX, float minY, float maxX,
+                                         float maxY, IJobSystem *jobSystem,
+                                         const InfluenceMapConfig &config)
+    : jobSystem_(jobSystem), config_(config),
+      map_(minX, minY, maxX, maxY, config.cellSize) {}
+
+template <typename RowJob>
+void InfluenceMapUseCase::forEachRowBand(RowJob &&job) {
+  const int rows = map_.getRows();
+  const size_t concurrency = jobSystem_ ? jobSystem_->getConcurrency() : 1;
+  const int bands = static_cast<int>(
+      std::min<size_t>(concurrency, static_cast<size_t>(rows)));
+  if (!jobSystem_ || bands <= 1) {
+    job(0, rows);
+    return;
+  }
+  const int rowsPerBand = (rows + bands - 1) / bands;
+  jobSystem_->parallelFor(static_cast<size_t>(bands), [&](size_t band) {
+    const int rowBegin = static_cast<int>(band) * rowsPerBand;
+    job(rowBegin, std::min(rows, rowBegin + rowsPerBand));
+  });
+}
+
+void InfluenceMapUseCase::update(
+    const std::vector<std::shared_ptr<UnitEntity>> &units, float deltaTime) {
+  sources_.clear();
+  for (const auto &unit : units) {
+    if (!unit || !unit->isAlive()) {
+      continue;
+    }
+    sources_.ids.push_back(unit->getId());
+    sources_.factions.push_back(unit->getFaction());
+    sources_.xs.push_back(unit->getPosition().getX());
+    sources_.ys.push_back(unit->getPosition().getY());
+    sources_.strengths.push_back(TargetSelector::threatOf(*unit));
+    sources_.radii.push_back(unit->getStats().getAttackRange() +
+                             config_.reachBonus);
+  }
+
+  if (map_.beginUpdate(sources_)) {
+    forEachRowBand([this](int rowBegin, int rowEnd) {
+      map_.rebuildRows(sources_, rowBegin, rowEnd);
+    });
+    map_.finishRebuild(sources_);
+  }
+
+  const float factor =
+      config_.memoryHalfLife > 0.0f
+          ? std::pow(0.5f, std::max(deltaTime, 0.0f) / config_.memoryHalfLife)
+          : 0.0f;
+  forEachRowBand([this, factor](int rowBegin, int rowEnd) {
+    map_.decayRows(factor, rowBegin, rowEnd);
+  });
+}
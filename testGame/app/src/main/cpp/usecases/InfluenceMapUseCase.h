@@ -0,0 +1,78 @@
+#ifndef SIMULATION_GAME_INFLUENCE_MAP_USECASE_H
+#define SIMULATION_GAME_INFLUENCE_MAP_USECASE_H
+
+/*
+ * InfluenceMapUseCase.h
+ *
+ * Keeps per-faction influence (threat) maps up to date for AI decisions.
+ *
+ * Contract:
+ * - update() reads units only; it never modifies UnitEntity objects.
+ * - Queries on getMap() are O(1) per cell and valid until the next update().
+ */
+
+#include "../domain/entities/UnitEntity.h"
+#include "../domain/services/InfluenceMap.h"
+#include "interfaces/IJobSystem.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 影響度マップの設定
+ */
+struct InfluenceMapConfig {
+  float cellSize = 2.0f;      // セルの大きさ（ワールド単位）
+  float reachBonus = 2.0f;    // 攻撃射程に加える影響範囲
+  float memoryHalfLife = 3.0f; // 記憶レイヤーが半分になるまでの秒数
+};
+
+/**
+ * @brief AI 用の陣営別影響度マップを更新するユースケース
+ *
+ * 設計方針：
+ * - ユニットは SoA（InfluenceSources）にスナップショットしてから処理する。
+ *   影響の強さは TargetSelector::threatOf（期待DPS）、範囲は攻撃射程 +
+ *   reachBonus
+ * - 変化の少ない更新は InfluenceMap の増分更新で済ませ、全再構築と減衰は
+ *   行帯ごとのジョブに分けてジョブシステムで並列実行する
+ *
+ * 責任：
+ * - ライブ状態からのスナップショット作成
+ * - 行帯ジョブの分配
+ */
+class InfluenceMapUseCase {
+public:
+  /**
+   * @brief コンストラクタ
+   * @param minX, minY, maxX, maxY マップの範囲（ワールド座標）
+   * @param jobSystem ジョブシステム（nullptr の場合は呼び出しスレッドで実行）
+   * @param config 設定
+   *
+   * ジョブシステムの所有権は呼び出し側が持つ。
+   */
+  InfluenceMapUseCase(float minX, float minY, float maxX, float maxY,
+                      IJobSystem *jobSystem = nullptr,
+                      const InfluenceMapConfig &config = InfluenceMapConfig());
+
+  /**
+   * @brief ユニットの位置・生死を反映し、記憶レイヤーを減衰させる
+   * @param units ユニット配列（読み取りのみ）
+   * @param deltaTime 前回の update からの経過時間（秒）
+   */
+  void update(const std::vector<std::shared_ptr<UnitEntity>> &units,
+              float deltaTime);
+
+  const InfluenceMap &getMap() const { return map_; }
+  const InfluenceMapConfig &getConfig() const { return config_; }
+
+private:
+  // マップの行を並列数ぶんの行帯に分けて job(rowBegin, rowEnd) を実行する
+  template <typename RowJob> void forEachRowBand(RowJob &&job);
+
+  IJobSystem *jobSystem_;
+  InfluenceMapConfig config_;
+  InfluenceMap map_;
+  InfluenceSources sources_;
+};
+
+#endif // SIMULATION_GAME_INFLUENCE_MAP_USECASE_H
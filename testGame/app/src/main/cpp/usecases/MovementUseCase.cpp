@@ -1,5 +1,7 @@
 #include "MovementUseCase.h"
+#include "../domain/services/FormationPlanner.h"
 #include "../domain/services/MovementField.h"
+#include "../domain/services/PathSmoother.h"
 #include "../frameworks/android/AndroidOut.h"
 #include <algorithm>
 #include <chrono>
@@ -20,6 +22,10 @@ void MovementUseCase::setMovementFailedCallback(
   movementFailedCallback_ = callback;
 }
 
+void MovementUseCase::setCombatBroadphase(const CombatBroadphase *broadphase) {
+  combatBroadphase_ = broadphase;
+}
+
 bool MovementUseCase::moveUnitTo(int unitId, const Position &targetPosition) {
   if (!movementEnabled_) {
     if (movementFailedCallback_) {
@@ -44,8 +50,6 @@ bool MovementUseCase::moveUnitTo(int unitId, const Position &targetPosition) {
     return false;
   }
 
-  auto otherUnits = getOtherUnits(*unit);
-
   Position boundedTarget = applyBounds(*unit, targetPosition);
   Position terrainAwareTarget = boundedTarget;
   
@@ -55,6 +59,18 @@ bool MovementUseCase::moveUnitTo(int unitId, const Position &targetPosition) {
     auto rayResult = gameMap_->clipMovementRaycast(unit->getPosition(),
                                                    boundedTarget, radius);
     terrainAwareTarget = rayResult.position;
+
+    // 直線が遮られる場合は迂回経路を探し、見つかればその経由点をたどる
+    if (rayResult.hitBlocking &&
+        gameMap_->isWalkable(boundedTarget, radius)) {
+      dropRoute(unitId);
+      if (planRoute(unit->getPosition(), boundedTarget, radius) &&
+          commitMoveOrder(*unit, targetPosition, routeWaypoints_[1])) {
+        beginRoute(*unit, boundedTarget, nullptr);
+        ++pathValidationCount_;
+        return true;
+      }
+    }
     
     if (rayResult.hitBlocking) {
       // 停止タイルに遮られた場合、到達可能な位置を最終目標とする
@@ -74,291 +90,846 @@ bool MovementUseCase::moveUnitTo(int unitId, const Position &targetPosition) {
     }
   }
 
-  Position avoidanceTarget = CollisionDomainService::calculateAvoidancePosition(
-      *unit, terrainAwareTarget, otherUnits);
-
-  avoidanceTarget = applyBounds(*unit, avoidanceTarget);
+  // 他ユニットとの干渉は移動中の局所回避（ORCA）で解決するため、ここでは
+  // 目標位置をずらさない
+  Position finalTarget = applyBounds(*unit, terrainAwareTarget);
   if (gameMap_) {
     const float radius = unit->getStats().getCollisionRadius();
     auto rayResult = gameMap_->clipMovementRaycast(unit->getPosition(),
-                                                   avoidanceTarget, radius);
-    avoidanceTarget = rayResult.position;
+                                                   finalTarget, radius);
+    finalTarget = rayResult.position;
+  }
+
+  if (!commitMoveOrder(*unit, targetPosition, finalTarget)) {
+    return false;
   }
+  // 上のレイキャストで現在位置から finalTarget までの直線は検証済み
+  validatedPaths_[unit->getId()] =
+      ValidatedPath{unit->getPosition(), finalTarget, currentTerrainEpoch()};
+  ++pathValidationCount_;
+  return true;
+}
 
-  Position fromPosition = unit->getPosition();
-  const float travelDistance = fromPosition.distanceTo(avoidanceTarget);
+size_t MovementUseCase::moveFormationTo(const std::vector<int> &unitIds,
+                                        const Position &targetPosition,
+                                        float spacing) {
+  if (!movementEnabled_ || unitIds.empty()) {
+    return 0;
+  }
+
+  // 対象ユニットを units_ の1回の走査で集める（ID は二分探索）
+  std::vector<int> sortedIds(unitIds);
+  std::sort(sortedIds.begin(), sortedIds.end());
+  std::vector<std::shared_ptr<UnitEntity>> members;
+  formationPositions_.clear();
+  float maxRadius = 0.0f;
+  float sumX = 0.0f;
+  float sumY = 0.0f;
+  for (const auto &unit : units_) {
+    if (!unit || unit->getStats().getCurrentHp() <= 0 ||
+        !std::binary_search(sortedIds.begin(), sortedIds.end(),
+                            unit->getId())) {
+      continue;
+    }
+    members.push_back(unit);
+    formationPositions_.push_back(unit->getPosition());
+    maxRadius = std::max(maxRadius, unit->getStats().getCollisionRadius());
+    sumX += unit->getPosition().getX();
+    sumY += unit->getPosition().getY();
+  }
+  if (members.empty()) {
+    return 0;
+  }
+  if (members.size() == 1) {
+    return moveUnitTo(members.front()->getId(), targetPosition) ? 1 : 0;
+  }
+
+  // アンカー（隊形の中心）の経路を地形に対して求める。直線が遮られても
+  // 目標が歩けるなら迂回経路の終点を、迂回できなければ遮られた手前を使う
+  const size_t count = members.size();
+  const Position anchorStart(sumX / count, sumY / count);
+  Position anchorTarget = targetPosition;
+  if (movementField_) {
+    anchorTarget = movementField_->snapInside(anchorTarget);
+  }
+  formationRoute_.clear();
+  if (gameMap_) {
+    const Position bounded = gameMap_->clampInside(anchorTarget, maxRadius);
+    const auto rayResult =
+        gameMap_->clipMovementRaycast(anchorStart, bounded, maxRadius);
+    anchorTarget = rayResult.position;
+    if (rayResult.hitBlocking && gameMap_->isWalkable(bounded, maxRadius) &&
+        planRoute(anchorStart, bounded, maxRadius)) {
+      formationRoute_ = routeWaypoints_;
+      anchorTarget = bounded;
+    }
+  }
+
+  // 隊形は最後の区間の向きにそろえる
+  const Position facingFrom = formationRoute_.size() > 2
+                                  ? formationRoute_[formationRoute_.size() - 2]
+                                  : anchorStart;
+  float facingX = anchorTarget.getX() - facingFrom.getX();
+  float facingY = anchorTarget.getY() - facingFrom.getY();
+  const float facingLength = std::sqrt(facingX * facingX + facingY * facingY);
+  if (facingLength > 1e-4f) {
+    facingX /= facingLength;
+    facingY /= facingLength;
+  } else {
+    facingX = 0.0f;
+    facingY = 1.0f;
+  }
+  if (spacing <= 0.0f) {
+    spacing = std::max(3.0f * maxRadius, 0.1f);
+  }
+
+  FormationPlanner::buildSlotOffsets(count, spacing, facingX, facingY,
+                                     formationSlots_);
+  for (Position &slot : formationSlots_) {
+    slot = anchorTarget + slot;
+    if (gameMap_) {
+      slot = gameMap_->clampInside(slot, maxRadius);
+    }
+  }
+
+  // 枠の歩行可能性はまとめて判定し、歩けない枠だけアンカー側へ引き戻す
+  if (gameMap_) {
+    formationWalkable_.resize(count);
+    gameMap_->areWalkable(formationSlots_.data(), count, maxRadius,
+                          formationWalkable_.data());
+    for (size_t slot = 0; slot < count; ++slot) {
+      if (!formationWalkable_[slot]) {
+        formationSlots_[slot] = gameMap_->resolveMovementTarget(
+            anchorTarget, formationSlots_[slot], maxRadius);
+      }
+    }
+  }
+
+  FormationPlanner::assignSlots(formationPositions_, facingX, facingY,
+                                formationAssignment_);
+  size_t ordered = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const Position &slot = formationSlots_[formationAssignment_[i]];
+    if (orderFormationMember(*members[i], targetPosition, slot)) {
+      ++ordered;
+    }
+  }
+  return ordered;
+}
+
+bool MovementUseCase::orderFormationMember(UnitEntity &unit,
+                                           const Position &targetPosition,
+                                           const Position &slot) {
+  if (!gameMap_) {
+    return commitMoveOrder(unit, targetPosition, slot);
+  }
+  // アンカーの経由点はアンカーの半径（隊形内の最大）で通れるので、
+  // 新しくできる両端の区間だけを自分の半径で確かめる
+  const float radius = unit.getStats().getCollisionRadius();
+  auto isClear = [&](const Position &from, const Position &to) {
+    return gameMap_->clipMovementRaycast(from, to, radius).position == to;
+  };
+  routeWaypoints_.assign(1, unit.getPosition());
+  if (formationRoute_.size() > 2) {
+    routeWaypoints_.insert(routeWaypoints_.end(), formationRoute_.begin() + 1,
+                           formationRoute_.end() - 1);
+  }
+  routeWaypoints_.push_back(slot);
+  const size_t last = routeWaypoints_.size() - 1;
+  const bool legsClear =
+      isClear(routeWaypoints_[0], routeWaypoints_[1]) &&
+      (last == 1 || isClear(routeWaypoints_[last - 1], routeWaypoints_[last]));
+  bool routed = legsClear && (last == 1 || smoothRoute(radius));
+  if (!legsClear) {
+    // 経由点へまっすぐ行けないユニットは自分の経路を探す
+    routed = gameMap_->isWalkable(slot, radius) &&
+             planRoute(unit.getPosition(), slot, radius);
+  }
+  if (!routed) {
+    // 経路がなければ枠を目標にし、次の更新で通れるところまで切り詰める
+    return commitMoveOrder(unit, targetPosition, slot);
+  }
+
+  if (!commitMoveOrder(unit, targetPosition, routeWaypoints_[1])) {
+    return false;
+  }
+  ++pathValidationCount_;
+  if (routeWaypoints_.size() > 2) {
+    beginRoute(unit, slot, nullptr);
+  } else {
+    validatedPaths_[unit.getId()] =
+        ValidatedPath{routeWaypoints_[0], routeWaypoints_[1],
+                      currentTerrainEpoch()};
+  }
+  return true;
+}
+
+bool MovementUseCase::commitMoveOrder(UnitEntity &unit,
+                                      const Position &targetPosition,
+                                      const Position &finalTarget) {
+  dropRoute(unit.getId()); // 新しい命令は前の迂回経路を置き換える
+  Position fromPosition = unit.getPosition();
+  const float travelDistance = fromPosition.distanceTo(finalTarget);
   if (travelDistance <= 1e-4f) {
     if (movementFailedCallback_) {
-      movementFailedCallback_(*unit, targetPosition, "No viable path found");
+      movementFailedCallback_(unit, targetPosition, "No viable path found");
     }
     return false;
   }
 
   // 移動命令前の状態をログ出力
-  aout << "MovementUseCase::moveUnitTo Unit " << unit->getId()
-       << " state=" << unit->getStateString()
+  aout << "MovementUseCase::moveUnitTo Unit " << unit.getId()
+       << " state=" << unit.getStateString()
        << " from=(" << fromPosition.getX() << ", " << fromPosition.getY() << ")"
-       << " to=(" << avoidanceTarget.getX() << ", " << avoidanceTarget.getY() << ")"
+       << " to=(" << finalTarget.getX() << ", " << finalTarget.getY() << ")"
        << std::endl;
 
-  bool setResult = unit->setTargetPosition(avoidanceTarget);
+  bool setResult = unit.setTargetPosition(finalTarget);
   
   // 新しい移動命令を受け取ったら、1秒間は攻撃意思を抑制
   // これにより移動中に敵を無視して通過できる
   if (setResult) {
     auto now = std::chrono::high_resolution_clock::now();
     float nowSec = std::chrono::duration<float>(now.time_since_epoch()).count();
-    unit->suppressAttackFor(nowSec, 1.0f); // 1秒間攻撃意思を抑制
+    unit.suppressAttackFor(nowSec, 1.0f); // 1秒間攻撃意思を抑制
     
     aout << "MovementUseCase::moveUnitTo attack suppressed for 1 second" << std::endl;
   }
   
   aout << "MovementUseCase::moveUnitTo setTargetPosition result=" 
        << (setResult ? "success" : "failed")
-       << " newState=" << unit->getStateString()
+       << " newState=" << unit.getStateString()
        << std::endl;
 
   if (!setResult) {
     if (movementFailedCallback_) {
-      movementFailedCallback_(*unit, targetPosition, 
+      movementFailedCallback_(unit, targetPosition, 
                               "setTargetPosition failed - unit cannot move in current state");
     }
     return false;
   }
 
   if (movementEventCallback_) {
-    movementEventCallback_(*unit, fromPosition, avoidanceTarget);
+    movementEventCallback_(unit, fromPosition, finalTarget);
   }
 
-  if (gameMap_ && targetPosition.distanceTo(avoidanceTarget) > 0.05f) {
+  if (gameMap_ && targetPosition.distanceTo(finalTarget) > 0.05f) {
     aout << "MovementUseCase: adjusted target due to terrain from ("
          << targetPosition.getX() << ", " << targetPosition.getY() << ") to ("
-         << avoidanceTarget.getX() << ", " << avoidanceTarget.getY() << ")"
+         << finalTarget.getX() << ", " << finalTarget.getY() << ")"
          << std::endl;
   }
 
   return true;
 }
 
+bool MovementUseCase::planRoute(const Position &start, const Position &goal,
+                                float radius) {
+  if (!gameMap_) {
+    return false;
+  }
+  // 跳び越せるタイルが多い地形は Jump Point Search（最短経路）で、地形の
+  // 境目が多く跳び越しが効かない地形はナビゲーショングラフで探す
+  if (navGraph_ && pathfinder_.getUniformTileRatio(*gameMap_, radius) <
+                       kJumpPointMinUniformRatio) {
+    navGraph_->update(*gameMap_);
+    if (navGraph_->isCurrent(*gameMap_, radius) &&
+        navGraph_->findPath(start, goal, routeWaypoints_)) {
+      lastRouteBackend_ = RouteBackend::NavigationGraph;
+      return smoothRoute(radius);
+    }
+  }
+  lastRouteBackend_ = RouteBackend::JumpPoint;
+  return pathfinder_.findPath(*gameMap_, start, goal, radius,
+                              routeWaypoints_) &&
+         smoothRoute(radius);
+}
+
+bool MovementUseCase::replanRoute(UnitEntity &unit) {
+  auto found = routes_.find(unit.getId());
+  if (found == routes_.end() || !gameMap_) {
+    return false;
+  }
+  ++routeReplanCount_;
+  const Position goal = found->second.goal;
+  const float radius = unit.getStats().getCollisionRadius();
+  std::unique_ptr<IncrementalPathfinder> planner =
+      std::move(found->second.planner);
+  bool planned = false;
+  if (planner && planner->hasPlan()) {
+    // 前回の探索を使い、変更されたタイルの周りだけを探し直す
+    planned = planner->repair(*gameMap_, unit.getPosition(),
+                              routeWaypoints_) &&
+              smoothRoute(radius);
+    lastRouteBackend_ = RouteBackend::Incremental;
+    if (planner->wasLastRepairAbandoned()) {
+      // 修復の方が高くつく地形（開けた場所を横切る壁など）。この経路では
+      // 以降も探索状態を持たずに最初から探す
+      releasePlanner(std::move(planner));
+      found->second.repairable = false;
+      planned = planRoute(unit.getPosition(), goal, radius);
+    }
+  } else {
+    // 地形の変更で初めて求め直す経路から探索状態を持たせ、以降の変更は
+    // 修復で済ませる（地形が変わらずに逸れただけなら最初と同じ探索）
+    if (!planner && found->second.repairable &&
+        found->second.plannedEpoch != currentTerrainEpoch()) {
+      planner = acquirePlanner();
+    }
+    if (planner) {
+      planned = planner->plan(*gameMap_, unit.getPosition(), goal, radius,
+                              routeWaypoints_) &&
+                smoothRoute(radius);
+      lastRouteBackend_ = RouteBackend::Incremental;
+    } else {
+      planned = planRoute(unit.getPosition(), goal, radius);
+    }
+  }
+  if (planned && unit.setTargetPosition(routeWaypoints_[1])) {
+    beginRoute(unit, goal, std::move(planner));
+    routes_[unit.getId()].nextReplanTick =
+        velocityTick_ + kReplanCooldownTicks;
+    return true;
+  }
+  releasePlanner(std::move(planner));
+  dropRoute(unit.getId());
+  return false;
+}
+
+bool MovementUseCase::smoothRoute(float radius) {
+  PathSmoother::smooth(*gameMap_, radius, routeWaypoints_);
+  // 現在位置と重なる経由点（開始タイルの中心に立っている場合）は飛ばす
+  while (routeWaypoints_.size() > 2 &&
+         routeWaypoints_[1].distanceTo(routeWaypoints_[0]) <= 1e-4f) {
+    routeWaypoints_.erase(routeWaypoints_.begin() + 1);
+  }
+  return routeWaypoints_.size() >= 2;
+}
+
+void MovementUseCase::beginRoute(
+    UnitEntity &unit, const Position &goal,
+    std::unique_ptr<IncrementalPathfinder> planner) {
+  const Position &first = routeWaypoints_[1];
+  validatedPaths_[unit.getId()] =
+      ValidatedPath{routeWaypoints_[0], first, currentTerrainEpoch()};
+  Route &route = routes_[unit.getId()];
+  releasePlanner(std::move(route.planner));
+  route.current = first;
+  route.goal = goal;
+  route.remaining.assign(routeWaypoints_.rbegin(),
+                         routeWaypoints_.rend() - 2);
+  route.planner = std::move(planner);
+  route.plannedEpoch = currentTerrainEpoch();
+}
+
+void MovementUseCase::dropRoute(int unitId) {
+  auto found = routes_.find(unitId);
+  if (found != routes_.end()) {
+    releasePlanner(std::move(found->second.planner));
+    routes_.erase(found);
+  }
+}
+
+std::unique_ptr<IncrementalPathfinder> MovementUseCase::acquirePlanner() {
+  if (!sparePlanners_.empty()) {
+    std::unique_ptr<IncrementalPathfinder> planner =
+        std::move(sparePlanners_.back());
+    sparePlanners_.pop_back();
+    ++plannersInUse_;
+    return planner;
+  }
+  if (plannersInUse_ >= kMaxIncrementalRoutes) {
+    return nullptr; // 上限を超えた経路は GridPathfinder で探し直す
+  }
+  ++plannersInUse_;
+  return std::make_unique<IncrementalPathfinder>();
+}
+
+void MovementUseCase::releasePlanner(
+    std::unique_ptr<IncrementalPathfinder> planner) {
+  if (planner) {
+    --plannersInUse_;
+    // 使い回すのは数個まで。残りは経路の終わりに解放する
+    if (sparePlanners_.size() < kMaxSparePlanners) {
+      sparePlanners_.push_back(std::move(planner));
+    }
+  }
+}
+
+bool MovementUseCase::advanceRoute(UnitEntity &unit,
+                                   const Position &position) {
+  auto found = routes_.find(unit.getId());
+  if (found == routes_.end()) {
+    return false;
+  }
+  Route &route = found->second;
+  if (route.current != unit.getTargetPosition() || route.remaining.empty()) {
+    dropRoute(unit.getId()); // 目標が変えられたか、経路の終わりに着いた
+    return false;
+  }
+  const Position next = route.remaining.back();
+  if (!unit.setTargetPosition(next)) {
+    dropRoute(unit.getId());
+    return false;
+  }
+  // 経由点ちょうどからなら次の区間は検証済み。手前で切り上げた場合は
+  // 次のフレームで現在位置から検証し直す
+  if (position == route.current) {
+    validatedPaths_[unit.getId()] =
+        ValidatedPath{position, next, currentTerrainEpoch()};
+  } else {
+    invalidatePath(unit.getId());
+  }
+  route.remaining.pop_back();
+  route.current = next;
+  return true;
+}
+
 void MovementUseCase::updateMovements(float deltaTime) {
   // 現在時刻を取得（攻撃意思のチェックに使用）
   auto now = std::chrono::high_resolution_clock::now();
   float nowSec = std::chrono::duration<float>(now.time_since_epoch()).count();
-  
-  for (auto &unit : units_) {
-    if (!unit || unit->getStats().getCurrentHp() <= 0) {
-      continue;
+
+  avoidanceAgents_.clear();
+  agentUnitIndices_.clear();
+  agentSteps_.clear();
+  ++velocityTick_;
+  velocities_.resize(units_.size(), SlotVelocity{-1, 0, Velocity{0.0f, 0.0f}});
+
+  const bool activeOnly = activeUnitSets_ &&
+                          activeUnitSets_->covers(units_.size()) &&
+                          combatBroadphase_ &&
+                          combatBroadphase_->covers(units_.size());
+  if (activeOnly) {
+    // 移動命令を持ちうるのは移動中か戦闘中のユニットだけ。待機中のユニットは
+    // 訪問しない（units_ の順に揃えて全走査のときと同じ順序で処理する）
+    activeIndices_.assign(activeUnitSets_->getMoving().begin(),
+                          activeUnitSets_->getMoving().end());
+    activeIndices_.insert(activeIndices_.end(),
+                          activeUnitSets_->getInCombat().begin(),
+                          activeUnitSets_->getInCombat().end());
+    std::sort(activeIndices_.begin(), activeIndices_.end());
+    for (size_t unitIndex : activeIndices_) {
+      gatherWithLod(unitIndex, deltaTime, nowSec);
     }
-    // 移動が必要かチェック：目標位置と現在位置が異なる場合のみ処理
-    // これにより、MOVING状態でもCOMBAT状態でも、移動命令があれば移動できる
-    if (unit->getPosition() == unit->getTargetPosition()) {
-      continue; // 移動の必要なし
+    gatherStaticNeighbors();
+  } else {
+    for (size_t unitIndex = 0; unitIndex < units_.size(); ++unitIndex) {
+      gatherWithLod(unitIndex, deltaTime, nowSec);
     }
-    
+  }
+
+  proposeVelocities(deltaTime);
+
+  for (size_t agent = 0; agent < avoidanceAgents_.size(); ++agent) {
+    if (avoidanceAgents_.movable[agent]) {
+      applyVelocity(agent, agentSteps_[agent]);
+    }
+  }
+}
+
+MovementUseCase::Velocity
+MovementUseCase::previousVelocity(size_t unitIndex) const {
+  const SlotVelocity &slot = velocities_[unitIndex];
+  if (slot.unitId != units_[unitIndex]->getId() ||
+      slot.tick + 1 != velocityTick_) {
+    return Velocity{0.0f, 0.0f};
+  }
+  return slot.velocity;
+}
+
+void MovementUseCase::gatherWithLod(size_t unitIndex, float deltaTime,
+                                    float nowSec) {
+  auto &unit = units_[unitIndex];
+  if (!simulationLod_ || !unit || unit->getStats().getCurrentHp() <= 0 ||
+      unit->getPosition() == unit->getTargetPosition()) {
+    gatherAgent(unitIndex, deltaTime, nowSec);
+    return;
+  }
+
+  const float stepTime = simulationLod_->stepFor(*unit, deltaTime);
+  if (stepTime > 0.0f) {
+    gatherAgent(unitIndex, stepTime, nowSec);
+    return;
+  }
+
+  // 今回は進めない。速度は次に進むときの回避の入力として残す
+  SlotVelocity &slot = velocities_[unitIndex];
+  if (slot.unitId == unit->getId() && slot.tick + 1 == velocityTick_) {
+    slot.tick = velocityTick_;
+  }
+  avoidanceAgents_.push(unit->getPosition().getX(), unit->getPosition().getY(),
+                        0.0f, 0.0f, 0.0f, 0.0f,
+                        unit->getStats().getCollisionRadius(), 0.0f, false);
+  agentUnitIndices_.push_back(unitIndex);
+  agentSteps_.push_back(0.0f);
+}
+
+void MovementUseCase::gatherAgent(size_t unitIndex, float stepTime,
+                                  float nowSec) {
+  auto &unit = units_[unitIndex];
+  if (!unit || unit->getStats().getCurrentHp() <= 0) {
+    return;
+  }
+  const Position currentPos = unit->getPosition();
+  const float radius = unit->getStats().getCollisionRadius();
+
+  // 移動が必要かチェック：目標位置と現在位置が異なる場合のみ処理
+  // これにより、MOVING状態でもCOMBAT状態でも、移動命令があれば移動できる
+  bool needsMove = currentPos != unit->getTargetPosition();
+  if (needsMove) {
     // デバッグ：移動処理開始
     bool wantsAttack = unit->wantsToAttack(nowSec);
     aout << "MovementUseCase::updateMovements: Unit " << unit->getId()
          << " state=" << unit->getStateString()
          << " wantsAttack=" << (wantsAttack ? "YES" : "NO")
-         << " pos=(" << unit->getPosition().getX() << ", " << unit->getPosition().getY() << ")"
-         << " target=(" << unit->getTargetPosition().getX() << ", " << unit->getTargetPosition().getY() << ")"
-         << std::endl;
+         << " pos=(" << currentPos.getX() << ", " << currentPos.getY() << ")"
+         << " target=(" << unit->getTargetPosition().getX() << ", "
+         << unit->getTargetPosition().getY() << ")" << std::endl;
 
     // 敵が攻撃範囲に入った時の自動停止は、MOVING状態で攻撃意思がある場合のみ適用
     // 攻撃したくない状態の場合は、敵を無視して移動を継続
     if (unit->getState() == UnitState::MOVING && wantsAttack) {
-      auto enemyInRange = findEnemyInAttackRange(*unit);
+      auto enemyInRange = findEnemyInAttackRange(unitIndex);
       if (enemyInRange) {
         // 攻撃範囲ギリギリの位置を計算（現在位置を返す）
-        Position attackRangePos = calculateAttackRangePosition(*unit, *enemyInRange);
-        Position currentPos = unit->getPosition();
-        float distanceToEnemy = currentPos.distanceTo(enemyInRange->getPosition());
+        Position attackRangePos =
+            calculateAttackRangePosition(*unit, *enemyInRange);
+        float distanceToEnemy =
+            currentPos.distanceTo(enemyInRange->getPosition());
         float distanceToStop = currentPos.distanceTo(attackRangePos);
-        
-        // 現在位置で停止するため、目標位置を現在位置に設定してからCOMBAT状態に遷移
-        // setTargetPosition()を使わず、直接状態を変更
-        unit->enterCombat(); // 戦闘状態に遷移（これによりその場で停止）
-        
-        aout << "MovementUseCase: Unit " << unit->getId() 
-             << " AUTO-STOPPED - enemy " << enemyInRange->getId() 
-             << " in attack range (distance to enemy: " << distanceToEnemy << ")"
-             << std::endl
-             << "  Current pos: (" << currentPos.getX() << ", " << currentPos.getY() << ")"
-             << " -> Stop pos: (" << attackRangePos.getX() << ", " << attackRangePos.getY() << ")"
-             << " (distance to stop: " << distanceToStop << ")"
-             << std::endl
+
+        // 戦闘状態に遷移（これによりその場で停止）
+        unit->enterCombat();
+
+        aout << "MovementUseCase: Unit " << unit->getId()
+             << " AUTO-STOPPED - enemy " << enemyInRange->getId()
+             << " in attack range (distance to enemy: " << distanceToEnemy
+             << ")" << std::endl
+             << "  Current pos: (" << currentPos.getX() << ", "
+             << currentPos.getY() << ")"
+             << " -> Stop pos: (" << attackRangePos.getX() << ", "
+             << attackRangePos.getY() << ")"
+             << " (distance to stop: " << distanceToStop << ")" << std::endl
              << "  Attack range: " << unit->getStats().getAttackRange()
-             << ", State changed to COMBAT"
-             << std::endl;
-        
-        // 移動処理をスキップ（その場で停止）
-        continue;
+             << ", State changed to COMBAT" << std::endl;
+        needsMove = false;
       }
     }
+  }
 
-    unit->setTargetPosition(applyBounds(*unit, unit->getTargetPosition()));
+  // 止まっているユニットも近傍として回避計算に参加する
+  float preferredX = 0.0f;
+  float preferredY = 0.0f;
+  float maxSpeed = 0.0f;
+  Velocity velocity{0.0f, 0.0f};
+  if (needsMove && stepTime > 0.0f) {
+    // 経路の検証は目標か地形が変わったときだけ。それ以外は検証済みの直線を
+    // 進むだけなので、地形からは現在位置の速度倍率だけを引く
+    if (!hasValidPath(*unit)) {
+      validatePath(*unit);
+    }
+    const Position &target = unit->getTargetPosition();
+    const float distance = currentPos.distanceTo(target);
+    maxSpeed = unit->getStats().getMoveSpeed() *
+               terrainSpeedMultiplier(*unit, currentPos);
+    const float step = std::min(distance, maxSpeed * stepTime);
+    if (distance > 1e-3f && step > 0.0f) {
+      const float scale = step / (distance * stepTime);
+      preferredX = (target.getX() - currentPos.getX()) * scale;
+      preferredY = (target.getY() - currentPos.getY()) * scale;
+      velocity = previousVelocity(unitIndex);
+    } else if (distance > 1e-3f) {
+      needsMove = false; // 通れない地形の上では進めない
+    } else {
+      preferredX = (target.getX() - currentPos.getX()) / stepTime;
+      preferredY = (target.getY() - currentPos.getY()) / stepTime;
+    }
+  } else {
+    needsMove = false;
+  }
 
-    Position currentPos = unit->getPosition();
-    Position nextPos = calculateNextPosition(*unit, deltaTime);
+  avoidanceAgents_.push(currentPos.getX(), currentPos.getY(), velocity.x,
+                        velocity.y, preferredX, preferredY, radius, maxSpeed,
+                        needsMove);
+  agentUnitIndices_.push_back(unitIndex);
+  agentSteps_.push_back(stepTime);
+}
 
-    auto logFinalMovement = [&](const Position &destination,
-                                const char *reason) {
-      if (currentPos == destination) {
-        return;
-      }
-      const float baseSpeed = unit->getStats().getMoveSpeed();
-    const float multiplier =
-      terrainSpeedMultiplier(*unit, currentPos);
-      const float effectiveSpeed = baseSpeed * multiplier;
-
-      aout << "MovementUseCase::updateMovements unit=" << unit->getId()
-           << " reason=" << reason << " from=(" << currentPos.getX() << ", "
-           << currentPos.getY() << ")" << " to=(" << destination.getX() << ", "
-           << destination.getY() << ")" << " baseSpeed=" << baseSpeed
-           << " terrainMultiplier=" << multiplier
-           << " effectiveSpeed=" << effectiveSpeed << " deltaTime=" << deltaTime
-           << std::endl;
-    };
-
-    auto otherUnits = getOtherUnits(*unit);
-    float movingRadius = unit->getStats().getCollisionRadius();
-    Position contactPos = currentPos;
-    const UnitEntity *contactUnit = nullptr;
-    bool hasContact = CollisionDomainService::findFirstContactOnPath(
-        currentPos, nextPos, otherUnits, contactPos, contactUnit, unit.get(),
-        movingRadius);
-
-    if (hasContact) {
-      constexpr float kEpsT = 1e-3f;
-      constexpr float kBackoffDistance = 0.02f;
-
-      float segmentLen = currentPos.distanceTo(nextPos);
-      float t = 0.0f;
-      if (segmentLen > 1e-6f) {
-        t = currentPos.distanceTo(contactPos) / segmentLen;
-      }
+void MovementUseCase::gatherStaticNeighbors() {
+  const size_t moverCount = avoidanceAgents_.size();
+  if (moverCount == 0) {
+    return;
+  }
+  if (agentStamps_.size() != units_.size()) {
+    agentStamps_.assign(units_.size(), 0);
+    agentStampGeneration_ = 0;
+  }
+  if (++agentStampGeneration_ == 0) {
+    std::fill(agentStamps_.begin(), agentStamps_.end(), 0);
+    agentStampGeneration_ = 1;
+  }
+  for (size_t unitIndex : agentUnitIndices_) {
+    agentStamps_[unitIndex] = agentStampGeneration_;
+  }
 
-      float dirX = 0.0f;
-      float dirY = 0.0f;
-      if (segmentLen > 1e-6f) {
-        dirX = (nextPos.getX() - currentPos.getX()) / segmentLen;
-        dirY = (nextPos.getY() - currentPos.getY()) / segmentLen;
-      }
+  // 止まっているユニットは動かないので、ブロードフェーズ構築時の位置で引ける
+  const FactionSpatialIndex &index = combatBroadphase_->getFactionIndex();
+  const float neighborDistance = avoidance_.getConfig().neighborDistance;
+  auto addNeighbor = [&](uint32_t other, float) {
+    if (agentStamps_[other] == agentStampGeneration_) {
+      return;
+    }
+    agentStamps_[other] = agentStampGeneration_;
+    const auto &unit = units_[other];
+    if (!unit || unit->getStats().getCurrentHp() <= 0) {
+      return;
+    }
+    avoidanceAgents_.push(unit->getPosition().getX(),
+                          unit->getPosition().getY(), 0.0f, 0.0f, 0.0f, 0.0f,
+                          unit->getStats().getCollisionRadius(), 0.0f, false);
+    agentUnitIndices_.push_back(other);
+    agentSteps_.push_back(0.0f);
+  };
+  for (size_t agent = 0; agent < moverCount; ++agent) {
+    if (!avoidanceAgents_.movable[agent]) {
+      continue;
+    }
+    const UnitEntity &mover = *units_[agentUnitIndices_[agent]];
+    const float x = avoidanceAgents_.xs[agent];
+    const float y = avoidanceAgents_.ys[agent];
+    const float radius =
+        neighborDistance + mover.getStats().getCollisionRadius();
+    index.forEachInFactionRadius(mover.getFaction(), x, y, radius, addNeighbor);
+    index.forEachEnemyInRadius(mover.getFaction(), x, y, radius, addNeighbor);
+  }
+}
 
-      bool currentlyOverlapping = CollisionDomainService::hasCollisionAt(
-          currentPos, otherUnits, unit.get(), movingRadius);
-
-      if (currentlyOverlapping) {
-        Position backPos = currentPos.moveBy(-dirX * kBackoffDistance,
-                                             -dirY * kBackoffDistance);
-        backPos = resolveTerrainConstraints(*unit, currentPos, backPos);
-        if (CollisionDomainService::hasCollisionAt(backPos, otherUnits,
-                                                   unit.get(), movingRadius)) {
-          Position safePos = CollisionDomainService::calculateAvoidancePosition(
-              *unit, currentPos, otherUnits);
-          safePos = resolveTerrainConstraints(*unit, currentPos, safePos);
-          unit->setTargetPosition(safePos);
-          unit->updatePosition(safePos);
-          logFinalMovement(safePos, "avoidance");
-        } else {
-          unit->setTargetPosition(backPos);
-          unit->updatePosition(backPos);
-          logFinalMovement(backPos, "backoff");
-        }
-      } else if (t <= kEpsT) {
-        Position stopBefore = contactPos.moveBy(-dirX * kBackoffDistance,
-                                                -dirY * kBackoffDistance);
-        stopBefore = resolveTerrainConstraints(*unit, currentPos, stopBefore);
-        unit->setTargetPosition(stopBefore);
-        unit->updatePosition(stopBefore);
-        logFinalMovement(stopBefore, "collision-stop");
-      } else {
-        Position adjustedContact =
-            resolveTerrainConstraints(*unit, currentPos, contactPos);
-        unit->setTargetPosition(adjustedContact);
-        unit->updatePosition(adjustedContact);
-        logFinalMovement(adjustedContact, "collision-adjusted");
-      }
-    } else {
-      Position constrainedNext = nextPos;
-      const char *moveReason = "direct-move";
-      if (gameMap_) {
-        Position clipped = clipMovementToTerrain(*unit, currentPos, nextPos);
-        if (clipped != nextPos) {
-          constrainedNext = clipped;
-          moveReason = "terrain-contact";
-          unit->setTargetPosition(constrainedNext);
-        }
-      }
+void MovementUseCase::proposeVelocities(float deltaTime) {
+  // 1区間あたりの最小エージェント数（これ未満ではスレッドに分けない）
+  constexpr size_t kMinAgentsPerJob = 64;
 
-      unit->updatePosition(constrainedNext);
-      logFinalMovement(constrainedNext, moveReason);
-    }
+  const size_t count = avoidanceAgents_.size();
+  proposedXs_.assign(count, 0.0f);
+  proposedYs_.assign(count, 0.0f);
+  if (count == 0) {
+    return;
+  }
+  const size_t concurrency = jobSystem_ ? jobSystem_->getConcurrency() : 1;
+  const size_t jobs = std::min(
+      concurrency, (count + kMinAgentsPerJob - 1) / kMinAgentsPerJob);
+  avoidance_.build(avoidanceAgents_, std::max<size_t>(jobs, 1));
+  if (!jobSystem_ || jobs <= 1) {
+    avoidance_.computeVelocities(0, count, deltaTime, proposedXs_.data(),
+                                 proposedYs_.data());
+    return;
   }
+  const size_t agentsPerJob = (count + jobs - 1) / jobs;
+  jobSystem_->parallelFor(jobs, [&](size_t job) {
+    const size_t begin = job * agentsPerJob;
+    const size_t end = std::min(count, begin + agentsPerJob);
+    if (begin < end) {
+      avoidance_.computeVelocities(begin, end, deltaTime, proposedXs_.data(),
+                                   proposedYs_.data(), job);
+    }
+  });
 }
 
-Position MovementUseCase::calculateNextPosition(const UnitEntity &unit,
-                                                float deltaTime) const {
-  Position currentPos = unit.getPosition();
-  Position targetPos = applyBounds(unit, unit.getTargetPosition());
+void MovementUseCase::applyVelocity(size_t agentIndex, float stepTime) {
+  // 目標付近で押し返されて進めない場合に停止する距離（衝突半径の倍数）
+  constexpr float kBlockedArrivalRadii = 4.0f;
+  // 希望速度に対してこの割合しか進めなければ「進めない」とみなす
+  constexpr float kBlockedProgressRatio = 0.1f;
+
+  auto &unit = units_[agentUnitIndices_[agentIndex]];
+  const Position currentPos = unit->getPosition();
+  const Position target = unit->getTargetPosition();
+  const float preferredX = avoidanceAgents_.preferredXs[agentIndex];
+  const float preferredY = avoidanceAgents_.preferredYs[agentIndex];
+  const float velocityX = proposedXs_[agentIndex];
+  const float velocityY = proposedYs_[agentIndex];
+
+  Position candidate =
+      currentPos.moveBy(velocityX * stepTime, velocityY * stepTime);
+  const float deviation = std::hypot(velocityX - preferredX,
+                                     velocityY - preferredY);
+  const bool avoiding = deviation > 1e-3f;
+  if (!avoiding || candidate.distanceTo(target) <= 1e-3f) {
+    // 回避が不要なら検証済みの直線上を進む
+    candidate = currentPos.moveBy(preferredX * stepTime,
+                                  preferredY * stepTime);
+    if (candidate.distanceTo(target) <= 1e-3f) {
+      candidate = target;
+    }
+  }
 
-  if (gameMap_) {
-    targetPos = gameMap_->resolveMovementTarget(
-        currentPos, targetPos, unit.getStats().getCollisionRadius());
+  // 回避で逸れた位置は地形で補正してから、経路上の停止タイルで切り詰める。
+  // 検証済みの直線の近く（衝突半径以内）に留まる小さな押し出しなら検証を
+  // 残し、地形に当たったか大きく逸れた場合だけ次のフレームで検証し直す
+  // （逸れるたびに経路を探し直さない）。検証済みの直線から外れている間は
+  // 回避していない移動も地形で切り詰める
+  Position constrained = candidate;
+  const char *moveReason = "direct-move";
+  if (avoiding) {
+    constrained = resolveTerrainConstraints(*unit, currentPos, candidate);
+    constrained = clipMovementToTerrain(*unit, currentPos, constrained);
+    moveReason = constrained != candidate ? "terrain-contact" : "orca-avoidance";
+    if (constrained != candidate || !keepNudgedPath(*unit, constrained)) {
+      invalidatePath(unit->getId());
+    }
+  } else if (!isOnValidatedLine(*unit)) {
+    constrained = clipMovementToTerrain(*unit, currentPos, candidate);
+    if (constrained != candidate) {
+      moveReason = "terrain-contact";
+      invalidatePath(unit->getId());
+    }
   }
 
-  const float distance = currentPos.distanceTo(targetPos);
-  if (distance <= 0.001f || deltaTime <= 0.0f) {
-      Position clipped = targetPos;
-      if (gameMap_) {
-        clipped = clipMovementToTerrain(unit, currentPos, targetPos);
+  // 目標の近くで他ユニットに塞がれて進めない場合は、その場で到着とする。
+  // 迂回経路の途中の経由点なら止まらずに次の経由点へ向かう
+  const float preferredSpeed = std::hypot(preferredX, preferredY);
+  bool blocked = false;
+  if (avoiding && preferredSpeed > 0.0f) {
+    const float progress =
+        ((constrained.getX() - currentPos.getX()) * preferredX +
+         (constrained.getY() - currentPos.getY()) * preferredY) /
+        preferredSpeed;
+    const float radius = unit->getStats().getCollisionRadius();
+    if (progress < kBlockedProgressRatio * preferredSpeed * stepTime &&
+        currentPos.distanceTo(target) <= kBlockedArrivalRadii * radius) {
+      blocked = true;
+      constrained = currentPos;
+      if (advanceRoute(*unit, constrained)) {
+        moveReason = "blocked-waypoint";
+      } else {
+        unit->setTargetPosition(currentPos);
+        moveReason = "blocked-stop";
       }
-      return clipped;
+    }
   }
 
-  // 現在位置の地形倍率を取得（ユニットが立っている地形が移動速度を決める）
-  const float speedMultiplier = terrainSpeedMultiplier(unit, currentPos);
-  const float baseSpeed = unit.getStats().getMoveSpeed();
-  const float effectiveSpeed = baseSpeed * speedMultiplier;
-  
-  if (effectiveSpeed <= 0.0f) {
-    return currentPos;
+  // 経由点に着いたら、待機に戻さずに次の経由点を目標にする
+  if (!blocked && constrained == target) {
+    advanceRoute(*unit, constrained);
   }
-
-  const float maxDistance = std::max(0.0f, effectiveSpeed * deltaTime);
-  if (maxDistance <= 0.0f) {
-    return currentPos;
+  unit->updatePosition(constrained);
+  if (constrained == unit->getTargetPosition()) {
+    invalidatePath(unit->getId());
+  }
+  velocities_[agentUnitIndices_[agentIndex]] = SlotVelocity{
+      unit->getId(), velocityTick_,
+      Velocity{(constrained.getX() - currentPos.getX()) / stepTime,
+               (constrained.getY() - currentPos.getY()) / stepTime}};
+
+  if (currentPos != constrained) {
+    aout << "MovementUseCase::updateMovements unit=" << unit->getId()
+         << " reason=" << moveReason << " from=(" << currentPos.getX() << ", "
+         << currentPos.getY() << ")" << " to=(" << constrained.getX() << ", "
+         << constrained.getY() << ")" << " speed="
+         << currentPos.distanceTo(constrained) / stepTime
+         << " step=" << stepTime << std::endl;
   }
+}
 
-  // travelDistance は今回のフレームで進める距離（地形倍率を反映済み）
-  const float travelDistance = std::min(distance, maxDistance);
-  if (travelDistance <= 0.0f) {
-    return currentPos;
+void MovementUseCase::validatePath(UnitEntity &unit) {
+  ++pathValidationCount_;
+  auto onRoute = [&]() {
+    auto found = routes_.find(unit.getId());
+    return found != routes_.end() &&
+                   found->second.current == unit.getTargetPosition()
+               ? &found->second
+               : nullptr;
+  };
+  // 迂回経路の途中で地形が変わった場合は、直線が通れても経路を修復する
+  // （近道が開いたか、先の区間が塞がれたかもしれない）
+  const Route *route = onRoute();
+  if (route && route->plannedEpoch != currentTerrainEpoch() &&
+      replanRoute(unit)) {
+    return;
   }
 
-  if (travelDistance >= distance - 1e-5f) {
-    if (gameMap_) {
-      Position clipped = clipMovementToTerrain(unit, currentPos, targetPos);
-      return applyBounds(unit, clipped);
+  const Position target = applyBounds(unit, unit.getTargetPosition());
+  const Position reachable =
+      clipMovementToTerrain(unit, unit.getPosition(), target);
+  if (reachable != unit.getTargetPosition()) {
+    // 迂回経路の途中で逸れた場合は、切り詰めずに現在位置から探し直す。
+    // 直前に探し直したばかりなら、地形で切り詰めながら経由点へ向かい、
+    // 間隔が空くまで待つ（押し合うユニットが毎フレーム探し直さないように）
+    if (const Route *route = onRoute()) {
+      if (velocityTick_ < route->nextReplanTick) {
+        return;
+      }
+      if (replanRoute(unit)) {
+        return;
+      }
     }
-    return applyBounds(unit, targetPos);
+    dropRoute(unit.getId());
+    unit.setTargetPosition(reachable);
   }
+  validatedPaths_[unit.getId()] =
+      ValidatedPath{unit.getPosition(), reachable, currentTerrainEpoch()};
+}
 
-  const float stepRatio = travelDistance / distance;
-  Position candidate(
-      currentPos.getX() + (targetPos.getX() - currentPos.getX()) * stepRatio,
-      currentPos.getY() + (targetPos.getY() - currentPos.getY()) * stepRatio);
+bool MovementUseCase::hasValidPath(const UnitEntity &unit) const {
+  auto found = validatedPaths_.find(unit.getId());
+  return found != validatedPaths_.end() &&
+         found->second.terrainEpoch == currentTerrainEpoch() &&
+         found->second.target == unit.getTargetPosition();
+}
 
-  if (gameMap_) {
-    candidate = gameMap_->resolveMovementTarget(
-        currentPos, candidate, unit.getStats().getCollisionRadius());
-    candidate = clipMovementToTerrain(unit, currentPos, candidate);
+void MovementUseCase::invalidatePath(int unitId) {
+  // 要素は消さずに世代を外す（次の検証でノードを確保し直さない）
+  auto found = validatedPaths_.find(unitId);
+  if (found != validatedPaths_.end()) {
+    found->second.terrainEpoch = kInvalidatedEpoch;
+  }
+}
+
+bool MovementUseCase::isOnValidatedLine(const UnitEntity &unit) const {
+  auto found = validatedPaths_.find(unit.getId());
+  return hasValidPath(unit) && !found->second.nudged;
+}
+
+bool MovementUseCase::keepNudgedPath(const UnitEntity &unit,
+                                     const Position &position) {
+  // 検証済みの直線から押し出されてもよい距離（衝突半径の倍数）
+  constexpr float kPathDriftRadii = 1.0f;
+  if (!hasValidPath(unit)) {
+    return false;
   }
+  ValidatedPath &path = validatedPaths_.find(unit.getId())->second;
+  const float segmentX = path.target.getX() - path.origin.getX();
+  const float segmentY = path.target.getY() - path.origin.getY();
+  const float lengthSq = segmentX * segmentX + segmentY * segmentY;
+  float t = 0.0f;
+  if (lengthSq > 0.0f) {
+    t = ((position.getX() - path.origin.getX()) * segmentX +
+         (position.getY() - path.origin.getY()) * segmentY) /
+        lengthSq;
+    t = std::max(0.0f, std::min(1.0f, t));
+  }
+  const Position closest = path.origin.moveBy(segmentX * t, segmentY * t);
+  if (position.distanceTo(closest) >
+      kPathDriftRadii * unit.getStats().getCollisionRadius()) {
+    return false;
+  }
+  path.nudged = true;
+  return true;
+}
+
+uint64_t MovementUseCase::currentTerrainEpoch() const {
+  return gameMap_ ? gameMap_->getTerrainEpoch() : 0;
+}
 
-  return applyBounds(unit, candidate);
+size_t MovementUseCase::getRouteWaypointCount(int unitId) const {
+  auto found = routes_.find(unitId);
+  return found == routes_.end() ? 0 : found->second.remaining.size() + 1;
 }
 
 size_t MovementUseCase::getMovingUnitsCount() const {
+  if (activeUnitSets_ && activeUnitSets_->covers(units_.size())) {
+    return activeUnitSets_->getMoving().size();
+  }
   return std::count_if(units_.begin(), units_.end(),
                        [](const std::shared_ptr<UnitEntity> &unit) {
                          return unit->getStats().getCurrentHp() > 0 &&
@@ -483,8 +1054,20 @@ Position MovementUseCase::clipMovementToTerrain(const UnitEntity &unit,
 }
 
 std::shared_ptr<UnitEntity>
-MovementUseCase::findEnemyInAttackRange(const UnitEntity &unit) const {
-  // 攻撃範囲内の敵ユニットを検索
+MovementUseCase::findEnemyInAttackRange(size_t unitIndex) const {
+  // ブロードフェーズがあればティック開始時点のペアリストから引く
+  if (combatBroadphase_ && combatBroadphase_->covers(units_.size())) {
+    for (const auto &pair : combatBroadphase_->pairsForAttacker(unitIndex)) {
+      const auto &candidate = units_[pair.targetIndex];
+      if (candidate && candidate->getStats().getCurrentHp() > 0) {
+        return candidate;
+      }
+    }
+    return nullptr;
+  }
+
+  // フォールバック: 攻撃範囲内の敵ユニットを全走査で検索
+  const UnitEntity &unit = *units_[unitIndex];
   for (const auto &otherUnit : units_) {
     if (!otherUnit || otherUnit->getId() == unit.getId()) {
       continue; // 自分自身は除外
@@ -3,10 +3,19 @@
 
 #include "../domain/entities/GameMap.h"
 #include "../domain/entities/UnitEntity.h"
+#include "../domain/services/ActiveUnitSets.h"
 #include "../domain/services/CollisionDomainService.h"
+#include "../domain/services/CombatBroadphase.h"
+#include "../domain/services/GridPathfinder.h"
+#include "../domain/services/IncrementalPathfinder.h"
+#include "../domain/services/LocalAvoidance.h"
+#include "../domain/services/RectNavGraph.h"
+#include "../domain/services/SimulationLod.h"
 #include "../domain/value_objects/Position.h"
+#include "interfaces/IJobSystem.h"
 #include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -35,6 +44,20 @@ public:
       std::function<void(const UnitEntity &unit, const Position &targetPosition,
                          const std::string &reason)>;
 
+  /**
+   * @brief 迂回経路を求めた方法
+   */
+  enum class RouteBackend {
+    None,            // まだ求めていない
+    JumpPoint,       // GridPathfinder（一様な地形では Jump Point Search）
+    NavigationGraph, // RectNavGraph
+    Incremental      // IncrementalPathfinder（D* Lite。地形の変更後）
+  };
+
+  // 通れるタイルのうち一様なタイルがこの割合以上なら、ナビゲーション
+  // グラフより GridPathfinder の Jump Point Search を使う
+  static constexpr float kJumpPointMinUniformRatio = 0.5f;
+
   /**
    * @brief コンストラクタ
    * @param units 管理するユニットのリスト
@@ -49,17 +72,101 @@ public:
   void setMovementEventCallback(MovementEventCallback callback);
   void setMovementFailedCallback(MovementFailedCallback callback);
 
+  /**
+   * @brief ティックごとに構築される戦闘ブロードフェーズを注入する
+   * @param broadphase 射程内ペアのリスト（nullptr の場合は全探索）
+   *
+   * 移動中の自動停止判定（射程内の敵検出）に使用する。
+   */
+  void setCombatBroadphase(const CombatBroadphase *broadphase);
+
+  /**
+   * @brief 局所回避（ORCA）の速度計算を並列化するジョブシステムを注入する
+   * @param jobSystem nullptr の場合は呼び出しスレッドだけで計算する
+   */
+  void setJobSystem(IJobSystem *jobSystem) { jobSystem_ = jobSystem; }
+
+  /**
+   * @brief 移動中・戦闘中のユニット集合を注入する
+   * @param activeUnitSets nullptr の場合は毎ティック全ユニットを走査する
+   *
+   * 集合とブロードフェーズがどちらも units と同じ配列に対して有効な間は、
+   * 移動処理は移動中・戦闘中のユニットだけを訪問する。止まっている
+   * ユニットは動くユニットの近傍にいるものだけを回避の障害物として加える。
+   */
+  void setActiveUnitSets(const ActiveUnitSets *activeUnitSets) {
+    activeUnitSets_ = activeUnitSets;
+  }
+
+  /**
+   * @brief 画面外のユニットの移動を間引くシミュレーション LOD を注入する
+   * @param simulationLod nullptr の場合はすべて毎ティック進める
+   *
+   * 縮退したユニットは番が来たティックに貯めた時間分をまとめて進み、
+   * それ以外のティックでは回避の障害物としてだけ参加する。
+   * SimulationLod::beginTick は呼び出し側がティックごとに呼ぶ。
+   */
+  void setSimulationLod(SimulationLod *simulationLod) {
+    simulationLod_ = simulationLod;
+  }
+
+  /**
+   * @brief 迂回経路の探索に使う矩形分割のナビゲーショングラフを注入する
+   * @param navGraph nullptr の場合はタイル単位で探索する
+   *
+   * グラフを使うのは一様なタイルの割合が kJumpPointMinUniformRatio 未満の
+   * （地形の境目が多く Jump Point Search の跳び越しが効かない）地形だけ。
+   * 経路を求める前に RectNavGraph::update で地形の変更を反映する。
+   * グラフの構築時の半径より大きいユニットと、開始・目標がグラフの矩形に
+   * 含まれない場合はタイル単位の探索に切り替える。
+   */
+  void setNavigationGraph(RectNavGraph *navGraph) { navGraph_ = navGraph; }
+
   /**
    * @brief ユニットを指定位置に移動
    * @param unitId 移動するユニットのID
    * @param targetPosition 移動先の位置
    * @return 移動が成功したかどうか
+   *
+   * 直線が地形に遮られる場合は迂回経路を求め、PathSmoother で間引いた
+   * 経由点を順にたどらせる。経路が見つからないときは従来どおり遮られる
+   * 手前までの移動になる。最初の迂回経路は GridPathfinder（Jump Point
+   * Search）か、地形の境目が多ければナビゲーショングラフで求める。
+   * 移動中に地形が変わった経路は IncrementalPathfinder（D* Lite）で
+   * 求め直し、以降の変更はその探索を使って修復する。同時に持てる探索
+   * 状態は kMaxIncrementalRoutes 個までで、それを超えた経路は最初と同じ
+   * 方法で探し直す。
    */
   bool moveUnitTo(int unitId, const Position &targetPosition);
 
+  /**
+   * @brief 複数ユニットを隊形を組んで同じ目標へ移動させる
+   * @param unitIds 移動するユニットのID（死亡・不明なIDは無視）
+   * @param targetPosition 隊形の中心の目標位置
+   * @param spacing 枠の間隔（0 以下なら最大衝突半径の 3 倍）
+   * @return 移動命令を受け付けたユニット数
+   *
+   * 隊形の中心（アンカー）の経路を1回だけ求め（直線が遮られれば
+   * planRoute で迂回する）、経路の終点に枠のオフセットを足した位置を
+   * 各ユニットの目標にする。枠の歩行可能性は GameMap::areWalkable で
+   * まとめて確かめ、歩けない枠だけをアンカー側へ引き戻す。各ユニットは
+   * アンカーの経由点をたどり、自分の位置から最初の経由点までと最後の
+   * 経由点から枠までの区間だけを検証する（通れなければ自分で経路を探す）。
+   *
+   * 注意: タップ入力（Renderer::moveUnitToPosition）は1体ずつの
+   * moveUnitTo を使う。複数ユニットを選ぶ入力ができたらここを呼ぶ。
+   */
+  size_t moveFormationTo(const std::vector<int> &unitIds,
+                         const Position &targetPosition, float spacing = 0.0f);
+
   /**
    * @brief 全ユニットの移動更新処理
    * @param deltaTime フレーム間の経過時間
+   *
+   * 1. 射程内の敵による自動停止と、目標へ向かう希望速度の算出（逐次）。
+   *    検証済みの直線経路があれば地形の再検証はせず、速度倍率だけを見る
+   * 2. 近傍ユニットとの ORCA で衝突しない速度を求める（並列の提案フェーズ）
+   * 3. 求めた速度で移動し、地形で補正する（逐次の適用フェーズ）
    */
   void updateMovements(float deltaTime);
 
@@ -69,6 +176,38 @@ public:
    */
   size_t getMovingUnitsCount() const;
 
+  /**
+   * @brief これまでに行った経路の地形検証（レイキャスト）の回数
+   *
+   * 移動命令ごとに1回が基本。地形の変更や、回避で検証済みの直線から
+   * 大きく逸れた場合に増える。
+   */
+  size_t getPathValidationCount() const { return pathValidationCount_; }
+
+  /**
+   * @brief これまでに迂回経路を求め直した回数（計測用）
+   *
+   * 地形の変更か、回避で経由点への直線から逸れた場合に増える。逸れた
+   * 場合の探し直しはユニットごとに一定のティック数を空ける。
+   */
+  size_t getRouteReplanCount() const { return routeReplanCount_; }
+
+  /**
+   * @brief ユニットがこれからたどる経由点の数（現在の目標を含む。
+   *        迂回経路を持たなければ 0）
+   */
+  size_t getRouteWaypointCount(int unitId) const;
+
+  /**
+   * @brief 修復用の探索状態（D* Lite）を持っている迂回経路の数
+   */
+  size_t getIncrementalRouteCount() const { return plannersInUse_; }
+
+  /**
+   * @brief 直前に迂回経路を求めた（求め直した）方法
+   */
+  RouteBackend getLastRouteBackend() const { return lastRouteBackend_; }
+
   /**
    * @brief 指定位置への移動可能性をチェック
    * @param unitId チェックするユニットのID
@@ -96,6 +235,88 @@ private:
   const class GameMap *gameMap_ = nullptr;
   MovementEventCallback movementEventCallback_;
   MovementFailedCallback movementFailedCallback_;
+  const CombatBroadphase *combatBroadphase_ = nullptr;
+  IJobSystem *jobSystem_ = nullptr;
+  const ActiveUnitSets *activeUnitSets_ = nullptr;
+  SimulationLod *simulationLod_ = nullptr;
+  RectNavGraph *navGraph_ = nullptr;
+
+  // アクティブ集合から集めた訪問対象（units_ の位置、昇順）
+  std::vector<size_t> activeIndices_;
+  // 回避の近傍として追加済みかの印（世代番号で毎ティックのクリアを省く）
+  std::vector<uint32_t> agentStamps_;
+  uint32_t agentStampGeneration_ = 0;
+
+  // 局所回避。入力と出力はティックごとに作り直す（容量は再利用する）
+  struct Velocity {
+    float x;
+    float y;
+  };
+  LocalAvoidance avoidance_;
+  AvoidanceAgents avoidanceAgents_;
+  std::vector<size_t> agentUnitIndices_; // エージェント -> units_ の位置
+  std::vector<float> agentSteps_; // エージェントを進める時間（LOD で伸びる）
+  std::vector<float> proposedXs_;
+  std::vector<float> proposedYs_;
+  // units_ の位置 -> 実際の速度（ORCA の入力）。unitId が違う（除去や
+  // 並べ替えで位置がずれた）か、前ティックに記録されていない速度は 0 とみなす
+  struct SlotVelocity {
+    int unitId;
+    uint32_t tick;
+    Velocity velocity;
+  };
+  std::vector<SlotVelocity> velocities_;
+  uint32_t velocityTick_ = 0;
+
+  // 地形に対して検証済みの移動経路。origin から target までの直線が
+  // terrainEpoch 時点の地形で通れることを表す。target がユニットの目標と
+  // 一致し、地形が変わっていない間は毎フレームの再検証を省く。nudged は
+  // 回避で直線の近くへ押し出された（直線上にはいない）こと
+  struct ValidatedPath {
+    Position origin;
+    Position target;
+    uint64_t terrainEpoch;
+    bool nudged = false;
+  };
+  std::unordered_map<int, ValidatedPath> validatedPaths_; // ユニットID -> 経路
+  // invalidatePath 後の terrainEpoch（地形の世代はここまで進まない）
+  static constexpr uint64_t kInvalidatedEpoch = UINT64_MAX;
+  size_t pathValidationCount_ = 0;
+
+  // 迂回経路。ユニットの目標は current で、着いたら remaining の末尾へ
+  // 進む（remaining は逆順に持ち、取り出しを pop_back で済ませる）。
+  // 目標が current 以外に変えられた経路は次の到着時に捨てる。
+  // planner は修復用の探索状態（地形の変更で求め直すまでと、上限を
+  // 超えた経路では nullptr）
+  struct Route {
+    Position current;
+    Position goal;
+    std::vector<Position> remaining;
+    std::unique_ptr<IncrementalPathfinder> planner;
+    uint64_t plannedEpoch = 0; // 経路を求めた時点の地形
+    uint32_t nextReplanTick = 0; // 逸れて探し直せる次のティック
+    bool repairable = true; // 修復が打ち切られたら、以降は探索状態を持たない
+  };
+  // 逸れた迂回経路を探し直してから、次に探し直すまでのティック数
+  static constexpr uint32_t kReplanCooldownTicks = 15;
+  size_t routeReplanCount_ = 0;
+  // 探索状態はマップの大きさの配列（256x256 で約 1.4 MB）を持つので、
+  // 同時に持つ数と、使い回しのために残しておく数を抑える
+  static constexpr size_t kMaxIncrementalRoutes = 8;
+  static constexpr size_t kMaxSparePlanners = 2;
+  std::unordered_map<int, Route> routes_; // ユニットID -> 経路
+  std::vector<std::unique_ptr<IncrementalPathfinder>> sparePlanners_;
+  size_t plannersInUse_ = 0;
+  GridPathfinder pathfinder_;
+  RouteBackend lastRouteBackend_ = RouteBackend::None;
+  std::vector<Position> routeWaypoints_; // 経路探索の作業領域
+
+  // 隊形移動の作業領域
+  std::vector<Position> formationPositions_;
+  std::vector<Position> formationSlots_;
+  std::vector<size_t> formationAssignment_;
+  std::vector<uint8_t> formationWalkable_;
+  std::vector<Position> formationRoute_; // アンカーの迂回経路（直進なら空）
 
   // 移動制御フラグ
   bool movementEnabled_;
@@ -112,16 +333,19 @@ private:
 
   /**
    * @brief 他のユニットのリストを取得（指定ユニット以外）
+   *
+   * 呼び出し元は canMoveToPosition だけで、毎ティックの処理からは
+   * 呼ばれない（一覧をフレームアリーナに置く必要はない）
    */
   std::vector<std::shared_ptr<UnitEntity>>
   getOtherUnits(const UnitEntity &excludeUnit) const;
 
   /**
    * @brief 攻撃範囲内に敵ユニットがいるかチェック
-   * @param unit チェック対象のユニット
+   * @param unitIndex チェック対象のユニットの units_ 上のインデックス
    * @return 攻撃範囲内に敵がいる場合はそのユニット、いない場合はnullptr
    */
-  std::shared_ptr<UnitEntity> findEnemyInAttackRange(const UnitEntity &unit) const;
+  std::shared_ptr<UnitEntity> findEnemyInAttackRange(size_t unitIndex) const;
 
   /**
    * @brief 敵に対して攻撃範囲ギリギリの位置を計算
@@ -133,9 +357,142 @@ private:
                                         const UnitEntity &enemy) const;
 
   /**
-   * @brief 指定ユニットの次フレームでの位置を計算
+   * @brief 検証済みの目標を移動命令として確定する（ログ・攻撃抑制・通知）
+   * @param targetPosition 呼び出し元が指定した目標（通知用）
+   * @param finalTarget 地形で補正済みの目標
+   */
+  bool commitMoveOrder(UnitEntity &unit, const Position &targetPosition,
+                       const Position &finalTarget);
+
+  /**
+   * @brief 隊形の1体に枠への移動命令を出す（moveFormationTo 用）
+   *
+   * formationRoute_ の経由点をたどる経路を作り、両端の区間を検証する
+   */
+  bool orderFormationMember(UnitEntity &unit, const Position &targetPosition,
+                            const Position &slot);
+
+  /**
+   * @brief start から goal までの迂回経路を求めて routeWaypoints_ に
+   *        間引いた経由点を置く（先頭は start）
+   *
+   * 一様なタイルが多い地形は GridPathfinder（Jump Point Search）で、
+   * 少なければナビゲーショングラフ（あれば）で求める。グラフが使えない
+   * 場合も GridPathfinder で求める。修復用の探索状態は持たない
+   * @param radius 通る者の衝突半径
+   * @return 経路が見つかったか
+   */
+  bool planRoute(const Position &start, const Position &goal, float radius);
+
+  /**
+   * @brief 迂回経路を現在位置と現在の地形で求め直し、ユニットの目標を
+   *        新しい最初の経由点にする
+   *
+   * 探索状態を持つ経路は修復する（修復が打ち切られたら planRoute で
+   * 求め直し、以降その経路は探索状態を持たない）。持たない経路は、地形が
+   * 変わっていれば探索状態を割り当てて D* Lite で求め、変わっていなければ
+   * planRoute で求め直す
+   * @return 求め直せたか（できなければ経路を捨てる）
+   */
+  bool replanRoute(UnitEntity &unit);
+
+  /**
+   * @brief routeWaypoints_ の生の経路を間引く（planRoute / replanRoute 用）
+   */
+  bool smoothRoute(float radius);
+
+  /**
+   * @brief routeWaypoints_ の経路をユニットに持たせる
+   *
+   * ユニットの目標は呼び出し側が routeWaypoints_[1] に設定済みであること。
+   * 経由点の間の直線は経路探索と間引きで通れることが分かっているので、
+   * 検証済みの経路として記録する（移動中の再検証は不要）。
+   */
+  void beginRoute(UnitEntity &unit, const Position &goal,
+                  std::unique_ptr<IncrementalPathfinder> planner);
+
+  /**
+   * @brief 迂回経路を捨て、探索状態を使い回し用に戻す
+   */
+  void dropRoute(int unitId);
+  std::unique_ptr<IncrementalPathfinder> acquirePlanner();
+  void releasePlanner(std::unique_ptr<IncrementalPathfinder> planner);
+
+  /**
+   * @brief 経由点に着いたユニットを次の経由点へ進める
+   * @param position 更新後のユニットの位置。経由点ちょうどにいる場合だけ
+   *        次の区間を検証済みとする
+   * @return 次の経由点を目標にしたか（経路の終わり・無効なら false）
+   */
+  bool advanceRoute(UnitEntity &unit, const Position &position);
+
+  /**
+   * @brief LOD で今回進めるかを決めてから gatherAgent する
+   *
+   * 今回進めないユニットは、前回の速度を引き継いだ止まった障害物として加える。
+   */
+  void gatherWithLod(size_t unitIndex, float deltaTime, float nowSec);
+
+  /**
+   * @brief 1体分の自動停止判定と希望速度の算出を行い、回避エージェントに加える
+   * @param unitIndex units_ 上の位置
+   * @param stepTime このユニットを進める時間
+   * @param nowSec 現在時刻（攻撃意思の判定用）
+   */
+  void gatherAgent(size_t unitIndex, float stepTime, float nowSec);
+
+  /**
+   * @brief 動くエージェントの近傍にいる止まったユニットを障害物として加える
+   *
+   * ブロードフェーズの陣営別インデックスで近傍だけを引く（全走査しない）。
+   */
+  void gatherStaticNeighbors();
+
+  /**
+   * @brief 提案フェーズ: 全エージェントの回避速度を区間に分けて並列に求める
+   */
+  void proposeVelocities(float deltaTime);
+
+  /**
+   * @brief 適用フェーズ: 1体分の回避速度で移動させる
+   * @param agentIndex avoidanceAgents_ 上の位置
+   * @param stepTime 進める時間（agentSteps_ の値）
+   */
+  void applyVelocity(size_t agentIndex, float stepTime);
+
+  /**
+   * @brief 前ティックに記録した units_[unitIndex] の速度（なければ 0）
+   */
+  Velocity previousVelocity(size_t unitIndex) const;
+
+  /**
+   * @brief 現在位置から目標までの直線経路を地形に対して検証し、記録する
+   *
+   * 目標は範囲内に収め、経路上の停止タイルの手前で切り詰める（切り詰めた
+   * 場合はユニットの目標も更新する）。
+   */
+  void validatePath(UnitEntity &unit);
+
+  /**
+   * @brief 検証済みの経路がユニットの現在の目標と地形に対して有効か
+   */
+  bool hasValidPath(const UnitEntity &unit) const;
+
+  /**
+   * @brief 検証済みの直線の上にいるか（回避で押し出されていないか）
+   */
+  bool isOnValidatedLine(const UnitEntity &unit) const;
+
+  /**
+   * @brief 回避で押し出された位置が検証済みの直線の近くなら検証を残す
+   * @return 残したか（false なら呼び出し側で検証を捨てる）
+   */
+  bool keepNudgedPath(const UnitEntity &unit, const Position &position);
+  /**
+   * @brief 検証済みの経路を無効にする（hasValidPath が false になる）
    */
-  Position calculateNextPosition(const UnitEntity &unit, float deltaTime) const;
+  void invalidatePath(int unitId);
+  uint64_t currentTerrainEpoch() const;
 
   Position applyBounds(const UnitEntity &unit, const Position &desired) const;
   float terrainSpeedMultiplier(const UnitEntity &unit,
@@ -0,0 +1,49 @@
+#ifndef SIMULATION_GAME_IJOB_SYSTEM_H
+#define SIMULATION_GAME_IJOB_SYSTEM_H
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief ジョブシステムのインターフェース
+ *
+ * 設計方針：
+ * - 依存関係逆転の原則（DIP）を適用。ユースケース層はスレッドの実装
+ *   （std::thread / プラットフォーム固有のプール）に依存しない
+ * - フォーク・ジョイン型の parallelFor は全ジョブの完了までブロックする
+ * - submit は完了を待たない単発のタスク用。結果の受け渡しは呼び出し側で
+ *   （アトミック変数などで）行う
+ */
+class IJobSystem {
+public:
+  virtual ~IJobSystem() = default;
+
+  /**
+   * @brief 同時に実行できるジョブ数（呼び出しスレッドを含む）
+   */
+  virtual size_t getConcurrency() const = 0;
+
+  /**
+   * @brief jobCount 個のジョブを並列に実行し、全て終わるまで待つ
+   * @param jobCount ジョブ数
+   * @param job void(size_t jobIndex) を受け取る関数
+   *
+   * 各 jobIndex はちょうど1回ずつ実行される。どのスレッドで実行されるかは
+   * 不定なので、ジョブ間で共有する状態は呼び出し側で分離すること。
+   */
+  virtual void parallelFor(size_t jobCount,
+                           const std::function<void(size_t)> &job) = 0;
+
+  /**
+   * @brief タスクをバックグラウンドで実行する（完了を待たない）
+   * @param task 実行する関数
+   *
+   * タスク内から parallelFor を呼び出してよい。既定の実装は呼び出し
+   * スレッドでそのまま実行する（スレッドを持たない実装・テスト用）。
+   * 破棄時に未着手のタスクは捨ててよいので、タスクが参照するものは
+   * ジョブシステムより長く生存させること。
+   */
+  virtual void submit(std::function<void()> task) { task(); }
+};
+
+#endif // SIMULATION_GAME_IJOB_SYSTEM_H
@@ -0,0 +1,34 @@
+#ifndef SIMULATION_GAME_IPROFILER_H
+#define SIMULATION_GAME_IPROFILER_H
+
+/**
+ * @brief 区間計測（プロファイラ）のインターフェース
+ *
+ * 設計方針：
+ * - 依存関係逆転の原則（DIP）を適用。ユースケース層は計測結果の集計・出力
+ *   方法（ログ / 画面表示）に依存しない
+ * - 区間名は文字列リテラルを想定する（ポインタは呼び出し後も有効であること）
+ */
+class IProfiler {
+public:
+  virtual ~IProfiler() = default;
+
+  /**
+   * @brief 区間の所要時間を記録する
+   * @param section 区間名
+   * @param microseconds 所要時間（マイクロ秒）
+   */
+  virtual void recordSample(const char *section, float microseconds) = 0;
+
+  /**
+   * @brief 予算を超過したことを記録する
+   * @param section 区間名
+   * @param budgetMicroseconds 予算（マイクロ秒）
+   * @param usedMicroseconds 実際の所要時間（マイクロ秒）
+   */
+  virtual void recordBudgetOverrun(const char *section,
+                                   float budgetMicroseconds,
+                                   float usedMicroseconds) = 0;
+};
+
+#endif // SIMULATION_GAME_IPROFILER_H